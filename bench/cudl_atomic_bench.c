@@ -0,0 +1,86 @@
+#include "cudl_bench.h"
+#include <cudl_atomic.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(b, uint64_t)
+CUDL_ADD_ATOMIC_UNIT(b, uint64_t)
+CUDL_ADD_SHARDED_COUNTER(b, 16)
+
+#define ATOMIC_BENCH_MAX_THREADS 16
+#define ATOMIC_BENCH_INCREMENTS ((size_t) 1 << 24)
+
+static cudl_b_atomic_t shared;
+static cudl_b_atomic_t adjacent[ATOMIC_BENCH_MAX_THREADS];
+static cudl_b_padded_atomic_t padded[ATOMIC_BENCH_MAX_THREADS];
+static cudl_b_sharded_counter_t sharded;
+
+typedef struct {
+    size_t index;
+    size_t increments;
+} worker_t;
+
+static void *shared_worker(void *arg) {
+    const worker_t *worker = (const worker_t *) arg;
+    for (size_t i = 0; i < worker->increments; ++i) {
+        cudl_b_atomic_fetch_add_explicit(&shared, cudl_b(1), memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static void *adjacent_worker(void *arg) {
+    const worker_t *worker = (const worker_t *) arg;
+    for (size_t i = 0; i < worker->increments; ++i) {
+        cudl_b_atomic_fetch_add_explicit(&adjacent[worker->index], cudl_b(1), memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static void *padded_worker(void *arg) {
+    const worker_t *worker = (const worker_t *) arg;
+    for (size_t i = 0; i < worker->increments; ++i) {
+        cudl_b_atomic_fetch_add_explicit(&padded[worker->index].atomic, cudl_b(1), memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static void *sharded_worker(void *arg) {
+    const worker_t *worker = (const worker_t *) arg;
+    for (size_t i = 0; i < worker->increments; ++i) { cudl_b_sharded_counter_add(&sharded, cudl_b(1)); }
+    return NULL;
+}
+
+static void run(const char *label, void *(*function)(void *), size_t threads) {
+    pthread_t ids[ATOMIC_BENCH_MAX_THREADS];
+    worker_t workers[ATOMIC_BENCH_MAX_THREADS];
+    char full_label[64];
+
+    double start = cudl_bench_now_ns();
+    for (size_t t = 0; t < threads; ++t) {
+        workers[t].index = t;
+        workers[t].increments = ATOMIC_BENCH_INCREMENTS / threads;
+        if (pthread_create(&ids[t], NULL, function, &workers[t]) != 0) { abort(); }
+    }
+    for (size_t t = 0; t < threads; ++t) { pthread_join(ids[t], NULL); }
+    snprintf(full_label, sizeof(full_label), "%s, %zu threads", label, threads);
+    cudl_bench_report("atomic add", full_label, ATOMIC_BENCH_INCREMENTS,
+                      (cudl_bench_now_ns() - start) / (double) ATOMIC_BENCH_INCREMENTS);
+}
+
+void cudl_atomic_bench(void) {
+    static const size_t thread_counts[] = {1, 2, 4, 8, 16};
+
+    cudl_b_atomic_init(&shared, cudl_b(0));
+    cudl_b_sharded_counter_init(&sharded);
+    for (size_t t = 0; t < ATOMIC_BENCH_MAX_THREADS; ++t) {
+        cudl_b_atomic_init(&adjacent[t], cudl_b(0));
+        cudl_b_atomic_init(&padded[t].atomic, cudl_b(0));
+    }
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); ++i) {
+        run("shared atomic", shared_worker, thread_counts[i]);
+        run("adjacent atomics", adjacent_worker, thread_counts[i]);
+        run("padded atomics", padded_worker, thread_counts[i]);
+        run("sharded counter", sharded_worker, thread_counts[i]);
+    }
+}
@@ -0,0 +1,125 @@
+/**
+ * @file cudl_bench.h
+ * @brief Small timing helpers shared by the cudl benchmarks. Every benchmark reports the time spent per processed
+ * element, in nanoseconds.
+ */
+
+#ifndef CUDL_BENCH_H
+#define CUDL_BENCH_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @brief Number of elements processed by a benchmark, all repetitions included. The repetition count is derived from
+ * it so that every measurement lasts roughly the same time whatever the array size is. Benchmarks of slow operations
+ * may define a smaller value before including this header.
+ */
+#ifndef CUDL_BENCH_TOTAL_ELEMENTS
+#define CUDL_BENCH_TOTAL_ELEMENTS ((size_t) 1 << 26)
+#endif
+
+static inline double cudl_bench_now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+/**
+ * @brief Prevents the optimizer from removing the benchmarked computation, and from moving it out of the repetition
+ * loop, by pretending that the memory pointed by _ptr is read.
+ */
+static inline void cudl_bench_clobber(const void *ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ volatile("" : : "g"(ptr) : "memory");
+#else
+    static const void *volatile sink;
+    sink = ptr;
+#endif
+}
+
+static inline void cudl_bench_report(const char *group, const char *label, size_t n, double ns_per_element) {
+    printf("%-14s %-44s n=%-10zu %8.3f ns/element\n", group, label, n, ns_per_element);
+}
+
+/**
+ * @brief Times _statement, that must process _n elements and write them at _output, and reports the ns per element.
+ */
+#define CUDL_BENCH(_group, _label, _n, _output, _statement)                                                            \
+    do {                                                                                                               \
+        size_t repeat = CUDL_BENCH_TOTAL_ELEMENTS / (_n) + 1;                                                          \
+        double start = cudl_bench_now_ns();                                                                            \
+        for (size_t rep = 0; rep < repeat; ++rep) {                                                                    \
+            _statement;                                                                                                \
+            cudl_bench_clobber(_output);                                                                               \
+        }                                                                                                              \
+        cudl_bench_report(_group, _label, _n, (cudl_bench_now_ns() - start) / ((double) repeat * (double) (_n)));      \
+    } while (0)
+
+/**
+ * @brief Times every generated op family against the equivalent raw C loop, over arrays of n elements.
+ */
+void cudl_ops_bench(size_t n);
+
+/**
+ * @brief Compares the conversions added by CUDL_ADD_CONVERSION_FRACTION_FACTOR and
+ * CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR.
+ */
+void cudl_conversion_bench(void);
+
+/**
+ * @brief Measures the throughput of a ring buffer added by CUDL_ADD_RING_BUFFER between a producer and a consumer
+ * thread, moving values one by one, in blocks, and in place.
+ */
+void cudl_ring_buffer_bench(void);
+
+/**
+ * @brief Measures how atomic unit increments scale with the number of threads, with a single shared atomic, with per
+ * thread atomics in adjacent and in padded memory, and with a sharded counter. The time is per increment, all threads
+ * included.
+ */
+void cudl_atomic_bench(void);
+
+/**
+ * @brief Compares the cudl_<name>_to_chars and cudl_<name>_from_chars functions to snprintf, strtol and strtod.
+ */
+void cudl_chars_bench(void);
+
+/**
+ * @brief Compares scans of one field over an array of records and over the column of a container added by CUDL_ADD_SOA,
+ * and the appends of records one by one and in bulk.
+ */
+void cudl_soa_bench(void);
+
+/**
+ * @brief Measures how the CUDL_ADD_PARALLEL_* functions scale with the number of threads of the pool, and compares a
+ * chain of whole array passes to the same steps fused by CUDL_ADD_PARALLEL_REDUCE_CHAIN.
+ */
+void cudl_parallel_bench(void);
+
+/**
+ * @brief Measures the cost of recording values in a histogram added by CUDL_ADD_HISTOGRAM, compared to counting them in
+ * a plain array, and the cost per bucket of merging histograms and of querying a percentile.
+ */
+void cudl_histogram_bench(void);
+
+/**
+ * @brief Measures the writer of a sample file added by CUDL_ADD_SAMPLE_FILE, appending samples one by one and in bulk,
+ * and compares reading the samples of the file with fread to summing them in place in its mapped view.
+ */
+void cudl_sample_file_bench(void);
+
+/**
+ * @brief Compares the functions added by CUDL_ADD_SELECTION_OPERATORS to the equivalent loops with a branch per value,
+ * with a threshold that makes the branch unpredictable and with one that is rarely exceeded.
+ */
+void cudl_selection_bench(void);
+
+/**
+ * @brief Compares the FIR filters and moving averages added by CUDL_ADD_FIR_FILTER and CUDL_ADD_MOVING_AVERAGE to
+ * their per value versions, and measures the biquad filters and the decimators.
+ */
+void cudl_filter_bench(void);
+
+#endif//CUDL_BENCH_H
@@ -0,0 +1,73 @@
+// Formatting and parsing text is around a hundred times slower than the arithmetic benchmarked elsewhere
+#define CUDL_BENCH_TOTAL_ELEMENTS ((size_t) 1 << 21)
+#include "cudl_bench.h"
+#include <cudl_chars.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(mv, int32_t)
+CUDL_ADD_EXPLICIT_INTEGER_CHARS(mv, int32_t, "mV")
+
+CUDL_ADD_UNIT(rad, double)
+CUDL_ADD_FLOAT_CHARS(rad, double)
+
+#define CHARS_BENCH_VALUES 100000
+#define CHARS_BENCH_TEXT_SIZE 40
+
+void cudl_chars_bench(void) {
+    const size_t n = CHARS_BENCH_VALUES;
+    cudl_mv_t *voltages = malloc(n * sizeof(cudl_mv_t));
+    cudl_rad_t *angles = malloc(n * sizeof(cudl_rad_t));
+    char *texts = malloc(n * CHARS_BENCH_TEXT_SIZE);
+    size_t *lens = malloc(n * sizeof(size_t));
+    if (!voltages || !angles || !texts || !lens) {
+        printf("chars bench: allocation failed, skipped\n");
+    } else {
+        uint64_t state = 88172645463325252ULL;
+        for (size_t i = 0; i < n; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            voltages[i] = cudl_mv((int32_t) (state % 2000001) - 1000000);
+            angles[i] = cudl_rad((double) (state >> 11) / (double) (1ULL << 53) * 6.283185307179586);
+        }
+
+        CUDL_BENCH("int format", "snprintf(\"%dmV\")", n, texts, for (size_t i = 0; i < n; ++i) {
+            lens[i] = (size_t) snprintf(texts + i * CHARS_BENCH_TEXT_SIZE, CHARS_BENCH_TEXT_SIZE, "%dmV",
+                                        (int) CUDL_GET(voltages[i]));
+        });
+        CUDL_BENCH("int format", "cudl_mv_to_chars", n, texts, for (size_t i = 0; i < n; ++i) {
+            lens[i] = cudl_mv_to_chars(texts + i * CHARS_BENCH_TEXT_SIZE, CHARS_BENCH_TEXT_SIZE, voltages[i]);
+        });
+        CUDL_BENCH("int parse", "strtol", n, voltages, for (size_t i = 0; i < n; ++i) {
+            voltages[i] = cudl_mv((int32_t) strtol(texts + i * CHARS_BENCH_TEXT_SIZE, NULL, 10));
+        });
+        CUDL_BENCH("int parse", "cudl_mv_from_chars", n, voltages, for (size_t i = 0; i < n; ++i) {
+            cudl_mv_from_chars(texts + i * CHARS_BENCH_TEXT_SIZE, lens[i], &voltages[i]);
+        });
+
+        CUDL_BENCH("float format", "snprintf(\"%.17grad\")", n, texts, for (size_t i = 0; i < n; ++i) {
+            lens[i] = (size_t) snprintf(texts + i * CHARS_BENCH_TEXT_SIZE, CHARS_BENCH_TEXT_SIZE, "%.17grad",
+                                        CUDL_GET(angles[i]));
+        });
+        CUDL_BENCH("float parse", "strtod (17 digits)", n, angles, for (size_t i = 0; i < n; ++i) {
+            angles[i] = cudl_rad(strtod(texts + i * CHARS_BENCH_TEXT_SIZE, NULL));
+        });
+        CUDL_BENCH("float parse", "cudl_rad_from_chars (17 digits)", n, angles, for (size_t i = 0; i < n; ++i) {
+            cudl_rad_from_chars(texts + i * CHARS_BENCH_TEXT_SIZE, lens[i], &angles[i]);
+        });
+        CUDL_BENCH("float format", "cudl_rad_to_chars (shortest)", n, texts, for (size_t i = 0; i < n; ++i) {
+            lens[i] = cudl_rad_to_chars(texts + i * CHARS_BENCH_TEXT_SIZE, CHARS_BENCH_TEXT_SIZE, angles[i]);
+        });
+        CUDL_BENCH("float parse", "strtod (shortest)", n, angles, for (size_t i = 0; i < n; ++i) {
+            angles[i] = cudl_rad(strtod(texts + i * CHARS_BENCH_TEXT_SIZE, NULL));
+        });
+        CUDL_BENCH("float parse", "cudl_rad_from_chars (shortest)", n, angles, for (size_t i = 0; i < n; ++i) {
+            cudl_rad_from_chars(texts + i * CHARS_BENCH_TEXT_SIZE, lens[i], &angles[i]);
+        });
+    }
+    free(voltages);
+    free(angles);
+    free(texts);
+    free(lens);
+}
@@ -0,0 +1,72 @@
+/*
+ * Representative functions compiled by cudl_codegen_check.cmake. Every cudl_wrapped_<op> function must compile to the
+ * same number of instructions as its cudl_raw_<op> counterpart, which is the loop or expression a user would write
+ * without cudl.
+ */
+#include <cudl.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(v, uint32_t)
+CUDL_ADD_INTEGER_OPERATORS(v, uint32_t)
+CUDL_ADD_INTEGER_ARRAY_OPERATORS(v, uint32_t)
+
+CUDL_ADD_UNIT(mv, uint32_t)
+
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(mv, v, 1, 1000)
+
+CUDL_ADD_UNIT(rad, double)
+CUDL_ADD_COMMON_OPERATORS(rad, double)
+
+CUDL_ADD_UNIT(deg, double)
+
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(rad, deg, 180.0, 3.14159265358979323846)
+
+cudl_v_t cudl_wrapped_add(cudl_v_t lhs, cudl_v_t rhs) { return cudl_v_add(lhs, rhs); }
+uint32_t cudl_raw_add(uint32_t lhs, uint32_t rhs) { return lhs + rhs; }
+
+cudl_v_t cudl_wrapped_mul(cudl_v_t lhs, uint32_t rhs) { return cudl_v_mul(lhs, rhs); }
+uint32_t cudl_raw_mul(uint32_t lhs, uint32_t rhs) { return lhs * rhs; }
+
+cudl_v_t cudl_wrapped_bsl(cudl_v_t lhs, uint32_t rhs) { return cudl_v_bsl(lhs, rhs); }
+uint32_t cudl_raw_bsl(uint32_t lhs, uint32_t rhs) { return lhs << rhs; }
+
+bool cudl_wrapped_gt(cudl_v_t lhs, cudl_v_t rhs) { return cudl_v_gt(lhs, rhs); }
+bool cudl_raw_gt(uint32_t lhs, uint32_t rhs) { return lhs > rhs; }
+
+cudl_v_t cudl_wrapped_conversion(cudl_mv_t value) { return cudl_from_mv_to_v(value); }
+uint32_t cudl_raw_conversion(uint32_t value) { return value / 1000; }
+
+cudl_rad_t cudl_wrapped_float_add(cudl_rad_t lhs, cudl_rad_t rhs) { return cudl_rad_add(lhs, rhs); }
+double cudl_raw_float_add(double lhs, double rhs) { return lhs + rhs; }
+
+cudl_deg_t cudl_wrapped_float_conversion(cudl_rad_t value) { return cudl_from_rad_to_deg(value); }
+double cudl_raw_float_conversion(double value) { return (value * 180.0) / 3.14159265358979323846; }
+
+void cudl_wrapped_add_n(cudl_v_t *restrict dst, const cudl_v_t *restrict lhs, const cudl_v_t *restrict rhs,
+                        size_t n) {
+    cudl_v_add_n(dst, lhs, rhs, n);
+}
+void cudl_raw_add_n(uint32_t *restrict dst, const uint32_t *restrict lhs, const uint32_t *restrict rhs, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = lhs[i] + rhs[i]; }
+}
+
+void cudl_wrapped_mul_n(cudl_v_t *restrict dst, const cudl_v_t *restrict lhs, uint32_t rhs, size_t n) {
+    cudl_v_mul_n(dst, lhs, rhs, n);
+}
+void cudl_raw_mul_n(uint32_t *restrict dst, const uint32_t *restrict lhs, uint32_t rhs, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = lhs[i] * rhs; }
+}
+
+void cudl_wrapped_gt_n(bool *restrict dst, const cudl_v_t *restrict lhs, const cudl_v_t *restrict rhs, size_t n) {
+    cudl_v_gt_n(dst, lhs, rhs, n);
+}
+void cudl_raw_gt_n(bool *restrict dst, const uint32_t *restrict lhs, const uint32_t *restrict rhs, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = lhs[i] > rhs[i]; }
+}
+
+void cudl_wrapped_conversion_n(cudl_v_t *restrict dst, const cudl_mv_t *restrict src, size_t n) {
+    cudl_from_mv_to_v_n(dst, src, n);
+}
+void cudl_raw_conversion_n(uint32_t *restrict dst, const uint32_t *restrict src, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = src[i] / 1000; }
+}
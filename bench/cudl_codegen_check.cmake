@@ -0,0 +1,70 @@
+# Compiles cudl_codegen_check.c to assembly and checks that every cudl_wrapped_<op> function has as many instructions
+# as its cudl_raw_<op> counterpart, and that nothing refers to the cudl_trace.h instrumentation. With TRACE set, the
+# source is compiled with CUDL_ENABLE_TRACE instead, and every wrapped function must be longer than its raw counterpart
+# and call the instrumentation, which shows that the hooks are really compiled out by default. Only the GNU assembler
+# syntax emitted by GCC and Clang is supported.
+#
+# Expected variables: COMPILER, SOURCE, INCLUDE_DIR, OUTPUT, FLAGS (a list, -O2 by default) and TRACE (optional).
+
+if (NOT FLAGS)
+    set(FLAGS -O2)
+endif ()
+if (TRACE)
+    list(APPEND FLAGS -DCUDL_ENABLE_TRACE)
+endif ()
+
+execute_process(
+        COMMAND ${COMPILER} ${FLAGS} -std=c17 -S -I${INCLUDE_DIR} -o ${OUTPUT} ${SOURCE}
+        RESULT_VARIABLE result
+        ERROR_VARIABLE error)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to compile ${SOURCE}:\n${error}")
+endif ()
+
+file(STRINGS ${OUTPUT} lines)
+set(current "")
+set(functions "")
+set(traced FALSE)
+foreach (line IN LISTS lines)
+    if (line MATCHES "cudl_trace_")
+        set(traced TRUE)
+    endif ()
+    if (line MATCHES "^(cudl_(wrapped|raw)_[A-Za-z0-9_]+):")
+        set(current ${CMAKE_MATCH_1})
+        list(APPEND functions ${current})
+        set(count_${current} 0)
+    elseif (line MATCHES "^[ \t]*\\.(cfi_endproc|size)")
+        set(current "")
+    elseif (current AND line MATCHES "^[ \t]+[a-z]")
+        math(EXPR count_${current} "${count_${current}} + 1")
+    endif ()
+endforeach ()
+
+set(failed FALSE)
+foreach (function IN LISTS functions)
+    if (function MATCHES "^cudl_wrapped_(.+)$")
+        set(raw cudl_raw_${CMAKE_MATCH_1})
+        if (NOT DEFINED count_${raw})
+            message(SEND_ERROR "${function} has no ${raw} counterpart")
+            set(failed TRUE)
+        elseif (TRACE AND NOT count_${function} GREATER count_${raw})
+            message(SEND_ERROR "${CMAKE_MATCH_1}: ${count_${function}} instructions traced, ${count_${raw}} raw")
+            set(failed TRUE)
+        elseif (NOT TRACE AND NOT count_${function} EQUAL count_${raw})
+            message(SEND_ERROR "${CMAKE_MATCH_1}: ${count_${function}} instructions wrapped, ${count_${raw}} raw")
+            set(failed TRUE)
+        else ()
+            message(STATUS "${CMAKE_MATCH_1}: ${count_${function}} instructions")
+        endif ()
+    endif ()
+endforeach ()
+
+if (NOT functions)
+    message(FATAL_ERROR "No function found in ${OUTPUT}")
+elseif (TRACE AND NOT traced)
+    message(FATAL_ERROR "CUDL_ENABLE_TRACE did not add any call to the instrumentation")
+elseif (NOT TRACE AND traced)
+    message(FATAL_ERROR "The instrumentation is compiled in without CUDL_ENABLE_TRACE")
+elseif (failed)
+    message(FATAL_ERROR "The wrapped and raw versions do not compare as expected, see above")
+endif ()
@@ -0,0 +1,83 @@
+# Compile time benchmark of a large unit catalog. A header with UNITS integer units, each with its integer operators,
+# array operators and a conversion, is generated twice: once with the CUDL_ADD_* macros and once with the
+# CUDL_DECLARE_* macros. SOURCES translation units including it are then compiled for each variant. The average time
+# per including translation unit is reported, as well as the one time cost of the CUDL_IMPLEMENTATION translation unit
+# for the second variant.
+#
+# Expected variables: COMPILER, INCLUDE_DIR, WORK_DIR, UNITS (400 by default), SOURCES (8 by default) and FLAGS (a list,
+# -O0 by default).
+
+if (CMAKE_VERSION VERSION_LESS 3.23)
+    message(FATAL_ERROR "Timing the compilations requires CMake 3.23 or later")
+endif ()
+if (NOT UNITS)
+    set(UNITS 400)
+endif ()
+if (NOT SOURCES)
+    set(SOURCES 8)
+endif ()
+if (NOT FLAGS)
+    set(FLAGS -O0)
+endif ()
+
+function(cudl_now_us _result)
+    string(TIMESTAMP seconds "%s")
+    string(TIMESTAMP microseconds "%f")
+    math(EXPR now "${seconds} * 1000000 + ${microseconds}")
+    set(${_result} ${now} PARENT_SCOPE)
+endfunction()
+
+function(cudl_compile _source)
+    execute_process(
+            COMMAND ${COMPILER} ${FLAGS} -std=c17 -c -I${INCLUDE_DIR} -I${WORK_DIR} -o ${_source}.o ${_source}
+            RESULT_VARIABLE result
+            ERROR_VARIABLE error)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "Failed to compile ${_source}:\n${error}")
+    endif ()
+endfunction()
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+math(EXPR last_unit "${UNITS} - 1")
+math(EXPR last_source "${SOURCES} - 1")
+
+foreach (variant IN ITEMS ADD DECLARE)
+    set(catalog "#include <cudl.h>\n#include <stdint.h>\n")
+    foreach (unit RANGE ${last_unit})
+        string(APPEND catalog
+               "CUDL_${variant}_UNIT(unit_${unit}, uint32_t)\n"
+               "CUDL_${variant}_INTEGER_OPERATORS(unit_${unit}, uint32_t)\n"
+               "CUDL_${variant}_INTEGER_ARRAY_OPERATORS(unit_${unit}, uint32_t)\n"
+               "CUDL_${variant}_UNIT(milli_unit_${unit}, uint32_t)\n"
+               "CUDL_${variant}_REDUCED_CONVERSION_FRACTION_FACTOR(milli_unit_${unit}, unit_${unit}, 1, 1000)\n")
+    endforeach ()
+    string(TOLOWER ${variant} prefix)
+    file(WRITE ${WORK_DIR}/${prefix}_catalog.h "${catalog}")
+
+    set(sources "")
+    foreach (source RANGE ${last_source})
+        file(WRITE ${WORK_DIR}/${prefix}_${source}.c
+             "#include \"${prefix}_catalog.h\"\n"
+             "uint32_t use_${source}(uint32_t value) {\n"
+             "    return CUDL_GET(cudl_unit_${source}_add(cudl_unit_${source}(value), cudl_unit_${source}(1)));\n"
+             "}\n")
+        list(APPEND sources ${WORK_DIR}/${prefix}_${source}.c)
+    endforeach ()
+
+    cudl_now_us(start)
+    foreach (source IN LISTS sources)
+        cudl_compile(${source})
+    endforeach ()
+    cudl_now_us(end)
+    math(EXPR average_ms "(${end} - ${start}) / 1000 / ${SOURCES}")
+    message(STATUS "CUDL_${variant}_*, ${UNITS} units, ${FLAGS}: ${average_ms} ms per including translation unit")
+
+    if (variant STREQUAL "DECLARE")
+        file(WRITE ${WORK_DIR}/declare_implementation.c "#define CUDL_IMPLEMENTATION\n#include \"declare_catalog.h\"\n")
+        cudl_now_us(start)
+        cudl_compile(${WORK_DIR}/declare_implementation.c)
+        cudl_now_us(end)
+        math(EXPR elapsed_ms "(${end} - ${start}) / 1000")
+        message(STATUS "CUDL_${variant}_*, ${UNITS} units, ${FLAGS}: ${elapsed_ms} ms for the implementation file")
+    endif ()
+endforeach ()
@@ -0,0 +1,148 @@
+#include "cudl_bench.h"
+#include <cudl_lut.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(v, uint32_t)
+CUDL_ADD_UNIT(mv, uint32_t)
+CUDL_ADD_UNIT(kib, uint32_t)
+CUDL_ADD_UNIT(count, uint32_t)
+CUDL_ADD_UNIT(scaled_count, uint32_t)
+
+CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR(mv, v, plain_from_mv_to_, 1000, 1000000)
+CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR(mv, v, reduced_from_mv_to_, 1000, 1000000)
+CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR(count, kib, plain_from_count_to_, 1024, 1048576)
+CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR(count, kib, reduced_from_count_to_, 1024, 1048576)
+CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR(count, scaled_count, plain_from_count_to_, 3000, 7000)
+CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR(count, scaled_count, reduced_from_count_to_, 3000, 7000)
+
+CUDL_ADD_UNIT(rad, double)
+CUDL_ADD_UNIT(deg, double)
+
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(rad, deg, 180.0, 3.14159265358979323846)
+
+CUDL_ADD_UNIT(adc, uint16_t)
+CUDL_ADD_UNIT(celsius, float)
+CUDL_ADD_UNIT(fahrenheit, float)
+CUDL_ADD_UNIT(biased_mv, int32_t)
+CUDL_ADD_UNIT(offset_mv, int32_t)
+
+CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR(celsius, fahrenheit, scaled_from_celsius_to_, 9, 5)
+CUDL_ADD_AFFINE_CONVERSION(celsius, fahrenheit, 9, 5, 32)
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(adc, biased_mv, 3300, 4096)
+CUDL_ADD_AFFINE_CONVERSION(adc, offset_mv, 3300, 4096, -1650)
+CUDL_ADD_UNIT(db, float)
+CUDL_ADD_UNIT(gain, float)
+
+#define CUDL_LUT_BENCH_SEGMENTS 64
+
+static float adc_celsius_table[CUDL_LUT_BENCH_SEGMENTS + 1];
+static float db_gain_table[CUDL_LUT_BENCH_SEGMENTS + 1];
+
+CUDL_ADD_LUT_CONVERSION(adc, celsius, adc_celsius_table, CUDL_LUT_BENCH_SEGMENTS + 1, 0, 4095)
+CUDL_ADD_LUT_CONVERSION(db, gain, db_gain_table, CUDL_LUT_BENCH_SEGMENTS + 1, -60, 20)
+
+/**
+ * @brief Steinhart-Hart equation of a 10k NTC thermistor at the bottom of a 10k divider read by a 12 bits ADC.
+ */
+static double thermistor_celsius(double adc) {
+    adc = adc < 1 ? 1 : adc > 4094 ? 4094 : adc;
+    const double ln_r = log(10000.0 * adc / (4096.0 - adc));
+    return 1.0 / (1.009249522e-3 + 2.378405444e-4 * ln_r + 2.019202697e-7 * ln_r * ln_r * ln_r) - 273.15;
+}
+
+static double db_to_gain(double db) { return pow(10.0, db / 20.0); }
+
+#define CUDL_CONVERSION_BENCH_SIZE ((size_t) 1 << 16)
+
+/**
+ * @brief Benchmarks the scalar conversion called in a loop and its array version.
+ */
+#define CUDL_CONVERSION_BENCH(_label, _fn, _dst, _src)                                                                 \
+    do {                                                                                                               \
+        CUDL_BENCH("conversion", _label " (scalar)", CUDL_CONVERSION_BENCH_SIZE, _dst,                                 \
+                   for (size_t i = 0; i < CUDL_CONVERSION_BENCH_SIZE; ++i) { _dst[i] = _fn(_src[i]); });               \
+        CUDL_BENCH("conversion", _label " (array)", CUDL_CONVERSION_BENCH_SIZE, _dst,                                  \
+                   _fn##_n(_dst, _src, CUDL_CONVERSION_BENCH_SIZE));                                                   \
+    } while (0)
+
+void cudl_conversion_bench(void) {
+    cudl_mv_t *mvolts = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_mv_t));
+    cudl_v_t *volts = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_v_t));
+    cudl_count_t *counts = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_count_t));
+    cudl_kib_t *kibs = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_kib_t));
+    cudl_scaled_count_t *scaled = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_scaled_count_t));
+    cudl_rad_t *rads = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_rad_t));
+    cudl_deg_t *degs = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_deg_t));
+    cudl_adc_t *adcs = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_adc_t));
+    cudl_celsius_t *celsius = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_celsius_t));
+    cudl_db_t *dbs = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_db_t));
+    cudl_gain_t *gains = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_gain_t));
+    cudl_fahrenheit_t *fahrenheits = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_fahrenheit_t));
+    cudl_biased_mv_t *biased_mvolts = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_biased_mv_t));
+    cudl_offset_mv_t *offset_mvolts = malloc(CUDL_CONVERSION_BENCH_SIZE * sizeof(cudl_offset_mv_t));
+    if (!mvolts || !volts || !counts || !kibs || !scaled || !rads || !degs || !adcs || !celsius || !dbs || !gains ||
+        !fahrenheits || !biased_mvolts || !offset_mvolts) {
+        printf("conversion bench: allocation failed\n");
+    } else {
+        for (size_t i = 0; i < CUDL_CONVERSION_BENCH_SIZE; ++i) {
+            mvolts[i] = cudl_mv((uint32_t) (i * 2654435761u));
+            counts[i] = cudl_count((uint32_t) (i * 2246822519u));
+            rads[i] = cudl_rad((double) i / 1000.0);
+            adcs[i] = cudl_adc((uint16_t) (i * 2654435761u % 4096));
+            dbs[i] = cudl_db((float) (i * 2246822519u % 80000) / 1000.0f - 60.0f);
+            celsius[i] = cudl_celsius((float) (i % 2000) / 10.0f - 50.0f);
+        }
+        for (size_t i = 0; i <= CUDL_LUT_BENCH_SEGMENTS; ++i) {
+            adc_celsius_table[i] = (float) thermistor_celsius(4095.0 * (double) i / CUDL_LUT_BENCH_SEGMENTS);
+            db_gain_table[i] = (float) db_to_gain(-60.0 + 80.0 * (double) i / CUDL_LUT_BENCH_SEGMENTS);
+        }
+
+        CUDL_CONVERSION_BENCH("mv->v 1000/1000000 current", cudl_plain_from_mv_to_v, volts, mvolts);
+        CUDL_CONVERSION_BENCH("mv->v 1000/1000000 reduced", cudl_reduced_from_mv_to_v, volts, mvolts);
+        CUDL_CONVERSION_BENCH("count->kib 1024/1048576 current", cudl_plain_from_count_to_kib, kibs, counts);
+        CUDL_CONVERSION_BENCH("count->kib 1024/1048576 reduced", cudl_reduced_from_count_to_kib, kibs, counts);
+        CUDL_CONVERSION_BENCH("count->scaled 3000/7000 current, wraps", cudl_plain_from_count_to_scaled_count, scaled,
+                              counts);
+        CUDL_CONVERSION_BENCH("count->scaled 3000/7000 reduced", cudl_reduced_from_count_to_scaled_count, scaled,
+                              counts);
+        CUDL_CONVERSION_BENCH("rad->deg 180/pi", cudl_from_rad_to_deg, degs, rads);
+        CUDL_BENCH("conversion", "celsius->fahrenheit 2 passes", CUDL_CONVERSION_BENCH_SIZE,
+                   fahrenheits, {
+                       cudl_scaled_from_celsius_to_fahrenheit_n(fahrenheits, celsius, CUDL_CONVERSION_BENCH_SIZE);
+                       for (size_t i = 0; i < CUDL_CONVERSION_BENCH_SIZE; ++i) { fahrenheits[i].value += 32; }
+                   });
+        CUDL_CONVERSION_BENCH("celsius->fahrenheit affine", cudl_from_celsius_to_fahrenheit, fahrenheits, celsius);
+        CUDL_BENCH("conversion", "adc->mv 2 passes", CUDL_CONVERSION_BENCH_SIZE, biased_mvolts, {
+            cudl_from_adc_to_biased_mv_n(biased_mvolts, adcs, CUDL_CONVERSION_BENCH_SIZE);
+            for (size_t i = 0; i < CUDL_CONVERSION_BENCH_SIZE; ++i) { biased_mvolts[i].value -= 1650; }
+        });
+        CUDL_CONVERSION_BENCH("adc->mv affine", cudl_from_adc_to_offset_mv, offset_mvolts, adcs);
+        CUDL_BENCH("conversion", "adc->celsius log (scalar)", CUDL_CONVERSION_BENCH_SIZE, celsius,
+                   for (size_t i = 0; i < CUDL_CONVERSION_BENCH_SIZE; ++i) {
+                       celsius[i] = cudl_celsius((float) thermistor_celsius(CUDL_GET(adcs[i])));
+                   });
+        CUDL_CONVERSION_BENCH("adc->celsius 64 segments table", cudl_from_adc_to_celsius, celsius, adcs);
+        CUDL_BENCH("conversion", "db->gain pow (scalar)", CUDL_CONVERSION_BENCH_SIZE, gains,
+                   for (size_t i = 0; i < CUDL_CONVERSION_BENCH_SIZE; ++i) {
+                       gains[i] = cudl_gain((float) db_to_gain(CUDL_GET(dbs[i])));
+                   });
+        CUDL_CONVERSION_BENCH("db->gain 64 segments table", cudl_from_db_to_gain, gains, dbs);
+    }
+
+    free(mvolts);
+    free(volts);
+    free(counts);
+    free(kibs);
+    free(scaled);
+    free(rads);
+    free(degs);
+    free(adcs);
+    free(celsius);
+    free(dbs);
+    free(gains);
+    free(fahrenheits);
+    free(biased_mvolts);
+    free(offset_mvolts);
+}
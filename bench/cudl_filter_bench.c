@@ -0,0 +1,93 @@
+#include "cudl_bench.h"
+#include <cudl_filter.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_MOVING_AVERAGE(mv, int32_t, 64)
+CUDL_ADD_FIR_FILTER(mv, 32, int16_t, int32_t, 1 << 15)
+CUDL_ADD_BIQUAD_FILTER(mv, int32_t, int64_t, 1 << 14)
+CUDL_ADD_DECIMATOR(mv, 4)
+
+CUDL_ADD_UNIT(v, float)
+CUDL_ADD_FIR_FILTER(v, 32, float, float, 1)
+
+#define FILTER_BENCH_SAMPLES ((size_t) 1 << 20)
+#define FILTER_BENCH_TAPS 32
+#define FILTER_BENCH_WINDOW 64
+
+// Per sample FIR of a circular history, as written without block processing
+static void naive_fir_n(cudl_mv_t *dst, const cudl_mv_t *src, const int16_t *coefs, int16_t *history, size_t n) {
+    static size_t next = 0;
+    for (size_t i = 0; i < n; ++i) {
+        history[next] = src[i].value;
+        int32_t acc = 0;
+        for (size_t k = 0; k < FILTER_BENCH_TAPS; ++k) {
+            acc += coefs[k] * history[(next + FILTER_BENCH_TAPS - k) % FILTER_BENCH_TAPS];
+        }
+        next = (next + 1) % FILTER_BENCH_TAPS;
+        dst[i] = cudl_mv((int16_t) ((acc + (1 << 14)) >> 15));
+    }
+}
+
+// Average summing the whole window for each sample
+static void naive_average_n(cudl_mv_t *dst, const cudl_mv_t *src, size_t n) {
+    for (size_t i = FILTER_BENCH_WINDOW; i < n; ++i) {
+        int32_t sum = 0;
+        for (size_t j = 0; j < FILTER_BENCH_WINDOW; ++j) { sum += src[i - j].value; }
+        dst[i] = cudl_mv((int16_t) (sum / FILTER_BENCH_WINDOW));
+    }
+}
+
+void cudl_filter_bench(void) {
+    const size_t n = FILTER_BENCH_SAMPLES;
+    cudl_mv_t *samples = malloc(n * sizeof(cudl_mv_t));
+    cudl_mv_t *filtered = malloc(n * sizeof(cudl_mv_t));
+    cudl_v_t *volts = malloc(n * sizeof(cudl_v_t));
+    cudl_v_t *filtered_volts = malloc(n * sizeof(cudl_v_t));
+    cudl_mv_fir_t *fir = malloc(sizeof(cudl_mv_fir_t));
+    cudl_v_fir_t *v_fir = malloc(sizeof(cudl_v_fir_t));
+    cudl_mv_moving_average_t *average = malloc(sizeof(cudl_mv_moving_average_t));
+    if (!samples || !filtered || !volts || !filtered_volts || !fir || !v_fir || !average) {
+        printf("filter bench: allocation failed, skipped\n");
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            samples[i] = cudl_mv((int16_t) ((i * 40503u) % 2001 - 1000));
+            volts[i] = cudl_v((float) samples[i].value / 1000);
+        }
+        int16_t coefs[FILTER_BENCH_TAPS];
+        float v_coefs[FILTER_BENCH_TAPS];
+        int16_t history[FILTER_BENCH_TAPS] = {0};
+        for (size_t k = 0; k < FILTER_BENCH_TAPS; ++k) {
+            coefs[k] = (int16_t) (1 << 10);
+            v_coefs[k] = 1.0f / FILTER_BENCH_TAPS;
+        }
+        cudl_mv_fir_init(fir, coefs);
+        cudl_v_fir_init(v_fir, v_coefs);
+        cudl_mv_moving_average_init(average);
+        cudl_mv_biquad_t biquad;
+        const int32_t butterworth[5] = {329, 658, 329, -25576, 10508};
+        cudl_mv_biquad_init(&biquad, butterworth);
+        cudl_mv_decimator_t decimator;
+        cudl_mv_decimator_init(&decimator);
+        size_t count = 0;
+
+        CUDL_BENCH("filter", "naive fir, 32 taps", n, filtered, naive_fir_n(filtered, samples, coefs, history, n));
+        CUDL_BENCH("filter", "fir_process_n, 32 taps", n, filtered, cudl_mv_fir_process_n(fir, filtered, samples, n));
+        CUDL_BENCH("filter", "fir_process_n, 32 taps, float", n, filtered_volts,
+                   cudl_v_fir_process_n(v_fir, filtered_volts, volts, n));
+        CUDL_BENCH("filter", "naive moving average, 64 values", n, filtered, naive_average_n(filtered, samples, n));
+        CUDL_BENCH("filter", "moving_average_process_n, 64 values", n, filtered,
+                   cudl_mv_moving_average_process_n(average, filtered, samples, n));
+        CUDL_BENCH("filter", "biquad_process_n", n, filtered, cudl_mv_biquad_process_n(&biquad, filtered, samples, n));
+        CUDL_BENCH("filter", "decimator_process_n, factor 4", n, &count,
+                   count = cudl_mv_decimator_process_n(&decimator, filtered, samples, n));
+    }
+    free(average);
+    free(v_fir);
+    free(fir);
+    free(filtered_volts);
+    free(volts);
+    free(filtered);
+    free(samples);
+}
@@ -0,0 +1,54 @@
+#include "cudl_bench.h"
+#include <cudl_histogram.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(ns, uint64_t)
+CUDL_ADD_HISTOGRAM(ns, 8)
+
+#define HISTOGRAM_BENCH_VALUES 1000000
+#define HISTOGRAM_BENCH_THREADS 16
+
+void cudl_histogram_bench(void) {
+    const size_t n = HISTOGRAM_BENCH_VALUES;
+    const size_t buckets = sizeof(((cudl_ns_histogram_t *) NULL)->counts) / sizeof(uint64_t);
+    cudl_ns_t *latencies = malloc(n * sizeof(cudl_ns_t));
+    uint64_t *raw_counts = calloc(1 << 16, sizeof(uint64_t));
+    cudl_ns_histogram_t *histograms = malloc((HISTOGRAM_BENCH_THREADS + 1) * sizeof(cudl_ns_histogram_t));
+    if (!latencies || !raw_counts || !histograms) {
+        printf("histogram bench: allocation failed, skipped\n");
+    } else {
+        // Latencies spread from a few ns to several seconds
+        uint64_t state = 88172645463325252ULL;
+        for (size_t i = 0; i < n; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            latencies[i] = cudl_ns(state >> (30 + state % 32));
+        }
+        for (size_t i = 0; i <= HISTOGRAM_BENCH_THREADS; ++i) { cudl_ns_histogram_init(&histograms[i]); }
+        cudl_ns_histogram_t *merged = &histograms[HISTOGRAM_BENCH_THREADS];
+        cudl_ns_t p99 = cudl_ns(0);
+
+        CUDL_BENCH("histogram", "raw C count of the low 16 bits", n, raw_counts, {
+            for (size_t i = 0; i < n; ++i) { ++raw_counts[latencies[i].value & 0xffff]; }
+        });
+        CUDL_BENCH("histogram", "cudl_ns_histogram_record", n, histograms, {
+            for (size_t i = 0; i < n; ++i) { cudl_ns_histogram_record(&histograms[0], latencies[i]); }
+        });
+        CUDL_BENCH("histogram", "cudl_ns_histogram_record_n", n, histograms,
+                   cudl_ns_histogram_record_n(&histograms[0], latencies, n));
+        for (size_t i = 1; i < HISTOGRAM_BENCH_THREADS; ++i) { cudl_ns_histogram_merge(&histograms[i], histograms); }
+        // Per bucket, merging the histograms of 16 threads
+        CUDL_BENCH("histogram", "cudl_ns_histogram_merge, 16 threads", buckets, merged, {
+            cudl_ns_histogram_init(merged);
+            for (size_t i = 0; i < HISTOGRAM_BENCH_THREADS; ++i) { cudl_ns_histogram_merge(merged, &histograms[i]); }
+        });
+        // Per bucket, a query walks the buckets once
+        CUDL_BENCH("histogram", "cudl_ns_histogram_percentile", buckets, &p99,
+                   p99 = cudl_ns_histogram_percentile(merged, 99.9));
+    }
+    free(histograms);
+    free(raw_counts);
+    free(latencies);
+}
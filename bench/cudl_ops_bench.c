@@ -0,0 +1,196 @@
+#include "cudl_bench.h"
+#include <cudl.h>
+#include <cudl_wire.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(v, uint32_t)
+CUDL_ADD_INTEGER_OPERATORS(v, uint32_t)
+CUDL_ADD_INTEGER_ARRAY_OPERATORS(v, uint32_t)
+CUDL_ADD_WIRE_ENCODING(v, uint32_t)
+
+CUDL_ADD_UNIT(mv, uint32_t)
+
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(mv, v, 1, 1000)
+
+CUDL_ADD_UNIT(rad, float)
+CUDL_ADD_COMMON_OPERATORS(rad, float)
+CUDL_ADD_COMMON_ARRAY_OPERATORS(rad, float)
+CUDL_ADD_FLOAT_REDUCTION_OPERATORS(rad, float)
+
+CUDL_ADD_UNIT(deg, float)
+
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(rad, deg, 180.0f, 3.14159265f)
+
+CUDL_ADD_UNIT(w, float)
+CUDL_ADD_UNIT(s, float)
+CUDL_ADD_UNIT(j, float)
+
+CUDL_ADD_FUSED_PRODUCT_OP(w, s, j, _mul_s_add)
+
+/*
+ * The raw loops are what a user would write without cudl. They take restrict pointers like the generated array
+ * functions, so both sides get the same aliasing information. The unit types only hold their storage type, so the raw
+ * loops work on the same buffers through a cast.
+ */
+static void raw_add_n(uint32_t *restrict dst, const uint32_t *restrict lhs, const uint32_t *restrict rhs, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = lhs[i] + rhs[i]; }
+}
+
+static void raw_mul_n(uint32_t *restrict dst, const uint32_t *restrict lhs, uint32_t rhs, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = lhs[i] * rhs; }
+}
+
+static void raw_gt_n(bool *restrict dst, const uint32_t *restrict lhs, const uint32_t *restrict rhs, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = lhs[i] > rhs[i]; }
+}
+
+static void raw_mv_to_v_n(uint32_t *restrict dst, const uint32_t *restrict src, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = src[i] / 1000; }
+}
+
+static void raw_float_add_n(float *restrict dst, const float *restrict lhs, const float *restrict rhs, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = lhs[i] + rhs[i]; }
+}
+
+static void raw_rad_to_deg_n(float *restrict dst, const float *restrict src, size_t n) {
+    const float scale = 180.0f / 3.14159265f;
+    for (size_t i = 0; i < n; ++i) { dst[i] = src[i] * scale; }
+}
+
+static void raw_energy_n(float *dst, const float *restrict lhs, const float *restrict rhs, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = lhs[i] * rhs[i] + dst[i]; }
+}
+
+static float raw_float_sum_n(const float *restrict src, size_t n) {
+    float sum = 0;
+    for (size_t i = 0; i < n; ++i) { sum += src[i]; }
+    return sum;
+}
+
+static float raw_float_max_n(const float *restrict src, size_t n) {
+    float max = src[0];
+    for (size_t i = 1; i < n; ++i) { max = src[i] > max ? src[i] : max; }
+    return max;
+}
+
+static void raw_encode_big_endian_n(uint8_t *restrict dst, const uint32_t *restrict src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i * 4] = (uint8_t) (src[i] >> 24);
+        dst[i * 4 + 1] = (uint8_t) (src[i] >> 16);
+        dst[i * 4 + 2] = (uint8_t) (src[i] >> 8);
+        dst[i * 4 + 3] = (uint8_t) src[i];
+    }
+}
+
+static void raw_decode_big_endian_n(uint32_t *restrict dst, const uint8_t *restrict src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = (uint32_t) src[i * 4] << 24 | (uint32_t) src[i * 4 + 1] << 16 | (uint32_t) src[i * 4 + 2] << 8 |
+                 (uint32_t) src[i * 4 + 3];
+    }
+}
+
+static void cudl_integer_ops_bench(size_t n) {
+    cudl_v_t *lhs = malloc(n * sizeof(cudl_v_t));
+    cudl_v_t *rhs = malloc(n * sizeof(cudl_v_t));
+    cudl_v_t *dst = malloc(n * sizeof(cudl_v_t));
+    bool *flags = malloc(n * sizeof(bool));
+    if (!lhs || !rhs || !dst || !flags) {
+        printf("ops bench: allocation of %zu elements failed, skipped\n", n);
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            lhs[i] = cudl_v((uint32_t) (i * 2654435761u));
+            rhs[i] = cudl_v((uint32_t) (i * 2246822519u));
+        }
+        uint32_t *raw_lhs = (uint32_t *) lhs;
+        uint32_t *raw_rhs = (uint32_t *) rhs;
+        uint32_t *raw_dst = (uint32_t *) dst;
+        cudl_mv_t *mvolts = (cudl_mv_t *) lhs;
+
+        CUDL_BENCH("add", "raw loop", n, raw_dst, raw_add_n(raw_dst, raw_lhs, raw_rhs, n));
+        CUDL_BENCH("add", "cudl_v_add loop", n, dst,
+                   for (size_t i = 0; i < n; ++i) { dst[i] = cudl_v_add(lhs[i], rhs[i]); });
+        CUDL_BENCH("add", "cudl_v_add_n", n, dst, cudl_v_add_n(dst, lhs, rhs, n));
+
+        CUDL_BENCH("mul", "raw loop", n, raw_dst, raw_mul_n(raw_dst, raw_lhs, 3, n));
+        CUDL_BENCH("mul", "cudl_v_mul loop", n, dst, for (size_t i = 0; i < n; ++i) { dst[i] = cudl_v_mul(lhs[i], 3); });
+        CUDL_BENCH("mul", "cudl_v_mul_n", n, dst, cudl_v_mul_n(dst, lhs, 3, n));
+
+        CUDL_BENCH("relational", "raw loop", n, flags, raw_gt_n(flags, raw_lhs, raw_rhs, n));
+        CUDL_BENCH("relational", "cudl_v_gt loop", n, flags,
+                   for (size_t i = 0; i < n; ++i) { flags[i] = cudl_v_gt(lhs[i], rhs[i]); });
+        CUDL_BENCH("relational", "cudl_v_gt_n", n, flags, cudl_v_gt_n(flags, lhs, rhs, n));
+
+        CUDL_BENCH("conversion", "raw loop", n, raw_dst, raw_mv_to_v_n(raw_dst, raw_lhs, n));
+        CUDL_BENCH("conversion", "cudl_from_mv_to_v loop", n, dst,
+                   for (size_t i = 0; i < n; ++i) { dst[i] = cudl_from_mv_to_v(mvolts[i]); });
+        CUDL_BENCH("conversion", "cudl_from_mv_to_v_n", n, dst, cudl_from_mv_to_v_n(dst, mvolts, n));
+
+        uint8_t *bytes = (uint8_t *) rhs;
+        CUDL_BENCH("wire encode", "raw shift loop", n, bytes, raw_encode_big_endian_n(bytes, raw_lhs, n));
+        CUDL_BENCH("wire encode", "cudl_v_encode_n big endian", n, bytes,
+                   cudl_v_encode_n(bytes, lhs, n, CUDL_BIG_ENDIAN));
+        CUDL_BENCH("wire decode", "raw shift loop", n, raw_dst, raw_decode_big_endian_n(raw_dst, bytes, n));
+        CUDL_BENCH("wire decode", "cudl_v_decode_n big endian", n, dst,
+                   cudl_v_decode_n(dst, bytes, n, CUDL_BIG_ENDIAN));
+        CUDL_BENCH("wire decode", "cudl_v_decode_n little endian", n, dst,
+                   cudl_v_decode_n(dst, bytes, n, CUDL_LITTLE_ENDIAN));
+    }
+    free(lhs);
+    free(rhs);
+    free(dst);
+    free(flags);
+}
+
+static void cudl_float_ops_bench(size_t n) {
+    cudl_rad_t *lhs = malloc(n * sizeof(cudl_rad_t));
+    cudl_rad_t *rhs = malloc(n * sizeof(cudl_rad_t));
+    cudl_rad_t *dst = malloc(n * sizeof(cudl_rad_t));
+    if (!lhs || !rhs || !dst) {
+        printf("ops bench: allocation of %zu elements failed, skipped\n", n);
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            lhs[i] = cudl_rad((float) (i % 1000) / 100.0f);
+            rhs[i] = cudl_rad((float) (i % 777) / 100.0f);
+        }
+        float *raw_lhs = (float *) lhs;
+        float *raw_rhs = (float *) rhs;
+        float *raw_dst = (float *) dst;
+        cudl_deg_t *degs = (cudl_deg_t *) dst;
+        cudl_w_t *watts = (cudl_w_t *) lhs;
+        cudl_s_t *seconds = (cudl_s_t *) rhs;
+        cudl_j_t *joules = (cudl_j_t *) dst;
+        float reduced = 0;
+
+        CUDL_BENCH("float add", "raw loop", n, raw_dst, raw_float_add_n(raw_dst, raw_lhs, raw_rhs, n));
+        CUDL_BENCH("float add", "cudl_rad_add loop", n, dst,
+                   for (size_t i = 0; i < n; ++i) { dst[i] = cudl_rad_add(lhs[i], rhs[i]); });
+        CUDL_BENCH("float add", "cudl_rad_add_n", n, dst, cudl_rad_add_n(dst, lhs, rhs, n));
+
+        CUDL_BENCH("float conv", "raw loop", n, raw_dst, raw_rad_to_deg_n(raw_dst, raw_lhs, n));
+        CUDL_BENCH("float conv", "cudl_from_rad_to_deg loop", n, degs,
+                   for (size_t i = 0; i < n; ++i) { degs[i] = cudl_from_rad_to_deg(lhs[i]); });
+        CUDL_BENCH("float conv", "cudl_from_rad_to_deg_n", n, degs, cudl_from_rad_to_deg_n(degs, lhs, n));
+
+        CUDL_BENCH("fused product", "raw loop", n, raw_dst, raw_energy_n(raw_dst, raw_lhs, raw_rhs, n));
+        CUDL_BENCH("fused product", "cudl_w_mul_s_add loop", n, joules, for (size_t i = 0; i < n; ++i) {
+            joules[i] = cudl_w_mul_s_add(watts[i], seconds[i], joules[i]);
+        });
+        CUDL_BENCH("fused product", "cudl_w_mul_s_add_n", n, joules,
+                   cudl_w_mul_s_add_n(joules, watts, seconds, joules, n));
+
+        CUDL_BENCH("float sum", "raw loop", n, &reduced, reduced = raw_float_sum_n(raw_lhs, n));
+        CUDL_BENCH("float sum", "cudl_rad_sum_n", n, &reduced, reduced = cudl_rad_sum_n(lhs, n));
+
+        CUDL_BENCH("float max", "raw loop", n, &reduced, reduced = raw_float_max_n(raw_lhs, n));
+        CUDL_BENCH("float max", "cudl_rad_max_n", n, &reduced, reduced = CUDL_GET(cudl_rad_max_n(lhs, n)));
+    }
+    free(lhs);
+    free(rhs);
+    free(dst);
+}
+
+void cudl_ops_bench(size_t n) {
+    cudl_integer_ops_bench(n);
+    cudl_float_ops_bench(n);
+}
@@ -0,0 +1,76 @@
+#include "cudl_bench.h"
+#define CUDL_PARALLEL_IMPLEMENTATION
+#include <cudl_parallel.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+CUDL_ADD_UNIT(adc, uint16_t)
+CUDL_ADD_UNIT(mv, int32_t)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int32_t, int64_t)
+CUDL_ADD_AFFINE_CONVERSION(adc, mv, 3300, 4096, -5)
+
+CUDL_ADD_PARALLEL_CONVERSION(adc, mv)
+CUDL_ADD_PARALLEL_REDUCTION_OPERATORS(mv, int64_t)
+
+static void decode_n(cudl_adc_t *dst, const uint16_t *src, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = cudl_adc((uint16_t) (src[i] & 0x0fff)); }
+}
+
+static void clamp_n(cudl_mv_t *dst, const cudl_mv_t *src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = cudl_mv(src[i].value < 0 ? 0 : src[i].value > 3000 ? 3000 : src[i].value);
+    }
+}
+
+#define PARALLEL_BENCH_ADD(_lhs, _rhs) ((_lhs) + (_rhs))
+
+// Single stage chains are the parallel version of any (dst, src, n) function
+CUDL_ADD_PARALLEL_CHAIN(decode_n_parallel, uint16_t, cudl_adc_t, (decode_n, cudl_adc_t))
+CUDL_ADD_PARALLEL_CHAIN(clamp_n_parallel, cudl_mv_t, cudl_mv_t, (clamp_n, cudl_mv_t))
+CUDL_ADD_PARALLEL_REDUCE_CHAIN(fused_sum, uint16_t, int64_t, cudl_mv_sum_n, PARALLEL_BENCH_ADD, (decode_n, cudl_adc_t),
+                               (cudl_from_adc_to_mv_n, cudl_mv_t), (clamp_n, cudl_mv_t))
+
+#define PARALLEL_BENCH_ELEMENTS ((size_t) 1 << 24)
+
+void cudl_parallel_bench(void) {
+    const size_t n = PARALLEL_BENCH_ELEMENTS;
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+    const size_t processors = online > 0 ? (size_t) online : 1;
+    uint16_t *raw = malloc(n * sizeof(uint16_t));
+    cudl_adc_t *codes = malloc(n * sizeof(cudl_adc_t));
+    cudl_mv_t *converted = malloc(n * sizeof(cudl_mv_t));
+    cudl_mv_t *clamped = malloc(n * sizeof(cudl_mv_t));
+    if (!raw || !codes || !converted || !clamped) {
+        printf("parallel bench: allocation failed, skipped\n");
+    } else {
+        for (size_t i = 0; i < n; ++i) { raw[i] = (uint16_t) (i * 40503u); }
+        int64_t total = 0;
+        char label[64];
+
+        // 1, 2, 4, ... threads, and the number of processors
+        for (size_t threads = 1; threads <= processors;
+             threads = threads < processors && threads * 2 > processors ? processors : threads * 2) {
+            cudl_pool_t *pool = cudl_pool_create(threads);
+            if (pool == NULL) { break; }
+            snprintf(label, sizeof(label), "conversion, %zu threads", threads);
+            CUDL_BENCH("parallel", label, n, converted, cudl_from_adc_to_mv_n_parallel(pool, converted, codes, n));
+            snprintf(label, sizeof(label), "sum, %zu threads", threads);
+            CUDL_BENCH("parallel", label, n, &total, total = cudl_mv_sum_n_parallel(pool, converted, n));
+            snprintf(label, sizeof(label), "4 passes chain, %zu threads", threads);
+            CUDL_BENCH("parallel", label, n, &total, {
+                cudl_decode_n_parallel(pool, codes, raw, n);
+                cudl_from_adc_to_mv_n_parallel(pool, converted, codes, n);
+                cudl_clamp_n_parallel(pool, clamped, converted, n);
+                total = cudl_mv_sum_n_parallel(pool, clamped, n);
+            });
+            snprintf(label, sizeof(label), "fused chain, %zu threads", threads);
+            CUDL_BENCH("parallel", label, n, &total, total = cudl_fused_sum(pool, raw, n));
+            cudl_pool_destroy(pool);
+        }
+    }
+    free(clamped);
+    free(converted);
+    free(codes);
+    free(raw);
+}
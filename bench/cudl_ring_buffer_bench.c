@@ -0,0 +1,99 @@
+#include "cudl_bench.h"
+#include <cudl_ring_buffer.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_RING_BUFFER(mv, 4096)
+
+#define RING_BUFFER_BENCH_VALUES ((size_t) 1 << 24)
+#define RING_BUFFER_BENCH_BLOCK 256
+
+// Waiting threads yield, so that the benchmark also completes when the producer and the consumer share a core.
+
+static cudl_mv_ring_buffer_t buffer;
+
+static void *single_producer(void *arg) {
+    (void) arg;
+    for (size_t i = 0; i < RING_BUFFER_BENCH_VALUES;) {
+        if (cudl_mv_ring_buffer_push(&buffer, cudl_mv((int16_t) i))) {
+            ++i;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *bulk_producer(void *arg) {
+    (void) arg;
+    cudl_mv_t block[RING_BUFFER_BENCH_BLOCK];
+    for (size_t i = 0; i < RING_BUFFER_BENCH_BLOCK; ++i) { block[i] = cudl_mv((int16_t) i); }
+    for (size_t i = 0; i < RING_BUFFER_BENCH_VALUES;) {
+        size_t n = RING_BUFFER_BENCH_VALUES - i < RING_BUFFER_BENCH_BLOCK ? RING_BUFFER_BENCH_VALUES - i
+                                                                          : RING_BUFFER_BENCH_BLOCK;
+        size_t pushed = cudl_mv_ring_buffer_push_n(&buffer, block, n);
+        if (pushed == 0) { sched_yield(); }
+        i += pushed;
+    }
+    return NULL;
+}
+
+static int64_t single_consumer(void) {
+    int64_t checksum = 0;
+    cudl_mv_t value;
+    for (size_t i = 0; i < RING_BUFFER_BENCH_VALUES;) {
+        if (cudl_mv_ring_buffer_pop(&buffer, &value)) {
+            checksum += CUDL_GET(value);
+            ++i;
+        } else {
+            sched_yield();
+        }
+    }
+    return checksum;
+}
+
+static int64_t bulk_consumer(void) {
+    int64_t checksum = 0;
+    cudl_mv_t block[RING_BUFFER_BENCH_BLOCK];
+    for (size_t i = 0; i < RING_BUFFER_BENCH_VALUES;) {
+        size_t n = cudl_mv_ring_buffer_pop_n(&buffer, block, RING_BUFFER_BENCH_BLOCK);
+        if (n == 0) { sched_yield(); }
+        for (size_t j = 0; j < n; ++j) { checksum += CUDL_GET(block[j]); }
+        i += n;
+    }
+    return checksum;
+}
+
+static int64_t peek_consumer(void) {
+    int64_t checksum = 0;
+    const cudl_mv_t *span;
+    for (size_t i = 0; i < RING_BUFFER_BENCH_VALUES;) {
+        size_t n = cudl_mv_ring_buffer_peek(&buffer, &span);
+        if (n == 0) { sched_yield(); }
+        for (size_t j = 0; j < n; ++j) { checksum += CUDL_GET(span[j]); }
+        cudl_mv_ring_buffer_consume(&buffer, n);
+        i += n;
+    }
+    return checksum;
+}
+
+static void run(const char *label, void *(*producer)(void *), int64_t (*consumer)(void)) {
+    pthread_t thread;
+    cudl_mv_ring_buffer_init(&buffer);
+    double start = cudl_bench_now_ns();
+    if (pthread_create(&thread, NULL, producer, NULL) != 0) { abort(); }
+    volatile int64_t checksum = consumer();
+    pthread_join(thread, NULL);
+    (void) checksum;
+    cudl_bench_report("ring buffer", label, RING_BUFFER_BENCH_VALUES,
+                      (cudl_bench_now_ns() - start) / (double) RING_BUFFER_BENCH_VALUES);
+}
+
+void cudl_ring_buffer_bench(void) {
+    run("push / pop", single_producer, single_consumer);
+    run("push_n / pop_n", bulk_producer, bulk_consumer);
+    run("push_n / peek + consume", bulk_producer, peek_consumer);
+}
@@ -0,0 +1,62 @@
+#include "cudl_bench.h"
+#include <cudl_sample_file.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int16_t, int64_t)
+CUDL_ADD_SAMPLE_FILE(mv, int16_t)
+
+#define SAMPLE_FILE_BENCH_SAMPLES ((size_t) 1 << 22)
+
+void cudl_sample_file_bench(void) {
+    const size_t n = SAMPLE_FILE_BENCH_SAMPLES;
+    const char *dir = getenv("TMPDIR");
+    char path[512];
+    snprintf(path, sizeof(path), "%s/cudl_sample_file_bench.bin", dir != NULL ? dir : "/tmp");
+    cudl_mv_t *samples = malloc(n * sizeof(cudl_mv_t));
+    cudl_mv_t *copy = malloc(n * sizeof(cudl_mv_t));
+    if (!samples || !copy) {
+        printf("sample file bench: allocation failed, skipped\n");
+    } else {
+        for (size_t i = 0; i < n; ++i) { samples[i] = cudl_mv((int16_t) (i * 40503u)); }
+        cudl_mv_sample_writer_t writer;
+        cudl_sample_file_status_t status = CUDL_SAMPLE_FILE_OK;
+        CUDL_BENCH("sample file", "writer, append one by one", n, &status, {
+            status = cudl_mv_sample_writer_open(&writer, path);
+            for (size_t i = 0; i < n && status == CUDL_SAMPLE_FILE_OK; ++i) {
+                status = cudl_mv_sample_writer_append(&writer, samples[i]);
+            }
+            status = cudl_mv_sample_writer_close(&writer);
+        });
+        CUDL_BENCH("sample file", "writer, append_n", n, &status, {
+            status = cudl_mv_sample_writer_open(&writer, path);
+            if (status == CUDL_SAMPLE_FILE_OK) { status = cudl_mv_sample_writer_append_n(&writer, samples, n); }
+            status = cudl_mv_sample_writer_close(&writer);
+        });
+
+        // The file is in the page cache: the reads measure the copy of fread against mapping the pages
+        int64_t total = 0;
+        CUDL_BENCH("sample file", "fread, then sum", n, &total, {
+            FILE *file = fopen(path, "rb");
+            if (file != NULL) {
+                if (fseek(file, CUDL_SAMPLE_FILE_HEADER_SIZE, SEEK_SET) == 0 &&
+                    fread(copy, sizeof(cudl_mv_t), n, file) == n) {
+                    total = cudl_mv_sum_n(copy, n);
+                }
+                fclose(file);
+            }
+        });
+        CUDL_BENCH("sample file", "mapped view, sum", n, &total, {
+            cudl_mv_sample_file_t file;
+            if (cudl_mv_sample_file_open(&file, path) == CUDL_SAMPLE_FILE_OK) {
+                total = cudl_mv_sum_n_aligned(file.samples, file.count);
+            }
+            cudl_mv_sample_file_close(&file);
+        });
+        remove(path);
+    }
+    free(copy);
+    free(samples);
+}
@@ -0,0 +1,76 @@
+#include "cudl_bench.h"
+#include <cudl.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_SELECTION_OPERATORS(mv, int16_t)
+
+#define SELECTION_BENCH_SAMPLES ((size_t) 1 << 20)
+
+static size_t branchy_filter_gt_n(cudl_mv_t *dst, const cudl_mv_t *src, cudl_mv_t threshold, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (src[i].value > threshold.value) { dst[count++] = src[i]; }
+    }
+    return count;
+}
+
+void cudl_selection_bench(void) {
+    const size_t n = SELECTION_BENCH_SAMPLES;
+    cudl_mv_t *samples = malloc(n * sizeof(cudl_mv_t));
+    cudl_mv_t *reference = malloc(n * sizeof(cudl_mv_t));
+    cudl_mv_t *dst = malloc(n * sizeof(cudl_mv_t));
+    uint64_t *mask = malloc(CUDL_MASK_WORDS(n) * sizeof(uint64_t));
+    bool *flags = malloc(n * sizeof(bool));
+    if (!samples || !reference || !dst || !mask || !flags) {
+        printf("selection bench: allocation failed, skipped\n");
+    } else {
+        uint32_t state = 2463534242u;
+        for (size_t i = 0; i < n; ++i) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            samples[i] = cudl_mv((int16_t) (state % 4001 - 2000));
+            reference[i] = cudl_mv(0);
+        }
+        size_t count = 0;
+        char label[64];
+        // A threshold in the middle of the values is the worst case of a branch, a high one the usual alarm case
+        static const int16_t thresholds[] = {0, 1990};
+        for (size_t t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); ++t) {
+            const cudl_mv_t threshold = cudl_mv(thresholds[t]);
+            snprintf(label, sizeof(label), "bool array, threshold %d", thresholds[t]);
+            CUDL_BENCH("selection", label, n, flags, {
+                for (size_t i = 0; i < n; ++i) { flags[i] = samples[i].value > threshold.value; }
+            });
+            snprintf(label, sizeof(label), "gt_mask_n, threshold %d", thresholds[t]);
+            CUDL_BENCH("selection", label, n, mask, cudl_mv_gt_mask_n(mask, samples, threshold, n));
+            snprintf(label, sizeof(label), "branchy filter, threshold %d", thresholds[t]);
+            CUDL_BENCH("selection", label, n, &count, count = branchy_filter_gt_n(dst, samples, threshold, n));
+            snprintf(label, sizeof(label), "filter_gt_n, threshold %d", thresholds[t]);
+            CUDL_BENCH("selection", label, n, &count, count = cudl_mv_filter_gt_n(dst, samples, threshold, n));
+            snprintf(label, sizeof(label), "branchy select, threshold %d", thresholds[t]);
+            CUDL_BENCH("selection", label, n, dst, {
+                for (size_t i = 0; i < n; ++i) {
+                    if (samples[i].value > threshold.value) {
+                        dst[i] = reference[i];
+                    } else {
+                        dst[i] = samples[i];
+                    }
+                }
+            });
+            snprintf(label, sizeof(label), "mask and select_n, threshold %d", thresholds[t]);
+            CUDL_BENCH("selection", label, n, dst, {
+                cudl_mv_gt_mask_n(mask, samples, threshold, n);
+                cudl_mv_select_n(dst, mask, reference, samples, n);
+            });
+        }
+        CUDL_BENCH("selection", "clamp_n", n, dst, cudl_mv_clamp_n(dst, samples, cudl_mv(-1000), cudl_mv(1000), n));
+    }
+    free(flags);
+    free(mask);
+    free(dst);
+    free(reference);
+    free(samples);
+}
@@ -0,0 +1,64 @@
+#include "cudl_bench.h"
+#include <cudl_soa.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(ns, int64_t)
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int16_t, int64_t)
+CUDL_ADD_UNIT(ma, int16_t)
+CUDL_ADD_UNIT(celsius, float)
+CUDL_ADD_FLOAT_REDUCTION_OPERATORS(celsius, float)
+
+CUDL_ADD_SOA(sample, (time, ns), (voltage, mv), (current, ma), (temperature, celsius))
+
+#define SOA_BENCH_RECORDS 1000000
+
+void cudl_soa_bench(void) {
+    const size_t n = SOA_BENCH_RECORDS;
+    cudl_sample_t *records = malloc(n * sizeof(cudl_sample_t));
+    cudl_sample_soa_t samples;
+    cudl_sample_soa_init(&samples, NULL);
+    if (!records || !cudl_sample_soa_reserve(&samples, n)) {
+        printf("soa bench: allocation failed, skipped\n");
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            records[i].time = cudl_ns((int64_t) i * 1000);
+            records[i].voltage = cudl_mv((int16_t) (i % 4096));
+            records[i].current = cudl_ma((int16_t) (i % 512));
+            records[i].temperature = cudl_celsius((float) (i % 100) / 4);
+        }
+        int64_t voltage_sum = 0;
+        float temperature_max = 0;
+
+        CUDL_BENCH("soa append", "cudl_sample_soa_append", n, &samples, {
+            cudl_sample_soa_clear(&samples);
+            for (size_t i = 0; i < n; ++i) { cudl_sample_soa_append(&samples, records[i]); }
+        });
+        CUDL_BENCH("soa append", "cudl_sample_soa_append_n", n, &samples, {
+            cudl_sample_soa_clear(&samples);
+            cudl_sample_soa_append_n(&samples, records, n);
+        });
+
+        CUDL_BENCH("column sum", "AoS loop", n, &voltage_sum, {
+            int64_t sum = 0;
+            for (size_t i = 0; i < n; ++i) { sum += CUDL_GET(records[i].voltage); }
+            voltage_sum = sum;
+        });
+        cudl_sample_view_t view = cudl_sample_soa_view(&samples);
+        CUDL_BENCH("column sum", "cudl_mv_sum_n_aligned(view.voltage)", n, &voltage_sum,
+                   voltage_sum = cudl_mv_sum_n_aligned(view.voltage, view.size));
+
+        CUDL_BENCH("column max", "AoS loop", n, &temperature_max, {
+            float max = CUDL_GET(records[0].temperature);
+            for (size_t i = 1; i < n; ++i) {
+                max = CUDL_GET(records[i].temperature) > max ? CUDL_GET(records[i].temperature) : max;
+            }
+            temperature_max = max;
+        });
+        CUDL_BENCH("column max", "cudl_celsius_max_n_aligned(view.temp.)", n, &temperature_max,
+                   temperature_max = CUDL_GET(cudl_celsius_max_n_aligned(view.temperature, view.size)));
+    }
+    cudl_sample_soa_release(&samples);
+    free(records);
+}
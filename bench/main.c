@@ -0,0 +1,28 @@
+#include "cudl_bench.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Usage: cudl-bench [max_elements]
+ * The op families are timed over 1K, 1M and 100M elements. The 100M run needs about 1.3 GB of memory, max_elements
+ * allows to skip the sizes above it.
+ */
+int main(int argc, char **argv) {
+    static const size_t sizes[] = {1000, 1000000, 100000000};
+    size_t max_elements = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : SIZE_MAX;
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        if (sizes[i] <= max_elements) { cudl_ops_bench(sizes[i]); }
+    }
+    cudl_conversion_bench();
+    cudl_ring_buffer_bench();
+    cudl_atomic_bench();
+    cudl_chars_bench();
+    cudl_soa_bench();
+    cudl_parallel_bench();
+    cudl_histogram_bench();
+    cudl_sample_file_bench();
+    cudl_selection_bench();
+    cudl_filter_bench();
+    return 0;
+}
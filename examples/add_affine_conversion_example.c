@@ -0,0 +1,22 @@
+#include <cudl.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(celsius, float)
+CUDL_ADD_UNIT(fahrenheit, float)
+CUDL_ADD_AFFINE_CONVERSION(celsius, fahrenheit, 9, 5, 32)
+
+CUDL_ADD_UNIT(adc, uint16_t)
+CUDL_ADD_UNIT(mv, int32_t)
+CUDL_ADD_AFFINE_CONVERSION(adc, mv, 3300, 4096, -1650)// 12 bits ADC with a 3.3 V reference and a 1.65 V bias
+
+static void bar(void) {
+    cudl_fahrenheit_t fahrenheit = cudl_from_celsius_to_fahrenheit(cudl_celsius(100.0f));// fahrenheit will be 212
+
+    cudl_adc_t samples[3] = {{0}, {2048}, {4095}};
+    cudl_mv_t mvolts[3];
+    cudl_from_adc_to_mv_n(mvolts, samples, 3);// mvolts will be equal to -1650, 0 and 1649 internally
+}
+/**
+ * @example add_affine_conversion_example.c
+ * Example to show how to use the #CUDL_ADD_AFFINE_CONVERSION.
+ */
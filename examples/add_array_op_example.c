@@ -0,0 +1,23 @@
+#include <cudl.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(v, uint32_t)
+CUDL_ADD_NO_TRANSFORM_ARRAY_OP(v, _add, +)
+CUDL_ADD_NO_UNIT_ARRAY_OP(v, _mul, *, uint32_t)
+CUDL_ADD_RELATIONAL_ARRAY_OP(v, _gt, >)
+
+static void bar(void) {
+    cudl_v_t a[4] = {{1}, {2}, {3}, {4}};
+    cudl_v_t b[4] = {{10}, {20}, {30}, {40}};
+    cudl_v_t sum[4];
+    cudl_v_t doubled[4];
+    bool greater[4];
+    cudl_v_add_n(sum, a, b, 4);     // sum will contain 11, 22, 33 and 44.
+    cudl_v_mul_n(doubled, a, 2, 4); // doubled will contain 2, 4, 6 and 8.
+    cudl_v_gt_n(greater, b, a, 4);  // greater will contain only true values.
+}
+/**
+ * @example add_array_op_example.c
+ * Example to show how to use the #CUDL_ADD_NO_TRANSFORM_ARRAY_OP, #CUDL_ADD_NO_UNIT_ARRAY_OP and
+ * #CUDL_ADD_RELATIONAL_ARRAY_OP.
+ */
@@ -0,0 +1,31 @@
+#include <cudl_atomic.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(b, uint64_t)
+CUDL_ADD_ATOMIC_UNIT(b, uint64_t)
+CUDL_ADD_SHARDED_COUNTER(b, 16)
+
+CUDL_ADD_UNIT(j, double)
+CUDL_ADD_ATOMIC_FLOAT_UNIT(j, double)
+
+static cudl_j_atomic_t energy;
+static cudl_b_sharded_counter_t received_bytes;
+
+static void init(void) {
+    cudl_j_atomic_init(&energy, cudl_j(0.0));
+    cudl_b_sharded_counter_init(&received_bytes);
+}
+
+static void worker_thread(cudl_j_t consumed, size_t packet_size) {
+    cudl_j_atomic_fetch_add(&energy, consumed);// cudl_j_atomic_fetch_add(&energy, 2.0) would not compile
+    cudl_b_sharded_counter_add(&received_bytes, cudl_b(packet_size));// No contention between the worker threads
+}
+
+static void report_thread(void) {
+    cudl_j_t total_energy = cudl_j_atomic_load_explicit(&energy, memory_order_relaxed);
+    cudl_b_t total_bytes = cudl_b_sharded_counter_load(&received_bytes);
+}
+/**
+ * @example add_atomic_unit_example.c
+ * Example to show how to use the #CUDL_ADD_ATOMIC_UNIT, #CUDL_ADD_ATOMIC_FLOAT_UNIT and #CUDL_ADD_SHARDED_COUNTER.
+ */
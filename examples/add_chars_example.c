@@ -0,0 +1,27 @@
+#include <cudl_chars.h>
+#include <stdint.h>
+#include <string.h>
+
+CUDL_ADD_UNIT(v, int32_t)
+CUDL_ADD_UNIT(mv, int32_t)
+CUDL_ADD_CONVERSION_FACTOR(v, mv, 1000)
+CUDL_ADD_EXPLICIT_INTEGER_CHARS(v, int32_t, "V")
+CUDL_ADD_EXPLICIT_INTEGER_CHARS_WITH_CONVERSIONS(mv, int32_t, "mV", v)// "mV" values, or "V" ones converted to mV
+
+CUDL_ADD_UNIT(rad, float)
+CUDL_ADD_FLOAT_CHARS(rad, float)
+
+static void bar(void) {
+    const char *config = "3300mV";
+    cudl_mv_t threshold;
+    size_t used = cudl_mv_from_chars(config, strlen(config), &threshold);// used will be equal to 6, threshold to 3300
+    used = cudl_mv_from_chars("5V", 2, &threshold);                      // used will be equal to 2, threshold to 5000
+    used = cudl_mv_from_chars("5kV", 3, &threshold);                     // used will be equal to 0, kV is unknown
+
+    char text[CUDL_CHARS_NUMBER_SIZE + 3];// Enough for any value followed by "rad"
+    size_t len = cudl_rad_to_chars(text, sizeof(text), cudl_rad(1.57f));// text will start with "1.57rad", len is 7
+}
+/**
+ * @example add_chars_example.c
+ * Example to show how to use the #CUDL_ADD_EXPLICIT_INTEGER_CHARS_WITH_CONVERSIONS and #CUDL_ADD_FLOAT_CHARS.
+ */
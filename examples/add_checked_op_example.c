@@ -0,0 +1,16 @@
+#include <cudl.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(ma, uint16_t)
+CUDL_ADD_CHECKED_OP(ma, _checked_add, __builtin_add_overflow)
+CUDL_ADD_CHECKED_NO_UNIT_OP(ma, _checked_mul, __builtin_mul_overflow, uint16_t)
+
+static void bar(void) {
+    cudl_ma_t result;
+    bool overflow = cudl_ma_checked_add(cudl_ma(60000), cudl_ma(6000), &result); // overflow will be true.
+    overflow = cudl_ma_checked_mul(cudl_ma(1000), 2, &result); // overflow will be false, result will contain 2000.
+}
+/**
+ * @example add_checked_op_example.c
+ * Example to show how to use the #CUDL_ADD_CHECKED_OP and #CUDL_ADD_CHECKED_NO_UNIT_OP.
+ */
@@ -11,6 +11,10 @@ static void bar(void) {
     cudl_v_t volts = cudl_v(10);
     cudl_mv_t mvolts = cudl_from_v_to_mv(volts);      // mvolts will be equal to 10000 internally.
     cudl_v_t other_volts = cudl_from_mv_to_v(mvolts); // other_volts will be equal to 10 internally.
+
+    cudl_mv_t samples[3] = {{1000}, {2500}, {42000}};
+    cudl_v_t samples_volts[3];
+    cudl_from_mv_to_v_n(samples_volts, samples, 3); // samples_volts will be equal to 1, 2 and 42 internally.
 }
 /**
  * @example add_conversion_example.c
@@ -0,0 +1,44 @@
+#include <cudl_filter.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+// Average of the last 16 values, summed in 32 bits
+CUDL_ADD_MOVING_AVERAGE(mv, int32_t, 16)
+// 8 taps low-pass filter, with coefficients in Q15 (1 is 1 << 15) accumulated in 32 bits
+CUDL_ADD_FIR_FILTER(mv, 8, int16_t, int32_t, 1 << 15)
+// Second order filter, with coefficients in Q14 to represent values from -2 to 2
+CUDL_ADD_BIQUAD_FILTER(mv, int32_t, int64_t, 1 << 14)
+// Keeps 1 value out of 4
+CUDL_ADD_DECIMATOR(mv, 4)
+
+static const int16_t low_pass[8] = {1024, 3072, 5120, 7168, 7168, 5120, 3072, 1024};
+// Butterworth low-pass of a cutoff at 1/20 of the sample rate: b0, b1, b2, a1, a2
+static const int32_t butterworth[5] = {329, 658, 329, -25576, 10508};
+
+static cudl_mv_fir_t fir;
+static cudl_mv_decimator_t decimator;
+static cudl_mv_moving_average_t average;
+static cudl_mv_biquad_t biquad;
+
+static void start(void) {
+    cudl_mv_fir_init(&fir, low_pass);
+    cudl_mv_decimator_init(&decimator);
+    cudl_mv_moving_average_init(&average);
+    cudl_mv_biquad_init(&biquad, butterworth);
+}
+
+// Called with each chunk of the stream as it arrives, whatever its size
+static size_t on_chunk(cudl_mv_t *chunk, size_t n) {
+    // Filtered in place, then decimated in place: chunk holds the decimated values, there are decimated_count of them
+    cudl_mv_biquad_process_n(&biquad, chunk, chunk, n);
+    cudl_mv_fir_process_n(&fir, chunk, chunk, n);
+    size_t decimated_count = cudl_mv_decimator_process_n(&decimator, chunk, chunk, n);
+    // Smoothed values, at the decimated rate
+    cudl_mv_moving_average_process_n(&average, chunk, chunk, decimated_count);
+    return decimated_count;
+}
+/**
+ * @example add_filter_example.c
+ * Example to show how to use the #CUDL_ADD_MOVING_AVERAGE, #CUDL_ADD_FIR_FILTER, #CUDL_ADD_BIQUAD_FILTER and
+ * #CUDL_ADD_DECIMATOR.
+ */
@@ -0,0 +1,28 @@
+#include <cudl.h>
+#include <stdint.h>
+
+CUDL_ADD_FIXED_POINT_UNIT(rad_q, int32_t, 16)
+CUDL_ADD_FIXED_POINT_OPERATORS(rad_q, int32_t)
+
+CUDL_ADD_FIXED_POINT_UNIT(deg_q, int32_t, 8)
+CUDL_ADD_FIXED_POINT_OPERATORS(deg_q, int32_t)
+
+CUDL_ADD_UNIT(rad, float)
+
+// 180 / pi approximated to 7 digits.
+CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR(rad_q, deg_q, 5729578, 100000)
+CUDL_ADD_FIXED_POINT_FLOAT_CONVERSIONS(rad_q, rad)
+
+static void bar(void) {
+    cudl_rad_q_t half_pi = CUDL_FIXED_POINT(rad_q, 1.5707963); // half_pi will be equal to 102944 internally.
+    cudl_rad_q_t pi = cudl_rad_q_mul(half_pi, 2);               // Multiplication by an integer.
+    cudl_rad_q_t pi_2 = cudl_rad_q_qmul(pi, pi);                // pi_2 will be close to 9.8696 (646818 internally).
+    cudl_rad_q_t three = cudl_rad_q_from_int(3);                // three will be equal to 196608 internally.
+    int32_t integer_part = cudl_rad_q_to_int(pi_2);              // integer_part will be equal to 9.
+    cudl_deg_q_t degs = cudl_from_rad_q_to_deg_q(half_pi);      // degs will be close to 90 (23040 internally).
+    cudl_rad_t rads = cudl_from_rad_q_to_rad(half_pi);          // rads will be close to 1.5707963.
+}
+/**
+ * @example add_fixed_point_unit_example.c
+ * Example to show how to use the #CUDL_ADD_FIXED_POINT_UNIT and the fixed-point operators and conversions.
+ */
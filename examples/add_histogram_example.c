@@ -0,0 +1,28 @@
+#include <cudl_histogram.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(ns, uint64_t)
+CUDL_ADD_UNIT(us, uint64_t)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(ns, us, 1, 1000)
+CUDL_ADD_HISTOGRAM(ns, 8)// Percentiles within 0.8 %
+
+static cudl_ns_histogram_t latencies[4];// One per thread, static storage is zero-initialized
+static cudl_ns_histogram_t merged;
+
+static void worker(size_t thread, cudl_ns_t latency) {
+    cudl_ns_histogram_record(&latencies[thread], latency);// No lock, no allocation, no branch
+}
+
+static void report(void) {
+    cudl_ns_histogram_init(&merged);
+    for (size_t thread = 0; thread < 4; ++thread) { cudl_ns_histogram_merge(&merged, &latencies[thread]); }
+
+    const double percentiles[3] = {50, 99, 99.9};
+    cudl_ns_t values[3];
+    cudl_ns_histogram_percentiles(&merged, percentiles, values, 3);// p50, p99 and p99.9 in a single pass
+    cudl_us_t p99 = cudl_from_ns_to_us(values[1]);
+}
+/**
+ * @example add_histogram_example.c
+ * Example to show how to use the #CUDL_ADD_HISTOGRAM.
+ */
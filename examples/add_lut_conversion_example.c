@@ -0,0 +1,24 @@
+#include <cudl_lut.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(adc, uint16_t)
+CUDL_ADD_UNIT(celsius, float)
+
+// Calibration curve of a thermistor divider, from the 12 bits ADC reading to degrees Celsius
+#define THERMISTOR_CELSIUS(_adc) ((float) (-40.0 + 0.05 * (_adc) - 2.5e-6 * (_adc) * (_adc)))
+
+static const float adc_to_celsius_table[33] = CUDL_LUT_TABLE(32, THERMISTOR_CELSIUS, 0, 4095);
+
+CUDL_ADD_LUT_CONVERSION(adc, celsius, adc_to_celsius_table, 33, 0, 4095)
+
+static void bar(void) {
+    cudl_celsius_t temperature = cudl_from_adc_to_celsius(cudl_adc(2048));// temperature will be close to 51.9
+
+    cudl_adc_t readings[3] = {{0}, {1024}, {4095}};
+    cudl_celsius_t temperatures[3];
+    cudl_from_adc_to_celsius_n(temperatures, readings, 3);// temperatures will be close to -40, 8.58 and 122.82
+}
+/**
+ * @example add_lut_conversion_example.c
+ * Example to show how to use the #CUDL_LUT_TABLE and #CUDL_ADD_LUT_CONVERSION.
+ */
@@ -0,0 +1,35 @@
+#include <cudl.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(v, float)
+CUDL_ADD_UNIT(a, float)
+CUDL_ADD_UNIT(w, float)
+CUDL_ADD_UNIT(s, float)
+CUDL_ADD_UNIT(j, float)
+
+CUDL_ADD_PRODUCT_OP(v, a, w, _mul_a)
+CUDL_ADD_QUOTIENT_OP(w, a, v, _div_a)
+CUDL_ADD_FUSED_PRODUCT_OP(w, s, j, _mul_s_add)
+
+CUDL_ADD_UNIT(mv, int32_t)
+CUDL_ADD_UNIT(ma, int32_t)
+CUDL_ADD_UNIT(mw, int32_t)
+
+CUDL_ADD_WIDENED_PRODUCT_OP(mv, ma, mw, _mul_ma, int64_t, 1, 1000)
+
+static void bar(void) {
+    cudl_w_t power = cudl_v_mul_a(cudl_v(12.0f), cudl_a(0.5f));// power will be equal to 6 W
+    cudl_v_t volts = cudl_w_div_a(power, cudl_a(2.0f));         // volts will be equal to 3 V
+
+    // Energy integration: energy += power * duration, with a single rounding when the target has FMA instructions.
+    cudl_j_t energy = cudl_j(0.0f);
+    energy = cudl_w_mul_s_add(power, cudl_s(10.0f), energy);// energy will be equal to 60 J
+
+    // 3.3 V * 2 A = 6600000 uW computed on 64 bits, then scaled to 6600 mW.
+    cudl_mw_t mwatts = cudl_mv_mul_ma(cudl_mv(3300), cudl_ma(2000));
+}
+/**
+ * @example add_product_op_example.c
+ * Example to show how to use the #CUDL_ADD_PRODUCT_OP, #CUDL_ADD_QUOTIENT_OP, #CUDL_ADD_WIDENED_PRODUCT_OP and
+ * #CUDL_ADD_FUSED_PRODUCT_OP.
+ */
@@ -0,0 +1,18 @@
+#include <cudl.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(count, uint32_t)
+CUDL_ADD_UNIT(scaled_count, uint32_t)
+
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(count, scaled_count, 3000, 7000)
+
+static void bar(void) {
+    cudl_count_t count = cudl_count(4000000000u);
+    // The fraction is reduced to 3 / 7 and the product is computed on 64 bits, so scaled will be equal to 1714285714
+    // internally. With CUDL_ADD_CONVERSION_FRACTION_FACTOR, the product would have overflowed.
+    cudl_scaled_count_t scaled = cudl_from_count_to_scaled_count(count);
+}
+/**
+ * @example add_reduced_conversion_example.c
+ * Example to show how to use the #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR.
+ */
@@ -0,0 +1,24 @@
+#include <cudl.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int16_t, int64_t)
+
+CUDL_ADD_UNIT(a, float)
+CUDL_ADD_FLOAT_REDUCTION_OPERATORS(a, float)
+
+static void bar(void) {
+    cudl_mv_t samples[4] = {cudl_mv(30000), cudl_mv(30000), cudl_mv(-20000), cudl_mv(10000)};
+    int64_t sum = cudl_mv_sum_n(samples, 4);   // sum will be equal to 50000, it does not wrap around like int16_t
+    cudl_mv_t mean = cudl_mv_mean_n(samples, 4);// mean will be equal to 12500
+    cudl_mv_t peak = cudl_mv_max_n(samples, 4); // peak will be equal to 30000
+    int64_t sumsq = cudl_mv_sumsq_n(samples, 4);// The RMS value is sqrt(sumsq / 4)
+
+    cudl_a_t currents[3] = {cudl_a(0.5f), cudl_a(-1.5f), cudl_a(2.0f)};
+    float total = cudl_a_sum_n(currents, 3);  // total will be equal to 1
+    cudl_a_t lowest = cudl_a_min_n(currents, 3);// lowest will be equal to -1.5
+}
+/**
+ * @example add_reduction_operators_example.c
+ * Example to show how to use the #CUDL_ADD_INTEGER_REDUCTION_OPERATORS and #CUDL_ADD_FLOAT_REDUCTION_OPERATORS.
+ */
@@ -0,0 +1,36 @@
+#include <cudl_ring_buffer.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_RING_BUFFER(mv, 256)
+
+static cudl_mv_ring_buffer_t samples;// Static storage respects the cache line alignment of the buffer type
+
+static void init(void) {
+    cudl_mv_ring_buffer_init(&samples);
+}
+
+static void acquisition_interrupt(int16_t adc_value) {
+    if (!cudl_mv_ring_buffer_push(&samples, cudl_mv(adc_value))) {
+        // The buffer is full, the processing thread is late
+    }
+}
+
+static void processing_thread(void) {
+    cudl_mv_t sample;
+    while (cudl_mv_ring_buffer_pop(&samples, &sample)) {
+        // Process a single sample
+    }
+
+    cudl_mv_t block[64];
+    size_t count = cudl_mv_ring_buffer_pop_n(&samples, block, 64);// Copies up to 64 samples, count are valid
+
+    const cudl_mv_t *span;
+    size_t available = cudl_mv_ring_buffer_peek(&samples, &span);// Reads the samples in place, without copying them
+    // Process span[0] to span[available - 1]
+    cudl_mv_ring_buffer_consume(&samples, available);
+}
+/**
+ * @example add_ring_buffer_example.c
+ * Example to show how to use the #CUDL_ADD_RING_BUFFER.
+ */
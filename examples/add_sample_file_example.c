@@ -0,0 +1,30 @@
+#include <cudl_sample_file.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int16_t, int64_t)
+CUDL_ADD_SAMPLE_FILE(mv, int16_t)
+
+static void capture(const cudl_mv_t *block, size_t n) {
+    cudl_mv_sample_writer_t writer;
+    if (cudl_mv_sample_writer_open(&writer, "capture.cudl") != CUDL_SAMPLE_FILE_OK) { return; }
+    for (int i = 0; i < 1000; ++i) {
+        cudl_mv_sample_writer_append_n(&writer, block, n);// Buffered, written 1 MiB at a time
+    }
+    cudl_mv_sample_writer_close(&writer);// Records the number of samples in the header
+}
+
+static void analyze(void) {
+    cudl_mv_sample_file_t file;
+    // Maps the file and checks it holds int16_t mv samples, without reading them
+    if (cudl_mv_sample_file_open(&file, "capture.cudl") == CUDL_SAMPLE_FILE_OK) {
+        // The array functions read the samples from the page cache, without copying them
+        int64_t sum = cudl_mv_sum_n_aligned(file.samples, file.count);
+        cudl_mv_t peak = cudl_mv_max_n(file.samples, file.count);
+    }
+    cudl_mv_sample_file_close(&file);
+}
+/**
+ * @example add_sample_file_example.c
+ * Example to show how to use the #CUDL_ADD_SAMPLE_FILE.
+ */
@@ -0,0 +1,19 @@
+#include <cudl.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(ma, uint16_t)
+CUDL_ADD_SATURATING_ADD_OP(ma, _sat_add, uint16_t)
+CUDL_ADD_SATURATING_SUB_OP(ma, _sat_sub, uint16_t)
+CUDL_ADD_SATURATING_MUL_OP(ma, _sat_mul, uint16_t)
+
+static void bar(void) {
+    cudl_ma_t current = cudl_ma(60000);
+    cudl_ma_t sum = cudl_ma_sat_add(current, cudl_ma(6000));    // sum will contain 65535.
+    cudl_ma_t difference = cudl_ma_sat_sub(cudl_ma(10), current); // difference will contain 0.
+    cudl_ma_t product = cudl_ma_sat_mul(current, 2);             // product will contain 65535.
+}
+/**
+ * @example add_saturating_op_example.c
+ * Example to show how to use the #CUDL_ADD_SATURATING_ADD_OP, #CUDL_ADD_SATURATING_SUB_OP and
+ * #CUDL_ADD_SATURATING_MUL_OP.
+ */
@@ -0,0 +1,27 @@
+#include <cudl.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_SELECTION_OPERATORS(mv, int16_t)
+
+#define CAPTURE_SIZE 4096
+
+static void bar(const cudl_mv_t *samples, const cudl_mv_t *reference) {
+    static uint64_t alarms[CUDL_MASK_WORDS(CAPTURE_SIZE)];
+    static cudl_mv_t peaks[CAPTURE_SIZE];
+    static cudl_mv_t repaired[CAPTURE_SIZE];
+    static cudl_mv_t clamped[CAPTURE_SIZE];
+
+    // Bit i % 64 of alarms[i / 64] is set if samples[i] is above 3000 mV
+    cudl_mv_gt_mask_n(alarms, samples, cudl_mv(3000), CAPTURE_SIZE);
+    // The samples above 3000 mV, in order. peak_count is their number
+    size_t peak_count = cudl_mv_filter_gt_n(peaks, samples, cudl_mv(3000), CAPTURE_SIZE);
+    // The samples above 3000 mV are replaced by the ones of the reference capture, the others are kept
+    cudl_mv_select_n(repaired, alarms, reference, samples, CAPTURE_SIZE);
+    // Every sample is brought between 0 and 3000 mV
+    cudl_mv_clamp_n(clamped, samples, cudl_mv(0), cudl_mv(3000), CAPTURE_SIZE);
+}
+/**
+ * @example add_selection_operators_example.c
+ * Example to show how to use the #CUDL_ADD_SELECTION_OPERATORS.
+ */
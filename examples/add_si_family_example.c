@@ -0,0 +1,22 @@
+#include <cudl.h>
+#include <stdint.h>
+
+// kv, v, mv and uv, their operators, and the 12 conversions between them
+CUDL_ADD_SI_FAMILY(v, int32_t, k, , m, u)
+// ms, us and ns only, without the base unit
+CUDL_ADD_SI_FAMILY(s, int64_t, m, u, n)
+
+static void foo(void) {
+    cudl_v_t supply = cudl_from_uv_to_v(cudl_uv(3300000));// A single division, not uv to mv to v
+
+    cudl_mv_t threshold = cudl_mv(3000);
+    cudl_uv_t offset = cudl_uv(-1500);
+    cudl_uv_t corrected = cudl_mv_add_uv(threshold, offset);// Only threshold is converted, to 3000000 uv
+    bool over = cudl_v_gt_mv(supply, threshold);
+
+    cudl_ns_t elapsed = cudl_us_add_ns(cudl_us(12), cudl_ns(345));
+}
+/**
+ * @example add_si_family_example.c
+ * Example to show how to use the #CUDL_ADD_SI_FAMILY.
+ */
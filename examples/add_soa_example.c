@@ -0,0 +1,38 @@
+#include <cudl_soa.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(ns, int64_t)
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int16_t, int64_t)
+
+CUDL_ADD_SOA(sample, (time, ns), (voltage, mv))
+
+static void bar(void) {
+    cudl_sample_soa_t samples;
+    cudl_sample_soa_init(&samples, NULL);// NULL stores the columns on the heap
+
+    cudl_sample_t sample = {cudl_ns(1000), cudl_mv(3300)};
+    cudl_sample_soa_append(&samples, sample);
+    cudl_sample_t more[2] = {{cudl_ns(2000), cudl_mv(3250)}, {cudl_ns(3000), cudl_mv(3350)}};
+    cudl_sample_soa_append_n(&samples, more, 2);
+
+    cudl_sample_view_t view = cudl_sample_soa_view(&samples);
+    int64_t total = cudl_mv_sum_n_aligned(view.voltage, view.size);// total will be 9900
+    cudl_ns_t last = cudl_sample_time(&samples)[2];                  // last will be 3000
+
+    // The columns may also be carved out of a buffer, released all at once by cudl_arena_reset
+    static unsigned char buffer[4096];
+    cudl_arena_t arena;
+    cudl_arena_init(&arena, buffer, sizeof(buffer));
+    cudl_allocator_t allocator = cudl_arena_allocator(&arena);
+    cudl_sample_soa_t copy;
+    cudl_sample_soa_init(&copy, &allocator);
+    cudl_sample_soa_append_view(&copy, cudl_sample_soa_slice(&samples, 1, 2));// copy will hold the last 2 samples
+
+    cudl_sample_soa_release(&samples);
+    cudl_arena_reset(&arena);
+}
+/**
+ * @example add_soa_example.c
+ * Example to show how to use the #CUDL_ADD_SOA.
+ */
@@ -0,0 +1,30 @@
+#include <cudl_wire.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_WIRE_ENCODING(mv, int16_t)
+
+static size_t send(uint8_t *packet, const cudl_mv_t *samples, uint32_t count) {
+    size_t size = cudl_mv_encode_header(packet, count, CUDL_BIG_ENDIAN);// Optional, records "mv", int16_t and count
+    size += cudl_mv_encode_n(packet + size, samples, count, CUDL_BIG_ENDIAN);
+    return size;
+}
+
+static void receive(uint8_t *packet, size_t size) {// packet comes from malloc, e.g. filled by recv
+    uint32_t count;
+    cudl_byte_order_t order;
+    if (!cudl_mv_decode_header(packet, size, &count, &order)) {
+        return;// The packet is too short or does not hold mv samples
+    }
+    const cudl_mv_t *samples = cudl_mv_decode_view(packet + CUDL_WIRE_HEADER_SIZE, order);
+    if (samples == NULL) {
+        // The byte order differs from the host one, swap the bytes in place (or copy them with cudl_mv_decode_n)
+        samples = cudl_mv_decode_in_place_n(packet + CUDL_WIRE_HEADER_SIZE, count, order);
+    }
+    // samples[0] to samples[count - 1] can now be used
+}
+/**
+ * @example add_wire_encoding_example.c
+ * Example to show how to use the #CUDL_ADD_WIRE_ENCODING.
+ */
@@ -0,0 +1,31 @@
+#include <cudl.h>
+#include <stdint.h>
+
+#define MV_FROM_CENTIVOLTS(_x) ((_x) * 10)
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_COMMON_OPERATORS(mv, int16_t)
+CUDL_ADD_UNIT(v, float)
+CUDL_ADD_UNIT_WITH_OP(cmv, int16_t, MV_FROM_CENTIVOLTS)
+CUDL_ADD_UNIT(celsius, float)
+CUDL_ADD_UNIT(fahrenheit, float)
+CUDL_ADD_FIXED_POINT_UNIT(gain, int32_t, 16)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(mv, v, 1, 1000)
+CUDL_ADD_AFFINE_CONVERSION(celsius, fahrenheit, 9, 5, 32)
+
+// All of these are computed by the compiler and placed in read-only memory, nothing runs at startup
+static const cudl_mv_t thresholds[] = {CUDL_CONST(mv, 3000), CUDL_CONST(mv, 3300), CUDL_CONST(mv, 3600)};
+static const cudl_cmv_t brownout = CUDL_CONST_WITH_OP(cmv, MV_FROM_CENTIVOLTS, 290);// brownout will be 2900
+// full_scale will be 3, like cudl_from_mv_to_v(cudl_mv(3300))
+static const cudl_v_t full_scale = CUDL_CONST_CONVERSION_FRACTION_FACTOR(mv, v, 3300, 1, 1000);
+static const cudl_fahrenheit_t alarms[] = {
+        CUDL_CONST_AFFINE_CONVERSION(celsius, fahrenheit, -40, 9, 5, 32),// -40 F
+        CUDL_CONST_AFFINE_CONVERSION(celsius, fahrenheit, 85, 9, 5, 32), // 185 F
+};
+static const cudl_gain_t unity = CUDL_CONST_FIXED_POINT(gain, 1.0);// unity will be 65536
+
+static bool bar(cudl_mv_t value) { return cudl_mv_gt(value, thresholds[1]); }
+/**
+ * @example const_unit_example.c
+ * Example to show how to use #CUDL_CONST and the other static initializer macros.
+ */
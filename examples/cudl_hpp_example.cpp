@@ -0,0 +1,23 @@
+#include <cudl.hpp>
+#include <cstdint>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_UNIT(v, float)
+CUDL_ADD_AFFINE_CONVERSION(mv, v, 1, 1000, 0)
+CUDL_ADD_LITERAL(mv, _mV)
+
+// Folded at compile time, and still the C struct that C code receives
+constexpr cudl_mv_t undervoltage = 3300_mV - 200_mV;// undervoltage will be 3100 mV
+constexpr cudl_v_t undervoltage_v = cudl_from_mv_to_v(undervoltage);// undervoltage_v will be 3.1 V
+static_assert(undervoltage < 3300_mV, "The threshold is checked at compile time");
+
+static bool bar(const cudl_mv_t *samples, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (samples[i] < undervoltage) { return true; }
+    }
+    return false;
+}
+/**
+ * @example cudl_hpp_example.cpp
+ * Example to show how to use the C++ layer of cudl.hpp and #CUDL_ADD_LITERAL.
+ */
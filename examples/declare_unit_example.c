@@ -0,0 +1,26 @@
+#include <cudl.h>
+#include <stdint.h>
+
+// In a header included everywhere, for example units.h. Only the types and the declarations are seen by the compiler.
+CUDL_DECLARE_UNIT(sample_count, uint32_t)
+CUDL_DECLARE_INTEGER_OPERATORS(sample_count, uint32_t)
+CUDL_DECLARE_UNIT(kilo_sample_count, uint32_t)
+CUDL_DECLARE_REDUCED_CONVERSION_FRACTION_FACTOR(sample_count, kilo_sample_count, 1, 1000)
+
+// In a single source file, for example units.c. Alternatively, units.c can only contain:
+//     #define CUDL_IMPLEMENTATION
+//     #include "units.h"
+CUDL_IMPLEMENT_UNIT(sample_count, uint32_t)
+CUDL_IMPLEMENT_INTEGER_OPERATORS(sample_count, uint32_t)
+CUDL_IMPLEMENT_UNIT(kilo_sample_count, uint32_t)
+CUDL_IMPLEMENT_REDUCED_CONVERSION_FRACTION_FACTOR(sample_count, kilo_sample_count, 1, 1000)
+
+static void bar(void) {
+    // Used like the functions added by the CUDL_ADD_* macros.
+    cudl_sample_count_t count = cudl_sample_count_add(cudl_sample_count(1500), cudl_sample_count(2500));
+    cudl_kilo_sample_count_t kilo = cudl_from_sample_count_to_kilo_sample_count(count);// kilo will be equal to 4
+}
+/**
+ * @example declare_unit_example.c
+ * Example to show how to use the #CUDL_DECLARE_UNIT_WITH_OP and #CUDL_IMPLEMENT_UNIT_WITH_OP families of macros.
+ */
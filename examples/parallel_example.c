@@ -0,0 +1,47 @@
+// The pool functions are defined in a single source file
+#define CUDL_PARALLEL_IMPLEMENTATION
+#include <cudl_parallel.h>
+#include <stdint.h>
+
+CUDL_ADD_UNIT(adc, uint16_t)
+CUDL_ADD_UNIT(mv, int32_t)
+CUDL_ADD_COMMON_ARRAY_OPERATORS(mv, int32_t)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int32_t, int64_t)
+CUDL_ADD_AFFINE_CONVERSION(adc, mv, 3300, 4096, 0)
+
+CUDL_ADD_PARALLEL_CONVERSION(adc, mv)
+CUDL_ADD_PARALLEL_COMMON_ARRAY_OPERATORS(mv, int32_t)
+CUDL_ADD_PARALLEL_REDUCTION_OPERATORS(mv, int64_t)
+
+// Stages of a chain take (dst, src, n), the other parameters are given by a wrapper
+static void decode_n(cudl_adc_t *dst, const uint16_t *src, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = cudl_adc((uint16_t) (src[i] & 0x0fff)); }
+}
+static void clamp_n(cudl_mv_t *dst, const cudl_mv_t *src, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = cudl_mv(src[i].value > 3000 ? 3000 : src[i].value); }
+}
+#define ADD(_lhs, _rhs) ((_lhs) + (_rhs))
+
+CUDL_ADD_PARALLEL_CHAIN(decode_to_mv, uint16_t, cudl_mv_t, (decode_n, cudl_adc_t), (cudl_from_adc_to_mv_n, cudl_mv_t),
+                        (clamp_n, cudl_mv_t))
+CUDL_ADD_PARALLEL_REDUCE_CHAIN(decoded_mv_sum, uint16_t, int64_t, cudl_mv_sum_n, ADD, (decode_n, cudl_adc_t),
+                               (cudl_from_adc_to_mv_n, cudl_mv_t), (clamp_n, cudl_mv_t))
+
+static void bar(const cudl_adc_t *codes, const uint16_t *raw, cudl_mv_t *millivolts, size_t n) {
+    cudl_pool_t *pool = cudl_pool_create(0);// One worker per processor, the calling thread included
+
+    cudl_from_adc_to_mv_n_parallel(pool, millivolts, codes, n);
+    cudl_mv_mul_n_parallel(pool, millivolts, millivolts, 2, n);
+    int64_t total = cudl_mv_sum_n_parallel(pool, millivolts, n);
+
+    // Each chunk of raw is decoded, converted and clamped while it is in cache, only the result is written
+    cudl_decode_to_mv(pool, millivolts, raw, n);
+    // Same without writing the millivolts at all, each chunk is summed in cache
+    int64_t clamped_total = cudl_decoded_mv_sum(pool, raw, n);
+
+    cudl_pool_destroy(pool);
+}
+/**
+ * @example parallel_example.c
+ * Example to show how to use a pool of threads and the functions added by the CUDL_ADD_PARALLEL_* macros.
+ */
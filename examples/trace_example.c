@@ -0,0 +1,34 @@
+// Tracing is enabled per source file. This one also defines the counters, which must be done in a single source file.
+#define CUDL_ENABLE_TRACE
+#define CUDL_TRACE_IMPLEMENTATION
+#include <cudl.h>
+#include <stdint.h>
+#include <stdio.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_COMMON_OPERATORS(mv, int16_t)
+CUDL_ADD_UNIT(v, int16_t)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(mv, v, 1, 1000)
+
+static void on_overflow(const char *unit, const char *op, cudl_trace_event_t event, uint64_t count, void *context) {
+    if (event == CUDL_TRACE_OVERFLOW) { fprintf((FILE *) context, "%s %s overflowed\n", unit, op); }
+}
+
+void trace_foo(void) {
+    const cudl_trace_hook_t hook = {on_overflow, stderr};
+    cudl_trace_set_hook(&hook);// on_overflow is a good place for a breakpoint, here it logs to stderr
+
+    cudl_mv_t total = cudl_mv(0);
+    for (int16_t i = 0; i < 100; ++i) { total = cudl_mv_add(total, cudl_mv(i)); }
+    cudl_v_t volts = cudl_from_mv_to_v(cudl_mv(1999));// Counted as a truncation: 1999 mV gives 1 V
+
+    cudl_trace_dump(stdout);
+    // unit             op                                calls      overflows    truncations
+    // mv               add                                 100              0              0
+    // mv               from_mv_to_v                          1              0              1
+    cudl_trace_set_hook(NULL);
+}
+/**
+ * @example trace_example.c
+ * Example to show how to enable the instrumentation of cudl_trace.h.
+ */
@@ -13,6 +13,9 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 #ifndef CUDL_PREFIX
 /**
@@ -22,6 +25,15 @@ extern "C" {
 #define CUDL_PREFIX cudl_
 #endif
 
+#ifndef CUDL_ARRAY_ALIGNMENT
+/**
+ * @brief Alignment, in bytes, that the pointers given to the *_n_aligned array functions must respect. The default
+ * value is a cache line, which is also enough for the widest vector registers (AVX-512). It can be redefined before
+ * including this header.
+ */
+#define CUDL_ARRAY_ALIGNMENT 64
+#endif
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 /**
  * @brief Level 2 stringification macro. For internal use only.
@@ -44,6 +56,1354 @@ extern "C" {
  * @brief Utility macro meant to allow reuse of other macros that requires an op. For internal use only.
  */
 #define __CUDL_NOP(_x) _x// NOLINT(bugprone-reserved-identifier)
+/**
+ * @brief Utility macro to build the name of a function generated for a unit, like cudl_v_add_n. For internal use only.
+ */
+#define __CUDL_FN(_name, _op_name, _suffix)                                                                            \
+    __CUDL_L1STR(__CUDL_L1STR(__CUDL_AP(_name), _op_name), _suffix)// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Utility macro to build the name of the array version of a function, like cudl_from_mv_to_v_n. For internal
+ * use only.
+ */
+#define __CUDL_ARRAY_FN(_fn) __CUDL_L1STR(_fn, _n)// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Utility macros calling _macro(_arg, item) for each of the (1 to 16) items given after _arg. For internal use
+ * only.
+ */
+#define __CUDL_FOR_EACH(_macro, _arg, ...)                                                                             \
+    __CUDL_L1STR(__CUDL_FOR_EACH_, __CUDL_COUNT_ARGS(__VA_ARGS__))                                                     \
+    (_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_COUNT_ARGS(...)                                                                                         \
+    __CUDL_COUNT_ARGS_IMPL(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1,                         \
+                           0)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_COUNT_ARGS_IMPL(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _count, ...)     \
+    _count// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_1(_macro, _arg, _item) _macro(_arg, _item)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_2(_macro, _arg, _item, ...)                                                                    \
+    _macro(_arg, _item) __CUDL_FOR_EACH_1(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_3(_macro, _arg, _item, ...)                                                                    \
+    _macro(_arg, _item) __CUDL_FOR_EACH_2(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_4(_macro, _arg, _item, ...)                                                                    \
+    _macro(_arg, _item) __CUDL_FOR_EACH_3(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_5(_macro, _arg, _item, ...)                                                                    \
+    _macro(_arg, _item) __CUDL_FOR_EACH_4(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_6(_macro, _arg, _item, ...)                                                                    \
+    _macro(_arg, _item) __CUDL_FOR_EACH_5(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_7(_macro, _arg, _item, ...)                                                                    \
+    _macro(_arg, _item) __CUDL_FOR_EACH_6(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_8(_macro, _arg, _item, ...)                                                                    \
+    _macro(_arg, _item) __CUDL_FOR_EACH_7(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_9(_macro, _arg, _item, ...)                                                                    \
+    _macro(_arg, _item) __CUDL_FOR_EACH_8(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_10(_macro, _arg, _item, ...)                                                                   \
+    _macro(_arg, _item) __CUDL_FOR_EACH_9(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_11(_macro, _arg, _item, ...)                                                                   \
+    _macro(_arg, _item) __CUDL_FOR_EACH_10(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_12(_macro, _arg, _item, ...)                                                                   \
+    _macro(_arg, _item) __CUDL_FOR_EACH_11(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_13(_macro, _arg, _item, ...)                                                                   \
+    _macro(_arg, _item) __CUDL_FOR_EACH_12(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_14(_macro, _arg, _item, ...)                                                                   \
+    _macro(_arg, _item) __CUDL_FOR_EACH_13(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_15(_macro, _arg, _item, ...)                                                                   \
+    _macro(_arg, _item) __CUDL_FOR_EACH_14(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FOR_EACH_16(_macro, _arg, _item, ...)                                                                   \
+    _macro(_arg, _item) __CUDL_FOR_EACH_15(_macro, _arg, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief restrict qualifier usable from both C and C++ translation units. For internal use only.
+ */
+#if defined(__cplusplus) || defined(_MSC_VER)
+#define __CUDL_RESTRICT __restrict// NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_RESTRICT restrict// NOLINT(bugprone-reserved-identifier)
+#endif
+
+/**
+ * @brief True during the compile time evaluation of a constexpr function in C++, where the optimization hints below
+ * are not constant expressions. For internal use only.
+ */
+#if defined(__cplusplus) && defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define __CUDL_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()// NOLINT(bugprone-reserved-identifier)
+#endif
+#endif
+#ifndef __CUDL_CONSTANT_EVALUATED
+#define __CUDL_CONSTANT_EVALUATED() 0// NOLINT(bugprone-reserved-identifier)
+#endif
+
+/**
+ * @brief Tells the compiler that the given pointer is aligned on CUDL_ARRAY_ALIGNMENT. For internal use only.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define __CUDL_ASSUME_ALIGNED(_ptr_type, _ptr)                                                                         \
+    (__CUDL_CONSTANT_EVALUATED()                                                                                       \
+            ? (_ptr_type) (_ptr)                                                                                       \
+            : (_ptr_type) __builtin_assume_aligned((_ptr), CUDL_ARRAY_ALIGNMENT))// NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_ASSUME_ALIGNED(_ptr_type, _ptr) ((_ptr_type) (_ptr))// NOLINT(bugprone-reserved-identifier)
+#endif
+
+/**
+ * @brief Static assertion, alignment specifier and alignment query usable from both C (C11) and C++ (C++11) translation
+ * units. For internal use only.
+ */
+#ifdef __cplusplus
+#define __CUDL_STATIC_ASSERT(_cond, _msg) static_assert(_cond, _msg)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ALIGNAS(_align) alignas(_align)                     // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ALIGNOF(_type) alignof(_type)                       // NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_STATIC_ASSERT(_cond, _msg) _Static_assert(_cond, _msg)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ALIGNAS(_align) _Alignas(_align)                       // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ALIGNOF(_type) _Alignof(_type)                         // NOLINT(bugprone-reserved-identifier)
+#endif
+
+/**
+ * @brief constexpr specifier of the functions that can be evaluated at compile time from C++ (C++14 or later), and the
+ * declaration of __cudl_unit_storage(unit), which tells cudl.hpp the storage type of each unit. Both are empty in C.
+ * For internal use only.
+ */
+#if defined(__cplusplus) && (__cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L))
+#define __CUDL_CONSTEXPR constexpr// NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_CONSTEXPR// NOLINT(bugprone-reserved-identifier)
+#endif
+#ifdef __cplusplus
+#define __CUDL_UNIT_STORAGE(_name, _type)                                                                              \
+    extern "C++" _type __cudl_unit_storage(__CUDL_UT(_name));// NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_UNIT_STORAGE(_name, _type)// NOLINT(bugprone-reserved-identifier)
+#endif
+
+/**
+ * @brief Function definition strategies given as the _def argument of the internal generator macros. They receive the
+ * function signature and its body. __CUDL_INLINE defines a static inline function, __CUDL_INLINE_CONSTEXPR a static
+ * inline function that is also constexpr in C++, __CUDL_IMPLEMENT defines a function with external linkage and
+ * __CUDL_DECLARE only declares it, unless CUDL_IMPLEMENTATION is defined before including this header, in which case it
+ * defines it like __CUDL_IMPLEMENT. For internal use only.
+ */
+#define __CUDL_INLINE(_signature, ...) static inline _signature __VA_ARGS__// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_IMPLEMENT(_signature, ...) _signature __VA_ARGS__          // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_INLINE_CONSTEXPR(_signature, ...)                                                                       \
+    static inline __CUDL_CONSTEXPR _signature __VA_ARGS__// NOLINT(bugprone-reserved-identifier)
+#ifdef CUDL_IMPLEMENTATION
+#define __CUDL_DECLARE __CUDL_IMPLEMENT// NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_DECLARE(_signature, ...) _signature;// NOLINT(bugprone-reserved-identifier)
+#endif
+
+/**
+ * @brief Instrumentation hooks of the generated operators and conversions. Unless CUDL_ENABLE_TRACE is defined before
+ * including this header, they expand to nothing (or to their _cond argument), so the generated functions are the same
+ * as without them. Otherwise, they are defined by cudl_trace.h. For internal use only.
+ */
+#ifndef CUDL_ENABLE_TRACE
+#define __CUDL_TRACE_CALLS(_name, _op_name, _count)                       // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_TRACE_FLAG(_name, _op_name, _event, _cond) (_cond)         // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_TRACE_CONVERSION(_from, _to, _explicative, _value, _exact)// NOLINT(bugprone-reserved-identifier)
+#endif
+
+/**
+ * @brief Generates an array function taking one source array, and its aligned variant, with the given _def strategy.
+ * _prelude is executed once before the loop. _assign is the loop body and must be written in terms of dst[i] and
+ * src[i]. For internal use only.
+ */
+#define __CUDL_UNARY_ARRAY_FUNCTIONS(_def, _fn, _dst_type, _src_type, _prelude, _assign)                               \
+    _def(void _fn(_dst_type *__CUDL_RESTRICT dst, const _src_type *__CUDL_RESTRICT src, size_t n), {                   \
+        _prelude;                                                                                                      \
+        for (size_t i = 0; i < n; ++i) { _assign; }                                                                    \
+    })                                                                                                                 \
+    _def(void __CUDL_L1STR(_fn, _aligned)(_dst_type *__CUDL_RESTRICT dst, const _src_type *__CUDL_RESTRICT src,        \
+                                          size_t n),                                                                   \
+         { _fn(__CUDL_ASSUME_ALIGNED(_dst_type *, dst), __CUDL_ASSUME_ALIGNED(const _src_type *, src), n); })
+
+/**
+ * @brief Generates an array function taking two source arrays of possibly different types, and its aligned variant,
+ * with the given _def strategy. _prelude is executed once before the loop. _assign is the loop body and must be written
+ * in terms of dst[i], lhs[i] and rhs[i]. For internal use only.
+ */
+#define __CUDL_MIXED_BINARY_ARRAY_FUNCTIONS(_def, _fn, _dst_type, _lhs_type, _rhs_type, _prelude, _assign)             \
+    _def(void _fn(_dst_type *__CUDL_RESTRICT dst, const _lhs_type *__CUDL_RESTRICT lhs,                                \
+                  const _rhs_type *__CUDL_RESTRICT rhs, size_t n),                                                     \
+         {                                                                                                             \
+             _prelude;                                                                                                 \
+             for (size_t i = 0; i < n; ++i) { _assign; }                                                               \
+         })                                                                                                            \
+    _def(void __CUDL_L1STR(_fn, _aligned)(_dst_type *__CUDL_RESTRICT dst, const _lhs_type *__CUDL_RESTRICT lhs,        \
+                                          const _rhs_type *__CUDL_RESTRICT rhs, size_t n),                             \
+         {                                                                                                             \
+             _fn(__CUDL_ASSUME_ALIGNED(_dst_type *, dst), __CUDL_ASSUME_ALIGNED(const _lhs_type *, lhs),               \
+                 __CUDL_ASSUME_ALIGNED(const _rhs_type *, rhs), n);                                                    \
+         })
+
+/**
+ * @brief Generates an array function taking two source arrays of the same type, and its aligned variant, with the
+ * given _def strategy. See #__CUDL_MIXED_BINARY_ARRAY_FUNCTIONS. For internal use only.
+ */
+#define __CUDL_BINARY_ARRAY_FUNCTIONS(_def, _fn, _dst_type, _src_type, _prelude, _assign)                              \
+    __CUDL_MIXED_BINARY_ARRAY_FUNCTIONS(_def, _fn, _dst_type, _src_type, _src_type, _prelude, _assign)
+
+/**
+ * @brief Generates an array function taking one source array and a scalar, and its aligned variant, with the given
+ * _def strategy. _prelude is executed once before the loop. _assign is the loop body and must be written in terms of
+ * dst[i], lhs[i] and rhs. For internal use only.
+ */
+#define __CUDL_SCALAR_ARRAY_FUNCTIONS(_def, _fn, _dst_type, _src_type, _scalar_type, _prelude, _assign)                \
+    _def(void _fn(_dst_type *__CUDL_RESTRICT dst, const _src_type *__CUDL_RESTRICT lhs, _scalar_type rhs, size_t n),   \
+         {                                                                                                             \
+             _prelude;                                                                                                 \
+             for (size_t i = 0; i < n; ++i) { _assign; }                                                               \
+         })                                                                                                            \
+    _def(void __CUDL_L1STR(_fn, _aligned)(_dst_type *__CUDL_RESTRICT dst, const _src_type *__CUDL_RESTRICT lhs,        \
+                                          _scalar_type rhs, size_t n),                                                 \
+         { _fn(__CUDL_ASSUME_ALIGNED(_dst_type *, dst), __CUDL_ASSUME_ALIGNED(const _src_type *, lhs), rhs, n); })
+
+/**
+ * @brief Generates the array version of a fraction conversion. The half values are constant folded by the compiler and
+ * tell if both storage types are floating point, in which case a precomputed scale factor replaces the division. For
+ * internal use only.
+ */
+#define __CUDL_CONVERSION_ARRAY_FUNCTIONS(_def, _from, _to, _explicative, _num, _den)                                  \
+    __CUDL_UNARY_ARRAY_FUNCTIONS(                                                                                      \
+            _def, __CUDL_ARRAY_FN(__CUDL_L1STR(__CUDL_AP(_explicative), _to)), __CUDL_UT(_to), __CUDL_UT(_from),       \
+            __CUDL_TRACE_CALLS(_from, _explicative##_to##_n, n) __CUDL_UT(_from) from_half = {1};                      \
+            __CUDL_UT(_to) to_half = {1}; __CUDL_UT(_to) scale = {0};                                                  \
+            from_half.value /= 2; to_half.value /= 2; scale.value = _num; scale.value /= _den;                         \
+            const bool floating = from_half.value != 0 && to_half.value != 0,                                          \
+            dst[i].value = floating ? src[i].value * scale.value : (src[i].value * _num) / _den)
+
+/**
+ * @brief Generates a function reducing an array to a single value, and its aligned variant, with the given _def
+ * strategy. _body must be written in terms of src and n. For internal use only.
+ */
+#define __CUDL_REDUCTION_FUNCTIONS(_def, _fn, _result_type, _src_type, _body)                                          \
+    _def(_result_type _fn(const _src_type *src, size_t n), _body)                                                      \
+    _def(_result_type __CUDL_L1STR(_fn, _aligned)(const _src_type *src, size_t n),                                     \
+         { return _fn(__CUDL_ASSUME_ALIGNED(const _src_type *, src), n); })
+
+/**
+ * @brief Number of independent accumulators of the floating point reductions, and number of elements below which
+ * their pairwise summation stops splitting the array. The accumulators do not depend on each other, so the compiler
+ * keeps them in vector registers without having to reassociate the additions (no -ffast-math needed). For internal
+ * use only.
+ */
+#define __CUDL_REDUCTION_LANES 16  // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PAIRWISE_BLOCK 1024// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Body of a floating point pairwise sum of _term(i) over n elements. Below __CUDL_PAIRWISE_BLOCK elements, the
+ * terms are accumulated in __CUDL_REDUCTION_LANES lanes that are added pairwise at the end, otherwise the elements are
+ * split in two halves summed by calling _split(_fn, offset, count). _trace is only expanded for the halves small
+ * enough to be accumulated, so each element is traced once. For internal use only.
+ */
+#define __CUDL_PAIRWISE_SUM_BODY(_fn, _type, _split, _term, _trace)                                                    \
+    {                                                                                                                  \
+        if (n > __CUDL_PAIRWISE_BLOCK) {                                                                               \
+            const size_t half = n / 2 / __CUDL_REDUCTION_LANES * __CUDL_REDUCTION_LANES;                               \
+            return _split(_fn, 0, half) + _split(_fn, half, n - half);                                                 \
+        }                                                                                                              \
+        _trace                                                                                                         \
+        _type lanes[__CUDL_REDUCTION_LANES] = {0};                                                                     \
+        _type tail = 0;                                                                                                \
+        const size_t blocks = n - n % __CUDL_REDUCTION_LANES;                                                          \
+        size_t i = 0;                                                                                                  \
+        for (; i < blocks; i += __CUDL_REDUCTION_LANES) {                                                              \
+            for (size_t j = 0; j < __CUDL_REDUCTION_LANES; ++j) { lanes[j] += _term(i + j); }                          \
+        }                                                                                                              \
+        for (; i < n; ++i) { tail += _term(i); }                                                                       \
+        for (size_t width = __CUDL_REDUCTION_LANES / 2; width > 0; width /= 2) {                                       \
+            for (size_t j = 0; j < width; ++j) { lanes[j] += lanes[j + width]; }                                       \
+        }                                                                                                              \
+        return lanes[0] + tail;                                                                                        \
+    }
+
+/**
+ * @brief Splitting and term macros given to #__CUDL_PAIRWISE_SUM_BODY, for the reductions of one src array or of the
+ * lhs and rhs arrays. For internal use only.
+ */
+#define __CUDL_SPLIT_SRC(_fn, _offset, _count) _fn(src + (_offset), (_count))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SPLIT_LHS_RHS(_fn, _offset, _count)                                                                     \
+    _fn(lhs + (_offset), rhs + (_offset), (_count))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SRC_VALUE(_i) src[_i].value                   // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SRC_SQUARE(_i) (src[_i].value * src[_i].value)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_LHS_RHS_PRODUCT(_i) (lhs[_i].value * rhs[_i].value)// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Maps the bits of a float (_bits_type int) or double (_bits_type long long) to an integer with the same order
+ * as the floating point value, and back. Negative values get all their bits but the sign flipped. For internal use
+ * only.
+ */
+#define __CUDL_FLOAT_KEY(_bits_type, _bits)                                                                            \
+    ((_bits) ^                                                                                                         \
+     (((_bits) >> (sizeof(_bits_type) * 8 - 1)) & __CUDL_TYPE_MAX(_bits_type)))// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Loop finding the minimum (_cmp is <) or maximum (_cmp is >) of a float or double array through the integer
+ * keys of #__CUDL_FLOAT_KEY. Floating point minimum and maximum reductions are only vectorized by the compiler with
+ * -ffinite-math-only and -fno-signed-zeros, while integer ones always are. For internal use only.
+ */
+#define __CUDL_FLOAT_KEY_EXTREMUM(_bits_type, _cmp)                                                                    \
+    {                                                                                                                  \
+        _bits_type best;                                                                                               \
+        memcpy(&best, &src[0].value, sizeof(best));                                                                    \
+        best = __CUDL_FLOAT_KEY(_bits_type, best);                                                                     \
+        for (size_t i = 1; i < n; ++i) {                                                                               \
+            _bits_type key;                                                                                            \
+            memcpy(&key, &src[i].value, sizeof(key));                                                                  \
+            key = __CUDL_FLOAT_KEY(_bits_type, key);                                                                   \
+            best = key _cmp best ? key : best;                                                                         \
+        }                                                                                                              \
+        best = __CUDL_FLOAT_KEY(_bits_type, best);                                                                     \
+        memcpy(&result.value, &best, sizeof(best));                                                                    \
+    }
+
+/**
+ * @brief Body of a floating point minimum (_cmp is <) or maximum (_cmp is >) over an array, 0 when it is empty. Float
+ * and double storages use #__CUDL_FLOAT_KEY_EXTREMUM, other storages a plain loop. For internal use only.
+ */
+#define __CUDL_FLOAT_EXTREMUM_BODY(_name, _type, _cmp)                                                                 \
+    {                                                                                                                  \
+        __CUDL_UT(_name) result = {0};                                                                                 \
+        if (n == 0) {                                                                                                  \
+            return result;                                                                                             \
+        }                                                                                                              \
+        if (sizeof(_type) == sizeof(int) && sizeof(float) == sizeof(int)) {                                            \
+            __CUDL_FLOAT_KEY_EXTREMUM(int, _cmp)                                                                       \
+        } else if (sizeof(_type) == sizeof(long long) && sizeof(double) == sizeof(long long)) {                        \
+            __CUDL_FLOAT_KEY_EXTREMUM(long long, _cmp)                                                                 \
+        } else {                                                                                                       \
+            result.value = src[0].value;                                                                               \
+            for (size_t i = 1; i < n; ++i) {                                                                           \
+                result.value = src[i].value _cmp result.value ? src[i].value : result.value;                           \
+            }                                                                                                          \
+        }                                                                                                              \
+        return result;                                                                                                 \
+    }
+
+/**
+ * @brief Generators of the reductions added by #CUDL_ADD_INTEGER_REDUCTION_OPERATORS and
+ * #CUDL_ADD_FLOAT_REDUCTION_OPERATORS, with the given _def strategy. For internal use only.
+ */
+#define __CUDL_INTEGER_REDUCTION_OPERATORS(_def, _name, _type, _sum_type)                                              \
+    __CUDL_REDUCTION_FUNCTIONS(_def, __CUDL_FN(_name, _sum, _n), _sum_type, __CUDL_UT(_name), {                        \
+        __CUDL_TRACE_CALLS(_name, _sum_n, n)                                                                           \
+        _sum_type sum = 0;                                                                                             \
+        for (size_t i = 0; i < n; ++i) { sum += src[i].value; }                                                        \
+        return sum;                                                                                                    \
+    })                                                                                                                 \
+    __CUDL_REDUCTION_FUNCTIONS(_def, __CUDL_FN(_name, _sumsq, _n), _sum_type, __CUDL_UT(_name), {                      \
+        __CUDL_TRACE_CALLS(_name, _sumsq_n, n)                                                                         \
+        _sum_type sum = 0;                                                                                             \
+        for (size_t i = 0; i < n; ++i) { sum += (_sum_type) src[i].value * src[i].value; }                             \
+        return sum;                                                                                                    \
+    })                                                                                                                 \
+    _def(_sum_type __CUDL_FN(_name, _dot, _n)(const __CUDL_UT(_name) *__CUDL_RESTRICT lhs,                             \
+                                              const __CUDL_UT(_name) *__CUDL_RESTRICT rhs, size_t n),                  \
+         {                                                                                                             \
+             __CUDL_TRACE_CALLS(_name, _dot_n, n)                                                                      \
+             _sum_type sum = 0;                                                                                        \
+             for (size_t i = 0; i < n; ++i) { sum += (_sum_type) lhs[i].value * rhs[i].value; }                        \
+             return sum;                                                                                               \
+         })                                                                                                            \
+    _def(_sum_type __CUDL_FN(_name, _dot, _n_aligned)(const __CUDL_UT(_name) *__CUDL_RESTRICT lhs,                     \
+                                                      const __CUDL_UT(_name) *__CUDL_RESTRICT rhs, size_t n),          \
+         {                                                                                                             \
+             return __CUDL_FN(_name, _dot, _n)(__CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, lhs),                   \
+                                               __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, rhs), n);               \
+         })                                                                                                            \
+    __CUDL_REDUCTION_FUNCTIONS(_def, __CUDL_FN(_name, _mean, _n), __CUDL_UT(_name), __CUDL_UT(_name), {                \
+        __CUDL_UT(_name) mean;                                                                                         \
+        __CUDL_TRACE_CALLS(_name, _mean_n, n)                                                                          \
+        mean.value = n == 0 ? 0 : (_type) (__CUDL_FN(_name, _sum, _n)(src, n) / (_sum_type) n);                        \
+        return mean;                                                                                                   \
+    })                                                                                                                 \
+    __CUDL_REDUCTION_FUNCTIONS(_def, __CUDL_FN(_name, _min, _n), __CUDL_UT(_name), __CUDL_UT(_name), {                 \
+        __CUDL_TRACE_CALLS(_name, _min_n, n)                                                                           \
+        if (n == 0) {                                                                                                  \
+            return __CUDL_AP(_name)((_type) 0);                                                                        \
+        }                                                                                                              \
+        _type min = src[0].value;                                                                                      \
+        for (size_t i = 1; i < n; ++i) { min = src[i].value < min ? src[i].value : min; }                              \
+        return __CUDL_AP(_name)(min);                                                                                  \
+    })                                                                                                                 \
+    __CUDL_REDUCTION_FUNCTIONS(_def, __CUDL_FN(_name, _max, _n), __CUDL_UT(_name), __CUDL_UT(_name), {                 \
+        __CUDL_TRACE_CALLS(_name, _max_n, n)                                                                           \
+        if (n == 0) {                                                                                                  \
+            return __CUDL_AP(_name)((_type) 0);                                                                        \
+        }                                                                                                              \
+        _type max = src[0].value;                                                                                      \
+        for (size_t i = 1; i < n; ++i) { max = src[i].value > max ? src[i].value : max; }                              \
+        return __CUDL_AP(_name)(max);                                                                                  \
+    })
+#define __CUDL_FLOAT_REDUCTION_OPERATORS(_def, _name, _type)                                                           \
+    __CUDL_REDUCTION_FUNCTIONS(                                                                                        \
+            _def, __CUDL_FN(_name, _sum, _n), _type, __CUDL_UT(_name),                                                 \
+            __CUDL_PAIRWISE_SUM_BODY(__CUDL_FN(_name, _sum, _n), _type, __CUDL_SPLIT_SRC, __CUDL_SRC_VALUE,            \
+                                     __CUDL_TRACE_CALLS(_name, _sum_n, n)))                                            \
+    __CUDL_REDUCTION_FUNCTIONS(                                                                                        \
+            _def, __CUDL_FN(_name, _sumsq, _n), _type, __CUDL_UT(_name),                                               \
+            __CUDL_PAIRWISE_SUM_BODY(__CUDL_FN(_name, _sumsq, _n), _type, __CUDL_SPLIT_SRC, __CUDL_SRC_SQUARE,         \
+                                     __CUDL_TRACE_CALLS(_name, _sumsq_n, n)))                                          \
+    _def(_type __CUDL_FN(_name, _dot, _n)(const __CUDL_UT(_name) *__CUDL_RESTRICT lhs,                                 \
+                                          const __CUDL_UT(_name) *__CUDL_RESTRICT rhs, size_t n),                      \
+         __CUDL_PAIRWISE_SUM_BODY(__CUDL_FN(_name, _dot, _n), _type, __CUDL_SPLIT_LHS_RHS, __CUDL_LHS_RHS_PRODUCT,     \
+                                  __CUDL_TRACE_CALLS(_name, _dot_n, n)))                                               \
+    _def(_type __CUDL_FN(_name, _dot, _n_aligned)(const __CUDL_UT(_name) *__CUDL_RESTRICT lhs,                         \
+                                                  const __CUDL_UT(_name) *__CUDL_RESTRICT rhs, size_t n),              \
+         {                                                                                                             \
+             return __CUDL_FN(_name, _dot, _n)(__CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, lhs),                   \
+                                               __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, rhs), n);               \
+         })                                                                                                            \
+    __CUDL_REDUCTION_FUNCTIONS(_def, __CUDL_FN(_name, _mean, _n), __CUDL_UT(_name), __CUDL_UT(_name), {                \
+        __CUDL_TRACE_CALLS(_name, _mean_n, n)                                                                          \
+        return __CUDL_AP(_name)(n == 0 ? 0 : __CUDL_FN(_name, _sum, _n)(src, n) / (_type) n);                          \
+    })                                                                                                                 \
+    __CUDL_REDUCTION_FUNCTIONS(_def, __CUDL_FN(_name, _min, _n), __CUDL_UT(_name), __CUDL_UT(_name), {                 \
+        __CUDL_TRACE_CALLS(_name, _min_n, n)                                                                           \
+        __CUDL_FLOAT_EXTREMUM_BODY(_name, _type, <)                                                                    \
+    })                                                                                                                 \
+    __CUDL_REDUCTION_FUNCTIONS(_def, __CUDL_FN(_name, _max, _n), __CUDL_UT(_name), __CUDL_UT(_name), {                 \
+        __CUDL_TRACE_CALLS(_name, _max_n, n)                                                                           \
+        __CUDL_FLOAT_EXTREMUM_BODY(_name, _type, >)                                                                    \
+    })
+
+/**
+ * @brief Packs 64 bytes being 0 or 1 in the bits of a word, the first byte in the lowest bit. On little endian targets,
+ * each group of 8 bytes is read as a word and a multiplication gathers their lowest bits in its top byte, which is 8
+ * times less instructions than shifting the bytes one by one. For internal use only.
+ */
+static inline uint64_t __cudl_mask_pack(const uint8_t *bytes) {// NOLINT(bugprone-reserved-identifier)
+    uint64_t bits = 0;
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (unsigned k = 0; k < 8; ++k) {
+        uint64_t group;
+        memcpy(&group, bytes + 8 * k, sizeof(group));
+        bits |= (group * UINT64_C(0x0102040810204080) >> 56) << (8 * k);
+    }
+#else
+    for (unsigned j = 0; j < 64; ++j) { bits |= (uint64_t) bytes[j] << j; }
+#endif
+    return bits;
+}
+
+/**
+ * @brief Packs the comparisons of the _block (at most 64) values of src from _base with threshold in the bits of
+ * _bits, the first value in the lowest bit. The comparisons are vectorized, the bytes of the missing values of a last
+ * partial block are 0. For internal use only.
+ */
+#define __CUDL_MASK_BLOCK(_bits, _base, _block, _op)                                                                   \
+    uint8_t matches[64] = {0};                                                                                         \
+    for (size_t j = 0; j < (_block); ++j) { matches[j] = (uint8_t) (src[(_base) + j].value _op threshold.value); }     \
+    const uint64_t _bits = __cudl_mask_pack(matches);
+
+/**
+ * @brief Blends the _block values of lhs and rhs from _base as _bits_type integers of the size of the storage type,
+ * with a mask of all ones or all zeros made from each bit of bits. Going through the bits of the values works for
+ * floating point storages too, and the and/or blend cannot be compiled to a branch, unlike a conditional expression.
+ * For internal use only.
+ */
+#define __CUDL_SELECT_BLOCK(_bits_type)                                                                                \
+    for (size_t j = 0; j < block; ++j) {                                                                               \
+        _bits_type selected, other;                                                                                    \
+        memcpy(&selected, &lhs[base + j].value, sizeof(selected));                                                     \
+        memcpy(&other, &rhs[base + j].value, sizeof(other));                                                           \
+        const _bits_type take = (_bits_type) (0 - (_bits_type) ((bits >> j) & 1));                                     \
+        selected = (_bits_type) ((selected & take) | (other & (_bits_type) ~take));                                    \
+        memcpy(&dst[base + j].value, &selected, sizeof(selected));                                                     \
+    }
+
+/**
+ * @brief Generates the packed mask and the filter of the values of an array compared with a threshold. The filter
+ * skips the blocks of 64 values without any match, which is a well predicted branch when the matches are rare, and
+ * otherwise stores every value of the block at the end of dst, advancing the end only for the matching ones, so that
+ * there is no branch per value whatever the matches are. __CUDL_SELECTION_OPERATORS generates them for every
+ * comparison, with the select and clamp functions. For internal use only.
+ */
+#define __CUDL_SELECTION_COMPARE_OPS(_def, _name, _op_name, _op)                                                       \
+    _def(void __CUDL_FN(_name, _op_name, _mask_n)(uint64_t *__CUDL_RESTRICT dst,                                       \
+                                                  const __CUDL_UT(_name) *__CUDL_RESTRICT src,                         \
+                                                  __CUDL_UT(_name) threshold, size_t n),                               \
+         {                                                                                                             \
+             __CUDL_TRACE_CALLS(_name, _op_name##_mask_n, n)                                                           \
+             for (size_t base = 0; base < n; base += 64) {                                                             \
+                 const size_t block = n - base < 64 ? n - base : 64;                                                   \
+                 __CUDL_MASK_BLOCK(bits, base, block, _op)                                                             \
+                 dst[base / 64] = bits;                                                                                \
+             }                                                                                                         \
+         })                                                                                                            \
+    _def(void __CUDL_FN(_name, _op_name, _mask_n_aligned)(uint64_t *__CUDL_RESTRICT dst,                               \
+                                                          const __CUDL_UT(_name) *__CUDL_RESTRICT src,                 \
+                                                          __CUDL_UT(_name) threshold, size_t n),                       \
+         {                                                                                                             \
+             __CUDL_FN(_name, _op_name, _mask_n)(__CUDL_ASSUME_ALIGNED(uint64_t *, dst),                               \
+                                                 __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, src), threshold, n);  \
+         })                                                                                                            \
+    _def(size_t __CUDL_FN(_name, _filter, _op_name##_n)(__CUDL_UT(_name) * dst, const __CUDL_UT(_name) * src,          \
+                                                        __CUDL_UT(_name) threshold, size_t n),                         \
+         {                                                                                                             \
+             __CUDL_TRACE_CALLS(_name, _filter##_op_name##_n, n)                                                       \
+             size_t count = 0;                                                                                         \
+             for (size_t base = 0; base < n; base += 64) {                                                             \
+                 const size_t block = n - base < 64 ? n - base : 64;                                                   \
+                 __CUDL_MASK_BLOCK(bits, base, block, _op)                                                             \
+                 if (bits == 0) { continue; }                                                                          \
+                 for (size_t j = 0; j < block; ++j) {                                                                  \
+                     dst[count] = src[base + j];                                                                       \
+                     count += (size_t) (bits >> j) & 1;                                                                \
+                 }                                                                                                     \
+             }                                                                                                         \
+             return count;                                                                                             \
+         })                                                                                                            \
+    _def(size_t __CUDL_FN(_name, _filter, _op_name##_n_aligned)(__CUDL_UT(_name) * dst, const __CUDL_UT(_name) * src,  \
+                                                                __CUDL_UT(_name) threshold, size_t n),                 \
+         {                                                                                                             \
+             return __CUDL_FN(_name, _filter, _op_name##_n)(__CUDL_ASSUME_ALIGNED(__CUDL_UT(_name) *, dst),            \
+                                                            __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, src),      \
+                                                            threshold, n);                                             \
+         })
+#define __CUDL_SELECTION_OPERATORS(_def, _name, _type)                                                                 \
+    __CUDL_SELECTION_COMPARE_OPS(_def, _name, _eq, ==)                                                                 \
+    __CUDL_SELECTION_COMPARE_OPS(_def, _name, _ne, !=)                                                                 \
+    __CUDL_SELECTION_COMPARE_OPS(_def, _name, _gt, >)                                                                  \
+    __CUDL_SELECTION_COMPARE_OPS(_def, _name, _ge, >=)                                                                 \
+    __CUDL_SELECTION_COMPARE_OPS(_def, _name, _lt, <)                                                                  \
+    __CUDL_SELECTION_COMPARE_OPS(_def, _name, _le, <=)                                                                 \
+    _def(void __CUDL_FN(_name, _select, _n)(__CUDL_UT(_name) *__CUDL_RESTRICT dst,                                     \
+                                            const uint64_t *__CUDL_RESTRICT mask,                                      \
+                                            const __CUDL_UT(_name) *__CUDL_RESTRICT lhs,                               \
+                                            const __CUDL_UT(_name) *__CUDL_RESTRICT rhs, size_t n), {                  \
+        __CUDL_TRACE_CALLS(_name, _select_n, n)                                                                        \
+        for (size_t base = 0; base < n; base += 64) {                                                                  \
+            const size_t block = n - base < 64 ? n - base : 64;                                                        \
+            const uint64_t bits = mask[base / 64];                                                                     \
+            if (sizeof(_type) == sizeof(uint8_t)) {                                                                    \
+                __CUDL_SELECT_BLOCK(uint8_t)                                                                           \
+            } else if (sizeof(_type) == sizeof(uint16_t)) {                                                            \
+                __CUDL_SELECT_BLOCK(uint16_t)                                                                          \
+            } else if (sizeof(_type) == sizeof(uint32_t)) {                                                            \
+                __CUDL_SELECT_BLOCK(uint32_t)                                                                          \
+            } else if (sizeof(_type) == sizeof(uint64_t)) {                                                            \
+                __CUDL_SELECT_BLOCK(uint64_t)                                                                          \
+            } else {                                                                                                   \
+                for (size_t j = 0; j < block; ++j) {                                                                   \
+                    dst[base + j].value = (bits >> j) & 1 ? lhs[base + j].value : rhs[base + j].value;                 \
+                }                                                                                                      \
+            }                                                                                                          \
+        }                                                                                                              \
+    })                                                                                                                 \
+    _def(void __CUDL_FN(_name, _select, _n_aligned)(__CUDL_UT(_name) *__CUDL_RESTRICT dst,                             \
+                                                    const uint64_t *__CUDL_RESTRICT mask,                              \
+                                                    const __CUDL_UT(_name) *__CUDL_RESTRICT lhs,                       \
+                                                    const __CUDL_UT(_name) *__CUDL_RESTRICT rhs, size_t n), {          \
+        __CUDL_FN(_name, _select, _n)(__CUDL_ASSUME_ALIGNED(__CUDL_UT(_name) *, dst),                                  \
+                                      __CUDL_ASSUME_ALIGNED(const uint64_t *, mask),                                   \
+                                      __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, lhs),                            \
+                                      __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, rhs), n);                        \
+    })                                                                                                                 \
+    _def(void __CUDL_FN(_name, _clamp, _n)(__CUDL_UT(_name) *__CUDL_RESTRICT dst,                                      \
+                                           const __CUDL_UT(_name) *__CUDL_RESTRICT src, __CUDL_UT(_name) low,          \
+                                           __CUDL_UT(_name) high, size_t n), {                                         \
+        __CUDL_TRACE_CALLS(_name, _clamp_n, n)                                                                         \
+        for (size_t i = 0; i < n; ++i) {                                                                               \
+            const _type value = src[i].value < low.value ? low.value : src[i].value;                                   \
+            dst[i].value = value > high.value ? high.value : value;                                                    \
+        }                                                                                                              \
+    })                                                                                                                 \
+    _def(void __CUDL_FN(_name, _clamp, _n_aligned)(__CUDL_UT(_name) *__CUDL_RESTRICT dst,                              \
+                                                   const __CUDL_UT(_name) *__CUDL_RESTRICT src,                        \
+                                                   __CUDL_UT(_name) low, __CUDL_UT(_name) high, size_t n), {           \
+        __CUDL_FN(_name, _clamp, _n)(__CUDL_ASSUME_ALIGNED(__CUDL_UT(_name) *, dst),                                   \
+                                     __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, src), low, high, n);              \
+    })
+
+/**
+ * @brief Fused multiply-add of float and double values. They map to a single FMA instruction when the target has one
+ * (e.g. -mfma or -march=native on x86-64, always on AArch64), and to a separate multiplication and addition otherwise,
+ * so a slow software fma() is never called. For internal use only.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__FP_FAST_FMAF)
+#define __CUDL_FMAF(_a, _b, _c) __builtin_fmaf((_a), (_b), (_c))// NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_FMAF(_a, _b, _c) ((float) (_a) * (float) (_b) + (float) (_c))// NOLINT(bugprone-reserved-identifier)
+#endif
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__FP_FAST_FMA)
+#define __CUDL_FMA(_a, _b, _c) __builtin_fma((_a), (_b), (_c))// NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_FMA(_a, _b, _c) ((double) (_a) * (double) (_b) + (double) (_c))// NOLINT(bugprone-reserved-identifier)
+#endif
+
+/**
+ * @brief Widest integer types available to compute the intermediate product of a reduced conversion. For internal use
+ * only.
+ */
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 __cudl_widest_int_t;         // NOLINT(bugprone-reserved-identifier)
+__extension__ typedef unsigned __int128 __cudl_widest_uint_t;// NOLINT(bugprone-reserved-identifier)
+#else
+typedef long long __cudl_widest_int_t;         // NOLINT(bugprone-reserved-identifier)
+typedef unsigned long long __cudl_widest_uint_t;// NOLINT(bugprone-reserved-identifier)
+#endif
+#define __CUDL_WIDEST_INT __cudl_widest_int_t  // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_WIDEST_UINT __cudl_widest_uint_t// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief One step of the Euclidean algorithm on the gcd_a and gcd_b variables. For internal use only.
+ */
+#define __CUDL_GCD_STEP                                                                                                \
+    if (gcd_b != 0) {                                                                                                  \
+        gcd_t = gcd_a % gcd_b;                                                                                         \
+        gcd_a = gcd_b;                                                                                                 \
+        gcd_b = gcd_t;                                                                                                 \
+    }
+#define __CUDL_GCD_STEP_4 __CUDL_GCD_STEP __CUDL_GCD_STEP __CUDL_GCD_STEP __CUDL_GCD_STEP
+#define __CUDL_GCD_STEP_16 __CUDL_GCD_STEP_4 __CUDL_GCD_STEP_4 __CUDL_GCD_STEP_4 __CUDL_GCD_STEP_4
+#define __CUDL_GCD_STEP_64 __CUDL_GCD_STEP_16 __CUDL_GCD_STEP_16 __CUDL_GCD_STEP_16 __CUDL_GCD_STEP_16
+
+/**
+ * @brief Declares the num and den constants holding _n / _d reduced to lowest terms. The Euclidean algorithm is written
+ * as straight line code (93 steps is the worst case for 64 bits values), so the optimizer folds it completely and only
+ * the constants remain. For internal use only.
+ */
+#define __CUDL_REDUCE_FRACTION(_n, _d)                                                                                 \
+    unsigned long long gcd_a = (_n), gcd_b = (_d), gcd_t = 0;                                                          \
+    __CUDL_GCD_STEP_64 __CUDL_GCD_STEP_16 __CUDL_GCD_STEP_4 __CUDL_GCD_STEP_4 __CUDL_GCD_STEP_4 __CUDL_GCD_STEP        \
+    const long long num = (long long) ((unsigned long long) (_n) / gcd_a);                                             \
+    const long long den = (long long) ((unsigned long long) (_d) / gcd_a)
+
+/**
+ * @brief Constant expressions giving the signedness and the range of an integer storage type. For internal use only.
+ */
+#define __CUDL_TYPE_IS_SIGNED(_type) ((_type) -1 / 2 == 0)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_TYPE_MAX(_type)                                                                                         \
+    (__CUDL_TYPE_IS_SIGNED(_type) ? (_type) ((((_type) 1 << (sizeof(_type) * 8 - 2)) - 1) * 2 + 1)                     \
+                                  : (_type) ~(_type) 0)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_TYPE_MIN(_type)                                                                                         \
+    (__CUDL_TYPE_IS_SIGNED(_type) ? (_type) (-__CUDL_TYPE_MAX(_type) - 1)                                              \
+                                  : (_type) 0)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_CLAMP(_type, _wide_type, _value)                                                                        \
+    ((_value) > (_wide_type) __CUDL_TYPE_MAX(_type)   ? __CUDL_TYPE_MAX(_type)                                         \
+     : (_value) < (_wide_type) __CUDL_TYPE_MIN(_type) ? __CUDL_TYPE_MIN(_type)                                         \
+                                                      : (_type) (_value))// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Floor of the signed integer _value divided by the positive integer constant _d, where a power of two _d is an
+ * arithmetic shift. __CUDL_LOG2_POW2 is the base 2 logarithm of a power of two, as a constant expression. For internal
+ * use only.
+ */
+#define __CUDL_LOG2_POW2(_x)                                                                                           \
+    (((unsigned long long) (_x) & 0xAAAAAAAAAAAAAAAAULL ? 1 : 0) |                                                     \
+     ((unsigned long long) (_x) & 0xCCCCCCCCCCCCCCCCULL ? 2 : 0) |                                                     \
+     ((unsigned long long) (_x) & 0xF0F0F0F0F0F0F0F0ULL ? 4 : 0) |                                                     \
+     ((unsigned long long) (_x) & 0xFF00FF00FF00FF00ULL ? 8 : 0) |                                                     \
+     ((unsigned long long) (_x) & 0xFFFF0000FFFF0000ULL ? 16 : 0) |                                                    \
+     ((unsigned long long) (_x) & 0xFFFFFFFF00000000ULL ? 32 : 0))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FLOOR_DIV(_value, _d)                                                                                   \
+    (((_d) & ((_d) - 1)) == 0 ? (_value) >> __CUDL_LOG2_POW2(_d)                                                       \
+                              : (_value) / (_d) - ((_value) % (_d) < 0))// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Utility macro to rebuild the name of the constant holding the number of fractional bits of a fixed-point
+ * unit. For internal use only.
+ */
+#define __CUDL_FRAC_BITS(_name) __CUDL_L1STR(__CUDL_AP(_name), _frac_bits)// NOLINT(bugprone-reserved-identifier)
+/**
+ * @brief Utility macro to rebuild the name of the cudl_<name>_storage_t typedef of the storage type of a unit. For
+ * internal use only.
+ */
+#define __CUDL_STORAGE(_name) __CUDL_L1STR(__CUDL_AP(_name), _storage_t)// NOLINT(bugprone-reserved-identifier)
+/**
+ * @brief Constant expression versions of the conversions, used by the CUDL_CONST_* macros. They compute the raw _to
+ * value from the raw _from value exactly like the conversion functions, selecting the same path with constant
+ * conditions on the storage types instead of local variables, so they can be used in static initializers. For
+ * internal use only.
+ */
+#define __CUDL_IS_FLOAT(_type) ((_type) 1 / 2 != 0)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_CONST_FLOOR(_x)                                                                                         \
+    ((long long) (_x) - ((double) (long long) (_x) > (_x)))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_CONST_CONVERSION_FRACTION_FACTOR(_from, _to, _value, _n, _d)                                            \
+    ((__CUDL_STORAGE(_to)) (((__CUDL_STORAGE(_from)) (_value) * _n) / _d))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_CONST_REDUCED_CONVERSION_FRACTION_FACTOR(_from, _to, _value, _n, _d)                                    \
+    (__CUDL_TYPE_IS_SIGNED(__CUDL_STORAGE(_from))                                                                      \
+             ? (__CUDL_STORAGE(_to)) ((__CUDL_WIDEST_INT) (__CUDL_STORAGE(_from)) (_value) * (_n) / (_d))              \
+             : (__CUDL_STORAGE(_to)) ((__CUDL_WIDEST_UINT) (__CUDL_STORAGE(_from)) (_value) *                          \
+                                      (__CUDL_WIDEST_UINT) (_n) /                                                      \
+                                      (__CUDL_WIDEST_UINT) (_d)))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_CONST_AFFINE_CONVERSION(_from, _to, _value, _scale_n, _scale_d, _offset)                                \
+    (__CUDL_IS_FLOAT(__CUDL_STORAGE(_to))                                                                              \
+             ? (sizeof(__CUDL_STORAGE(_to)) == sizeof(float) && sizeof(__CUDL_STORAGE(_from)) <= sizeof(float)         \
+                        ? (__CUDL_STORAGE(_to)) __CUDL_FMAF((__CUDL_STORAGE(_from)) (_value),                          \
+                                                            (__CUDL_STORAGE(_to)) (_scale_n) / (_scale_d),             \
+                                                            (__CUDL_STORAGE(_to)) (_offset))                           \
+                        : (__CUDL_STORAGE(_to)) __CUDL_FMA((__CUDL_STORAGE(_from)) (_value),                           \
+                                                           (double) (_scale_n) / (_scale_d), (double) (_offset)))      \
+     : __CUDL_IS_FLOAT(__CUDL_STORAGE(_from))                                                                          \
+             ? (__CUDL_STORAGE(_to)) __CUDL_CONST_FLOOR(                                                               \
+                       __CUDL_FMA((__CUDL_STORAGE(_from)) (_value), (double) (_scale_n) / (_scale_d),                  \
+                                  (_offset) + 0.5))                                                                    \
+     : sizeof(__CUDL_STORAGE(_from)) <= 4 && sizeof(__CUDL_STORAGE(_to)) <= 4                                          \
+             ? (__CUDL_STORAGE(_to)) __CUDL_FLOOR_DIV(                                                                 \
+                       (long long) ((long long) (__CUDL_STORAGE(_from)) (_value) * (_scale_n) +                        \
+                                    (long long) (_offset) * (_scale_d) + (_scale_d) / 2),                              \
+                       _scale_d)                                                                                       \
+             : (__CUDL_STORAGE(_to)) __CUDL_FLOOR_DIV(                                                                 \
+                       (__CUDL_WIDEST_INT) ((__CUDL_WIDEST_INT) (__CUDL_STORAGE(_from)) (_value) * (_scale_n) +        \
+                                            (__CUDL_WIDEST_INT) (_offset) * (_scale_d) + (_scale_d) / 2),              \
+                       _scale_d))// NOLINT(bugprone-reserved-identifier)
+/**
+ * @brief Generators behind the public CUDL_ADD_*, CUDL_DECLARE_* and CUDL_IMPLEMENT_* macros. The _def argument is one
+ * of the function definition strategies (__CUDL_INLINE, __CUDL_DECLARE or __CUDL_IMPLEMENT), the other arguments are
+ * documented with the CUDL_ADD_* macro of the same name. For internal use only.
+ */
+#define __CUDL_UNIT_TYPE(_name, _type)                                                                                 \
+    typedef _type __CUDL_STORAGE(_name);                                                                               \
+    typedef struct {                                                                                                   \
+        _type value;                                                                                                   \
+    } __CUDL_UT(_name);                                                                                                \
+    __CUDL_UNIT_STORAGE(_name, _type)
+#define __CUDL_UNIT_INIT(_def, _name, _type, _op)                                                                      \
+    _def(__CUDL_UT(_name) __CUDL_AP(_name)(_type input_value), {                                                       \
+        __CUDL_UT(_name) ct = {0};                                                                                     \
+        ct.value = _op(input_value);                                                                                   \
+        return ct;                                                                                                     \
+    })
+#define __CUDL_CONVERSION_FRACTION_FACTOR(_def, _from, _to, _explicative, _n, _d)                                      \
+    _def(__CUDL_UT(_to) __CUDL_L1STR(__CUDL_AP(_explicative), _to)(__CUDL_UT(_from) from_value), {                     \
+        __CUDL_UT(_to) to_value = {0};                                                                                 \
+        to_value.value = (from_value.value * _n) / _d;                                                                 \
+        __CUDL_TRACE_CONVERSION(_from, _to, _explicative, to_value.value,                                              \
+                                (long double) from_value.value * (_n) / (_d))                                          \
+        return to_value;                                                                                               \
+    })                                                                                                                 \
+    __CUDL_CONVERSION_ARRAY_FUNCTIONS(_def, _from, _to, _explicative, _n, _d)
+#define __CUDL_REDUCED_CONVERSION_FRACTION_FACTOR(_def, _from, _to, _explicative, _n, _d)                              \
+    __CUDL_STATIC_ASSERT(!__CUDL_IS_FLOAT(__CUDL_STORAGE(_from)) && !__CUDL_IS_FLOAT(__CUDL_STORAGE(_to)),             \
+                         "The reduced conversions only support integer storages");                                     \
+    _def(__CUDL_UT(_to) __CUDL_L1STR(__CUDL_AP(_explicative), _to)(__CUDL_UT(_from) from_value), {                     \
+        __CUDL_REDUCE_FRACTION(_n, _d);                                                                                \
+        __CUDL_UT(_from) from_den = {0};                                                                               \
+        __CUDL_UT(_from) sign_probe = {0};                                                                             \
+        __CUDL_UT(_to) to_value = {0};                                                                                 \
+        from_den.value = den;                                                                                          \
+        sign_probe.value -= 1;                                                                                         \
+        sign_probe.value /= 2;                                                                                         \
+        if (num == 1 && (long long) from_den.value == den) {                                                           \
+            to_value.value = from_value.value / from_den.value;                                                        \
+        } else if (num == 1) {                                                                                         \
+            to_value.value = from_value.value / den;                                                                   \
+        } else if (den == 1) {                                                                                         \
+            to_value.value = from_value.value * num;                                                                   \
+        } else if (sizeof(from_value.value) <= 4 && num <= (0x7FFFFFFFFFFFFFFFLL >> 32)) {                             \
+            if (sign_probe.value == 0) {                                                                               \
+                to_value.value = ((long long) from_value.value * num) / den;                                           \
+            } else {                                                                                                   \
+                to_value.value = ((unsigned long long) from_value.value * (unsigned long long) num) /                  \
+                                 (unsigned long long) den;                                                             \
+            }                                                                                                          \
+        } else if (sign_probe.value == 0) {                                                                            \
+            to_value.value = ((__CUDL_WIDEST_INT) from_value.value * num) / den;                                       \
+        } else {                                                                                                       \
+            to_value.value = ((__CUDL_WIDEST_UINT) from_value.value * (__CUDL_WIDEST_UINT) num) /                      \
+                             (__CUDL_WIDEST_UINT) den;                                                                 \
+        }                                                                                                              \
+        __CUDL_TRACE_CONVERSION(_from, _to, _explicative, to_value.value,                                              \
+                                (long double) from_value.value * (_n) / (_d))                                          \
+        return to_value;                                                                                               \
+    })                                                                                                                 \
+    __CUDL_UNARY_ARRAY_FUNCTIONS(_def, __CUDL_ARRAY_FN(__CUDL_L1STR(__CUDL_AP(_explicative), _to)), __CUDL_UT(_to),    \
+                                 __CUDL_UT(_from), __CUDL_TRACE_CALLS(_from, _explicative##_to##_n, n),                \
+                                 dst[i] = __CUDL_L1STR(__CUDL_AP(_explicative), _to)(src[i]))
+#define __CUDL_AFFINE_CONVERSION(_def, _from, _to, _explicative, _scale_n, _scale_d, _offset)                          \
+    _def(__CUDL_UT(_to) __CUDL_L1STR(__CUDL_AP(_explicative), _to)(__CUDL_UT(_from) from_value), {                     \
+        __CUDL_UT(_from) from_half = {1};                                                                              \
+        __CUDL_UT(_to) to_value = {1};                                                                                 \
+        from_half.value /= 2;                                                                                          \
+        to_value.value /= 2;                                                                                           \
+        if (to_value.value != 0) {                                                                                     \
+            __CUDL_UT(_to) scale = {0};                                                                                \
+            __CUDL_UT(_to) offset = {0};                                                                               \
+            scale.value = _scale_n;                                                                                    \
+            scale.value /= _scale_d;                                                                                   \
+            offset.value = _offset;                                                                                    \
+            if (sizeof(to_value.value) == sizeof(float) && sizeof(from_value.value) <= sizeof(float)) {                \
+                to_value.value = __CUDL_FMAF(from_value.value, scale.value, offset.value);                             \
+            } else {                                                                                                   \
+                to_value.value = __CUDL_FMA(from_value.value, (double) (_scale_n) / (_scale_d), (double) (_offset));   \
+            }                                                                                                          \
+        } else if (from_half.value != 0) {                                                                             \
+            const double scaled = __CUDL_FMA(from_value.value, (double) (_scale_n) / (_scale_d), (_offset) + 0.5);     \
+            to_value.value = (long long) scaled - ((double) (long long) scaled > scaled);                              \
+        } else if (sizeof(from_value.value) <= 4 && sizeof(to_value.value) <= 4) {                                     \
+            const long long scaled =                                                                                   \
+                    (long long) from_value.value * (_scale_n) + (long long) (_offset) * (_scale_d) + (_scale_d) / 2;   \
+            to_value.value = __CUDL_FLOOR_DIV(scaled, _scale_d);                                                       \
+        } else {                                                                                                       \
+            const __CUDL_WIDEST_INT scaled = (__CUDL_WIDEST_INT) from_value.value * (_scale_n) +                       \
+                                             (__CUDL_WIDEST_INT) (_offset) * (_scale_d) + (_scale_d) / 2;              \
+            to_value.value = __CUDL_FLOOR_DIV(scaled, _scale_d);                                                       \
+        }                                                                                                              \
+        __CUDL_TRACE_CONVERSION(_from, _to, _explicative, to_value.value,                                              \
+                                (long double) from_value.value * (_scale_n) / (_scale_d) + (_offset))                  \
+        return to_value;                                                                                               \
+    })                                                                                                                 \
+    __CUDL_UNARY_ARRAY_FUNCTIONS(_def, __CUDL_ARRAY_FN(__CUDL_L1STR(__CUDL_AP(_explicative), _to)), __CUDL_UT(_to),    \
+                                 __CUDL_UT(_from), __CUDL_TRACE_CALLS(_from, _explicative##_to##_n, n),                \
+                                 dst[i] = __CUDL_L1STR(__CUDL_AP(_explicative), _to)(src[i]))
+#define __CUDL_NO_TRANSFORM_OP(_def, _name, _op_name, _op)                                                             \
+    _def(__CUDL_UT(_name) __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, __CUDL_UT(_name) rhs), {      \
+        __CUDL_TRACE_CALLS(_name, _op_name, 1)                                                                         \
+        __CUDL_UT(_name) result = {0};                                                                                 \
+        result.value = CUDL_GET(lhs) _op CUDL_GET(rhs);                                                                \
+        return result;                                                                                                 \
+    })
+#define __CUDL_NO_UNIT_OP(_def, _name, _op_name, _op, _type)                                                           \
+    _def(__CUDL_UT(_name) __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, _type rhs), {                 \
+        __CUDL_TRACE_CALLS(_name, _op_name, 1)                                                                         \
+        __CUDL_UT(_name) result = {0};                                                                                 \
+        result.value = CUDL_GET(lhs) _op rhs;                                                                          \
+        return result;                                                                                                 \
+    })
+#define __CUDL_RELATIONAL_OP(_def, _name, _op_name, _op)                                                               \
+    _def(bool __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, __CUDL_UT(_name) rhs), {                  \
+        __CUDL_TRACE_CALLS(_name, _op_name, 1)                                                                         \
+        return CUDL_GET(lhs) _op CUDL_GET(rhs);                                                                        \
+    })
+#define __CUDL_BITWISE_NOT_OP(_def, _name, _op_name)                                                                   \
+    _def(__CUDL_UT(_name) __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) value), {                          \
+        __CUDL_TRACE_CALLS(_name, _op_name, 1)                                                                         \
+        value.value = ~value.value;                                                                                    \
+        return value;                                                                                                  \
+    })
+#define __CUDL_COMMON_OPERATORS(_def, _name, _type)                                                                    \
+    __CUDL_NO_TRANSFORM_OP(_def, _name, _add, +)                                                                       \
+    __CUDL_NO_TRANSFORM_OP(_def, _name, _sub, -)                                                                       \
+    __CUDL_NO_UNIT_OP(_def, _name, _mul, *, _type)                                                                     \
+    __CUDL_NO_UNIT_OP(_def, _name, _div, /, _type)                                                                     \
+    __CUDL_RELATIONAL_OP(_def, _name, _eq, ==)                                                                         \
+    __CUDL_RELATIONAL_OP(_def, _name, _ne, !=)                                                                         \
+    __CUDL_RELATIONAL_OP(_def, _name, _gt, >)                                                                          \
+    __CUDL_RELATIONAL_OP(_def, _name, _ge, >=)                                                                         \
+    __CUDL_RELATIONAL_OP(_def, _name, _lt, <)                                                                          \
+    __CUDL_RELATIONAL_OP(_def, _name, _le, <=)
+#define __CUDL_INTEGER_OPERATORS(_def, _name, _type)                                                                   \
+    __CUDL_COMMON_OPERATORS(_def, _name, _type)                                                                        \
+    __CUDL_NO_UNIT_OP(_def, _name, _mod, %, _type)                                                                     \
+    __CUDL_NO_UNIT_OP(_def, _name, _and, &, _type)                                                                     \
+    __CUDL_NO_UNIT_OP(_def, _name, _or, |, _type)                                                                      \
+    __CUDL_NO_UNIT_OP(_def, _name, _xor, ^, _type)                                                                     \
+    __CUDL_NO_UNIT_OP(_def, _name, _bsl, <<, _type)                                                                    \
+    __CUDL_NO_UNIT_OP(_def, _name, _bsr, >>, _type)                                                                    \
+    __CUDL_BITWISE_NOT_OP(_def, _name, _bnot)
+#define __CUDL_NO_TRANSFORM_ARRAY_OP(_def, _name, _op_name, _op)                                                       \
+    __CUDL_BINARY_ARRAY_FUNCTIONS(_def, __CUDL_FN(_name, _op_name, _n), __CUDL_UT(_name), __CUDL_UT(_name),            \
+                                  __CUDL_TRACE_CALLS(_name, _op_name##_n, n),                                          \
+                                  dst[i].value = lhs[i].value _op rhs[i].value)
+#define __CUDL_NO_UNIT_ARRAY_OP(_def, _name, _op_name, _op, _type)                                                     \
+    __CUDL_SCALAR_ARRAY_FUNCTIONS(_def, __CUDL_FN(_name, _op_name, _n), __CUDL_UT(_name), __CUDL_UT(_name), _type,     \
+                                  __CUDL_TRACE_CALLS(_name, _op_name##_n, n), dst[i].value = lhs[i].value _op rhs)
+#define __CUDL_RELATIONAL_ARRAY_OP(_def, _name, _op_name, _op)                                                         \
+    __CUDL_BINARY_ARRAY_FUNCTIONS(_def, __CUDL_FN(_name, _op_name, _n), bool, __CUDL_UT(_name),                        \
+                                  __CUDL_TRACE_CALLS(_name, _op_name##_n, n), dst[i] = lhs[i].value _op rhs[i].value)
+#define __CUDL_BITWISE_NOT_ARRAY_OP(_def, _name, _op_name)                                                             \
+    __CUDL_UNARY_ARRAY_FUNCTIONS(_def, __CUDL_FN(_name, _op_name, _n), __CUDL_UT(_name), __CUDL_UT(_name),             \
+                                 __CUDL_TRACE_CALLS(_name, _op_name##_n, n), dst[i].value = ~src[i].value)
+#define __CUDL_COMMON_ARRAY_OPERATORS(_def, _name, _type)                                                              \
+    __CUDL_NO_TRANSFORM_ARRAY_OP(_def, _name, _add, +)                                                                 \
+    __CUDL_NO_TRANSFORM_ARRAY_OP(_def, _name, _sub, -)                                                                 \
+    __CUDL_NO_UNIT_ARRAY_OP(_def, _name, _mul, *, _type)                                                               \
+    __CUDL_NO_UNIT_ARRAY_OP(_def, _name, _div, /, _type)                                                               \
+    __CUDL_RELATIONAL_ARRAY_OP(_def, _name, _eq, ==)                                                                   \
+    __CUDL_RELATIONAL_ARRAY_OP(_def, _name, _ne, !=)                                                                   \
+    __CUDL_RELATIONAL_ARRAY_OP(_def, _name, _gt, >)                                                                    \
+    __CUDL_RELATIONAL_ARRAY_OP(_def, _name, _ge, >=)                                                                   \
+    __CUDL_RELATIONAL_ARRAY_OP(_def, _name, _lt, <)                                                                    \
+    __CUDL_RELATIONAL_ARRAY_OP(_def, _name, _le, <=)
+#define __CUDL_INTEGER_ARRAY_OPERATORS(_def, _name, _type)                                                             \
+    __CUDL_COMMON_ARRAY_OPERATORS(_def, _name, _type)                                                                  \
+    __CUDL_NO_UNIT_ARRAY_OP(_def, _name, _mod, %, _type)                                                               \
+    __CUDL_NO_UNIT_ARRAY_OP(_def, _name, _and, &, _type)                                                               \
+    __CUDL_NO_UNIT_ARRAY_OP(_def, _name, _or, |, _type)                                                                \
+    __CUDL_NO_UNIT_ARRAY_OP(_def, _name, _xor, ^, _type)                                                               \
+    __CUDL_NO_UNIT_ARRAY_OP(_def, _name, _bsl, <<, _type)                                                              \
+    __CUDL_NO_UNIT_ARRAY_OP(_def, _name, _bsr, >>, _type)                                                              \
+    __CUDL_BITWISE_NOT_ARRAY_OP(_def, _name, _bnot)
+
+/**
+ * @brief Generators of the saturating and checked operators. The __CUDL_SATURATING_*_VALUE blocks store the clamped
+ * result of _lhs and _rhs in _result, and are expanded both in the scalar function and in the loop of the array one, so
+ * the array call is traced once instead of once per element. For internal use only.
+ */
+#define __CUDL_SATURATING_ADD_VALUE(_type, _result, _lhs, _rhs)                                                        \
+    {                                                                                                                  \
+        if (!__CUDL_TYPE_IS_SIGNED(_type)) {                                                                           \
+            _result = (_type) ((_lhs) + (_rhs));                                                                       \
+            _result = _result < (_lhs) ? __CUDL_TYPE_MAX(_type) : _result;                                             \
+        } else if (sizeof(_type) < sizeof(int)) {                                                                      \
+            int wide = (_lhs) + (_rhs);                                                                                \
+            _result = __CUDL_CLAMP(_type, int, wide);                                                                  \
+        } else if (sizeof(_type) < sizeof(long long)) {                                                                \
+            long long wide = (long long) (_lhs) + (long long) (_rhs);                                                  \
+            _result = __CUDL_CLAMP(_type, long long, wide);                                                            \
+        } else {                                                                                                       \
+            bool overflow = __builtin_add_overflow(_lhs, _rhs, &_result);                                              \
+            _result = overflow ? ((_rhs) > 0 ? __CUDL_TYPE_MAX(_type) : __CUDL_TYPE_MIN(_type)) : _result;             \
+        }                                                                                                              \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SATURATING_SUB_VALUE(_type, _result, _lhs, _rhs)                                                        \
+    {                                                                                                                  \
+        if (!__CUDL_TYPE_IS_SIGNED(_type)) {                                                                           \
+            _result = (_type) ((_lhs) - (_rhs));                                                                       \
+            _result = _result > (_lhs) ? __CUDL_TYPE_MIN(_type) : _result;                                             \
+        } else if (sizeof(_type) < sizeof(int)) {                                                                      \
+            int wide = (_lhs) - (_rhs);                                                                                \
+            _result = __CUDL_CLAMP(_type, int, wide);                                                                  \
+        } else if (sizeof(_type) < sizeof(long long)) {                                                                \
+            long long wide = (long long) (_lhs) - (long long) (_rhs);                                                  \
+            _result = __CUDL_CLAMP(_type, long long, wide);                                                            \
+        } else {                                                                                                       \
+            bool overflow = __builtin_sub_overflow(_lhs, _rhs, &_result);                                              \
+            _result = overflow ? ((_rhs) > 0 ? __CUDL_TYPE_MIN(_type) : __CUDL_TYPE_MAX(_type)) : _result;             \
+        }                                                                                                              \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SATURATING_MUL_VALUE(_type, _result, _lhs, _rhs)                                                        \
+    {                                                                                                                  \
+        if (sizeof(_type) < sizeof(long long) && __CUDL_TYPE_IS_SIGNED(_type)) {                                       \
+            long long wide = (long long) (_lhs) * (long long) (_rhs);                                                  \
+            _result = __CUDL_CLAMP(_type, long long, wide);                                                            \
+        } else if (sizeof(_type) < sizeof(long long)) {                                                                \
+            unsigned long long wide = (unsigned long long) (_lhs) * (unsigned long long) (_rhs);                       \
+            _result = wide > (unsigned long long) __CUDL_TYPE_MAX(_type) ? __CUDL_TYPE_MAX(_type) : (_type) wide;      \
+        } else {                                                                                                       \
+            bool overflow = __builtin_mul_overflow(_lhs, _rhs, &_result);                                              \
+            _result = overflow ? (((_lhs) > 0) == ((_rhs) > 0) ? __CUDL_TYPE_MAX(_type) : __CUDL_TYPE_MIN(_type))      \
+                               : _result;                                                                              \
+        }                                                                                                              \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SATURATING_OP(_def, _name, _op_name, _type, _value)                                                     \
+    _def(__CUDL_UT(_name) __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, __CUDL_UT(_name) rhs), {      \
+        __CUDL_UT(_name) result;                                                                                       \
+        __CUDL_TRACE_CALLS(_name, _op_name, 1)                                                                         \
+        _value(_type, result.value, CUDL_GET(lhs), CUDL_GET(rhs))                                                      \
+        return result;                                                                                                 \
+    })                                                                                                                 \
+    __CUDL_BINARY_ARRAY_FUNCTIONS(_def, __CUDL_FN(_name, _op_name, _n), __CUDL_UT(_name), __CUDL_UT(_name),            \
+                                  __CUDL_TRACE_CALLS(_name, _op_name##_n, n),                                          \
+                                  _value(_type, dst[i].value, lhs[i].value, rhs[i].value))
+#define __CUDL_SATURATING_NO_UNIT_OP(_def, _name, _op_name, _type, _value)                                             \
+    _def(__CUDL_UT(_name) __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, _type rhs), {                 \
+        __CUDL_UT(_name) result;                                                                                       \
+        __CUDL_TRACE_CALLS(_name, _op_name, 1)                                                                         \
+        _value(_type, result.value, CUDL_GET(lhs), rhs)                                                                \
+        return result;                                                                                                 \
+    })                                                                                                                 \
+    __CUDL_SCALAR_ARRAY_FUNCTIONS(_def, __CUDL_FN(_name, _op_name, _n), __CUDL_UT(_name), __CUDL_UT(_name), _type,     \
+                                  __CUDL_TRACE_CALLS(_name, _op_name##_n, n),                                          \
+                                  _value(_type, dst[i].value, lhs[i].value, rhs))
+#define __CUDL_CHECKED_OP(_def, _name, _op_name, _builtin)                                                             \
+    _def(bool __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, __CUDL_UT(_name) rhs,                     \
+                                                       __CUDL_UT(_name) *result),                                      \
+         {                                                                                                             \
+             __CUDL_TRACE_CALLS(_name, _op_name, 1)                                                                    \
+             return __CUDL_TRACE_FLAG(_name, _op_name, CUDL_TRACE_OVERFLOW,                                            \
+                                      _builtin(CUDL_GET(lhs), CUDL_GET(rhs), &result->value));                         \
+         })                                                                                                            \
+    _def(bool __CUDL_FN(_name, _op_name, _n)(__CUDL_UT(_name) *__CUDL_RESTRICT dst,                                    \
+                                             const __CUDL_UT(_name) *__CUDL_RESTRICT lhs,                              \
+                                             const __CUDL_UT(_name) *__CUDL_RESTRICT rhs, size_t n),                   \
+         {                                                                                                             \
+             bool overflow = false;                                                                                    \
+             __CUDL_TRACE_CALLS(_name, _op_name##_n, n)                                                                \
+             for (size_t i = 0; i < n; ++i) {                                                                          \
+                 overflow |= __CUDL_TRACE_FLAG(_name, _op_name##_n, CUDL_TRACE_OVERFLOW,                               \
+                                               _builtin(lhs[i].value, rhs[i].value, &dst[i].value));                   \
+             }                                                                                                         \
+             return overflow;                                                                                          \
+         })                                                                                                            \
+    _def(bool __CUDL_FN(_name, _op_name, _n_aligned)(__CUDL_UT(_name) *__CUDL_RESTRICT dst,                            \
+                                                     const __CUDL_UT(_name) *__CUDL_RESTRICT lhs,                      \
+                                                     const __CUDL_UT(_name) *__CUDL_RESTRICT rhs, size_t n),           \
+         {                                                                                                             \
+             return __CUDL_FN(_name, _op_name, _n)(__CUDL_ASSUME_ALIGNED(__CUDL_UT(_name) *, dst),                     \
+                                                   __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, lhs),               \
+                                                   __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, rhs), n);           \
+         })
+#define __CUDL_CHECKED_NO_UNIT_OP(_def, _name, _op_name, _builtin, _type)                                              \
+    _def(bool __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, _type rhs, __CUDL_UT(_name) *result), {   \
+        __CUDL_TRACE_CALLS(_name, _op_name, 1)                                                                         \
+        return __CUDL_TRACE_FLAG(_name, _op_name, CUDL_TRACE_OVERFLOW, _builtin(CUDL_GET(lhs), rhs, &result->value));  \
+    })                                                                                                                 \
+    _def(bool __CUDL_FN(_name, _op_name, _n)(__CUDL_UT(_name) *__CUDL_RESTRICT dst,                                    \
+                                             const __CUDL_UT(_name) *__CUDL_RESTRICT lhs, _type rhs, size_t n),        \
+         {                                                                                                             \
+             bool overflow = false;                                                                                    \
+             __CUDL_TRACE_CALLS(_name, _op_name##_n, n)                                                                \
+             for (size_t i = 0; i < n; ++i) {                                                                          \
+                 overflow |= __CUDL_TRACE_FLAG(_name, _op_name##_n, CUDL_TRACE_OVERFLOW,                               \
+                                               _builtin(lhs[i].value, rhs, &dst[i].value));                            \
+             }                                                                                                         \
+             return overflow;                                                                                          \
+         })                                                                                                            \
+    _def(bool __CUDL_FN(_name, _op_name, _n_aligned)(__CUDL_UT(_name) *__CUDL_RESTRICT dst,                            \
+                                                     const __CUDL_UT(_name) *__CUDL_RESTRICT lhs, _type rhs,           \
+                                                     size_t n),                                                        \
+         {                                                                                                             \
+             return __CUDL_FN(_name, _op_name, _n)(__CUDL_ASSUME_ALIGNED(__CUDL_UT(_name) *, dst),                     \
+                                                   __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_name) *, lhs), rhs, n);      \
+         })
+#define __CUDL_SATURATING_OPERATORS(_def, _name, _type)                                                                \
+    __CUDL_SATURATING_OP(_def, _name, _sat_add, _type, __CUDL_SATURATING_ADD_VALUE)                                    \
+    __CUDL_SATURATING_OP(_def, _name, _sat_sub, _type, __CUDL_SATURATING_SUB_VALUE)                                    \
+    __CUDL_SATURATING_NO_UNIT_OP(_def, _name, _sat_mul, _type, __CUDL_SATURATING_MUL_VALUE)
+#define __CUDL_CHECKED_OPERATORS(_def, _name, _type)                                                                   \
+    __CUDL_CHECKED_OP(_def, _name, _checked_add, __builtin_add_overflow)                                               \
+    __CUDL_CHECKED_OP(_def, _name, _checked_sub, __builtin_sub_overflow)                                               \
+    __CUDL_CHECKED_NO_UNIT_OP(_def, _name, _checked_mul, __builtin_mul_overflow, _type)
+
+/**
+ * @brief Generators of the operators between two units giving a third one. Their array loops compute each element
+ * directly instead of calling the scalar function. __CUDL_FUSED_PRODUCT_VALUE stores lhs * rhs + addend in _dst through
+ * a temporary, as the array version of the fused product allows dst to be the same array as addend. For internal use
+ * only.
+ */
+#define __CUDL_PRODUCT_OP(_def, _lhs, _rhs, _result, _op_name)                                                         \
+    _def(__CUDL_UT(_result) __CUDL_L1STR(__CUDL_AP(_lhs), _op_name)(__CUDL_UT(_lhs) lhs, __CUDL_UT(_rhs) rhs), {       \
+        __CUDL_UT(_result) result;                                                                                     \
+        __CUDL_TRACE_CALLS(_lhs, _op_name, 1)                                                                          \
+        result.value = lhs.value;                                                                                      \
+        result.value *= rhs.value;                                                                                     \
+        return result;                                                                                                 \
+    })                                                                                                                 \
+    __CUDL_MIXED_BINARY_ARRAY_FUNCTIONS(_def, __CUDL_FN(_lhs, _op_name, _n), __CUDL_UT(_result), __CUDL_UT(_lhs),      \
+                                        __CUDL_UT(_rhs), __CUDL_TRACE_CALLS(_lhs, _op_name##_n, n),                    \
+                                        dst[i].value = lhs[i].value; dst[i].value *= rhs[i].value)
+#define __CUDL_QUOTIENT_OP(_def, _lhs, _rhs, _result, _op_name)                                                        \
+    _def(__CUDL_UT(_result) __CUDL_L1STR(__CUDL_AP(_lhs), _op_name)(__CUDL_UT(_lhs) lhs, __CUDL_UT(_rhs) rhs), {       \
+        __CUDL_UT(_result) result;                                                                                     \
+        __CUDL_TRACE_CALLS(_lhs, _op_name, 1)                                                                          \
+        result.value = lhs.value;                                                                                      \
+        result.value /= rhs.value;                                                                                     \
+        return result;                                                                                                 \
+    })                                                                                                                 \
+    __CUDL_MIXED_BINARY_ARRAY_FUNCTIONS(_def, __CUDL_FN(_lhs, _op_name, _n), __CUDL_UT(_result), __CUDL_UT(_lhs),      \
+                                        __CUDL_UT(_rhs), __CUDL_TRACE_CALLS(_lhs, _op_name##_n, n),                    \
+                                        dst[i].value = lhs[i].value; dst[i].value /= rhs[i].value)
+#define __CUDL_WIDENED_PRODUCT_OP(_def, _lhs, _rhs, _result, _op_name, _wide_type, _num, _den)                         \
+    _def(__CUDL_UT(_result) __CUDL_L1STR(__CUDL_AP(_lhs), _op_name)(__CUDL_UT(_lhs) lhs, __CUDL_UT(_rhs) rhs), {       \
+        __CUDL_UT(_result) result;                                                                                     \
+        __CUDL_TRACE_CALLS(_lhs, _op_name, 1)                                                                          \
+        result.value = ((_wide_type) lhs.value * (_wide_type) rhs.value * (_num)) / (_den);                            \
+        return result;                                                                                                 \
+    })                                                                                                                 \
+    __CUDL_MIXED_BINARY_ARRAY_FUNCTIONS(_def, __CUDL_FN(_lhs, _op_name, _n), __CUDL_UT(_result), __CUDL_UT(_lhs),      \
+                                        __CUDL_UT(_rhs), __CUDL_TRACE_CALLS(_lhs, _op_name##_n, n),                    \
+                                        dst[i].value = ((_wide_type) lhs[i].value * (_wide_type) rhs[i].value *        \
+                                                        (_num)) / (_den))
+#define __CUDL_WIDENED_QUOTIENT_OP(_def, _lhs, _rhs, _result, _op_name, _wide_type, _num, _den)                        \
+    _def(__CUDL_UT(_result) __CUDL_L1STR(__CUDL_AP(_lhs), _op_name)(__CUDL_UT(_lhs) lhs, __CUDL_UT(_rhs) rhs), {       \
+        __CUDL_UT(_result) result;                                                                                     \
+        __CUDL_TRACE_CALLS(_lhs, _op_name, 1)                                                                          \
+        result.value = ((_wide_type) lhs.value * (_num)) / ((_wide_type) rhs.value * (_den));                          \
+        return result;                                                                                                 \
+    })                                                                                                                 \
+    __CUDL_MIXED_BINARY_ARRAY_FUNCTIONS(_def, __CUDL_FN(_lhs, _op_name, _n), __CUDL_UT(_result), __CUDL_UT(_lhs),      \
+                                        __CUDL_UT(_rhs), __CUDL_TRACE_CALLS(_lhs, _op_name##_n, n),                    \
+                                        dst[i].value = ((_wide_type) lhs[i].value * (_num)) /                          \
+                                                       ((_wide_type) rhs[i].value * (_den)))
+#define __CUDL_FUSED_PRODUCT_VALUE(_result, _dst, _lhs, _rhs, _addend)                                                 \
+    {                                                                                                                  \
+        __CUDL_UT(_result) fused = {1};                                                                                \
+        fused.value /= 2;                                                                                              \
+        if (fused.value != 0 && sizeof(fused.value) == sizeof(float)) {                                                \
+            fused.value = __CUDL_FMAF(_lhs, _rhs, _addend);                                                            \
+        } else if (fused.value != 0 && sizeof(fused.value) == sizeof(double)) {                                        \
+            fused.value = __CUDL_FMA(_lhs, _rhs, _addend);                                                             \
+        } else {                                                                                                       \
+            fused.value = _lhs;                                                                                        \
+            fused.value *= _rhs;                                                                                       \
+            fused.value += _addend;                                                                                    \
+        }                                                                                                              \
+        _dst = fused.value;                                                                                            \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FUSED_PRODUCT_OP(_def, _lhs, _rhs, _result, _op_name)                                                   \
+    _def(__CUDL_UT(_result) __CUDL_L1STR(__CUDL_AP(_lhs), _op_name)(__CUDL_UT(_lhs) lhs, __CUDL_UT(_rhs) rhs,          \
+                                                                    __CUDL_UT(_result) addend),                        \
+         {                                                                                                             \
+             __CUDL_UT(_result) result;                                                                                \
+             __CUDL_TRACE_CALLS(_lhs, _op_name, 1)                                                                     \
+             __CUDL_FUSED_PRODUCT_VALUE(_result, result.value, lhs.value, rhs.value, addend.value)                     \
+             return result;                                                                                            \
+         })                                                                                                            \
+    _def(void __CUDL_FN(_lhs, _op_name, _n)(__CUDL_UT(_result) *dst, const __CUDL_UT(_lhs) *__CUDL_RESTRICT lhs,       \
+                                            const __CUDL_UT(_rhs) *__CUDL_RESTRICT rhs,                                \
+                                            const __CUDL_UT(_result) *addend, size_t n),                               \
+         {                                                                                                             \
+             __CUDL_TRACE_CALLS(_lhs, _op_name##_n, n)                                                                 \
+             for (size_t i = 0; i < n; ++i) {                                                                          \
+                 __CUDL_FUSED_PRODUCT_VALUE(_result, dst[i].value, lhs[i].value, rhs[i].value, addend[i].value)        \
+             }                                                                                                         \
+         })                                                                                                            \
+    _def(void __CUDL_FN(_lhs, _op_name, _n_aligned)(__CUDL_UT(_result) *dst,                                           \
+                                                    const __CUDL_UT(_lhs) *__CUDL_RESTRICT lhs,                        \
+                                                    const __CUDL_UT(_rhs) *__CUDL_RESTRICT rhs,                        \
+                                                    const __CUDL_UT(_result) *addend, size_t n),                       \
+         {                                                                                                             \
+             __CUDL_FN(_lhs, _op_name, _n)(__CUDL_ASSUME_ALIGNED(__CUDL_UT(_result) *, dst),                           \
+                                           __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_lhs) *, lhs),                        \
+                                           __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_rhs) *, rhs),                        \
+                                           __CUDL_ASSUME_ALIGNED(const __CUDL_UT(_result) *, addend), n);              \
+         })
+
+/**
+ * @brief Generators of the Q-format multiplication and division of a fixed-point unit. The __CUDL_FIXED_POINT_*_VALUE
+ * blocks store the rounded result of _lhs and _rhs in _result, and are expanded both in the scalar function and in the
+ * loop of the array one. 64 bits storages need a 128 bits intermediate, so they are rejected at compile time when the
+ * compiler has none. For internal use only.
+ */
+#define __CUDL_FIXED_POINT_MUL_VALUE(_name, _storage, _result, _lhs, _rhs)                                             \
+    {                                                                                                                  \
+        if (sizeof(_storage) <= 4) {                                                                                   \
+            long long product = (long long) (_lhs) * (long long) (_rhs);                                               \
+            _result = (_storage) ((product + (1LL << (__CUDL_FRAC_BITS(_name) - 1))) >> __CUDL_FRAC_BITS(_name));      \
+        } else {                                                                                                       \
+            __CUDL_WIDEST_INT product = (__CUDL_WIDEST_INT) (_lhs) * (_rhs);                                           \
+            _result = (_storage) ((product + (1LL << (__CUDL_FRAC_BITS(_name) - 1))) >> __CUDL_FRAC_BITS(_name));      \
+        }                                                                                                              \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FIXED_POINT_DIV_VALUE(_name, _storage, _result, _lhs, _rhs)                                             \
+    {                                                                                                                  \
+        if (sizeof(_storage) <= 4) {                                                                                   \
+            long long dividend = (long long) (_lhs) * (1LL << __CUDL_FRAC_BITS(_name));                                \
+            long long divisor = (long long) (_rhs);                                                                    \
+            long long half = (dividend < 0) == (divisor < 0) ? divisor / 2 : -(divisor / 2);                           \
+            _result = (_storage) ((dividend + half) / divisor);                                                        \
+        } else {                                                                                                       \
+            __CUDL_WIDEST_INT dividend =                                                                               \
+                    (__CUDL_WIDEST_INT) (_lhs) * ((__CUDL_WIDEST_INT) 1 << __CUDL_FRAC_BITS(_name));                   \
+            __CUDL_WIDEST_INT divisor = (__CUDL_WIDEST_INT) (_rhs);                                                    \
+            __CUDL_WIDEST_INT half = (dividend < 0) == (divisor < 0) ? divisor / 2 : -(divisor / 2);                   \
+            _result = (_storage) ((dividend + half) / divisor);                                                        \
+        }                                                                                                              \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FIXED_POINT_OP(_def, _name, _op_name, _storage, _value)                                                 \
+    __CUDL_STATIC_ASSERT(sizeof(_storage) <= 4 || sizeof(__CUDL_WIDEST_INT) > sizeof(_storage),                        \
+                         "The fixed-point multiplication and division of 64 bits storages need __int128");             \
+    _def(__CUDL_UT(_name) __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, __CUDL_UT(_name) rhs), {      \
+        __CUDL_UT(_name) result;                                                                                       \
+        __CUDL_TRACE_CALLS(_name, _op_name, 1)                                                                         \
+        _value(_name, _storage, result.value, CUDL_GET(lhs), CUDL_GET(rhs))                                            \
+        return result;                                                                                                 \
+    })                                                                                                                 \
+    __CUDL_BINARY_ARRAY_FUNCTIONS(_def, __CUDL_FN(_name, _op_name, _n), __CUDL_UT(_name), __CUDL_UT(_name),            \
+                                  __CUDL_TRACE_CALLS(_name, _op_name##_n, n),                                          \
+                                  _value(_name, _storage, dst[i].value, lhs[i].value, rhs[i].value))
+#define __CUDL_FIXED_POINT_OPERATORS(_def, _name, _storage)                                                            \
+    __CUDL_FIXED_POINT_OP(_def, _name, _qmul, _storage, __CUDL_FIXED_POINT_MUL_VALUE)                                  \
+    __CUDL_FIXED_POINT_OP(_def, _name, _qdiv, _storage, __CUDL_FIXED_POINT_DIV_VALUE)
+
+/**
+ * @brief Generators of the format of a fixed-point unit, of its conversions from and to integers, and of its
+ * conversions to other fixed-point and floating point units. __CUDL_FIXED_POINT_FORMAT defines the
+ * cudl_<name>_frac_bits constant, so it is only expanded by the CUDL_ADD_* or CUDL_DECLARE_* macro of the unit. For
+ * internal use only.
+ */
+#define __CUDL_FIXED_POINT_FORMAT(_name, _storage, _frac_bits)                                                         \
+    __CUDL_STATIC_ASSERT((_frac_bits) >= 1 && (_frac_bits) < sizeof(_storage) * 8 - __CUDL_TYPE_IS_SIGNED(_storage),   \
+                         "The fractional bits of a fixed-point unit must be from 1 to its number of value bits - 1");  \
+    enum { __CUDL_FRAC_BITS(_name) = _frac_bits };
+#define __CUDL_FIXED_POINT_INT_CONVERSIONS(_def, _name, _storage)                                                      \
+    _def(__CUDL_UT(_name) __CUDL_L1STR(__CUDL_AP(_name), _from_int)(_storage input_value), {                           \
+        __CUDL_TRACE_CALLS(_name, _from_int, 1)                                                                        \
+        return __CUDL_AP(_name)((_storage) (input_value * ((_storage) 1 << __CUDL_FRAC_BITS(_name))));                 \
+    })                                                                                                                 \
+    _def(_storage __CUDL_L1STR(__CUDL_AP(_name), _to_int)(__CUDL_UT(_name) value), {                                   \
+        __CUDL_TRACE_CALLS(_name, _to_int, 1)                                                                          \
+        return (_storage) (CUDL_GET(value) / ((_storage) 1 << __CUDL_FRAC_BITS(_name)));                               \
+    })
+#define __CUDL_FIXED_POINT_CONVERSION_FRACTION_FACTOR(_def, _from, _to, _explicative, _n, _d)                          \
+    _def(__CUDL_UT(_to) __CUDL_L1STR(__CUDL_AP(_explicative), _to)(__CUDL_UT(_from) from_value), {                     \
+        __CUDL_WIDEST_INT numerator = (__CUDL_WIDEST_INT) CUDL_GET(from_value) * (_n);                                 \
+        __CUDL_WIDEST_INT denominator = (_d);                                                                          \
+        __CUDL_UT(_to) to_value;                                                                                       \
+        const int to_bits = __CUDL_FRAC_BITS(_to);                                                                     \
+        const int from_bits = __CUDL_FRAC_BITS(_from);                                                                 \
+        numerator *= (__CUDL_WIDEST_INT) 1 << (to_bits > from_bits ? to_bits - from_bits : 0);                         \
+        denominator *= (__CUDL_WIDEST_INT) 1 << (from_bits > to_bits ? from_bits - to_bits : 0);                       \
+        to_value.value = (numerator + (numerator < 0 ? -(denominator / 2) : denominator / 2)) / denominator;           \
+        __CUDL_TRACE_CONVERSION(_from, _to, _explicative, to_value.value, (long double) numerator / denominator)       \
+        return to_value;                                                                                               \
+    })                                                                                                                 \
+    __CUDL_UNARY_ARRAY_FUNCTIONS(_def, __CUDL_ARRAY_FN(__CUDL_L1STR(__CUDL_AP(_explicative), _to)), __CUDL_UT(_to),    \
+                                 __CUDL_UT(_from), __CUDL_TRACE_CALLS(_from, _explicative##_to##_n, n),                \
+                                 dst[i] = __CUDL_L1STR(__CUDL_AP(_explicative), _to)(src[i]))
+#define __CUDL_FIXED_POINT_FLOAT_CONVERSIONS(_def, _fixed, _float, _to_float, _to_fixed)                               \
+    _def(__CUDL_UT(_float) __CUDL_L1STR(__CUDL_AP(_to_float), _float)(__CUDL_UT(_fixed) value), {                      \
+        __CUDL_UT(_float) result;                                                                                      \
+        __CUDL_TRACE_CALLS(_fixed, _to_float##_float, 1)                                                               \
+        result.value = (__CUDL_STORAGE(_float)) CUDL_GET(value) *                                                      \
+                       ((__CUDL_STORAGE(_float)) 1 / (__CUDL_STORAGE(_float)) (1LL << __CUDL_FRAC_BITS(_fixed)));      \
+        return result;                                                                                                 \
+    })                                                                                                                 \
+    _def(__CUDL_UT(_fixed) __CUDL_L1STR(__CUDL_AP(_to_fixed), _fixed)(__CUDL_UT(_float) value), {                      \
+        const __CUDL_STORAGE(_float) half = (__CUDL_STORAGE(_float)) 1 / 2;                                            \
+        const __CUDL_STORAGE(_float) scale = (__CUDL_STORAGE(_float)) (1LL << __CUDL_FRAC_BITS(_fixed));               \
+        __CUDL_UT(_fixed) result;                                                                                      \
+        result.value = (__CUDL_STORAGE(_fixed)) (long long) (CUDL_GET(value) * scale +                                 \
+                                                             (CUDL_GET(value) < 0 ? -half : half));                    \
+        __CUDL_TRACE_CONVERSION(_float, _fixed, _to_fixed, result.value,                                               \
+                                (long double) CUDL_GET(value) * (1LL << __CUDL_FRAC_BITS(_fixed)))                     \
+        return result;                                                                                                 \
+    })                                                                                                                 \
+    __CUDL_UNARY_ARRAY_FUNCTIONS(_def, __CUDL_ARRAY_FN(__CUDL_L1STR(__CUDL_AP(_to_float), _float)), __CUDL_UT(_float), \
+                                 __CUDL_UT(_fixed), __CUDL_TRACE_CALLS(_fixed, _to_float##_float##_n, n),              \
+                                 dst[i] = __CUDL_L1STR(__CUDL_AP(_to_float), _float)(src[i]))                          \
+    __CUDL_UNARY_ARRAY_FUNCTIONS(_def, __CUDL_ARRAY_FN(__CUDL_L1STR(__CUDL_AP(_to_fixed), _fixed)), __CUDL_UT(_fixed), \
+                                 __CUDL_UT(_float), __CUDL_TRACE_CALLS(_float, _to_fixed##_fixed##_n, n),              \
+                                 dst[i] = __CUDL_L1STR(__CUDL_AP(_to_fixed), _fixed)(src[i]))
+
+/**
+ * @brief Power of ten of the SI prefixes accepted by #CUDL_ADD_SI_FAMILY, the empty prefix being the base unit, and
+ * 10^_e for _e from 0 to 18 as a long long constant expression (1 for a negative _e). For internal use only.
+ */
+#define __CUDL_SI_EXPONENT_T 12   // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_G 9    // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_M 6    // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_k 3    // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_h 2    // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_ 0     // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_d (-1) // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_c (-2) // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_m (-3) // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_u (-6) // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_n (-9) // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_p (-12)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_EXPONENT_f (-15)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_POW10(_e)                                                                                            \
+    ((_e) <= 0 ? 1LL                                                                                                   \
+               : ((_e) & 1 ? 10LL : 1LL) * ((_e) & 2 ? 100LL : 1LL) * ((_e) & 4 ? 10000LL : 1LL) *                     \
+                         ((_e) & 8 ? 100000000LL : 1LL) *                                                              \
+                         ((_e) & 16 ? 10000000000000000LL : 1LL))// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Generators of #CUDL_ADD_SI_FAMILY. The family is given to the __CUDL_FOR_EACH callbacks as a (base, type) or
+ * a (base, coarse prefix) tuple, which is unpacked by one macro level and pasted by the next one, so the arguments are
+ * expanded before being pasted. __CUDL_SI_PAIRS_<n> pairs the first of n prefixes with each of the following ones,
+ * then recurses on the following ones, so every pair of units is generated once, the coarse one first. For internal
+ * use only.
+ */
+#define __CUDL_SI_FIRST(_first, _second) _first  // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_SECOND(_first, _second) _second// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_UNIT(_family, _prefix)                                                                               \
+    __CUDL_SI_UNIT_EXPAND(__CUDL_SI_FIRST _family, __CUDL_SI_SECOND _family,                                           \
+                          _prefix)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_UNIT_EXPAND(_base, _type, _prefix)                                                                   \
+    __CUDL_SI_UNIT_NAMED(_prefix, _base, _type)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_UNIT_NAMED(_prefix, _base, _type)                                                                    \
+    __CUDL_SI_UNIT_OPERATORS(_prefix##_base, _type)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_UNIT_OPERATORS(_name, _type)                                                                         \
+    __CUDL_UNIT_TYPE(_name, _type)                                                                                     \
+    __CUDL_UNIT_INIT(__CUDL_INLINE_CONSTEXPR, _name, _type, __CUDL_NOP)                                                \
+    __CUDL_COMMON_OPERATORS(__CUDL_INLINE_CONSTEXPR, _name, _type)                                                     \
+    __CUDL_COMMON_ARRAY_OPERATORS(__CUDL_INLINE, _name, _type)
+#define __CUDL_SI_PAIR(_family, _fine_prefix)                                                                          \
+    __CUDL_SI_PAIR_EXPAND(__CUDL_SI_FIRST _family, __CUDL_SI_SECOND _family,                                           \
+                          _fine_prefix)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIR_EXPAND(_base, _coarse_prefix, _fine_prefix)                                                     \
+    __CUDL_SI_PAIR_NAMED(_base, _coarse_prefix, _fine_prefix)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIR_NAMED(_base, _coarse_prefix, _fine_prefix)                                                      \
+    __CUDL_SI_PAIR_UNITS(_coarse_prefix##_base, _fine_prefix##_base, __CUDL_SI_EXPONENT_##_coarse_prefix,              \
+                         __CUDL_SI_EXPONENT_##_fine_prefix)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIR_UNITS(_coarse, _fine, _coarse_exponent, _fine_exponent)                                         \
+    __CUDL_STATIC_ASSERT((_coarse_exponent) > (_fine_exponent) && (_coarse_exponent) - (_fine_exponent) <= 18,         \
+                         "The prefixes of a SI family must be in descending order and at most 10^18 apart");           \
+    __CUDL_CONVERSION_FRACTION_FACTOR(__CUDL_INLINE_CONSTEXPR, _coarse, _fine, from_##_coarse##_to_,                   \
+                                      __CUDL_SI_POW10((_coarse_exponent) - (_fine_exponent)), 1)                       \
+    __CUDL_CONVERSION_FRACTION_FACTOR(__CUDL_INLINE_CONSTEXPR, _fine, _coarse, from_##_fine##_to_, 1,                  \
+                                      __CUDL_SI_POW10((_coarse_exponent) - (_fine_exponent)))                          \
+    __CUDL_SI_MIXED_OP(_coarse, _fine, _add, +)                                                                        \
+    __CUDL_SI_MIXED_OP(_coarse, _fine, _sub, -)                                                                        \
+    __CUDL_SI_MIXED_RELATIONAL_OP(_coarse, _fine, _eq, ==)                                                             \
+    __CUDL_SI_MIXED_RELATIONAL_OP(_coarse, _fine, _ne, !=)                                                             \
+    __CUDL_SI_MIXED_RELATIONAL_OP(_coarse, _fine, _gt, >)                                                              \
+    __CUDL_SI_MIXED_RELATIONAL_OP(_coarse, _fine, _ge, >=)                                                             \
+    __CUDL_SI_MIXED_RELATIONAL_OP(_coarse, _fine, _lt, <)                                                              \
+    __CUDL_SI_MIXED_RELATIONAL_OP(_coarse, _fine, _le, <=)
+#define __CUDL_SI_MIXED_OP(_coarse, _fine, _op_name, _op)                                                              \
+    __CUDL_INLINE_CONSTEXPR(__CUDL_UT(_fine) __CUDL_FN(_coarse, _op_name, _##_fine)(__CUDL_UT(_coarse) lhs,            \
+                                                                                     __CUDL_UT(_fine) rhs),            \
+                            {                                                                                          \
+                                __CUDL_TRACE_CALLS(_coarse, _op_name##_##_fine, 1)                                     \
+                                __CUDL_UT(_fine) result = __CUDL_L1STR(__CUDL_AP(from_##_coarse##_to_), _fine)(lhs);   \
+                                result.value = CUDL_GET(result) _op CUDL_GET(rhs);                                     \
+                                return result;                                                                         \
+                            })                                                                                         \
+    __CUDL_INLINE_CONSTEXPR(__CUDL_UT(_fine) __CUDL_FN(_fine, _op_name, _##_coarse)(__CUDL_UT(_fine) lhs,              \
+                                                                                     __CUDL_UT(_coarse) rhs),          \
+                            {                                                                                          \
+                                __CUDL_TRACE_CALLS(_fine, _op_name##_##_coarse, 1)                                     \
+                                __CUDL_UT(_fine) result = __CUDL_L1STR(__CUDL_AP(from_##_coarse##_to_), _fine)(rhs);   \
+                                result.value = CUDL_GET(lhs) _op CUDL_GET(result);                                     \
+                                return result;                                                                         \
+                            })
+#define __CUDL_SI_MIXED_RELATIONAL_OP(_coarse, _fine, _op_name, _op)                                                   \
+    __CUDL_INLINE_CONSTEXPR(bool __CUDL_FN(_coarse, _op_name, _##_fine)(__CUDL_UT(_coarse) lhs, __CUDL_UT(_fine) rhs), \
+                            {                                                                                          \
+                                __CUDL_TRACE_CALLS(_coarse, _op_name##_##_fine, 1)                                     \
+                                return CUDL_GET(__CUDL_L1STR(__CUDL_AP(from_##_coarse##_to_), _fine)(lhs))             \
+                                        _op CUDL_GET(rhs);                                                             \
+                            })                                                                                         \
+    __CUDL_INLINE_CONSTEXPR(bool __CUDL_FN(_fine, _op_name, _##_coarse)(__CUDL_UT(_fine) lhs, __CUDL_UT(_coarse) rhs), \
+                            {                                                                                          \
+                                __CUDL_TRACE_CALLS(_fine, _op_name##_##_coarse, 1)                                     \
+                                return CUDL_GET(lhs) _op CUDL_GET(                                                     \
+                                        __CUDL_L1STR(__CUDL_AP(from_##_coarse##_to_), _fine)(rhs));                    \
+                            })
+#define __CUDL_SI_PAIRS_1(_base, _prefix)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_2(_base, _prefix, ...)                                                                         \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_1(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_3(_base, _prefix, ...)                                                                         \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_2(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_4(_base, _prefix, ...)                                                                         \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_3(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_5(_base, _prefix, ...)                                                                         \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_4(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_6(_base, _prefix, ...)                                                                         \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_5(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_7(_base, _prefix, ...)                                                                         \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_6(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_8(_base, _prefix, ...)                                                                         \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_7(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_9(_base, _prefix, ...)                                                                         \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_8(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_10(_base, _prefix, ...)                                                                        \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_9(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_11(_base, _prefix, ...)                                                                        \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_10(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_12(_base, _prefix, ...)                                                                        \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_11(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_13(_base, _prefix, ...)                                                                        \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_12(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_14(_base, _prefix, ...)                                                                        \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_13(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_15(_base, _prefix, ...)                                                                        \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_14(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SI_PAIRS_16(_base, _prefix, ...)                                                                        \
+    __CUDL_FOR_EACH(__CUDL_SI_PAIR, (_base, _prefix), __VA_ARGS__)                                                     \
+    __CUDL_SI_PAIRS_15(_base, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
 #endif                   //DOXYGEN_SHOULD_SKIP_THIS
 
 /**
@@ -54,14 +1414,8 @@ extern "C" {
  * @param _op Should be a macro or function that can take _type as an input and returns _type as a value.
  */
 #define CUDL_ADD_UNIT_WITH_OP(_name, _type, _op)                                                                       \
-    typedef struct {                                                                                                   \
-        _type value;                                                                                                   \
-    } __CUDL_UT(_name);                                                                                                \
-    static inline __CUDL_UT(_name) __CUDL_AP(_name)(_type input_value) {                                               \
-        __CUDL_UT(_name) ct;                                                                                           \
-        ct.value = _op(input_value);                                                                                   \
-        return ct;                                                                                                     \
-    }
+    __CUDL_UNIT_TYPE(_name, _type)                                                                                     \
+    __CUDL_UNIT_INIT(__CUDL_INLINE_CONSTEXPR, _name, _type, _op)
 
 /**
  * @brief Function to add a unit.
@@ -77,9 +1431,36 @@ extern "C" {
  */
 #define CUDL_GET(_value) (_value).value
 
+/**
+ * @brief Initializer of a unit value from a constant, usable where the init function cannot be called: in the
+ * initializer of a static or global variable, e.g. static const cudl_mv_t thresholds[] = {CUDL_CONST(mv, 3300),
+ * CUDL_CONST(mv, 3600)}. Such tables are then built by the compiler and placed in read-only memory (.rodata or flash)
+ * instead of being initialized at startup. The value is converted to cudl_<name>_storage_t, the typedef of the storage
+ * type added with the unit.
+ * @include const_unit_example.c
+ * @param _name The unit. It is expected to be the same as the _name param used with CUDL_ADD_UNIT.
+ * @param _literal The value, a constant expression.
+ */
+#define CUDL_CONST(_name, _literal) {(__CUDL_STORAGE(_name)) (_literal)}
+
+/**
+ * @brief Version of #CUDL_CONST for the units added with #CUDL_ADD_UNIT_WITH_OP, applying their init op to the value.
+ * @include const_unit_example.c
+ * @param _name The unit. It is expected to be the same as the _name param used with CUDL_ADD_UNIT_WITH_OP.
+ * @param _op The init op of the unit. It must be a macro expanding to a constant expression when given a constant.
+ * @param _literal The value, a constant expression.
+ */
+#define CUDL_CONST_WITH_OP(_name, _op, _literal) {(__CUDL_STORAGE(_name)) _op(_literal)}
+
 /**
  * @brief This function allows to a conversion from one unit to another. It does this with a fraction. The from value
  * will be multiplied by _n and divided by _d.
+ *
+ * An array version with a _n suffix (and its _n_aligned variant, see #CUDL_ADD_NO_TRANSFORM_ARRAY_OP) is also added,
+ * e.g. cudl_from_mv_to_v_n(dst, src, n). For integer units, it gives exactly the same results as the scalar
+ * conversion: _d stays a compile time constant, so the compiler replaces the division by a multiply-high and shift by
+ * the reciprocal, in the scalar and in the vectorized loop. For floating point units, the values are multiplied by a
+ * single scale factor _n / _d computed before the loop, which may differ from the scalar conversion in the last bit.
  * @param _from The unit to convert from. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
  * @param _to The unit to convert to. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
  * @param _explicative String to append to the beginning of the function name to make it unique.
@@ -87,11 +1468,7 @@ extern "C" {
  * @param _d Denominator of the fraction.
  */
 #define CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR(_from, _to, _explicative, _n, _d)                                 \
-    static inline __CUDL_UT(_to) __CUDL_L1STR(__CUDL_AP(_explicative), _to)(__CUDL_UT(_from) from_value) {             \
-        __CUDL_UT(_to) to_value;                                                                                       \
-        to_value.value = (from_value.value * _n) / _d;                                                                 \
-        return to_value;                                                                                               \
-    }
+    __CUDL_CONVERSION_FRACTION_FACTOR(__CUDL_INLINE_CONSTEXPR, _from, _to, _explicative, _n, _d)
 
 /**
  * @brief Simplified version of the #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR to have a default explicative.
@@ -114,6 +1491,125 @@ extern "C" {
  */
 #define CUDL_ADD_CONVERSION_FACTOR(_from, _to, _factor) CUDL_ADD_CONVERSION_FRACTION_FACTOR(_from, _to, _factor, 1)
 
+/**
+ * @brief Integer only alternative to #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR that cannot overflow in the middle
+ * of the conversion and uses the cheapest instruction sequence for the fraction. The fraction _n / _d is reduced to
+ * lowest terms at compile time. Then:
+ * - if the reduced numerator is 1, the value is only divided;
+ * - if the reduced denominator is 1, the value is only multiplied;
+ * - otherwise, the product is computed in a wider type (64 bits for storages of 32 bits or less when the numerator
+ *   allows it, 128 bits when the compiler supports it otherwise) before dividing.
+ *
+ * Divisions and multiplications by a power of two are then emitted as shifts by the compiler. The result is only
+ * truncated when it does not fit in the _to storage type. Like #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR, the
+ * array versions with the _n and _n_aligned suffixes are also added. The selection is done with constants that the
+ * optimizer folds, so this is meant to be used with optimizations enabled. A static assertion rejects float storages.
+ * @include add_reduced_conversion_example.c
+ * @param _from The unit to convert from. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _to The unit to convert to. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _explicative String to append to the beginning of the function name to make it unique.
+ * @param _n Numerator of the fraction. Must be a positive integer constant.
+ * @param _d Denominator of the fraction. Must be a positive integer constant.
+ */
+#define CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR(_from, _to, _explicative, _n, _d)                         \
+    __CUDL_REDUCED_CONVERSION_FRACTION_FACTOR(__CUDL_INLINE_CONSTEXPR, _from, _to, _explicative, _n, _d)
+
+/**
+ * @brief Simplified version of the #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR to have a default explicative.
+ * It adds the same function names as #CUDL_ADD_CONVERSION_FRACTION_FACTOR, so it can be used as a drop-in replacement
+ * for integer units.
+ * @include add_reduced_conversion_example.c
+ * @param _from See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param __to See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(_from, __to, _n, _d)                                               \
+    CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR(_from, __to, from_##_from##_to_, _n, _d)
+
+/**
+ * @brief Adds an affine conversion function from the _from unit to the _to unit: to = from * _scale_n / _scale_d +
+ * _offset, like converting degrees Celsius to Fahrenheit (9, 5, 32) or raw ADC counts to volts with a bias. The
+ * function is named cudl_<explicative><to>, and its array versions with the _n and _n_aligned suffixes are also added.
+ * The scaling and the offset are done in one step, with a single rounding:
+ * - for float and double _to storages, the scale is folded to a constant and the conversion is a fused multiply-add,
+ *   a single FMA instruction when the target has one (e.g. -mfma or -march=native on x86-64). It is computed in float
+ *   when _to is a float and the _from storage is not larger than 4 bytes, in double otherwise;
+ * - for integer storages, from * _scale_n + _offset * _scale_d is computed in 64 bits (128 bits for 64 bits storages
+ *   when the compiler supports it), then divided by _scale_d rounding to nearest, ties toward positive infinity. When
+ *   _scale_d is a power of two, the whole conversion is a multiply-add and an arithmetic shift, otherwise the compiler
+ *   replaces the division by a multiplication;
+ * - from a float or double to an integer storage, the value is computed in double and rounded the same way.
+ *
+ * The array versions have no branch once the conversion is inlined and are vectorized like the other array functions.
+ * The result is only truncated when it does not fit in the _to storage type.
+ * @include add_affine_conversion_example.c
+ * @param _from The unit to convert from. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _to The unit to convert to. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _explicative String to append to the beginning of the function name to make it unique.
+ * @param _scale_n Numerator of the scale. It may be negative, and must be an integer constant for integer storages.
+ * @param _scale_d Denominator of the scale. Must be a positive integer constant.
+ * @param _offset Offset added after scaling, in _to units. Must be an integer constant for integer _to storages.
+ */
+#define CUDL_ADD_EXPLICIT_AFFINE_CONVERSION(_from, _to, _explicative, _scale_n, _scale_d, _offset)                     \
+    __CUDL_AFFINE_CONVERSION(__CUDL_INLINE_CONSTEXPR, _from, _to, _explicative, _scale_n, _scale_d, _offset)
+
+/**
+ * @brief Simplified version of the #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION to have a default explicative. It adds the same
+ * function names as #CUDL_ADD_CONVERSION_FRACTION_FACTOR, e.g. cudl_from_celsius_to_fahrenheit.
+ * @include add_affine_conversion_example.c
+ * @param _from See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param __to See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _scale_n See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _scale_d See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _offset See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ */
+#define CUDL_ADD_AFFINE_CONVERSION(_from, __to, _scale_n, _scale_d, _offset)                                           \
+    CUDL_ADD_EXPLICIT_AFFINE_CONVERSION(_from, __to, from_##_from##_to_, _scale_n, _scale_d, _offset)
+
+/**
+ * @brief Initializer of a _to value converted from the constant _value of the _from unit, usable in static
+ * initializers like #CUDL_CONST. The result is the one of the conversion function added by
+ * #CUDL_ADD_CONVERSION_FRACTION_FACTOR with the same arguments, e.g. static const cudl_v_t limit =
+ * CUDL_CONST_CONVERSION_FRACTION_FACTOR(mv, v, 3300, 1, 1000) gives the same value as
+ * cudl_from_mv_to_v(cudl_mv(3300)), but is computed by the compiler.
+ * @include const_unit_example.c
+ * @param _from See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _value The raw value in the _from unit, a constant expression.
+ * @param _n See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_CONST_CONVERSION_FRACTION_FACTOR(_from, _to, _value, _n, _d)                                              \
+    {__CUDL_CONST_CONVERSION_FRACTION_FACTOR(_from, _to, _value, _n, _d)}
+
+/**
+ * @brief Static initializer version of the conversion added by #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR, see
+ * #CUDL_CONST_CONVERSION_FRACTION_FACTOR.
+ * @param _from See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _value The raw value in the _from unit, a constant expression.
+ * @param _n See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_CONST_REDUCED_CONVERSION_FRACTION_FACTOR(_from, _to, _value, _n, _d)                                      \
+    {__CUDL_CONST_REDUCED_CONVERSION_FRACTION_FACTOR(_from, _to, _value, _n, _d)}
+
+/**
+ * @brief Static initializer version of the conversion added by #CUDL_ADD_AFFINE_CONVERSION, with the same rounding,
+ * see #CUDL_CONST_CONVERSION_FRACTION_FACTOR. When the conversion is computed with a fused multiply-add, the compiler
+ * must be able to fold __builtin_fma in a constant expression, which GCC does.
+ * @include const_unit_example.c
+ * @param _from See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _value The raw value in the _from unit, a constant expression.
+ * @param _scale_n See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _scale_d See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _offset See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ */
+#define CUDL_CONST_AFFINE_CONVERSION(_from, _to, _value, _scale_n, _scale_d, _offset)                                  \
+    {__CUDL_CONST_AFFINE_CONVERSION(_from, _to, _value, _scale_n, _scale_d, _offset)}
+
 /**
  * @brief Macro to add an operation that has a left hand side and right side of the same type and does not change the
  * units. For example, adding 2 variables of volts together still results in volts, but multiplying would result in
@@ -124,12 +1620,7 @@ extern "C" {
  * @param _op The op to use between the 2 values.
  */
 #define CUDL_ADD_NO_TRANSFORM_OP(_name, _op_name, _op)                                                                 \
-    static inline __CUDL_UT(_name)                                                                                     \
-            __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, __CUDL_UT(_name) rhs) {                     \
-        __CUDL_UT(_name) result;                                                                                       \
-        result.value = CUDL_GET(lhs) _op CUDL_GET(rhs);                                                                \
-        return result;                                                                                                 \
-    }
+    __CUDL_NO_TRANSFORM_OP(__CUDL_INLINE_CONSTEXPR, _name, _op_name, _op)
 
 /**
  * @brief Macro to add an operation that has a left hand side of the unit type and a unitless right side. This is a type
@@ -141,11 +1632,7 @@ extern "C" {
  * @param _type The underlying storage type to use.
  */
 #define CUDL_ADD_NO_UNIT_OP(_name, _op_name, _op, _type)                                                               \
-    static inline __CUDL_UT(_name) __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, _type rhs) {         \
-        __CUDL_UT(_name) result;                                                                                       \
-        result.value = CUDL_GET(lhs) _op rhs;                                                                          \
-        return result;                                                                                                 \
-    }
+    __CUDL_NO_UNIT_OP(__CUDL_INLINE_CONSTEXPR, _name, _op_name, _op, _type)
 
 /**
  * @brief Macro to add a relational operation (==, !=, >, >=, <, <=). The result of these operations is always a
@@ -155,10 +1642,7 @@ extern "C" {
  * @param _op_name The core name of function to add.
  * @param _op The op to use between the 2 values.
  */
-#define CUDL_ADD_RELATIONAL_OP(_name, _op_name, _op)                                                                   \
-    static inline bool __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) lhs, __CUDL_UT(_name) rhs) {          \
-        return CUDL_GET(lhs) _op CUDL_GET(rhs);                                                                        \
-    }
+#define CUDL_ADD_RELATIONAL_OP(_name, _op_name, _op) __CUDL_RELATIONAL_OP(__CUDL_INLINE_CONSTEXPR, _name, _op_name, _op)
 
 /**
  * @brief Add the bitwise not operator for a given unit.
@@ -166,46 +1650,1252 @@ extern "C" {
  * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
  * @param _op_name The core name of function to add.
  */
-#define CUDL_ADD_BITWISE_NOT_OP(_name, _op_name)                                                                       \
-    static inline __CUDL_UT(_name) __CUDL_L1STR(__CUDL_AP(_name), _op_name)(__CUDL_UT(_name) value) {                  \
-        value.value = ~value.value;                                                                                    \
-        return value;                                                                                                  \
-    }
+#define CUDL_ADD_BITWISE_NOT_OP(_name, _op_name) __CUDL_BITWISE_NOT_OP(__CUDL_INLINE_CONSTEXPR, _name, _op_name)
 
 /**
  * @brief Helper macro to add operators that are supported by all types.
  * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
  * @param _type The underlying storage type to use.
  */
-#define CUDL_ADD_COMMON_OPERATORS(_name, _type)                                                                        \
-    CUDL_ADD_NO_TRANSFORM_OP(_name, _add, +)                                                                           \
-    CUDL_ADD_NO_TRANSFORM_OP(_name, _sub, -)                                                                           \
-    CUDL_ADD_NO_UNIT_OP(_name, _mul, *, _type)                                                                         \
-    CUDL_ADD_NO_UNIT_OP(_name, _div, /, _type)                                                                         \
-    CUDL_ADD_RELATIONAL_OP(_name, _eq, ==)                                                                             \
-    CUDL_ADD_RELATIONAL_OP(_name, _ne, !=)                                                                             \
-    CUDL_ADD_RELATIONAL_OP(_name, _gt, >)                                                                              \
-    CUDL_ADD_RELATIONAL_OP(_name, _ge, >=)                                                                             \
-    CUDL_ADD_RELATIONAL_OP(_name, _lt, <)                                                                              \
-    CUDL_ADD_RELATIONAL_OP(_name, _le, <=)
+#define CUDL_ADD_COMMON_OPERATORS(_name, _type) __CUDL_COMMON_OPERATORS(__CUDL_INLINE_CONSTEXPR, _name, _type)
 
 /**
  * @brief Helper macro to add operators that are supported by integer types.
  * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
  * @param _type The underlying storage type to use.
  */
-#define CUDL_ADD_INTEGER_OPERATORS(_name, _type)                                                                       \
-    CUDL_ADD_COMMON_OPERATORS(_name, _type)                                                                            \
-    CUDL_ADD_NO_UNIT_OP(_name, _mod, %, _type)                                                                         \
-    CUDL_ADD_NO_UNIT_OP(_name, _and, &, _type)                                                                         \
-    CUDL_ADD_NO_UNIT_OP(_name, _or, |, _type)                                                                          \
-    CUDL_ADD_NO_UNIT_OP(_name, _xor, ^, _type)                                                                         \
-    CUDL_ADD_NO_UNIT_OP(_name, _bsl, <<, _type)                                                                        \
-    CUDL_ADD_NO_UNIT_OP(_name, _bsr, >>, _type)                                                                        \
-    CUDL_ADD_BITWISE_NOT_OP(_name, _bnot)
+#define CUDL_ADD_INTEGER_OPERATORS(_name, _type) __CUDL_INTEGER_OPERATORS(__CUDL_INLINE_CONSTEXPR, _name, _type)
 
-#ifdef __cplusplus
-}
+/**
+ * @brief Array version of #CUDL_ADD_NO_TRANSFORM_OP. Adds a function named like the scalar one with a _n suffix that
+ * applies the op element by element, as well as a _n_aligned variant for arrays aligned on #CUDL_ARRAY_ALIGNMENT. The
+ * arrays are restrict qualified: dst must not overlap lhs or rhs. The loop has no dependency between iterations so it
+ * is auto-vectorized by GCC and Clang (-O3, or -O2 with -ftree-vectorize).
+ * @include add_array_op_example.c
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of function to add.
+ * @param _op The op to use between the 2 values.
+ */
+#define CUDL_ADD_NO_TRANSFORM_ARRAY_OP(_name, _op_name, _op)                                                           \
+    __CUDL_NO_TRANSFORM_ARRAY_OP(__CUDL_INLINE, _name, _op_name, _op)
+
+/**
+ * @brief Array version of #CUDL_ADD_NO_UNIT_OP. Every element of lhs is combined with the same unitless rhs. See
+ * #CUDL_ADD_NO_TRANSFORM_ARRAY_OP for the generated functions.
+ * @include add_array_op_example.c
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of function to add.
+ * @param _op The op to use between the 2 values.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_NO_UNIT_ARRAY_OP(_name, _op_name, _op, _type)                                                         \
+    __CUDL_NO_UNIT_ARRAY_OP(__CUDL_INLINE, _name, _op_name, _op, _type)
+
+/**
+ * @brief Array version of #CUDL_ADD_RELATIONAL_OP. The result of each comparison is written in a bool array. See
+ * #CUDL_ADD_NO_TRANSFORM_ARRAY_OP for the generated functions.
+ * @include add_array_op_example.c
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of function to add.
+ * @param _op The op to use between the 2 values.
+ */
+#define CUDL_ADD_RELATIONAL_ARRAY_OP(_name, _op_name, _op)                                                             \
+    __CUDL_RELATIONAL_ARRAY_OP(__CUDL_INLINE, _name, _op_name, _op)
+
+/**
+ * @brief Array version of #CUDL_ADD_BITWISE_NOT_OP. See #CUDL_ADD_NO_TRANSFORM_ARRAY_OP for the generated functions.
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of function to add.
+ */
+#define CUDL_ADD_BITWISE_NOT_ARRAY_OP(_name, _op_name) __CUDL_BITWISE_NOT_ARRAY_OP(__CUDL_INLINE, _name, _op_name)
+
+/**
+ * @brief Helper macro to add the array version of the operators added by #CUDL_ADD_COMMON_OPERATORS.
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_COMMON_ARRAY_OPERATORS(_name, _type) __CUDL_COMMON_ARRAY_OPERATORS(__CUDL_INLINE, _name, _type)
+
+/**
+ * @brief Helper macro to add the array version of the operators added by #CUDL_ADD_INTEGER_OPERATORS.
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_INTEGER_ARRAY_OPERATORS(_name, _type) __CUDL_INTEGER_ARRAY_OPERATORS(__CUDL_INLINE, _name, _type)
+
+/**
+ * @brief Adds a family of units of the same quantity with different SI prefixes, e.g. kv, v, mv and uv, in a single
+ * line instead of a unit and an operator set per prefix and a conversion per pair of prefixes. For each prefix, the
+ * unit named <prefix><base> is added with the operators of #CUDL_ADD_COMMON_OPERATORS and
+ * #CUDL_ADD_COMMON_ARRAY_OPERATORS. For each pair of units of the family, in both directions:
+ * - a direct conversion, named like the ones of #CUDL_ADD_CONVERSION_FRACTION_FACTOR, e.g. cudl_from_uv_to_v. The power
+ *   of ten between the prefixes is folded to a single constant, so every conversion is a single multiplication (to the
+ *   finer unit) or division (to the coarser unit), never a chain of them with intermediate roundings;
+ * - mixed prefix operations named cudl_<lhs unit>_<op>_<rhs unit>, e.g. cudl_mv_add_uv(mv, uv): add and sub, which
+ *   return the finer unit, and the relational ops eq, ne, gt, ge, lt and le. Only the coarser operand is converted,
+ *   by a multiplication, so nothing is rounded.
+ *
+ * For integer storages, converting to the finer unit overflows when the value times the power of ten between the
+ * prefixes does not fit in _type. The integer only operators of #CUDL_ADD_INTEGER_OPERATORS can be added to a unit of
+ * the family one by one, with #CUDL_ADD_NO_UNIT_OP and #CUDL_ADD_BITWISE_NOT_OP.
+ * @include add_si_family_example.c
+ * @param _base The name of the unit without prefix, e.g. v. The names of the units are <prefix><base>.
+ * @param _type The underlying storage type of all the units of the family.
+ * @param ... The prefixes (1 to 16), from the largest to the smallest, among T, G, M, k, h, d, c, m, u (micro), n, p
+ * and f. The base unit itself is given by an empty prefix at its place, e.g. (v, int32_t, k, , m, u) adds kv, v, mv and
+ * uv, while (s, int64_t, m, u, n) adds ms, us and ns only. The prefixes of two units must be at most 10^18 apart.
+ */
+#define CUDL_ADD_SI_FAMILY(_base, _type, ...)                                                                          \
+    __CUDL_FOR_EACH(__CUDL_SI_UNIT, (_base, _type), __VA_ARGS__)                                                       \
+    __CUDL_L1STR(__CUDL_SI_PAIRS_, __CUDL_COUNT_ARGS(__VA_ARGS__))(_base, __VA_ARGS__)
+
+/**
+ * @brief Macro to add a saturating addition for an integer unit. Instead of wrapping around, the result is clamped to
+ * the range of _type. The clamping is branch free: unsigned storages compare the wrapped result with lhs, signed
+ * storages smaller than int are added as int and clamped, other signed storages are added on 64 bits and clamped and
+ * the 64 bits ones use __builtin_add_overflow. Except for the latter, the array versions (see
+ * #CUDL_ADD_NO_TRANSFORM_ARRAY_OP) are vectorized with SIMD compare and blend, min/max or saturating instructions.
+ * @include add_saturating_op_example.c
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of function to add.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_SATURATING_ADD_OP(_name, _op_name, _type)                                                             \
+    __CUDL_SATURATING_OP(__CUDL_INLINE, _name, _op_name, _type, __CUDL_SATURATING_ADD_VALUE)
+
+/**
+ * @brief Macro to add a saturating subtraction for an integer unit. See #CUDL_ADD_SATURATING_ADD_OP.
+ * @include add_saturating_op_example.c
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of function to add.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_SATURATING_SUB_OP(_name, _op_name, _type)                                                             \
+    __CUDL_SATURATING_OP(__CUDL_INLINE, _name, _op_name, _type, __CUDL_SATURATING_SUB_VALUE)
+
+/**
+ * @brief Macro to add a saturating multiplication of an integer unit by a unitless value. Storages smaller than 64 bits
+ * are multiplied on 64 bits and clamped, 64 bits ones use __builtin_mul_overflow. See #CUDL_ADD_SATURATING_ADD_OP.
+ * @include add_saturating_op_example.c
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of function to add.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_SATURATING_MUL_OP(_name, _op_name, _type)                                                             \
+    __CUDL_SATURATING_NO_UNIT_OP(__CUDL_INLINE, _name, _op_name, _type, __CUDL_SATURATING_MUL_VALUE)
+
+/**
+ * @brief Macro to add a checked operation, built on one of the __builtin_add_overflow, __builtin_sub_overflow or
+ * __builtin_mul_overflow compiler builtins (GCC and Clang). The function stores the wrapped result in *result and
+ * returns true when an overflow happened. The array versions (_n and _n_aligned, see #CUDL_ADD_NO_TRANSFORM_ARRAY_OP)
+ * return true when at least one element overflowed.
+ * @include add_checked_op_example.c
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of function to add.
+ * @param _builtin The overflow builtin to use.
+ */
+#define CUDL_ADD_CHECKED_OP(_name, _op_name, _builtin) __CUDL_CHECKED_OP(__CUDL_INLINE, _name, _op_name, _builtin)
+
+/**
+ * @brief Macro to add a checked operation between a unit and a unitless value. See #CUDL_ADD_CHECKED_OP.
+ * @include add_checked_op_example.c
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of function to add.
+ * @param _builtin The overflow builtin to use.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_CHECKED_NO_UNIT_OP(_name, _op_name, _builtin, _type)                                                  \
+    __CUDL_CHECKED_NO_UNIT_OP(__CUDL_INLINE, _name, _op_name, _builtin, _type)
+
+/**
+ * @brief Helper macro to add saturating versions of the arithmetic operators of an integer unit: _sat_add, _sat_sub
+ * and _sat_mul, with their array versions.
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_SATURATING_OPERATORS(_name, _type) __CUDL_SATURATING_OPERATORS(__CUDL_INLINE, _name, _type)
+
+/**
+ * @brief Helper macro to add checked versions of the arithmetic operators of an integer unit: _checked_add,
+ * _checked_sub and _checked_mul, with their array versions.
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_CHECKED_OPERATORS(_name, _type) __CUDL_CHECKED_OPERATORS(__CUDL_INLINE, _name, _type)
+
+/**
+ * @brief Converts a floating point literal to the raw value of a fixed-point number with _frac_bits fractional bits,
+ * rounded to the nearest. With a constant _literal, this is folded by the compiler and does not need an FPU at runtime.
+ * @param _frac_bits Number of fractional bits of the fixed-point format.
+ * @param _literal The floating point value to convert.
+ */
+#define CUDL_FIXED_POINT_RAW(_frac_bits, _literal)                                                                     \
+    ((long long) ((_literal) * (double) (1LL << (_frac_bits)) + ((_literal) < 0 ? -0.5 : 0.5)))
+
+/**
+ * @brief Function to add a fixed-point (Q-format) unit: the value is stored in an integer, with its _frac_bits lower
+ * bits used as the fractional part. It is meant for targets without an FPU. On top of the unit type and the raw init
+ * function added by #CUDL_ADD_UNIT, it adds:
+ * - a cudl_<name>_frac_bits constant;
+ * - cudl_<name>_from_int and cudl_<name>_to_int, to convert from and to integers (truncating towards zero);
+ *
+ * Use #CUDL_FIXED_POINT to init a value from a literal, and #CUDL_ADD_FIXED_POINT_OPERATORS to add the operators.
+ * @include add_fixed_point_unit_example.c
+ * @param _name The name of the unit. This will be used to define the unit type and the init functions.
+ * @param _storage The underlying integer storage type to use.
+ * @param _frac_bits Number of fractional bits. Must be at least 1 and less than the number of value bits of _storage,
+ * which is checked at compile time.
+ */
+#define CUDL_ADD_FIXED_POINT_UNIT(_name, _storage, _frac_bits)                                                         \
+    CUDL_ADD_UNIT(_name, _storage)                                                                                     \
+    __CUDL_FIXED_POINT_FORMAT(_name, _storage, _frac_bits)                                                             \
+    __CUDL_FIXED_POINT_INT_CONVERSIONS(__CUDL_INLINE, _name, _storage)
+
+/**
+ * @brief Utility macro to init a fixed-point unit added with #CUDL_ADD_FIXED_POINT_UNIT from a floating point literal.
+ * See #CUDL_FIXED_POINT_RAW.
+ * @include add_fixed_point_unit_example.c
+ * @param _name The fixed-point unit. It is expected to be the same as the _name param used with
+ * CUDL_ADD_FIXED_POINT_UNIT.
+ * @param _literal The floating point value.
+ */
+#define CUDL_FIXED_POINT(_name, _literal) __CUDL_AP(_name)(CUDL_FIXED_POINT_RAW(__CUDL_FRAC_BITS(_name), _literal))
+
+/**
+ * @brief Static initializer version of #CUDL_FIXED_POINT, see #CUDL_CONST.
+ * @include const_unit_example.c
+ * @param _name The fixed-point unit. It is expected to be the same as the _name param used with
+ * CUDL_ADD_FIXED_POINT_UNIT.
+ * @param _literal The floating point value, a constant expression.
+ */
+#define CUDL_CONST_FIXED_POINT(_name, _literal)                                                                        \
+    {(__CUDL_STORAGE(_name)) CUDL_FIXED_POINT_RAW(__CUDL_FRAC_BITS(_name), _literal)}
+
+/**
+ * @brief Macro to add the Q-format multiplication of a fixed-point unit by a fixed-point factor of the same format.
+ * The product (or the shifted dividend) is computed on 64 bits for storages of 32 bits or less, and on 128 bits
+ * otherwise, then rounded to the nearest. 64 bits storages are rejected at compile time when the compiler has no
+ * __int128. An array version with a _n suffix (and its _n_aligned variant, see #CUDL_ADD_NO_TRANSFORM_ARRAY_OP)
+ * multiplies two arrays element by element.
+ * @include add_fixed_point_unit_example.c
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with
+ * CUDL_ADD_FIXED_POINT_UNIT.
+ * @param _op_name The core name of function to add.
+ * @param _storage The underlying integer storage type to use.
+ */
+#define CUDL_ADD_FIXED_POINT_MUL_OP(_name, _op_name, _storage)                                                         \
+    __CUDL_FIXED_POINT_OP(__CUDL_INLINE, _name, _op_name, _storage, __CUDL_FIXED_POINT_MUL_VALUE)
+
+/**
+ * @brief Macro to add the Q-format division of a fixed-point unit by a fixed-point divisor of the same format. The
+ * dividend is shifted on a wider integer like the product of #CUDL_ADD_FIXED_POINT_MUL_OP, and the quotient is rounded
+ * to the nearest. The array versions are added like with #CUDL_ADD_FIXED_POINT_MUL_OP.
+ * @include add_fixed_point_unit_example.c
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with
+ * CUDL_ADD_FIXED_POINT_UNIT.
+ * @param _op_name The core name of function to add.
+ * @param _storage The underlying integer storage type to use.
+ */
+#define CUDL_ADD_FIXED_POINT_DIV_OP(_name, _op_name, _storage)                                                         \
+    __CUDL_FIXED_POINT_OP(__CUDL_INLINE, _name, _op_name, _storage, __CUDL_FIXED_POINT_DIV_VALUE)
+
+/**
+ * @brief Helper macro to add the operators of a fixed-point unit: the ones of #CUDL_ADD_COMMON_OPERATORS (_mul and
+ * _div take an integer factor), plus _qmul and _qdiv that take a fixed-point factor (see #CUDL_ADD_FIXED_POINT_MUL_OP).
+ * @param _name The unit to add an op for. It is expected to be the same as the _name param used with
+ * CUDL_ADD_FIXED_POINT_UNIT.
+ * @param _storage The underlying integer storage type to use.
+ */
+#define CUDL_ADD_FIXED_POINT_OPERATORS(_name, _storage)                                                                \
+    CUDL_ADD_COMMON_OPERATORS(_name, _storage)                                                                         \
+    __CUDL_FIXED_POINT_OPERATORS(__CUDL_INLINE, _name, _storage)
+
+/**
+ * @brief Adds a conversion between two fixed-point units, that can have different formats. The raw value is
+ * multiplied by _n, realigned on the fractional bits of _to and divided by _d, on the widest integer available, then
+ * rounded to the nearest. An array version with the _n suffix is also added.
+ * @include add_fixed_point_unit_example.c
+ * @param _from The fixed-point unit to convert from.
+ * @param _to The fixed-point unit to convert to.
+ * @param _n Numerator of the fraction. Must be an integer.
+ * @param _d Denominator of the fraction. Must be a positive integer.
+ */
+#define CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR(_from, _to, _n, _d)                                            \
+    __CUDL_FIXED_POINT_CONVERSION_FRACTION_FACTOR(__CUDL_INLINE, _from, _to, from_##_from##_to_, _n, _d)
+
+/**
+ * @brief Simplified version of #CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR for two fixed-point units that only
+ * differ by their format.
+ * @include add_fixed_point_unit_example.c
+ * @param _from The fixed-point unit to convert from.
+ * @param _to The fixed-point unit to convert to.
+ */
+#define CUDL_ADD_FIXED_POINT_CONVERSION(_from, _to) CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR(_from, _to, 1, 1)
+
+/**
+ * @brief Adds the conversions between a fixed-point unit and a floating point unit holding the same quantity:
+ * cudl_from_<fixed>_to_<float> and cudl_from_<float>_to_<fixed> (rounded to the nearest), and their array versions.
+ * The scale is a power of two computed in the storage type of _float, so a float unit does not need double arithmetic.
+ * @include add_fixed_point_unit_example.c
+ * @param _fixed The fixed-point unit. It is expected to be the same as the _name param used with
+ * CUDL_ADD_FIXED_POINT_UNIT.
+ * @param _float The floating point unit. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ */
+#define CUDL_ADD_FIXED_POINT_FLOAT_CONVERSIONS(_fixed, _float)                                                         \
+    __CUDL_FIXED_POINT_FLOAT_CONVERSIONS(__CUDL_INLINE, _fixed, _float, from_##_fixed##_to_, from_##_float##_to_)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_UNIT_WITH_OP, meant for large unit catalogs. Every CUDL_ADD_* macro
+ * defines static inline functions, so each translation unit including the catalog parses and, without optimizations,
+ * compiles all of them. The CUDL_DECLARE_* macros only define the unit type and declare the functions, which are
+ * defined once with external linkage, either:
+ * - by the matching CUDL_IMPLEMENT_* macros, used in a single source file;
+ * - or by the CUDL_DECLARE_* macros themselves in the single source file that defines CUDL_IMPLEMENTATION before
+ *   including the catalog (and this header).
+ *
+ * Calls then go through the linker, so link time optimization (-flto) is needed to keep them inlined and vectorized in
+ * optimized builds. The CUDL_ADD_* macros without a CUDL_DECLARE_* counterpart keep defining static inline functions.
+ * @include declare_unit_example.c
+ * @param _name See #CUDL_ADD_UNIT_WITH_OP documentation.
+ * @param _type See #CUDL_ADD_UNIT_WITH_OP documentation.
+ * @param _op See #CUDL_ADD_UNIT_WITH_OP documentation.
+ */
+#define CUDL_DECLARE_UNIT_WITH_OP(_name, _type, _op)                                                                   \
+    __CUDL_UNIT_TYPE(_name, _type)                                                                                     \
+    __CUDL_UNIT_INIT(__CUDL_DECLARE, _name, _type, _op)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_UNIT_WITH_OP. It must be used in a single source file, after
+ * the declaration.
+ * @include declare_unit_example.c
+ * @param _name See #CUDL_ADD_UNIT_WITH_OP documentation.
+ * @param _type See #CUDL_ADD_UNIT_WITH_OP documentation.
+ * @param _op See #CUDL_ADD_UNIT_WITH_OP documentation.
+ */
+#define CUDL_IMPLEMENT_UNIT_WITH_OP(_name, _type, _op) __CUDL_UNIT_INIT(__CUDL_IMPLEMENT, _name, _type, _op)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_UNIT, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_UNIT documentation.
+ * @param _type See #CUDL_ADD_UNIT documentation.
+ */
+#define CUDL_DECLARE_UNIT(_name, _type) CUDL_DECLARE_UNIT_WITH_OP(_name, _type, __CUDL_NOP)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_UNIT, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_UNIT documentation.
+ * @param _type See #CUDL_ADD_UNIT documentation.
+ */
+#define CUDL_IMPLEMENT_UNIT(_name, _type) CUDL_IMPLEMENT_UNIT_WITH_OP(_name, _type, __CUDL_NOP)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _explicative See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_DECLARE_EXPLICIT_CONVERSION_FRACTION_FACTOR(_from, _to, _explicative, _n, _d)                             \
+    __CUDL_CONVERSION_FRACTION_FACTOR(__CUDL_DECLARE, _from, _to, _explicative, _n, _d)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_EXPLICIT_CONVERSION_FRACTION_FACTOR, see
+ * #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _explicative See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_IMPLEMENT_EXPLICIT_CONVERSION_FRACTION_FACTOR(_from, _to, _explicative, _n, _d)                           \
+    __CUDL_CONVERSION_FRACTION_FACTOR(__CUDL_IMPLEMENT, _from, _to, _explicative, _n, _d)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_CONVERSION_FRACTION_FACTOR, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_CONVERSION_FRACTION_FACTOR documentation.
+ * @param __to See #CUDL_ADD_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_DECLARE_CONVERSION_FRACTION_FACTOR(_from, __to, _n, _d)                                                   \
+    __CUDL_CONVERSION_FRACTION_FACTOR(__CUDL_DECLARE, _from, __to, from_##_from##_to_, _n, _d)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_CONVERSION_FRACTION_FACTOR, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_CONVERSION_FRACTION_FACTOR documentation.
+ * @param __to See #CUDL_ADD_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_IMPLEMENT_CONVERSION_FRACTION_FACTOR(_from, __to, _n, _d)                                                 \
+    __CUDL_CONVERSION_FRACTION_FACTOR(__CUDL_IMPLEMENT, _from, __to, from_##_from##_to_, _n, _d)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_CONVERSION_FACTOR, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_CONVERSION_FACTOR documentation.
+ * @param _to See #CUDL_ADD_CONVERSION_FACTOR documentation.
+ * @param _factor See #CUDL_ADD_CONVERSION_FACTOR documentation.
+ */
+#define CUDL_DECLARE_CONVERSION_FACTOR(_from, _to, _factor)                                                            \
+    CUDL_DECLARE_CONVERSION_FRACTION_FACTOR(_from, _to, _factor, 1)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_CONVERSION_FACTOR, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_CONVERSION_FACTOR documentation.
+ * @param _to See #CUDL_ADD_CONVERSION_FACTOR documentation.
+ * @param _factor See #CUDL_ADD_CONVERSION_FACTOR documentation.
+ */
+#define CUDL_IMPLEMENT_CONVERSION_FACTOR(_from, _to, _factor)                                                          \
+    CUDL_IMPLEMENT_CONVERSION_FRACTION_FACTOR(_from, _to, _factor, 1)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR, see
+ * #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _explicative See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_DECLARE_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR(_from, _to, _explicative, _n, _d)                     \
+    __CUDL_REDUCED_CONVERSION_FRACTION_FACTOR(__CUDL_DECLARE, _from, _to, _explicative, _n, _d)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR, see
+ * #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _explicative See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_IMPLEMENT_EXPLICIT_REDUCED_CONVERSION_FRACTION_FACTOR(_from, _to, _explicative, _n, _d)                   \
+    __CUDL_REDUCED_CONVERSION_FRACTION_FACTOR(__CUDL_IMPLEMENT, _from, _to, _explicative, _n, _d)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param __to See #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_DECLARE_REDUCED_CONVERSION_FRACTION_FACTOR(_from, __to, _n, _d)                                           \
+    __CUDL_REDUCED_CONVERSION_FRACTION_FACTOR(__CUDL_DECLARE, _from, __to, from_##_from##_to_, _n, _d)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_REDUCED_CONVERSION_FRACTION_FACTOR, see
+ * #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param __to See #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_IMPLEMENT_REDUCED_CONVERSION_FRACTION_FACTOR(_from, __to, _n, _d)                                         \
+    __CUDL_REDUCED_CONVERSION_FRACTION_FACTOR(__CUDL_IMPLEMENT, _from, __to, from_##_from##_to_, _n, _d)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _explicative See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _scale_n See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _scale_d See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _offset See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ */
+#define CUDL_DECLARE_EXPLICIT_AFFINE_CONVERSION(_from, _to, _explicative, _scale_n, _scale_d, _offset)                 \
+    __CUDL_AFFINE_CONVERSION(__CUDL_DECLARE, _from, _to, _explicative, _scale_n, _scale_d, _offset)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_EXPLICIT_AFFINE_CONVERSION, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _explicative See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _scale_n See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _scale_d See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ * @param _offset See #CUDL_ADD_EXPLICIT_AFFINE_CONVERSION documentation.
+ */
+#define CUDL_IMPLEMENT_EXPLICIT_AFFINE_CONVERSION(_from, _to, _explicative, _scale_n, _scale_d, _offset)               \
+    __CUDL_AFFINE_CONVERSION(__CUDL_IMPLEMENT, _from, _to, _explicative, _scale_n, _scale_d, _offset)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_AFFINE_CONVERSION, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_AFFINE_CONVERSION documentation.
+ * @param __to See #CUDL_ADD_AFFINE_CONVERSION documentation.
+ * @param _scale_n See #CUDL_ADD_AFFINE_CONVERSION documentation.
+ * @param _scale_d See #CUDL_ADD_AFFINE_CONVERSION documentation.
+ * @param _offset See #CUDL_ADD_AFFINE_CONVERSION documentation.
+ */
+#define CUDL_DECLARE_AFFINE_CONVERSION(_from, __to, _scale_n, _scale_d, _offset)                                       \
+    __CUDL_AFFINE_CONVERSION(__CUDL_DECLARE, _from, __to, from_##_from##_to_, _scale_n, _scale_d, _offset)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_AFFINE_CONVERSION, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_AFFINE_CONVERSION documentation.
+ * @param __to See #CUDL_ADD_AFFINE_CONVERSION documentation.
+ * @param _scale_n See #CUDL_ADD_AFFINE_CONVERSION documentation.
+ * @param _scale_d See #CUDL_ADD_AFFINE_CONVERSION documentation.
+ * @param _offset See #CUDL_ADD_AFFINE_CONVERSION documentation.
+ */
+#define CUDL_IMPLEMENT_AFFINE_CONVERSION(_from, __to, _scale_n, _scale_d, _offset)                                     \
+    __CUDL_AFFINE_CONVERSION(__CUDL_IMPLEMENT, _from, __to, from_##_from##_to_, _scale_n, _scale_d, _offset)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_NO_TRANSFORM_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_NO_TRANSFORM_OP documentation.
+ * @param _op_name See #CUDL_ADD_NO_TRANSFORM_OP documentation.
+ * @param _op See #CUDL_ADD_NO_TRANSFORM_OP documentation.
+ */
+#define CUDL_DECLARE_NO_TRANSFORM_OP(_name, _op_name, _op) __CUDL_NO_TRANSFORM_OP(__CUDL_DECLARE, _name, _op_name, _op)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_NO_TRANSFORM_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_NO_TRANSFORM_OP documentation.
+ * @param _op_name See #CUDL_ADD_NO_TRANSFORM_OP documentation.
+ * @param _op See #CUDL_ADD_NO_TRANSFORM_OP documentation.
+ */
+#define CUDL_IMPLEMENT_NO_TRANSFORM_OP(_name, _op_name, _op)                                                           \
+    __CUDL_NO_TRANSFORM_OP(__CUDL_IMPLEMENT, _name, _op_name, _op)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_NO_UNIT_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_NO_UNIT_OP documentation.
+ * @param _op_name See #CUDL_ADD_NO_UNIT_OP documentation.
+ * @param _op See #CUDL_ADD_NO_UNIT_OP documentation.
+ * @param _type See #CUDL_ADD_NO_UNIT_OP documentation.
+ */
+#define CUDL_DECLARE_NO_UNIT_OP(_name, _op_name, _op, _type)                                                           \
+    __CUDL_NO_UNIT_OP(__CUDL_DECLARE, _name, _op_name, _op, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_NO_UNIT_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_NO_UNIT_OP documentation.
+ * @param _op_name See #CUDL_ADD_NO_UNIT_OP documentation.
+ * @param _op See #CUDL_ADD_NO_UNIT_OP documentation.
+ * @param _type See #CUDL_ADD_NO_UNIT_OP documentation.
+ */
+#define CUDL_IMPLEMENT_NO_UNIT_OP(_name, _op_name, _op, _type)                                                         \
+    __CUDL_NO_UNIT_OP(__CUDL_IMPLEMENT, _name, _op_name, _op, _type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_RELATIONAL_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_RELATIONAL_OP documentation.
+ * @param _op_name See #CUDL_ADD_RELATIONAL_OP documentation.
+ * @param _op See #CUDL_ADD_RELATIONAL_OP documentation.
+ */
+#define CUDL_DECLARE_RELATIONAL_OP(_name, _op_name, _op) __CUDL_RELATIONAL_OP(__CUDL_DECLARE, _name, _op_name, _op)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_RELATIONAL_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_RELATIONAL_OP documentation.
+ * @param _op_name See #CUDL_ADD_RELATIONAL_OP documentation.
+ * @param _op See #CUDL_ADD_RELATIONAL_OP documentation.
+ */
+#define CUDL_IMPLEMENT_RELATIONAL_OP(_name, _op_name, _op) __CUDL_RELATIONAL_OP(__CUDL_IMPLEMENT, _name, _op_name, _op)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_BITWISE_NOT_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_BITWISE_NOT_OP documentation.
+ * @param _op_name See #CUDL_ADD_BITWISE_NOT_OP documentation.
+ */
+#define CUDL_DECLARE_BITWISE_NOT_OP(_name, _op_name) __CUDL_BITWISE_NOT_OP(__CUDL_DECLARE, _name, _op_name)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_BITWISE_NOT_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_BITWISE_NOT_OP documentation.
+ * @param _op_name See #CUDL_ADD_BITWISE_NOT_OP documentation.
+ */
+#define CUDL_IMPLEMENT_BITWISE_NOT_OP(_name, _op_name) __CUDL_BITWISE_NOT_OP(__CUDL_IMPLEMENT, _name, _op_name)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_COMMON_OPERATORS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_COMMON_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_COMMON_OPERATORS documentation.
+ */
+#define CUDL_DECLARE_COMMON_OPERATORS(_name, _type) __CUDL_COMMON_OPERATORS(__CUDL_DECLARE, _name, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_COMMON_OPERATORS, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_COMMON_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_COMMON_OPERATORS documentation.
+ */
+#define CUDL_IMPLEMENT_COMMON_OPERATORS(_name, _type) __CUDL_COMMON_OPERATORS(__CUDL_IMPLEMENT, _name, _type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_INTEGER_OPERATORS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_INTEGER_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_INTEGER_OPERATORS documentation.
+ */
+#define CUDL_DECLARE_INTEGER_OPERATORS(_name, _type) __CUDL_INTEGER_OPERATORS(__CUDL_DECLARE, _name, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_INTEGER_OPERATORS, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_INTEGER_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_INTEGER_OPERATORS documentation.
+ */
+#define CUDL_IMPLEMENT_INTEGER_OPERATORS(_name, _type) __CUDL_INTEGER_OPERATORS(__CUDL_IMPLEMENT, _name, _type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_NO_TRANSFORM_ARRAY_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_NO_TRANSFORM_ARRAY_OP documentation.
+ * @param _op_name See #CUDL_ADD_NO_TRANSFORM_ARRAY_OP documentation.
+ * @param _op See #CUDL_ADD_NO_TRANSFORM_ARRAY_OP documentation.
+ */
+#define CUDL_DECLARE_NO_TRANSFORM_ARRAY_OP(_name, _op_name, _op)                                                       \
+    __CUDL_NO_TRANSFORM_ARRAY_OP(__CUDL_DECLARE, _name, _op_name, _op)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_NO_TRANSFORM_ARRAY_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_NO_TRANSFORM_ARRAY_OP documentation.
+ * @param _op_name See #CUDL_ADD_NO_TRANSFORM_ARRAY_OP documentation.
+ * @param _op See #CUDL_ADD_NO_TRANSFORM_ARRAY_OP documentation.
+ */
+#define CUDL_IMPLEMENT_NO_TRANSFORM_ARRAY_OP(_name, _op_name, _op)                                                     \
+    __CUDL_NO_TRANSFORM_ARRAY_OP(__CUDL_IMPLEMENT, _name, _op_name, _op)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_NO_UNIT_ARRAY_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_NO_UNIT_ARRAY_OP documentation.
+ * @param _op_name See #CUDL_ADD_NO_UNIT_ARRAY_OP documentation.
+ * @param _op See #CUDL_ADD_NO_UNIT_ARRAY_OP documentation.
+ * @param _type See #CUDL_ADD_NO_UNIT_ARRAY_OP documentation.
+ */
+#define CUDL_DECLARE_NO_UNIT_ARRAY_OP(_name, _op_name, _op, _type)                                                     \
+    __CUDL_NO_UNIT_ARRAY_OP(__CUDL_DECLARE, _name, _op_name, _op, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_NO_UNIT_ARRAY_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_NO_UNIT_ARRAY_OP documentation.
+ * @param _op_name See #CUDL_ADD_NO_UNIT_ARRAY_OP documentation.
+ * @param _op See #CUDL_ADD_NO_UNIT_ARRAY_OP documentation.
+ * @param _type See #CUDL_ADD_NO_UNIT_ARRAY_OP documentation.
+ */
+#define CUDL_IMPLEMENT_NO_UNIT_ARRAY_OP(_name, _op_name, _op, _type)                                                   \
+    __CUDL_NO_UNIT_ARRAY_OP(__CUDL_IMPLEMENT, _name, _op_name, _op, _type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_RELATIONAL_ARRAY_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_RELATIONAL_ARRAY_OP documentation.
+ * @param _op_name See #CUDL_ADD_RELATIONAL_ARRAY_OP documentation.
+ * @param _op See #CUDL_ADD_RELATIONAL_ARRAY_OP documentation.
+ */
+#define CUDL_DECLARE_RELATIONAL_ARRAY_OP(_name, _op_name, _op)                                                         \
+    __CUDL_RELATIONAL_ARRAY_OP(__CUDL_DECLARE, _name, _op_name, _op)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_RELATIONAL_ARRAY_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_RELATIONAL_ARRAY_OP documentation.
+ * @param _op_name See #CUDL_ADD_RELATIONAL_ARRAY_OP documentation.
+ * @param _op See #CUDL_ADD_RELATIONAL_ARRAY_OP documentation.
+ */
+#define CUDL_IMPLEMENT_RELATIONAL_ARRAY_OP(_name, _op_name, _op)                                                       \
+    __CUDL_RELATIONAL_ARRAY_OP(__CUDL_IMPLEMENT, _name, _op_name, _op)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_BITWISE_NOT_ARRAY_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_BITWISE_NOT_ARRAY_OP documentation.
+ * @param _op_name See #CUDL_ADD_BITWISE_NOT_ARRAY_OP documentation.
+ */
+#define CUDL_DECLARE_BITWISE_NOT_ARRAY_OP(_name, _op_name) __CUDL_BITWISE_NOT_ARRAY_OP(__CUDL_DECLARE, _name, _op_name)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_BITWISE_NOT_ARRAY_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_BITWISE_NOT_ARRAY_OP documentation.
+ * @param _op_name See #CUDL_ADD_BITWISE_NOT_ARRAY_OP documentation.
+ */
+#define CUDL_IMPLEMENT_BITWISE_NOT_ARRAY_OP(_name, _op_name)                                                           \
+    __CUDL_BITWISE_NOT_ARRAY_OP(__CUDL_IMPLEMENT, _name, _op_name)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_COMMON_ARRAY_OPERATORS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_COMMON_ARRAY_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_COMMON_ARRAY_OPERATORS documentation.
+ */
+#define CUDL_DECLARE_COMMON_ARRAY_OPERATORS(_name, _type) __CUDL_COMMON_ARRAY_OPERATORS(__CUDL_DECLARE, _name, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_COMMON_ARRAY_OPERATORS, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_COMMON_ARRAY_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_COMMON_ARRAY_OPERATORS documentation.
+ */
+#define CUDL_IMPLEMENT_COMMON_ARRAY_OPERATORS(_name, _type)                                                            \
+    __CUDL_COMMON_ARRAY_OPERATORS(__CUDL_IMPLEMENT, _name, _type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_INTEGER_ARRAY_OPERATORS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_INTEGER_ARRAY_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_INTEGER_ARRAY_OPERATORS documentation.
+ */
+#define CUDL_DECLARE_INTEGER_ARRAY_OPERATORS(_name, _type) __CUDL_INTEGER_ARRAY_OPERATORS(__CUDL_DECLARE, _name, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_INTEGER_ARRAY_OPERATORS, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_INTEGER_ARRAY_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_INTEGER_ARRAY_OPERATORS documentation.
+ */
+#define CUDL_IMPLEMENT_INTEGER_ARRAY_OPERATORS(_name, _type)                                                           \
+    __CUDL_INTEGER_ARRAY_OPERATORS(__CUDL_IMPLEMENT, _name, _type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_SATURATING_ADD_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_SATURATING_ADD_OP documentation.
+ * @param _op_name See #CUDL_ADD_SATURATING_ADD_OP documentation.
+ * @param _type See #CUDL_ADD_SATURATING_ADD_OP documentation.
+ */
+#define CUDL_DECLARE_SATURATING_ADD_OP(_name, _op_name, _type)                                                         \
+    __CUDL_SATURATING_OP(__CUDL_DECLARE, _name, _op_name, _type, __CUDL_SATURATING_ADD_VALUE)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_SATURATING_ADD_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_SATURATING_ADD_OP documentation.
+ * @param _op_name See #CUDL_ADD_SATURATING_ADD_OP documentation.
+ * @param _type See #CUDL_ADD_SATURATING_ADD_OP documentation.
+ */
+#define CUDL_IMPLEMENT_SATURATING_ADD_OP(_name, _op_name, _type)                                                       \
+    __CUDL_SATURATING_OP(__CUDL_IMPLEMENT, _name, _op_name, _type, __CUDL_SATURATING_ADD_VALUE)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_SATURATING_SUB_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_SATURATING_SUB_OP documentation.
+ * @param _op_name See #CUDL_ADD_SATURATING_SUB_OP documentation.
+ * @param _type See #CUDL_ADD_SATURATING_SUB_OP documentation.
+ */
+#define CUDL_DECLARE_SATURATING_SUB_OP(_name, _op_name, _type)                                                         \
+    __CUDL_SATURATING_OP(__CUDL_DECLARE, _name, _op_name, _type, __CUDL_SATURATING_SUB_VALUE)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_SATURATING_SUB_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_SATURATING_SUB_OP documentation.
+ * @param _op_name See #CUDL_ADD_SATURATING_SUB_OP documentation.
+ * @param _type See #CUDL_ADD_SATURATING_SUB_OP documentation.
+ */
+#define CUDL_IMPLEMENT_SATURATING_SUB_OP(_name, _op_name, _type)                                                       \
+    __CUDL_SATURATING_OP(__CUDL_IMPLEMENT, _name, _op_name, _type, __CUDL_SATURATING_SUB_VALUE)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_SATURATING_MUL_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_SATURATING_MUL_OP documentation.
+ * @param _op_name See #CUDL_ADD_SATURATING_MUL_OP documentation.
+ * @param _type See #CUDL_ADD_SATURATING_MUL_OP documentation.
+ */
+#define CUDL_DECLARE_SATURATING_MUL_OP(_name, _op_name, _type)                                                         \
+    __CUDL_SATURATING_NO_UNIT_OP(__CUDL_DECLARE, _name, _op_name, _type, __CUDL_SATURATING_MUL_VALUE)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_SATURATING_MUL_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_SATURATING_MUL_OP documentation.
+ * @param _op_name See #CUDL_ADD_SATURATING_MUL_OP documentation.
+ * @param _type See #CUDL_ADD_SATURATING_MUL_OP documentation.
+ */
+#define CUDL_IMPLEMENT_SATURATING_MUL_OP(_name, _op_name, _type)                                                       \
+    __CUDL_SATURATING_NO_UNIT_OP(__CUDL_IMPLEMENT, _name, _op_name, _type, __CUDL_SATURATING_MUL_VALUE)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_CHECKED_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_CHECKED_OP documentation.
+ * @param _op_name See #CUDL_ADD_CHECKED_OP documentation.
+ * @param _builtin See #CUDL_ADD_CHECKED_OP documentation.
+ */
+#define CUDL_DECLARE_CHECKED_OP(_name, _op_name, _builtin) __CUDL_CHECKED_OP(__CUDL_DECLARE, _name, _op_name, _builtin)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_CHECKED_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_CHECKED_OP documentation.
+ * @param _op_name See #CUDL_ADD_CHECKED_OP documentation.
+ * @param _builtin See #CUDL_ADD_CHECKED_OP documentation.
+ */
+#define CUDL_IMPLEMENT_CHECKED_OP(_name, _op_name, _builtin)                                                           \
+    __CUDL_CHECKED_OP(__CUDL_IMPLEMENT, _name, _op_name, _builtin)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_CHECKED_NO_UNIT_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_CHECKED_NO_UNIT_OP documentation.
+ * @param _op_name See #CUDL_ADD_CHECKED_NO_UNIT_OP documentation.
+ * @param _builtin See #CUDL_ADD_CHECKED_NO_UNIT_OP documentation.
+ * @param _type See #CUDL_ADD_CHECKED_NO_UNIT_OP documentation.
+ */
+#define CUDL_DECLARE_CHECKED_NO_UNIT_OP(_name, _op_name, _builtin, _type)                                              \
+    __CUDL_CHECKED_NO_UNIT_OP(__CUDL_DECLARE, _name, _op_name, _builtin, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_CHECKED_NO_UNIT_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_CHECKED_NO_UNIT_OP documentation.
+ * @param _op_name See #CUDL_ADD_CHECKED_NO_UNIT_OP documentation.
+ * @param _builtin See #CUDL_ADD_CHECKED_NO_UNIT_OP documentation.
+ * @param _type See #CUDL_ADD_CHECKED_NO_UNIT_OP documentation.
+ */
+#define CUDL_IMPLEMENT_CHECKED_NO_UNIT_OP(_name, _op_name, _builtin, _type)                                            \
+    __CUDL_CHECKED_NO_UNIT_OP(__CUDL_IMPLEMENT, _name, _op_name, _builtin, _type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_SATURATING_OPERATORS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_SATURATING_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_SATURATING_OPERATORS documentation.
+ */
+#define CUDL_DECLARE_SATURATING_OPERATORS(_name, _type) __CUDL_SATURATING_OPERATORS(__CUDL_DECLARE, _name, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_SATURATING_OPERATORS, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_SATURATING_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_SATURATING_OPERATORS documentation.
+ */
+#define CUDL_IMPLEMENT_SATURATING_OPERATORS(_name, _type) __CUDL_SATURATING_OPERATORS(__CUDL_IMPLEMENT, _name, _type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_CHECKED_OPERATORS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_CHECKED_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_CHECKED_OPERATORS documentation.
+ */
+#define CUDL_DECLARE_CHECKED_OPERATORS(_name, _type) __CUDL_CHECKED_OPERATORS(__CUDL_DECLARE, _name, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_CHECKED_OPERATORS, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_CHECKED_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_CHECKED_OPERATORS documentation.
+ */
+#define CUDL_IMPLEMENT_CHECKED_OPERATORS(_name, _type) __CUDL_CHECKED_OPERATORS(__CUDL_IMPLEMENT, _name, _type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_PRODUCT_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _lhs See #CUDL_ADD_PRODUCT_OP documentation.
+ * @param _rhs See #CUDL_ADD_PRODUCT_OP documentation.
+ * @param _result See #CUDL_ADD_PRODUCT_OP documentation.
+ * @param _op_name See #CUDL_ADD_PRODUCT_OP documentation.
+ */
+#define CUDL_DECLARE_PRODUCT_OP(_lhs, _rhs, _result, _op_name)                                                         \
+    __CUDL_PRODUCT_OP(__CUDL_DECLARE, _lhs, _rhs, _result, _op_name)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_PRODUCT_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _lhs See #CUDL_ADD_PRODUCT_OP documentation.
+ * @param _rhs See #CUDL_ADD_PRODUCT_OP documentation.
+ * @param _result See #CUDL_ADD_PRODUCT_OP documentation.
+ * @param _op_name See #CUDL_ADD_PRODUCT_OP documentation.
+ */
+#define CUDL_IMPLEMENT_PRODUCT_OP(_lhs, _rhs, _result, _op_name)                                                       \
+    __CUDL_PRODUCT_OP(__CUDL_IMPLEMENT, _lhs, _rhs, _result, _op_name)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_QUOTIENT_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _lhs See #CUDL_ADD_QUOTIENT_OP documentation.
+ * @param _rhs See #CUDL_ADD_QUOTIENT_OP documentation.
+ * @param _result See #CUDL_ADD_QUOTIENT_OP documentation.
+ * @param _op_name See #CUDL_ADD_QUOTIENT_OP documentation.
+ */
+#define CUDL_DECLARE_QUOTIENT_OP(_lhs, _rhs, _result, _op_name)                                                        \
+    __CUDL_QUOTIENT_OP(__CUDL_DECLARE, _lhs, _rhs, _result, _op_name)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_QUOTIENT_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _lhs See #CUDL_ADD_QUOTIENT_OP documentation.
+ * @param _rhs See #CUDL_ADD_QUOTIENT_OP documentation.
+ * @param _result See #CUDL_ADD_QUOTIENT_OP documentation.
+ * @param _op_name See #CUDL_ADD_QUOTIENT_OP documentation.
+ */
+#define CUDL_IMPLEMENT_QUOTIENT_OP(_lhs, _rhs, _result, _op_name)                                                      \
+    __CUDL_QUOTIENT_OP(__CUDL_IMPLEMENT, _lhs, _rhs, _result, _op_name)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_WIDENED_PRODUCT_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _lhs See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _rhs See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _result See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _op_name See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _wide_type See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _n See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _d See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ */
+#define CUDL_DECLARE_WIDENED_PRODUCT_OP(_lhs, _rhs, _result, _op_name, _wide_type, _n, _d)                             \
+    __CUDL_WIDENED_PRODUCT_OP(__CUDL_DECLARE, _lhs, _rhs, _result, _op_name, _wide_type, _n, _d)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_WIDENED_PRODUCT_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _lhs See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _rhs See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _result See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _op_name See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _wide_type See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _n See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ * @param _d See #CUDL_ADD_WIDENED_PRODUCT_OP documentation.
+ */
+#define CUDL_IMPLEMENT_WIDENED_PRODUCT_OP(_lhs, _rhs, _result, _op_name, _wide_type, _n, _d)                           \
+    __CUDL_WIDENED_PRODUCT_OP(__CUDL_IMPLEMENT, _lhs, _rhs, _result, _op_name, _wide_type, _n, _d)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_WIDENED_QUOTIENT_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _lhs See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _rhs See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _result See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _op_name See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _wide_type See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _n See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _d See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ */
+#define CUDL_DECLARE_WIDENED_QUOTIENT_OP(_lhs, _rhs, _result, _op_name, _wide_type, _n, _d)                            \
+    __CUDL_WIDENED_QUOTIENT_OP(__CUDL_DECLARE, _lhs, _rhs, _result, _op_name, _wide_type, _n, _d)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_WIDENED_QUOTIENT_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _lhs See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _rhs See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _result See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _op_name See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _wide_type See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _n See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ * @param _d See #CUDL_ADD_WIDENED_QUOTIENT_OP documentation.
+ */
+#define CUDL_IMPLEMENT_WIDENED_QUOTIENT_OP(_lhs, _rhs, _result, _op_name, _wide_type, _n, _d)                          \
+    __CUDL_WIDENED_QUOTIENT_OP(__CUDL_IMPLEMENT, _lhs, _rhs, _result, _op_name, _wide_type, _n, _d)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_FUSED_PRODUCT_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _lhs See #CUDL_ADD_FUSED_PRODUCT_OP documentation.
+ * @param _rhs See #CUDL_ADD_FUSED_PRODUCT_OP documentation.
+ * @param _result See #CUDL_ADD_FUSED_PRODUCT_OP documentation.
+ * @param _op_name See #CUDL_ADD_FUSED_PRODUCT_OP documentation.
+ */
+#define CUDL_DECLARE_FUSED_PRODUCT_OP(_lhs, _rhs, _result, _op_name)                                                   \
+    __CUDL_FUSED_PRODUCT_OP(__CUDL_DECLARE, _lhs, _rhs, _result, _op_name)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_FUSED_PRODUCT_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _lhs See #CUDL_ADD_FUSED_PRODUCT_OP documentation.
+ * @param _rhs See #CUDL_ADD_FUSED_PRODUCT_OP documentation.
+ * @param _result See #CUDL_ADD_FUSED_PRODUCT_OP documentation.
+ * @param _op_name See #CUDL_ADD_FUSED_PRODUCT_OP documentation.
+ */
+#define CUDL_IMPLEMENT_FUSED_PRODUCT_OP(_lhs, _rhs, _result, _op_name)                                                 \
+    __CUDL_FUSED_PRODUCT_OP(__CUDL_IMPLEMENT, _lhs, _rhs, _result, _op_name)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_FIXED_POINT_MUL_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_FIXED_POINT_MUL_OP documentation.
+ * @param _op_name See #CUDL_ADD_FIXED_POINT_MUL_OP documentation.
+ * @param _storage See #CUDL_ADD_FIXED_POINT_MUL_OP documentation.
+ */
+#define CUDL_DECLARE_FIXED_POINT_MUL_OP(_name, _op_name, _storage)                                                     \
+    __CUDL_FIXED_POINT_OP(__CUDL_DECLARE, _name, _op_name, _storage, __CUDL_FIXED_POINT_MUL_VALUE)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_FIXED_POINT_MUL_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_FIXED_POINT_MUL_OP documentation.
+ * @param _op_name See #CUDL_ADD_FIXED_POINT_MUL_OP documentation.
+ * @param _storage See #CUDL_ADD_FIXED_POINT_MUL_OP documentation.
+ */
+#define CUDL_IMPLEMENT_FIXED_POINT_MUL_OP(_name, _op_name, _storage)                                                   \
+    __CUDL_FIXED_POINT_OP(__CUDL_IMPLEMENT, _name, _op_name, _storage, __CUDL_FIXED_POINT_MUL_VALUE)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_FIXED_POINT_DIV_OP, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_FIXED_POINT_DIV_OP documentation.
+ * @param _op_name See #CUDL_ADD_FIXED_POINT_DIV_OP documentation.
+ * @param _storage See #CUDL_ADD_FIXED_POINT_DIV_OP documentation.
+ */
+#define CUDL_DECLARE_FIXED_POINT_DIV_OP(_name, _op_name, _storage)                                                     \
+    __CUDL_FIXED_POINT_OP(__CUDL_DECLARE, _name, _op_name, _storage, __CUDL_FIXED_POINT_DIV_VALUE)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_FIXED_POINT_DIV_OP, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_FIXED_POINT_DIV_OP documentation.
+ * @param _op_name See #CUDL_ADD_FIXED_POINT_DIV_OP documentation.
+ * @param _storage See #CUDL_ADD_FIXED_POINT_DIV_OP documentation.
+ */
+#define CUDL_IMPLEMENT_FIXED_POINT_DIV_OP(_name, _op_name, _storage)                                                   \
+    __CUDL_FIXED_POINT_OP(__CUDL_IMPLEMENT, _name, _op_name, _storage, __CUDL_FIXED_POINT_DIV_VALUE)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_FIXED_POINT_OPERATORS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_FIXED_POINT_OPERATORS documentation.
+ * @param _storage See #CUDL_ADD_FIXED_POINT_OPERATORS documentation.
+ */
+#define CUDL_DECLARE_FIXED_POINT_OPERATORS(_name, _storage)                                                            \
+    __CUDL_COMMON_OPERATORS(__CUDL_DECLARE, _name, _storage)                                                           \
+    __CUDL_FIXED_POINT_OPERATORS(__CUDL_DECLARE, _name, _storage)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_FIXED_POINT_OPERATORS, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_FIXED_POINT_OPERATORS documentation.
+ * @param _storage See #CUDL_ADD_FIXED_POINT_OPERATORS documentation.
+ */
+#define CUDL_IMPLEMENT_FIXED_POINT_OPERATORS(_name, _storage)                                                          \
+    __CUDL_COMMON_OPERATORS(__CUDL_IMPLEMENT, _name, _storage)                                                         \
+    __CUDL_FIXED_POINT_OPERATORS(__CUDL_IMPLEMENT, _name, _storage)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_FIXED_POINT_UNIT, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_FIXED_POINT_UNIT documentation.
+ * @param _storage See #CUDL_ADD_FIXED_POINT_UNIT documentation.
+ * @param _frac_bits See #CUDL_ADD_FIXED_POINT_UNIT documentation.
+ */
+#define CUDL_DECLARE_FIXED_POINT_UNIT(_name, _storage, _frac_bits)                                                     \
+    CUDL_DECLARE_UNIT(_name, _storage)                                                                                 \
+    __CUDL_FIXED_POINT_FORMAT(_name, _storage, _frac_bits)                                                             \
+    __CUDL_FIXED_POINT_INT_CONVERSIONS(__CUDL_DECLARE, _name, _storage)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_FIXED_POINT_UNIT, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_FIXED_POINT_UNIT documentation.
+ * @param _storage See #CUDL_ADD_FIXED_POINT_UNIT documentation.
+ */
+#define CUDL_IMPLEMENT_FIXED_POINT_UNIT(_name, _storage)                                                               \
+    CUDL_IMPLEMENT_UNIT(_name, _storage)                                                                               \
+    __CUDL_FIXED_POINT_INT_CONVERSIONS(__CUDL_IMPLEMENT, _name, _storage)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _to See #CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_DECLARE_FIXED_POINT_CONVERSION_FRACTION_FACTOR(_from, _to, _n, _d)                                        \
+    __CUDL_FIXED_POINT_CONVERSION_FRACTION_FACTOR(__CUDL_DECLARE, _from, _to, from_##_from##_to_, _n, _d)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_FIXED_POINT_CONVERSION_FRACTION_FACTOR, see
+ * #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _to See #CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _n See #CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR documentation.
+ * @param _d See #CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR documentation.
+ */
+#define CUDL_IMPLEMENT_FIXED_POINT_CONVERSION_FRACTION_FACTOR(_from, _to, _n, _d)                                      \
+    __CUDL_FIXED_POINT_CONVERSION_FRACTION_FACTOR(__CUDL_IMPLEMENT, _from, _to, from_##_from##_to_, _n, _d)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_FIXED_POINT_CONVERSION, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_FIXED_POINT_CONVERSION documentation.
+ * @param _to See #CUDL_ADD_FIXED_POINT_CONVERSION documentation.
+ */
+#define CUDL_DECLARE_FIXED_POINT_CONVERSION(_from, _to)                                                                \
+    CUDL_DECLARE_FIXED_POINT_CONVERSION_FRACTION_FACTOR(_from, _to, 1, 1)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_FIXED_POINT_CONVERSION, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_FIXED_POINT_CONVERSION documentation.
+ * @param _to See #CUDL_ADD_FIXED_POINT_CONVERSION documentation.
+ */
+#define CUDL_IMPLEMENT_FIXED_POINT_CONVERSION(_from, _to)                                                              \
+    CUDL_IMPLEMENT_FIXED_POINT_CONVERSION_FRACTION_FACTOR(_from, _to, 1, 1)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_FIXED_POINT_FLOAT_CONVERSIONS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _fixed See #CUDL_ADD_FIXED_POINT_FLOAT_CONVERSIONS documentation.
+ * @param _float See #CUDL_ADD_FIXED_POINT_FLOAT_CONVERSIONS documentation.
+ */
+#define CUDL_DECLARE_FIXED_POINT_FLOAT_CONVERSIONS(_fixed, _float)                                                     \
+    __CUDL_FIXED_POINT_FLOAT_CONVERSIONS(__CUDL_DECLARE, _fixed, _float, from_##_fixed##_to_, from_##_float##_to_)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_FIXED_POINT_FLOAT_CONVERSIONS, see
+ * #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _fixed See #CUDL_ADD_FIXED_POINT_FLOAT_CONVERSIONS documentation.
+ * @param _float See #CUDL_ADD_FIXED_POINT_FLOAT_CONVERSIONS documentation.
+ */
+#define CUDL_IMPLEMENT_FIXED_POINT_FLOAT_CONVERSIONS(_fixed, _float)                                                   \
+    __CUDL_FIXED_POINT_FLOAT_CONVERSIONS(__CUDL_IMPLEMENT, _fixed, _float, from_##_fixed##_to_, from_##_float##_to_)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_INTEGER_REDUCTION_OPERATORS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_INTEGER_REDUCTION_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_INTEGER_REDUCTION_OPERATORS documentation.
+ * @param _sum_type See #CUDL_ADD_INTEGER_REDUCTION_OPERATORS documentation.
+ */
+#define CUDL_DECLARE_INTEGER_REDUCTION_OPERATORS(_name, _type, _sum_type)                                              \
+    __CUDL_INTEGER_REDUCTION_OPERATORS(__CUDL_DECLARE, _name, _type, _sum_type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_INTEGER_REDUCTION_OPERATORS, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_INTEGER_REDUCTION_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_INTEGER_REDUCTION_OPERATORS documentation.
+ * @param _sum_type See #CUDL_ADD_INTEGER_REDUCTION_OPERATORS documentation.
+ */
+#define CUDL_IMPLEMENT_INTEGER_REDUCTION_OPERATORS(_name, _type, _sum_type)                                            \
+    __CUDL_INTEGER_REDUCTION_OPERATORS(__CUDL_IMPLEMENT, _name, _type, _sum_type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_FLOAT_REDUCTION_OPERATORS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_FLOAT_REDUCTION_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_FLOAT_REDUCTION_OPERATORS documentation.
+ */
+#define CUDL_DECLARE_FLOAT_REDUCTION_OPERATORS(_name, _type)                                                           \
+    __CUDL_FLOAT_REDUCTION_OPERATORS(__CUDL_DECLARE, _name, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_FLOAT_REDUCTION_OPERATORS, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_FLOAT_REDUCTION_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_FLOAT_REDUCTION_OPERATORS documentation.
+ */
+#define CUDL_IMPLEMENT_FLOAT_REDUCTION_OPERATORS(_name, _type)                                                         \
+    __CUDL_FLOAT_REDUCTION_OPERATORS(__CUDL_IMPLEMENT, _name, _type)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_SELECTION_OPERATORS, see #CUDL_DECLARE_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_SELECTION_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_SELECTION_OPERATORS documentation.
+ */
+#define CUDL_DECLARE_SELECTION_OPERATORS(_name, _type) __CUDL_SELECTION_OPERATORS(__CUDL_DECLARE, _name, _type)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_SELECTION_OPERATORS, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _name See #CUDL_ADD_SELECTION_OPERATORS documentation.
+ * @param _type See #CUDL_ADD_SELECTION_OPERATORS documentation.
+ */
+#define CUDL_IMPLEMENT_SELECTION_OPERATORS(_name, _type) __CUDL_SELECTION_OPERATORS(__CUDL_IMPLEMENT, _name, _type)
+
+/**
+ * @brief Macro to add a product between two units giving a third one, like volts multiplied by amperes giving watts.
+ * The operands are converted to the storage type of _result before being multiplied, so the product does not overflow
+ * smaller operand types. An array version with a _n suffix (and its _n_aligned variant, see
+ * #CUDL_ADD_NO_TRANSFORM_ARRAY_OP) is also added.
+ * @include add_product_op_example.c
+ * @param _lhs The unit of the left hand side. The function name starts with it.
+ * @param _rhs The unit of the right hand side.
+ * @param _result The unit of the result.
+ * @param _op_name The core name of function to add.
+ */
+#define CUDL_ADD_PRODUCT_OP(_lhs, _rhs, _result, _op_name)                                                             \
+    __CUDL_PRODUCT_OP(__CUDL_INLINE, _lhs, _rhs, _result, _op_name)
+
+/**
+ * @brief Macro to add a quotient between two units giving a third one, like meters divided by seconds giving meters per
+ * second. The operands are converted to the storage type of _result before being divided. The array versions are added
+ * like with #CUDL_ADD_PRODUCT_OP.
+ * @include add_product_op_example.c
+ * @param _lhs The unit of the dividend. The function name starts with it.
+ * @param _rhs The unit of the divisor.
+ * @param _result The unit of the result.
+ * @param _op_name The core name of function to add.
+ */
+#define CUDL_ADD_QUOTIENT_OP(_lhs, _rhs, _result, _op_name)                                                            \
+    __CUDL_QUOTIENT_OP(__CUDL_INLINE, _lhs, _rhs, _result, _op_name)
+
+/**
+ * @brief Integer version of #CUDL_ADD_PRODUCT_OP where the product is computed in a wider type and scaled by _n / _d
+ * before being stored in _result. This allows the result to use a prefix that differs from the operands, like
+ * millivolts multiplied by milliamperes giving milliwatts (_n = 1, _d = 1000), without overflowing in the middle. The
+ * result is only truncated when it does not fit in the _result storage type.
+ * @include add_product_op_example.c
+ * @param _lhs The unit of the left hand side. The function name starts with it.
+ * @param _rhs The unit of the right hand side.
+ * @param _result The unit of the result.
+ * @param _op_name The core name of function to add.
+ * @param _wide_type The integer type used for the intermediate computations, e.g. int64_t.
+ * @param _n Numerator of the scale applied to the product.
+ * @param _d Denominator of the scale applied to the product.
+ */
+#define CUDL_ADD_WIDENED_PRODUCT_OP(_lhs, _rhs, _result, _op_name, _wide_type, _n, _d)                                 \
+    __CUDL_WIDENED_PRODUCT_OP(__CUDL_INLINE, _lhs, _rhs, _result, _op_name, _wide_type, _n, _d)
+
+/**
+ * @brief Integer version of #CUDL_ADD_QUOTIENT_OP where the dividend is widened and scaled by _n, and the divisor by
+ * _d, before the division. For example, meters divided by milliseconds giving meters per second uses _n = 1000 and
+ * _d = 1.
+ * @include add_product_op_example.c
+ * @param _lhs The unit of the dividend. The function name starts with it.
+ * @param _rhs The unit of the divisor.
+ * @param _result The unit of the result.
+ * @param _op_name The core name of function to add.
+ * @param _wide_type The integer type used for the intermediate computations, e.g. int64_t.
+ * @param _n Numerator of the scale applied to the quotient.
+ * @param _d Denominator of the scale applied to the quotient.
+ */
+#define CUDL_ADD_WIDENED_QUOTIENT_OP(_lhs, _rhs, _result, _op_name, _wide_type, _n, _d)                                \
+    __CUDL_WIDENED_QUOTIENT_OP(__CUDL_INLINE, _lhs, _rhs, _result, _op_name, _wide_type, _n, _d)
+
+/**
+ * @brief Macro to add a fused multiply-add between two units and a third one: result = lhs * rhs + addend, like
+ * accumulating the energy of power samples multiplied by their duration. For float and double _result storages, the
+ * operation is rounded once and compiled to an FMA instruction when the target has one (e.g. -mfma or -march=native on
+ * x86-64). Otherwise, it is computed in the storage type of _result like #CUDL_ADD_PRODUCT_OP followed by an addition.
+ *
+ * The array version with a _n suffix takes a dst, lhs, rhs and addend arrays. Unlike the other array functions, dst
+ * may be the same array as addend to accumulate in place, so only lhs and rhs are restrict qualified. The _n_aligned
+ * variant is also added.
+ * @include add_product_op_example.c
+ * @param _lhs The unit of the left hand side. The function name starts with it.
+ * @param _rhs The unit of the right hand side.
+ * @param _result The unit of the addend and of the result.
+ * @param _op_name The core name of function to add.
+ */
+#define CUDL_ADD_FUSED_PRODUCT_OP(_lhs, _rhs, _result, _op_name)                                                       \
+    __CUDL_FUSED_PRODUCT_OP(__CUDL_INLINE, _lhs, _rhs, _result, _op_name)
+
+/**
+ * @brief Adds the reductions of arrays of an integer unit:
+ * - _sum_type cudl_<name>_sum_n(src, n): sum of the values;
+ * - _sum_type cudl_<name>_sumsq_n(src, n): sum of the squared values, e.g. to compute a RMS value;
+ * - _sum_type cudl_<name>_dot_n(lhs, rhs, n): sum of the products of the values of two arrays;
+ * - cudl_<name>_t cudl_<name>_mean_n(src, n): mean of the values, truncated like an integer division;
+ * - cudl_<name>_t cudl_<name>_min_n(src, n) and cudl_<name>_max_n(src, n): smallest and largest values.
+ *
+ * The sums are accumulated in _sum_type, so they do not wrap around like the storage type would. The loops are
+ * vectorized by GCC and Clang (-O3, or -O2 with -ftree-vectorize). The mean, min and max of an empty array are 0,
+ * without reading src. _n_aligned variants taking arrays aligned on #CUDL_ARRAY_ALIGNMENT are also added.
+ * @include add_reduction_operators_example.c
+ * @param _name The unit to add the reductions for. It is expected to be the same as the _name param used with
+ * CUDL_ADD_UNIT*.
+ * @param _type The underlying storage type to use.
+ * @param _sum_type The integer type the sums are accumulated in and returned as, e.g. int64_t for int32_t values.
+ */
+#define CUDL_ADD_INTEGER_REDUCTION_OPERATORS(_name, _type, _sum_type)                                                  \
+    __CUDL_INTEGER_REDUCTION_OPERATORS(__CUDL_INLINE, _name, _type, _sum_type)
+
+/**
+ * @brief Adds the same reductions as #CUDL_ADD_INTEGER_REDUCTION_OPERATORS for a floating point unit, with _type as
+ * the sum type. The sums are computed with pairwise summation: the array is split in halves until they are small
+ * enough, and those are accumulated in several independent lanes. The rounding error grows with the logarithm of n
+ * instead of n, and the lanes are vectorized without having to allow the compiler to reassociate floating point
+ * additions (-ffast-math is not needed, and does not change the result). The mean is the pairwise sum divided by n.
+ * For float and double storages, the min and max compare the bits of the values as integers, which are vectorized
+ * without -ffast-math too: -0 is smaller than +0, and NaN values are smaller than -infinity or larger than +infinity
+ * depending on their sign bit.
+ * @include add_reduction_operators_example.c
+ * @param _name The unit to add the reductions for. It is expected to be the same as the _name param used with
+ * CUDL_ADD_UNIT*.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_FLOAT_REDUCTION_OPERATORS(_name, _type)                                                               \
+    __CUDL_FLOAT_REDUCTION_OPERATORS(__CUDL_INLINE, _name, _type)
+
+/**
+ * @brief Number of 64 bits words of a packed mask of _n values, as written by the cudl_<name>_<op>_mask_n functions
+ * added by #CUDL_ADD_SELECTION_OPERATORS.
+ */
+#define CUDL_MASK_WORDS(_n) (((_n) + 63) / 64)
+
+/**
+ * @brief Adds the branchless selection functions of arrays of a unit, e.g. to detect the samples of a stream above an
+ * alarm threshold:
+ * - cudl_<name>_<op>_mask_n(dst, src, threshold, n), with op being eq, ne, gt, ge, lt and le: sets bit i % 64 of
+ *   dst[i / 64] if src[i] <op> threshold. dst must have room for CUDL_MASK_WORDS(n) words, the unused bits of the last
+ *   one are set to 0. The mask is 8 times smaller than the bool arrays of #CUDL_ADD_RELATIONAL_ARRAY_OP;
+ * - size_t cudl_<name>_filter_<op>_n(dst, src, threshold, n): copies the values of src for which src[i] <op>
+ *   threshold at the beginning of dst, in order, and returns their number. dst must have room for n values. dst may be
+ *   src to filter an array in place;
+ * - cudl_<name>_select_n(dst, mask, lhs, rhs, n): blends two arrays, dst[i] is lhs[i] if bit i of the mask is set,
+ *   rhs[i] otherwise. The mask is typically written by a cudl_<name>_<op>_mask_n function;
+ * - cudl_<name>_clamp_n(dst, src, low, high, n): dst[i] is src[i] clamped between low and high.
+ *
+ * The values are processed by blocks of 64 without any branch depending on them, so the loops run at the same speed
+ * whatever the proportion of matching values, without branch mispredictions. The comparisons and the clamp loops are
+ * auto-vectorized by GCC and Clang (-O3, or -O2 with -ftree-vectorize), and the select loops on targets with variable
+ * vector shifts (e.g. -mavx2 or -march=x86-64-v3 on x86-64), being scalar but still branchless on others. Except for
+ * the filters, the arrays are restrict qualified. _n_aligned variants taking arrays aligned on
+ * #CUDL_ARRAY_ALIGNMENT are also added.
+ * @include add_selection_operators_example.c
+ * @param _name The unit to add the functions for. It is expected to be the same as the _name param used with
+ * CUDL_ADD_UNIT*.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_SELECTION_OPERATORS(_name, _type) __CUDL_SELECTION_OPERATORS(__CUDL_INLINE, _name, _type)
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef CUDL_ENABLE_TRACE
+#include "cudl_trace.h"
 #endif
 
 #endif//CUDL_H
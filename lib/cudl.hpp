@@ -0,0 +1,249 @@
+/**
+ * @file cudl.hpp
+ * @author Olivier Allaire
+ * @brief Optional C++ (C++14 or later) layer over the units defined with cudl.h. It adds operators and user defined
+ * literals to the unit types themselves, so the same structs and functions are shared by C and C++ code, without any
+ * copy or conversion.
+ *
+ * When compiled as C++, the functions added by CUDL_ADD_UNIT*, the CUDL_ADD_*_OP and CUDL_ADD_*_OPERATORS macros of
+ * cudl.h and the fraction, reduced and affine conversions (including their array versions) are constexpr. With this
+ * header, every unit added by CUDL_ADD_UNIT* or CUDL_DECLARE_UNIT* also gets constexpr operators:
+ * - +, - between values of the unit, unary + and -, and the compound assignments += and -=;
+ * - * and / by a value of the storage type (on either side for *), and *= and /=. The quotient of two values of the
+ *   same unit is a value of the storage type;
+ * - for integer storages, % by a value of the storage type, the bitwise &, |, ^, <<, >> with a value of the storage
+ *   type, and ~;
+ * - ==, !=, <, <=, > and >=.
+ *
+ * They compute like the C operators added by CUDL_ADD_COMMON_OPERATORS and CUDL_ADD_INTEGER_OPERATORS. So constant
+ * expressions such as thresholds, converted values or whole conversion tables are folded at compile time:
+ * @include cudl_hpp_example.cpp
+ */
+
+#ifndef CUDL_HPP
+#define CUDL_HPP
+
+#include "cudl.h"
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace cudl {
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace detail {
+
+/**
+ * @brief Fallback of the __cudl_unit_storage(unit) declarations added by __CUDL_UNIT_STORAGE, found by argument
+ * dependent lookup for the unit types only. For internal use only.
+ */
+void __cudl_unit_storage(...);// NOLINT(bugprone-reserved-identifier)
+
+template <typename U>
+using storage_or_void_t = decltype(__cudl_unit_storage(std::declval<U>()));
+
+struct parsed_integer {
+    unsigned long long value;
+    bool valid;
+};
+
+/**
+ * @brief Parses the characters of an integer literal, in any base and with digit separators. valid is false when the
+ * value does not fit in an unsigned long long. For internal use only.
+ */
+template <char... C>
+constexpr parsed_integer parse_integer() {
+    const char digits[] = {C..., '\0'};
+    unsigned base = 10;
+    size_t i = 0;
+    if (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+        base = 16;
+        i = 2;
+    } else if (digits[0] == '0' && (digits[1] == 'b' || digits[1] == 'B')) {
+        base = 2;
+        i = 2;
+    } else if (digits[0] == '0') {
+        base = 8;
+    }
+    parsed_integer parsed = {0, true};
+    for (; digits[i] != '\0'; ++i) {
+        if (digits[i] == '\'') { continue; }
+        const unsigned digit =
+                digits[i] <= '9' ? (unsigned) (digits[i] - '0') : (unsigned) ((digits[i] | 0x20) - 'a' + 10);
+        if (parsed.value > (std::numeric_limits<unsigned long long>::max() - digit) / base) { parsed.valid = false; }
+        parsed.value = parsed.value * base + digit;
+    }
+    return parsed;
+}
+
+template <typename T>
+constexpr bool integer_literal_fits(parsed_integer parsed) {
+    return parsed.valid && (!std::numeric_limits<T>::is_integer ||
+                            parsed.value <= static_cast<unsigned long long>(std::numeric_limits<T>::max()));
+}
+
+template <typename T, char... C>
+constexpr T integer_literal() {
+    static_assert(integer_literal_fits<T>(parse_integer<C...>()), "The literal does not fit in the unit storage");
+    return static_cast<T>(parse_integer<C...>().value);
+}
+
+/**
+ * @brief Called for floating point literals that do not fit in the storage of the unit, or that are not whole for an
+ * integer storage. It is not constexpr, so such a literal does not compile where a constant expression is required,
+ * and aborts if it is evaluated at run time. For internal use only.
+ */
+template <typename T>
+[[noreturn]] inline T literal_out_of_range() {
+    std::abort();
+}
+
+template <typename T>
+constexpr T floating_literal(long double value) {
+    return value <= static_cast<long double>(std::numeric_limits<T>::max()) &&
+                           (!std::numeric_limits<T>::is_integer ||
+                            static_cast<long double>(static_cast<T>(value)) == value)
+                   ? static_cast<T>(value)
+                   : literal_out_of_range<T>();
+}
+
+}// namespace detail
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief True for the unit types added by CUDL_ADD_UNIT* and CUDL_DECLARE_UNIT*.
+ */
+template <typename U>
+struct is_unit : std::integral_constant<bool, !std::is_void<detail::storage_or_void_t<U>>::value> {};
+
+/**
+ * @brief True for the unit types with an integer storage.
+ */
+template <typename U>
+struct is_integer_unit : std::integral_constant<bool, is_unit<U>::value &&
+                                                              std::is_integral<detail::storage_or_void_t<U>>::value> {
+};
+
+/**
+ * @brief Storage type of a unit, e.g. int16_t for a unit added with CUDL_ADD_UNIT(mv, int16_t).
+ */
+template <typename U>
+using storage_t = typename std::enable_if<is_unit<U>::value, detail::storage_or_void_t<U>>::type;
+
+/**
+ * @brief Returns the value of the unit U holding value, without the init op of the unit.
+ */
+template <typename U>
+constexpr U make(storage_t<U> value) {
+    U unit{};
+    unit.value = value;
+    return unit;
+}
+
+}// namespace cudl
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Shorter spellings of the return types of the operators, which only exist for the unit types. For internal use
+ * only.
+ */
+#define __CUDL_IF_UNIT(_unit, _result)                                                                                 \
+    typename std::enable_if<cudl::is_unit<_unit>::value, _result>::type// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_IF_INTEGER_UNIT(_unit, _result)                                                                         \
+    typename std::enable_if<cudl::is_integer_unit<_unit>::value, _result>::type// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Binary operators taking two values of a unit, and taking a value of a unit and a value of its storage type.
+ * For internal use only.
+ */
+#define __CUDL_HPP_UNIT_OP(_op, _enable)                                                                               \
+    template <typename U>                                                                                              \
+    constexpr _enable(U, U) operator _op(U lhs, U rhs) {                                                               \
+        return cudl::make<U>(static_cast<cudl::storage_t<U>>(lhs.value _op rhs.value));                                \
+    }                                                                                                                  \
+    template <typename U>                                                                                              \
+    constexpr _enable(U, U &) operator _op##=(U &lhs, U rhs) {                                                         \
+        return lhs = lhs _op rhs;                                                                                      \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_HPP_SCALAR_OP(_op, _enable)                                                                             \
+    template <typename U>                                                                                              \
+    constexpr _enable(U, U) operator _op(U lhs, cudl::storage_t<U> rhs) {                                              \
+        return cudl::make<U>(static_cast<cudl::storage_t<U>>(lhs.value _op rhs));                                      \
+    }                                                                                                                  \
+    template <typename U>                                                                                              \
+    constexpr _enable(U, U &) operator _op##=(U &lhs, cudl::storage_t<U> rhs) {                                        \
+        return lhs = lhs _op rhs;                                                                                      \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_HPP_RELATIONAL_OP(_op)                                                                                  \
+    template <typename U>                                                                                              \
+    constexpr __CUDL_IF_UNIT(U, bool) operator _op(U lhs, U rhs) {                                                     \
+        return lhs.value _op rhs.value;                                                                                \
+    }// NOLINT(bugprone-reserved-identifier)
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+__CUDL_HPP_UNIT_OP(+, __CUDL_IF_UNIT)
+__CUDL_HPP_UNIT_OP(-, __CUDL_IF_UNIT)
+__CUDL_HPP_SCALAR_OP(*, __CUDL_IF_UNIT)
+__CUDL_HPP_SCALAR_OP(/, __CUDL_IF_UNIT)
+__CUDL_HPP_SCALAR_OP(%, __CUDL_IF_INTEGER_UNIT)
+__CUDL_HPP_SCALAR_OP(&, __CUDL_IF_INTEGER_UNIT)
+__CUDL_HPP_SCALAR_OP(|, __CUDL_IF_INTEGER_UNIT)
+__CUDL_HPP_SCALAR_OP(^, __CUDL_IF_INTEGER_UNIT)
+__CUDL_HPP_SCALAR_OP(<<, __CUDL_IF_INTEGER_UNIT)
+__CUDL_HPP_SCALAR_OP(>>, __CUDL_IF_INTEGER_UNIT)
+__CUDL_HPP_RELATIONAL_OP(==)
+__CUDL_HPP_RELATIONAL_OP(!=)
+__CUDL_HPP_RELATIONAL_OP(<)
+__CUDL_HPP_RELATIONAL_OP(<=)
+__CUDL_HPP_RELATIONAL_OP(>)
+__CUDL_HPP_RELATIONAL_OP(>=)
+
+template <typename U>
+constexpr __CUDL_IF_UNIT(U, U) operator*(cudl::storage_t<U> lhs, U rhs) {
+    return cudl::make<U>(static_cast<cudl::storage_t<U>>(lhs * rhs.value));
+}
+
+template <typename U>
+constexpr __CUDL_IF_UNIT(U, cudl::storage_t<U>) operator/(U lhs, U rhs) {
+    return static_cast<cudl::storage_t<U>>(lhs.value / rhs.value);
+}
+
+template <typename U>
+constexpr __CUDL_IF_UNIT(U, U) operator+(U value) {
+    return value;
+}
+
+template <typename U>
+constexpr __CUDL_IF_UNIT(U, U) operator-(U value) {
+    return cudl::make<U>(static_cast<cudl::storage_t<U>>(-value.value));
+}
+
+template <typename U>
+constexpr __CUDL_IF_INTEGER_UNIT(U, U) operator~(U value) {
+    return cudl::make<U>(static_cast<cudl::storage_t<U>>(~value.value));
+}
+
+/**
+ * @brief Adds the user defined literal operator""_suffix for the _name unit, e.g. CUDL_ADD_LITERAL(mv, _mV) to write
+ * 3300_mV instead of cudl_mv(3300). The literal value is given to the init function of the unit, so its init op
+ * applies, and the literal is a constant expression when the init function is constexpr (always, except for the units
+ * added by CUDL_DECLARE_UNIT*). Integer literals, in any base and with digit separators, that do not fit in the storage
+ * type do not compile. Floating point literals that do not fit, or that are not whole for an integer storage (e.g.
+ * 3.5_mV), do not compile where a constant expression is required, and abort otherwise. Negative values are written
+ * with the unary minus operator, e.g. -5_mV. It must be used at namespace scope, where the unit is visible.
+ * @include cudl_hpp_example.cpp
+ * @param _name The unit to add a literal for. It is expected to be the same as the _name param used with
+ * CUDL_ADD_UNIT*.
+ * @param _suffix The literal suffix, which must start with an underscore, e.g. _mV.
+ */
+#define CUDL_ADD_LITERAL(_name, _suffix)                                                                               \
+    template <char... __cudl_chars>                                                                                    \
+    constexpr __CUDL_UT(_name) operator __CUDL_L1STR("", _suffix)() {                                                  \
+        return __CUDL_AP(_name)(cudl::detail::integer_literal<cudl::storage_t<__CUDL_UT(_name)>, __cudl_chars...>());  \
+    }                                                                                                                  \
+    constexpr __CUDL_UT(_name) operator __CUDL_L1STR("", _suffix)(long double value) {                                 \
+        return __CUDL_AP(_name)(cudl::detail::floating_literal<cudl::storage_t<__CUDL_UT(_name)>>(value));             \
+    }
+
+#endif//CUDL_HPP
@@ -0,0 +1,304 @@
+/**
+ * @file cudl_atomic.h
+ * @author Olivier Allaire
+ * @brief Atomic operations shared by the lock-free facilities of cudl. C translation units use the C11 stdatomic.h
+ * header, C++ ones use std::atomic, so the same generated code compiles in both languages.
+ */
+
+#ifndef CUDL_ATOMIC_H
+#define CUDL_ATOMIC_H
+
+#include "cudl.h"
+
+#ifdef __cplusplus
+#include <atomic>
+#else
+#include <stdatomic.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CUDL_CACHE_LINE_SIZE
+/**
+ * @brief Size, in bytes, of a cache line. Data written by different threads is kept at least this far apart to avoid
+ * false sharing. It can be redefined before including this header, e.g. to 128 on Apple M1 or some POWER targets.
+ */
+#define CUDL_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * @brief Memory order taken by the _explicit functions of the atomic units: memory_order_relaxed,
+ * memory_order_acquire, ... in C, and std::memory_order_relaxed, std::memory_order_acquire, ... in C++.
+ */
+#ifdef __cplusplus
+typedef std::memory_order cudl_memory_order_t;
+#else
+typedef memory_order cudl_memory_order_t;
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Atomic version of _type and memory order named like the suffix of the C11 memory_order_* constants (relaxed,
+ * acquire, release, acq_rel or seq_cst). For internal use only.
+ */
+#ifdef __cplusplus
+#define __CUDL_ATOMIC(_type) std::atomic<_type>               // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_MEMORY_ORDER(_order) std::memory_order_##_order// NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_ATOMIC(_type) _Atomic(_type)              // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_MEMORY_ORDER(_order) memory_order_##_order// NOLINT(bugprone-reserved-identifier)
+#endif
+
+/**
+ * @brief Atomic operations on the object pointed by _obj, with an explicit memory order. The _EXPLICIT versions take
+ * memory order values, the other ones take the suffix of the memory order, see #__CUDL_MEMORY_ORDER. For internal use
+ * only.
+ */
+#ifdef __cplusplus
+#define __CUDL_THREAD_LOCAL thread_local                                   // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_INIT(_obj, _value) std::atomic_init((_obj), (_value))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_LOAD_EXPLICIT(_obj, _order) (_obj)->load(_order)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_STORE_EXPLICIT(_obj, _value, _order)                                                             \
+    (_obj)->store((_value), (_order))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_EXCHANGE_EXPLICIT(_obj, _value, _order)                                                          \
+    (_obj)->exchange((_value), (_order))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT(_obj, _expected, _desired, _success, _failure)                  \
+    (_obj)->compare_exchange_strong(*(_expected), (_desired), (_success),                                              \
+                                    (_failure))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT(_obj, _expected, _desired, _success, _failure)                    \
+    (_obj)->compare_exchange_weak(*(_expected), (_desired), (_success),                                                \
+                                  (_failure))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_FETCH_ADD_EXPLICIT(_obj, _value, _order)                                                         \
+    (_obj)->fetch_add((_value), (_order))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_FETCH_SUB_EXPLICIT(_obj, _value, _order)                                                         \
+    (_obj)->fetch_sub((_value), (_order))// NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_THREAD_LOCAL _Thread_local                             // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_INIT(_obj, _value) atomic_init((_obj), (_value))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_LOAD_EXPLICIT(_obj, _order)                                                                      \
+    atomic_load_explicit((_obj), (_order))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_STORE_EXPLICIT(_obj, _value, _order)                                                             \
+    atomic_store_explicit((_obj), (_value), (_order))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_EXCHANGE_EXPLICIT(_obj, _value, _order)                                                          \
+    atomic_exchange_explicit((_obj), (_value), (_order))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT(_obj, _expected, _desired, _success, _failure)                  \
+    atomic_compare_exchange_strong_explicit((_obj), (_expected), (_desired), (_success),                               \
+                                            (_failure))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT(_obj, _expected, _desired, _success, _failure)                    \
+    atomic_compare_exchange_weak_explicit((_obj), (_expected), (_desired), (_success),                                 \
+                                          (_failure))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_FETCH_ADD_EXPLICIT(_obj, _value, _order)                                                         \
+    atomic_fetch_add_explicit((_obj), (_value), (_order))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_FETCH_SUB_EXPLICIT(_obj, _value, _order)                                                         \
+    atomic_fetch_sub_explicit((_obj), (_value), (_order))// NOLINT(bugprone-reserved-identifier)
+#endif
+#define __CUDL_ATOMIC_LOAD(_obj, _order)                                                                               \
+    __CUDL_ATOMIC_LOAD_EXPLICIT(_obj, __CUDL_MEMORY_ORDER(_order))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_ATOMIC_STORE(_obj, _value, _order)                                                                      \
+    __CUDL_ATOMIC_STORE_EXPLICIT(_obj, _value, __CUDL_MEMORY_ORDER(_order))// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Returns a small index, different for each thread that calls it in the translation unit, that sharded
+ * counters use to pick their shard. For internal use only.
+ */
+static inline size_t __cudl_thread_slot(void) {// NOLINT(bugprone-reserved-identifier)
+    static __CUDL_ATOMIC(size_t) next_slot;
+    static __CUDL_THREAD_LOCAL size_t slot = 0;
+    if (slot == 0) {
+        slot = __CUDL_ATOMIC_FETCH_ADD_EXPLICIT(&next_slot, (size_t) 1, __CUDL_MEMORY_ORDER(relaxed)) + 1;
+    }
+    return slot - 1;
+}
+
+/**
+ * @brief Functions shared by the atomic units with integer and floating point types. For internal use only.
+ */
+#define __CUDL_ATOMIC_UNIT_COMMON(_name, _type)                                                                        \
+    typedef struct {                                                                                                   \
+        __CUDL_ATOMIC(_type) value;                                                                                    \
+    } __CUDL_UT(_name##_atomic);                                                                                       \
+    typedef struct {                                                                                                   \
+        __CUDL_ALIGNAS(CUDL_CACHE_LINE_SIZE) __CUDL_UT(_name##_atomic) atomic;                                         \
+    } __CUDL_UT(_name##_padded_atomic);                                                                                \
+    static inline void __CUDL_FN(_name, _atomic, _init)(__CUDL_UT(_name##_atomic) * atomic, __CUDL_UT(_name) value) {  \
+        __CUDL_ATOMIC_INIT(&atomic->value, value.value);                                                               \
+    }                                                                                                                  \
+    static inline __CUDL_UT(_name) __CUDL_FN(_name, _atomic, _load_explicit)(__CUDL_UT(_name##_atomic) * atomic,       \
+                                                                             cudl_memory_order_t order) {              \
+        __CUDL_UT(_name) result;                                                                                       \
+        result.value = __CUDL_ATOMIC_LOAD_EXPLICIT(&atomic->value, order);                                             \
+        return result;                                                                                                 \
+    }                                                                                                                  \
+    static inline __CUDL_UT(_name) __CUDL_FN(_name, _atomic, _load)(__CUDL_UT(_name##_atomic) * atomic) {              \
+        return __CUDL_FN(_name, _atomic, _load_explicit)(atomic, __CUDL_MEMORY_ORDER(seq_cst));                        \
+    }                                                                                                                  \
+    static inline void __CUDL_FN(_name, _atomic, _store_explicit)(__CUDL_UT(_name##_atomic) * atomic,                  \
+                                                                  __CUDL_UT(_name) value, cudl_memory_order_t order) { \
+        __CUDL_ATOMIC_STORE_EXPLICIT(&atomic->value, value.value, order);                                              \
+    }                                                                                                                  \
+    static inline void __CUDL_FN(_name, _atomic, _store)(__CUDL_UT(_name##_atomic) * atomic, __CUDL_UT(_name) value) { \
+        __CUDL_FN(_name, _atomic, _store_explicit)(atomic, value, __CUDL_MEMORY_ORDER(seq_cst));                       \
+    }                                                                                                                  \
+    static inline __CUDL_UT(_name) __CUDL_FN(_name, _atomic, _exchange_explicit)(                                      \
+            __CUDL_UT(_name##_atomic) * atomic, __CUDL_UT(_name) value, cudl_memory_order_t order) {                   \
+        __CUDL_UT(_name) result;                                                                                       \
+        result.value = __CUDL_ATOMIC_EXCHANGE_EXPLICIT(&atomic->value, value.value, order);                            \
+        return result;                                                                                                 \
+    }                                                                                                                  \
+    static inline __CUDL_UT(_name) __CUDL_FN(_name, _atomic, _exchange)(__CUDL_UT(_name##_atomic) * atomic,            \
+                                                                        __CUDL_UT(_name) value) {                      \
+        return __CUDL_FN(_name, _atomic, _exchange_explicit)(atomic, value, __CUDL_MEMORY_ORDER(seq_cst));             \
+    }                                                                                                                  \
+    static inline bool __CUDL_FN(_name, _atomic, _compare_exchange_explicit)(                                          \
+            __CUDL_UT(_name##_atomic) * atomic, __CUDL_UT(_name) * expected, __CUDL_UT(_name) desired,                 \
+            cudl_memory_order_t success, cudl_memory_order_t failure) {                                                \
+        return __CUDL_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT(&atomic->value, &expected->value, desired.value,         \
+                                                              success, failure);                                       \
+    }                                                                                                                  \
+    static inline bool __CUDL_FN(_name, _atomic, _compare_exchange)(                                                   \
+            __CUDL_UT(_name##_atomic) * atomic, __CUDL_UT(_name) * expected, __CUDL_UT(_name) desired) {               \
+        return __CUDL_FN(_name, _atomic, _compare_exchange_explicit)(                                                  \
+                atomic, expected, desired, __CUDL_MEMORY_ORDER(seq_cst), __CUDL_MEMORY_ORDER(seq_cst));                \
+    }                                                                                                                  \
+    static inline bool __CUDL_FN(_name, _atomic, _compare_exchange_weak_explicit)(                                     \
+            __CUDL_UT(_name##_atomic) * atomic, __CUDL_UT(_name) * expected, __CUDL_UT(_name) desired,                 \
+            cudl_memory_order_t success, cudl_memory_order_t failure) {                                                \
+        return __CUDL_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT(&atomic->value, &expected->value, desired.value, success,  \
+                                                            failure);                                                  \
+    }                                                                                                                  \
+    static inline bool __CUDL_FN(_name, _atomic, _compare_exchange_weak)(                                              \
+            __CUDL_UT(_name##_atomic) * atomic, __CUDL_UT(_name) * expected, __CUDL_UT(_name) desired) {               \
+        return __CUDL_FN(_name, _atomic, _compare_exchange_weak_explicit)(                                             \
+                atomic, expected, desired, __CUDL_MEMORY_ORDER(seq_cst), __CUDL_MEMORY_ORDER(seq_cst));                \
+    }
+
+/**
+ * @brief Defines a fetch operation (fetch_add or fetch_sub) of an atomic unit, and its version with the sequentially
+ * consistent order. _body must set result.value to the previous value of atomic, see the two bodies below. For
+ * internal use only.
+ */
+#define __CUDL_ATOMIC_FETCH_OP(_name, _op_name, _body)                                                                 \
+    static inline __CUDL_UT(_name) __CUDL_FN(_name, _atomic, __CUDL_L1STR(_op_name, _explicit))(                       \
+            __CUDL_UT(_name##_atomic) * atomic, __CUDL_UT(_name) value, cudl_memory_order_t order) {                   \
+        __CUDL_UT(_name) result;                                                                                       \
+        _body;                                                                                                         \
+        return result;                                                                                                 \
+    }                                                                                                                  \
+    static inline __CUDL_UT(_name) __CUDL_FN(_name, _atomic, _op_name)(__CUDL_UT(_name##_atomic) * atomic,             \
+                                                                       __CUDL_UT(_name) value) {                       \
+        return __CUDL_FN(_name, _atomic, __CUDL_L1STR(_op_name, _explicit))(atomic, value,                             \
+                                                                             __CUDL_MEMORY_ORDER(seq_cst));            \
+    }
+/**
+ * @brief Fetch operation body using the read-modify-write instruction of the target, for integer types. For internal
+ * use only.
+ */
+#define __CUDL_ATOMIC_NATIVE_FETCH_BODY(_fetch)                                                                        \
+    result.value = _fetch(&atomic->value, value.value, order)// NOLINT(bugprone-reserved-identifier)
+/**
+ * @brief Fetch operation body using a compare and exchange loop, for floating point types that C11 atomics cannot
+ * add to. For internal use only.
+ */
+#define __CUDL_ATOMIC_CAS_FETCH_BODY(_op)                                                                              \
+    result.value = __CUDL_ATOMIC_LOAD(&atomic->value, relaxed);                                                        \
+    while (!__CUDL_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT(&atomic->value, &result.value, result.value _op value.value,  \
+                                                         order, __CUDL_MEMORY_ORDER(relaxed))) {                       \
+    }// NOLINT(bugprone-reserved-identifier)
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Adds an atomic version of the _name unit, named cudl_<name>_atomic_t, whose functions take and return the
+ * unit type, so that values shared between threads keep the unit safety. The functions follow the C11 atomics:
+ * - cudl_<name>_atomic_init(atomic, value);
+ * - cudl_<name>_atomic_load(atomic) and cudl_<name>_atomic_store(atomic, value);
+ * - cudl_<name>_atomic_exchange(atomic, value), which returns the previous value;
+ * - cudl_<name>_atomic_compare_exchange(atomic, &expected, desired) and cudl_<name>_atomic_compare_exchange_weak,
+ *   which store desired and return true if atomic is equal to expected, or update expected and return false;
+ * - cudl_<name>_atomic_fetch_add(atomic, value) and cudl_<name>_atomic_fetch_sub(atomic, value), which return the
+ *   previous value.
+ *
+ * Each function also has an _explicit version taking the memory order(s) as last parameters, e.g.
+ * cudl_<name>_atomic_load_explicit(atomic, memory_order_acquire), the default versions being sequentially consistent.
+ *
+ * cudl_<name>_padded_atomic_t holds a cudl_<name>_atomic_t in its atomic field, alone in its cache line, to avoid
+ * false sharing between atomics written by different threads, e.g. in an array of per thread counters.
+ * @include add_atomic_unit_example.c
+ * @param _name The name of the unit. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _type The underlying integer type of the unit. It is expected to be the same as the _type param used with
+ * CUDL_ADD_UNIT*.
+ */
+#define CUDL_ADD_ATOMIC_UNIT(_name, _type)                                                                             \
+    __CUDL_ATOMIC_UNIT_COMMON(_name, _type)                                                                            \
+    __CUDL_ATOMIC_FETCH_OP(_name, _fetch_add, __CUDL_ATOMIC_NATIVE_FETCH_BODY(__CUDL_ATOMIC_FETCH_ADD_EXPLICIT))       \
+    __CUDL_ATOMIC_FETCH_OP(_name, _fetch_sub, __CUDL_ATOMIC_NATIVE_FETCH_BODY(__CUDL_ATOMIC_FETCH_SUB_EXPLICIT))
+
+/**
+ * @brief Floating point version of #CUDL_ADD_ATOMIC_UNIT. C11 atomics cannot add to floating point values, so
+ * cudl_<name>_atomic_fetch_add and cudl_<name>_atomic_fetch_sub are compare and exchange loops, which retry when
+ * another thread modified the value in between.
+ * @include add_atomic_unit_example.c
+ * @param _name See #CUDL_ADD_ATOMIC_UNIT documentation.
+ * @param _type The underlying floating point type of the unit. It is expected to be the same as the _type param used
+ * with CUDL_ADD_UNIT*.
+ */
+#define CUDL_ADD_ATOMIC_FLOAT_UNIT(_name, _type)                                                                       \
+    __CUDL_ATOMIC_UNIT_COMMON(_name, _type)                                                                            \
+    __CUDL_ATOMIC_FETCH_OP(_name, _fetch_add, __CUDL_ATOMIC_CAS_FETCH_BODY(+))                                         \
+    __CUDL_ATOMIC_FETCH_OP(_name, _fetch_sub, __CUDL_ATOMIC_CAS_FETCH_BODY(-))
+
+/**
+ * @brief Adds a counter of the _name unit split in _shards padded atomics, named cudl_<name>_sharded_counter_t, for
+ * values incremented by many threads and read rarely, like packet byte counters. Each thread adds to its own shard, so
+ * that increments from different threads do not contend for the same cache line, and reading the counter sums every
+ * shard:
+ * - cudl_<name>_sharded_counter_init(counter) sets the counter to 0;
+ * - cudl_<name>_sharded_counter_add(counter, value) and cudl_<name>_sharded_counter_sub(counter, value) update the
+ *   shard of the calling thread with a relaxed atomic operation;
+ * - cudl_<name>_sharded_counter_load(counter) returns the sum of the shards. Increments made concurrently may or may
+ *   not be counted.
+ *
+ * Threads are assigned shards in the order they first use a sharded counter, so the counter does not contend as long
+ * as there are fewer threads than shards. It requires the atomic unit functions, added by #CUDL_ADD_ATOMIC_UNIT or
+ * #CUDL_ADD_ATOMIC_FLOAT_UNIT.
+ * @include add_atomic_unit_example.c
+ * @param _name See #CUDL_ADD_ATOMIC_UNIT documentation.
+ * @param _shards The number of shards. Each one uses #CUDL_CACHE_LINE_SIZE bytes.
+ */
+#define CUDL_ADD_SHARDED_COUNTER(_name, _shards)                                                                       \
+    typedef struct {                                                                                                   \
+        __CUDL_UT(_name##_padded_atomic) shards[_shards];                                                              \
+    } __CUDL_UT(_name##_sharded_counter);                                                                              \
+    static inline void __CUDL_FN(_name, _sharded_counter, _init)(__CUDL_UT(_name##_sharded_counter) * counter) {       \
+        __CUDL_UT(_name) zero;                                                                                         \
+        zero.value = 0;                                                                                                \
+        for (size_t i = 0; i < (_shards); ++i) { __CUDL_FN(_name, _atomic, _init)(&counter->shards[i].atomic, zero); } \
+    }                                                                                                                  \
+    static inline void __CUDL_FN(_name, _sharded_counter, _add)(__CUDL_UT(_name##_sharded_counter) * counter,          \
+                                                                __CUDL_UT(_name) value) {                              \
+        __CUDL_FN(_name, _atomic, _fetch_add_explicit)(&counter->shards[__cudl_thread_slot() % (_shards)].atomic,      \
+                                                       value, __CUDL_MEMORY_ORDER(relaxed));                           \
+    }                                                                                                                  \
+    static inline void __CUDL_FN(_name, _sharded_counter, _sub)(__CUDL_UT(_name##_sharded_counter) * counter,          \
+                                                                __CUDL_UT(_name) value) {                              \
+        __CUDL_FN(_name, _atomic, _fetch_sub_explicit)(&counter->shards[__cudl_thread_slot() % (_shards)].atomic,      \
+                                                       value, __CUDL_MEMORY_ORDER(relaxed));                           \
+    }                                                                                                                  \
+    static inline __CUDL_UT(_name) __CUDL_FN(_name, _sharded_counter, _load)(                                          \
+            __CUDL_UT(_name##_sharded_counter) * counter) {                                                            \
+        __CUDL_UT(_name) total;                                                                                        \
+        total.value = 0;                                                                                               \
+        for (size_t i = 0; i < (_shards); ++i) {                                                                       \
+            total.value += __CUDL_FN(_name, _atomic, _load_explicit)(&counter->shards[i].atomic,                       \
+                                                                     __CUDL_MEMORY_ORDER(relaxed))                     \
+                                   .value;                                                                             \
+        }                                                                                                              \
+        return total;                                                                                                  \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_ATOMIC_H
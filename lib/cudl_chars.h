@@ -0,0 +1,594 @@
+/**
+ * @file cudl_chars.h
+ * @author Olivier Allaire
+ * @brief Locale independent formatting and parsing of unit values with their unit suffix, like "3300mV" or "1.57rad".
+ */
+
+#ifndef CUDL_CHARS_H
+#define CUDL_CHARS_H
+
+#include "cudl.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size of a buffer large enough for any number written by the cudl_<name>_to_chars functions, without the
+ * suffix.
+ */
+#define CUDL_CHARS_NUMBER_SIZE 32
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Writes the decimal digits of value just before end and returns a pointer to the first one. The digits are
+ * produced two at a time from a table, which halves the number of divisions. For internal use only.
+ */
+static inline char *__cudl_chars_format_uint(char *end,// NOLINT(bugprone-reserved-identifier)
+                                             unsigned long long value) {
+    static const char pairs[] = "00010203040506070809101112131415161718192021222324"
+                                "25262728293031323334353637383940414243444546474849"
+                                "50515253545556575859606162636465666768697071727374"
+                                "75767778798081828384858687888990919293949596979899";
+    while (value >= 100) {
+        const size_t index = (size_t) (value % 100) * 2;
+        value /= 100;
+        *--end = pairs[index + 1];
+        *--end = pairs[index];
+    }
+    if (value >= 10) {
+        *--end = pairs[value * 2 + 1];
+        *--end = pairs[value * 2];
+    } else {
+        *--end = (char) ('0' + value);
+    }
+    return end;
+}
+
+/**
+ * @brief Copies the number and the suffix to buffer, if there is enough room for both, and returns the number of
+ * characters written (0 if there was not enough room). For internal use only.
+ */
+static inline size_t __cudl_chars_write(char *buffer, size_t len,// NOLINT(bugprone-reserved-identifier)
+                                        const char *number, size_t number_len, const char *suffix, size_t suffix_len) {
+    if (number_len + suffix_len > len) { return 0; }
+    memcpy(buffer, number, number_len);
+    memcpy(buffer + number_len, suffix, suffix_len);
+    return number_len + suffix_len;
+}
+static inline size_t __cudl_chars_write_integer(char *buffer, size_t len,// NOLINT(bugprone-reserved-identifier)
+                                                bool negative, unsigned long long magnitude, const char *suffix,
+                                                size_t suffix_len) {
+    char number[CUDL_CHARS_NUMBER_SIZE];
+    char *first = __cudl_chars_format_uint(number + sizeof(number), magnitude);
+    if (negative) { *--first = '-'; }
+    return __cudl_chars_write(buffer, len, first, (size_t) (number + sizeof(number) - first), suffix, suffix_len);
+}
+
+/**
+ * @brief Returns true if str starts with the suffix, and if the suffix is not directly followed by a letter, a digit
+ * or an underscore (so that "3mV" does not match the "m" suffix). For internal use only.
+ */
+static inline bool __cudl_chars_match_suffix(const char *str, size_t len,// NOLINT(bugprone-reserved-identifier)
+                                             const char *suffix, size_t suffix_len) {
+    if (suffix_len > len || memcmp(str, suffix, suffix_len) != 0) { return false; }
+    if (suffix_len == len) { return true; }
+    const char next = str[suffix_len];
+    return !((next >= '0' && next <= '9') || (next >= 'a' && next <= 'z') || (next >= 'A' && next <= 'Z') ||
+             next == '_');
+}
+
+/**
+ * @brief Parses an optional sign and decimal digits, and returns the number of characters used (0 if there is no
+ * digit or if the magnitude does not fit in an unsigned long long). For internal use only.
+ */
+static inline size_t __cudl_chars_scan_integer(const char *str, size_t len,// NOLINT(bugprone-reserved-identifier)
+                                               bool *negative, unsigned long long *magnitude) {
+    size_t i = 0;
+    *negative = false;
+    *magnitude = 0;
+    if (i < len && (str[i] == '-' || str[i] == '+')) { *negative = str[i++] == '-'; }
+    const size_t first_digit = i;
+    for (; i < len && str[i] >= '0' && str[i] <= '9'; ++i) {
+        const unsigned digit = (unsigned) (str[i] - '0');
+        if (*magnitude > (~0ULL - digit) / 10) { return 0; }
+        *magnitude = *magnitude * 10 + digit;
+    }
+    if (*magnitude == 0) { *negative = false; }
+    return i == first_digit ? 0 : i;
+}
+
+/**
+ * @brief Decimal number read from text: (-1)^negative * mantissa * 10^exponent. When the text has more than 19
+ * significant digits, only the 19 first ones are kept in mantissa and truncated tells if the other ones were not all
+ * zeros. For internal use only.
+ */
+typedef struct {
+    uint64_t mantissa;
+    int exponent;
+    bool negative;
+    bool truncated;
+    bool infinity;
+    bool nan;
+} __cudl_decimal_t;// NOLINT(bugprone-reserved-identifier)
+
+static inline size_t __cudl_chars_scan_decimal(const char *str, size_t len,// NOLINT(bugprone-reserved-identifier)
+                                               __cudl_decimal_t *decimal) {
+    size_t i = 0;
+    int significant = 0;
+    bool digits = false;
+    memset(decimal, 0, sizeof(*decimal));
+    if (i < len && (str[i] == '-' || str[i] == '+')) { decimal->negative = str[i++] == '-'; }
+    if (len - i >= 3 && (memcmp(str + i, "inf", 3) == 0 || memcmp(str + i, "nan", 3) == 0)) {
+        decimal->infinity = str[i] == 'i';
+        decimal->nan = str[i] == 'n';
+        return i + 3;
+    }
+    for (; i < len && str[i] >= '0' && str[i] <= '9'; ++i) {
+        digits = true;
+        if (significant < 19) {
+            decimal->mantissa = decimal->mantissa * 10 + (uint64_t) (str[i] - '0');
+            significant += decimal->mantissa != 0;
+        } else {
+            ++decimal->exponent;
+            decimal->truncated |= str[i] != '0';
+        }
+    }
+    if (i < len && str[i] == '.') {
+        for (++i; i < len && str[i] >= '0' && str[i] <= '9'; ++i) {
+            digits = true;
+            if (significant < 19) {
+                decimal->mantissa = decimal->mantissa * 10 + (uint64_t) (str[i] - '0');
+                significant += decimal->mantissa != 0;
+                --decimal->exponent;
+            } else {
+                decimal->truncated |= str[i] != '0';
+            }
+        }
+    }
+    if (!digits) { return 0; }
+    if (i < len && (str[i] == 'e' || str[i] == 'E')) {
+        size_t j = i + 1;
+        bool negative_exponent = false;
+        int exponent = 0;
+        if (j < len && (str[j] == '-' || str[j] == '+')) { negative_exponent = str[j++] == '-'; }
+        if (j < len && str[j] >= '0' && str[j] <= '9') {
+            for (; j < len && str[j] >= '0' && str[j] <= '9'; ++j) {
+                if (exponent < 100000) { exponent = exponent * 10 + (str[j] - '0'); }
+            }
+            decimal->exponent += negative_exponent ? -exponent : exponent;
+            i = j;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief Correctly rounded conversion of a decimal to a double or a float. Decimals that are exactly representable
+ * with a single multiplication or division are computed directly, the other ones are given to strtod (or strtof) as
+ * "<digits>e<exponent>", which is not affected by the locale. For internal use only.
+ */
+static inline char *__cudl_decimal_text(char *text,// NOLINT(bugprone-reserved-identifier)
+                                        const __cudl_decimal_t *decimal) {
+    char digits[CUDL_CHARS_NUMBER_SIZE];
+    char *first = __cudl_chars_format_uint(digits + sizeof(digits), decimal->mantissa);
+    char *end = text;
+    int exponent = decimal->exponent;
+    if (decimal->negative) { *end++ = '-'; }
+    memcpy(end, first, (size_t) (digits + sizeof(digits) - first));
+    end += digits + sizeof(digits) - first;
+    if (decimal->truncated) {
+        *end++ = '1';// Any non zero digit keeps the rounding direction of the truncated ones
+        --exponent;
+    }
+    *end++ = 'e';
+    if (exponent < 0) { *end++ = '-'; }
+    const unsigned long long exponent_magnitude = (unsigned long long) (exponent < 0 ? -exponent : exponent);
+    first = __cudl_chars_format_uint(digits + sizeof(digits), exponent_magnitude);
+    memcpy(end, first, (size_t) (digits + sizeof(digits) - first));
+    end += digits + sizeof(digits) - first;
+    *end = '\0';
+    return text;
+}
+static inline double __cudl_decimal_to_double(const __cudl_decimal_t *decimal) {// NOLINT(bugprone-reserved-identifier)
+    static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    if (decimal->nan) { return decimal->negative ? -(double) NAN : (double) NAN; }
+    if (decimal->infinity) { return decimal->negative ? -(double) INFINITY : (double) INFINITY; }
+    if (!decimal->truncated && decimal->mantissa <= (1ULL << 53) && decimal->exponent >= -22 &&
+        decimal->exponent <= 22) {
+        double value = (double) decimal->mantissa;
+        value = decimal->exponent < 0 ? value / powers[-decimal->exponent] : value * powers[decimal->exponent];
+        return decimal->negative ? -value : value;
+    }
+    char text[2 * CUDL_CHARS_NUMBER_SIZE];
+    return strtod(__cudl_decimal_text(text, decimal), NULL);
+}
+static inline float __cudl_decimal_to_float(const __cudl_decimal_t *decimal) {// NOLINT(bugprone-reserved-identifier)
+    static const float powers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    if (decimal->nan || decimal->infinity) { return (float) __cudl_decimal_to_double(decimal); }
+    if (!decimal->truncated && decimal->mantissa <= (1ULL << 24) && decimal->exponent >= -10 &&
+        decimal->exponent <= 10) {
+        float value = (float) decimal->mantissa;
+        value = decimal->exponent < 0 ? value / powers[-decimal->exponent] : value * powers[decimal->exponent];
+        return decimal->negative ? -value : value;
+    }
+    char text[2 * CUDL_CHARS_NUMBER_SIZE];
+    return strtof(__cudl_decimal_text(text, decimal), NULL);
+}
+
+/**
+ * @brief Shortest representation of floating point numbers with the Grisu2 algorithm of Florian Loitsch ("Printing
+ * Floating-Point Numbers Quickly and Accurately with Integers", 2010): the value and the boundaries of its rounding
+ * interval are scaled by a cached power of ten so that the digits can be produced with 64 bits integers only. The
+ * output always reads back to the same value, and is the shortest one for about 99.9% of the values. For internal use
+ * only.
+ */
+typedef struct {
+    uint64_t f;
+    int e;
+} __cudl_diy_fp_t;// NOLINT(bugprone-reserved-identifier)
+
+static inline __cudl_diy_fp_t __cudl_diy_fp(uint64_t f, int e) {// NOLINT(bugprone-reserved-identifier)
+    __cudl_diy_fp_t result;
+    result.f = f;
+    result.e = e;
+    return result;
+}
+static inline __cudl_diy_fp_t __cudl_diy_fp_normalize(__cudl_diy_fp_t x) {// NOLINT(bugprone-reserved-identifier)
+#if defined(__GNUC__) || defined(__clang__)
+    const int shift = __builtin_clzll(x.f);
+    x.f <<= shift;
+    x.e -= shift;
+#else
+    while (!(x.f & (1ULL << 63))) {
+        x.f <<= 1;
+        --x.e;
+    }
+#endif
+    return x;
+}
+static inline __cudl_diy_fp_t __cudl_diy_fp_multiply(__cudl_diy_fp_t x,// NOLINT(bugprone-reserved-identifier)
+                                                     __cudl_diy_fp_t y) {
+    const uint64_t a = x.f >> 32, b = x.f & 0xffffffffu, c = y.f >> 32, d = y.f & 0xffffffffu;
+    const uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    const uint64_t middle = (bd >> 32) + (ad & 0xffffffffu) + (bc & 0xffffffffu) + (1u << 31);
+    return __cudl_diy_fp(ac + (ad >> 32) + (bc >> 32) + (middle >> 32), x.e + y.e + 64);
+}
+static inline __cudl_diy_fp_t __cudl_cached_power(int e, int *k) {// NOLINT(bugprone-reserved-identifier)
+    static const uint64_t significands[] = {
+            0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+            0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+            0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+            0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+            0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+            0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+            0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+            0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+            0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+            0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+            0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+            0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+            0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+            0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+            0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+            0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+            0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+            0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+            0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+            0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+            0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+            0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL};
+    static const int16_t exponents[] = {
+            -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927, -901, -874, -847, -821,
+            -794, -768, -741, -715, -688, -661, -635, -608, -582, -555, -529, -502, -475, -449, -422, -396, -369, -343,
+            -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30, 56, 83, 109, 136, 162, 189, 216,
+            242, 269, 295, 322, 348, 375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747, 774,
+            800, 827, 853, 880, 907, 933, 960, 986, 1013, 1039, 1066};
+    const double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = (int) dk;
+    if (dk - ik > 0.0) { ++ik; }
+    const int index = (ik >> 3) + 1;
+    *k = -(-348 + index * 8);
+    return __cudl_diy_fp(significands[index], exponents[index]);
+}
+static inline void __cudl_grisu_round(char *digits, int len, uint64_t delta,// NOLINT(bugprone-reserved-identifier)
+                                      uint64_t rest, uint64_t ten_kappa, uint64_t wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        --digits[len - 1];
+        rest += ten_kappa;
+    }
+}
+static inline int __cudl_grisu_digits(__cudl_diy_fp_t w, __cudl_diy_fp_t mp,// NOLINT(bugprone-reserved-identifier)
+                                      uint64_t delta, char *digits, int *k) {
+    static const uint64_t powers[] = {1ULL,
+                                      10ULL,
+                                      100ULL,
+                                      1000ULL,
+                                      10000ULL,
+                                      100000ULL,
+                                      1000000ULL,
+                                      10000000ULL,
+                                      100000000ULL,
+                                      1000000000ULL,
+                                      10000000000ULL,
+                                      100000000000ULL,
+                                      1000000000000ULL,
+                                      10000000000000ULL,
+                                      100000000000000ULL,
+                                      1000000000000000ULL,
+                                      10000000000000000ULL,
+                                      100000000000000000ULL,
+                                      1000000000000000000ULL,
+                                      10000000000000000000ULL};
+    const __cudl_diy_fp_t one = __cudl_diy_fp(1ULL << -mp.e, mp.e);
+    const uint64_t wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t) (mp.f >> -one.e);
+    uint64_t p2 = mp.f & (one.f - 1);
+    int kappa = 1;
+    int len = 0;
+    while (kappa < 10 && p1 >= powers[kappa]) { ++kappa; }
+    while (kappa > 0) {
+        const uint32_t divisor = (uint32_t) powers[kappa - 1];
+        const uint32_t digit = p1 / divisor;
+        p1 %= divisor;
+        if (digit != 0 || len != 0) { digits[len++] = (char) ('0' + digit); }
+        --kappa;
+        const uint64_t rest = ((uint64_t) p1 << -one.e) + p2;
+        if (rest <= delta) {
+            *k += kappa;
+            __cudl_grisu_round(digits, len, delta, rest, powers[kappa] << -one.e, wp_w);
+            return len;
+        }
+    }
+    for (;;) {
+        p2 *= 10;
+        delta *= 10;
+        const char digit = (char) (p2 >> -one.e);
+        if (digit != 0 || len != 0) { digits[len++] = (char) ('0' + digit); }
+        p2 &= one.f - 1;
+        --kappa;
+        if (p2 < delta) {
+            *k += kappa;
+            __cudl_grisu_round(digits, len, delta, p2, one.f, -kappa < 20 ? wp_w * powers[-kappa] : 0);
+            return len;
+        }
+    }
+}
+static inline int __cudl_grisu2(__cudl_diy_fp_t v, bool lower_closer,// NOLINT(bugprone-reserved-identifier)
+                                char *digits, int *k) {
+    const __cudl_diy_fp_t plus = __cudl_diy_fp_normalize(__cudl_diy_fp((v.f << 1) + 1, v.e - 1));
+    __cudl_diy_fp_t minus =
+            lower_closer ? __cudl_diy_fp((v.f << 2) - 1, v.e - 2) : __cudl_diy_fp((v.f << 1) - 1, v.e - 1);
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    const __cudl_diy_fp_t cached = __cudl_cached_power(plus.e, k);
+    const __cudl_diy_fp_t w = __cudl_diy_fp_multiply(__cudl_diy_fp_normalize(v), cached);
+    __cudl_diy_fp_t scaled_plus = __cudl_diy_fp_multiply(plus, cached);
+    __cudl_diy_fp_t scaled_minus = __cudl_diy_fp_multiply(minus, cached);
+    ++scaled_minus.f;
+    --scaled_plus.f;
+    return __cudl_grisu_digits(w, scaled_plus, scaled_plus.f - scaled_minus.f, digits, k);
+}
+
+/**
+ * @brief Writes digits * 10^k like JavaScript does: without exponent from 1e-6 to 1e21, with one otherwise. For
+ * internal use only.
+ */
+static inline char *__cudl_chars_prettify(char *out, const char *digits, int len,// NOLINT(bugprone-reserved-identifier)
+                                          int k) {
+    const int kk = len + k;
+    if (k >= 0 && kk <= 21) {
+        memcpy(out, digits, (size_t) len);
+        memset(out + len, '0', (size_t) k);
+        return out + kk;
+    }
+    if (kk > 0 && kk <= 21) {
+        memcpy(out, digits, (size_t) kk);
+        out[kk] = '.';
+        memcpy(out + kk + 1, digits + kk, (size_t) (len - kk));
+        return out + len + 1;
+    }
+    if (kk > -6 && kk <= 0) {
+        out[0] = '0';
+        out[1] = '.';
+        memset(out + 2, '0', (size_t) -kk);
+        memcpy(out + 2 - kk, digits, (size_t) len);
+        return out + 2 - kk + len;
+    }
+    *out++ = digits[0];
+    if (len > 1) {
+        *out++ = '.';
+        memcpy(out, digits + 1, (size_t) (len - 1));
+        out += len - 1;
+    }
+    *out++ = 'e';
+    if (kk - 1 < 0) { *out++ = '-'; }
+    char exponent[8];
+    const int exponent_value = kk < 1 ? 1 - kk : kk - 1;
+    char *first = __cudl_chars_format_uint(exponent + sizeof(exponent), (unsigned long long) exponent_value);
+    memcpy(out, first, (size_t) (exponent + sizeof(exponent) - first));
+    return out + (exponent + sizeof(exponent) - first);
+}
+
+/**
+ * @brief Writes the shortest representation of a float or a double, from the sign bit, the biased exponent and the
+ * fraction bits of its IEEE 754 encoding, and returns the number of characters written. For internal use only.
+ */
+static inline size_t __cudl_chars_format_ieee(// NOLINT(bugprone-reserved-identifier)
+        char *out, bool negative, int biased, uint64_t fraction, int fraction_bits, int max_biased, int exponent_bias) {
+    char digits[24];
+    char *end = out;
+    if (biased == max_biased) {
+        if (fraction != 0) {
+            memcpy(out, "nan", 3);
+            return 3;
+        }
+        if (negative) { *end++ = '-'; }
+        memcpy(end, "inf", 3);
+        return (size_t) (end + 3 - out);
+    }
+    if (negative) { *end++ = '-'; }
+    if (biased == 0 && fraction == 0) {
+        *end++ = '0';
+        return (size_t) (end - out);
+    }
+    const __cudl_diy_fp_t v = biased != 0 ? __cudl_diy_fp(fraction | (1ULL << fraction_bits), biased - exponent_bias)
+                                          : __cudl_diy_fp(fraction, 1 - exponent_bias);
+    int k = 0;
+    const int len = __cudl_grisu2(v, biased > 1 && fraction == 0, digits, &k);
+    return (size_t) (__cudl_chars_prettify(end, digits, len, k) - out);
+}
+static inline size_t __cudl_chars_format_double(char *out, double value) {// NOLINT(bugprone-reserved-identifier)
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return __cudl_chars_format_ieee(out, (bits >> 63) != 0, (int) ((bits >> 52) & 0x7ff), bits & ((1ULL << 52) - 1),
+                                    52, 0x7ff, 1075);
+}
+static inline size_t __cudl_chars_format_float(char *out, float value) {// NOLINT(bugprone-reserved-identifier)
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return __cudl_chars_format_ieee(out, (bits >> 31) != 0, (int) ((bits >> 23) & 0xff), bits & ((1u << 23) - 1), 23,
+                                    0xff, 150);
+}
+
+/**
+ * @brief Tries to parse the text as a value of the _unit unit, and converts it to the _name unit with the function
+ * added by CUDL_ADD_CONVERSION_* when it succeeds. For internal use only.
+ */
+#define __CUDL_CHARS_FROM_CONVERTED(_name, _unit)                                                                      \
+    {                                                                                                                  \
+        __CUDL_UT(_unit) converted;                                                                                    \
+        const size_t converted_used = __CUDL_FN(_unit, _from, _chars)(str, len, &converted);                           \
+        if (converted_used != 0) {                                                                                     \
+            *value = __CUDL_L1STR(__CUDL_AP(from_##_unit##_to_), _name)(converted);                                    \
+            return converted_used;                                                                                     \
+        }                                                                                                              \
+    }
+
+/**
+ * @brief Generators behind the public CUDL_ADD_*_CHARS* macros. _conversions are statements trying the other units
+ * when the text does not end with _suffix. For internal use only.
+ */
+#define __CUDL_INTEGER_CHARS(_name, _type, _suffix, _conversions)                                                      \
+    static inline size_t __CUDL_FN(_name, _to, _chars)(char *buffer, size_t len, __CUDL_UT(_name) value) {             \
+        const bool negative = __CUDL_TYPE_IS_SIGNED(_type) && (long long) value.value < 0;                             \
+        const unsigned long long magnitude =                                                                           \
+                negative ? 0ULL - (unsigned long long) (long long) value.value : (unsigned long long) value.value;     \
+        return __cudl_chars_write_integer(buffer, len, negative, magnitude, _suffix, sizeof(_suffix) - 1);             \
+    }                                                                                                                  \
+    static inline size_t __CUDL_FN(_name, _from, _chars)(const char *str, size_t len, __CUDL_UT(_name) * value) {      \
+        bool negative;                                                                                                 \
+        unsigned long long magnitude;                                                                                  \
+        const size_t used = __cudl_chars_scan_integer(str, len, &negative, &magnitude);                                \
+        if (used != 0 && __cudl_chars_match_suffix(str + used, len - used, _suffix, sizeof(_suffix) - 1) &&            \
+            (negative ? __CUDL_TYPE_IS_SIGNED(_type) && magnitude - 1 <= (unsigned long long) __CUDL_TYPE_MAX(_type)   \
+                      : magnitude <= (unsigned long long) __CUDL_TYPE_MAX(_type))) {                                   \
+            value->value = negative ? (_type) (-(long long) (magnitude - 1) - 1) : (_type) magnitude;                  \
+            return used + sizeof(_suffix) - 1;                                                                         \
+        }                                                                                                              \
+        _conversions return 0;                                                                                         \
+    }
+#define __CUDL_FLOAT_CHARS(_name, _type, _suffix, _conversions)                                                        \
+    static inline size_t __CUDL_FN(_name, _to, _chars)(char *buffer, size_t len, __CUDL_UT(_name) value) {             \
+        char number[CUDL_CHARS_NUMBER_SIZE];                                                                           \
+        const size_t number_len = sizeof(_type) == sizeof(float)                                                       \
+                                          ? __cudl_chars_format_float(number, (float) value.value)                     \
+                                          : __cudl_chars_format_double(number, (double) value.value);                  \
+        return __cudl_chars_write(buffer, len, number, number_len, _suffix, sizeof(_suffix) - 1);                      \
+    }                                                                                                                  \
+    static inline size_t __CUDL_FN(_name, _from, _chars)(const char *str, size_t len, __CUDL_UT(_name) * value) {      \
+        __cudl_decimal_t decimal;                                                                                      \
+        const size_t used = __cudl_chars_scan_decimal(str, len, &decimal);                                             \
+        if (used != 0 && __cudl_chars_match_suffix(str + used, len - used, _suffix, sizeof(_suffix) - 1)) {            \
+            value->value = sizeof(_type) == sizeof(float) ? (_type) __cudl_decimal_to_float(&decimal)                  \
+                                                          : (_type) __cudl_decimal_to_double(&decimal);                \
+            return used + sizeof(_suffix) - 1;                                                                         \
+        }                                                                                                              \
+        _conversions return 0;                                                                                         \
+    }
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Adds functions to format and parse values of an integer unit with their suffix, independently of the locale
+ * and without allocation:
+ * - size_t cudl_<name>_to_chars(buffer, len, value) writes the value followed by the suffix, e.g. "-3300mV", to
+ *   buffer and returns the number of characters written. Nothing is written and 0 is returned if len is too small
+ *   (#CUDL_CHARS_NUMBER_SIZE plus the suffix length is always enough). Like C++ std::to_chars, no terminating null
+ *   character is written;
+ * - size_t cudl_<name>_from_chars(str, len, &value) parses a decimal integer, with an optional sign, directly followed
+ *   by the suffix. It returns the number of characters used, or 0 if str does not start with such a value, if the
+ *   value does not fit in _type or if the suffix is followed by a letter, a digit or an underscore.
+ * @include add_chars_example.c
+ * @param _name The unit to add the functions for. It is expected to be the same as the _name param used with
+ * CUDL_ADD_UNIT*.
+ * @param _type The underlying integer type. It is expected to be the same as the _type param used with CUDL_ADD_UNIT*.
+ * @param _suffix The unit suffix, as a string literal, e.g. "mV".
+ */
+#define CUDL_ADD_EXPLICIT_INTEGER_CHARS(_name, _type, _suffix) __CUDL_INTEGER_CHARS(_name, _type, _suffix, )
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_INTEGER_CHARS using the name of the unit as suffix.
+ * @include add_chars_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_INTEGER_CHARS documentation.
+ * @param _type See #CUDL_ADD_EXPLICIT_INTEGER_CHARS documentation.
+ */
+#define CUDL_ADD_INTEGER_CHARS(_name, _type) CUDL_ADD_EXPLICIT_INTEGER_CHARS(_name, _type, #_name)
+
+/**
+ * @brief Version of #CUDL_ADD_EXPLICIT_INTEGER_CHARS whose cudl_<name>_from_chars also accepts values of other units,
+ * like "3.3V" for a mV unit. When the text does not end with _suffix, the units given after it are tried in order with
+ * their own cudl_<unit>_from_chars, and the first value parsed is converted with cudl_from_<unit>_to_<name>. So each of
+ * these units needs its *_CHARS functions, and a conversion to _name added with CUDL_ADD_CONVERSION_* (or
+ * CUDL_ADD_REDUCED_CONVERSION_*).
+ * @include add_chars_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_INTEGER_CHARS documentation.
+ * @param _type See #CUDL_ADD_EXPLICIT_INTEGER_CHARS documentation.
+ * @param _suffix See #CUDL_ADD_EXPLICIT_INTEGER_CHARS documentation.
+ * @param ... The other units accepted (up to 16).
+ */
+#define CUDL_ADD_EXPLICIT_INTEGER_CHARS_WITH_CONVERSIONS(_name, _type, _suffix, ...)                                   \
+    __CUDL_INTEGER_CHARS(_name, _type, _suffix, __CUDL_FOR_EACH(__CUDL_CHARS_FROM_CONVERTED, _name, __VA_ARGS__))
+
+/**
+ * @brief Floating point version of #CUDL_ADD_EXPLICIT_INTEGER_CHARS. cudl_<name>_to_chars writes the shortest text that
+ * reads back to the same value (e.g. "1.57rad", "1e-7rad"), with the Grisu2 algorithm, which does not need an
+ * arbitrary precision fallback and is the shortest one for about 99.9% of the values. cudl_<name>_from_chars also
+ * accepts an exponent, "inf" and "nan", and is correctly rounded. Only float and double are supported.
+ * @include add_chars_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_INTEGER_CHARS documentation.
+ * @param _type The underlying floating point type. It is expected to be the same as the _type param used with
+ * CUDL_ADD_UNIT*.
+ * @param _suffix See #CUDL_ADD_EXPLICIT_INTEGER_CHARS documentation.
+ */
+#define CUDL_ADD_EXPLICIT_FLOAT_CHARS(_name, _type, _suffix) __CUDL_FLOAT_CHARS(_name, _type, _suffix, )
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_FLOAT_CHARS using the name of the unit as suffix.
+ * @include add_chars_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_FLOAT_CHARS documentation.
+ * @param _type See #CUDL_ADD_EXPLICIT_FLOAT_CHARS documentation.
+ */
+#define CUDL_ADD_FLOAT_CHARS(_name, _type) CUDL_ADD_EXPLICIT_FLOAT_CHARS(_name, _type, #_name)
+
+/**
+ * @brief Version of #CUDL_ADD_EXPLICIT_FLOAT_CHARS accepting values of other units, see
+ * #CUDL_ADD_EXPLICIT_INTEGER_CHARS_WITH_CONVERSIONS.
+ * @include add_chars_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_FLOAT_CHARS documentation.
+ * @param _type See #CUDL_ADD_EXPLICIT_FLOAT_CHARS documentation.
+ * @param _suffix See #CUDL_ADD_EXPLICIT_FLOAT_CHARS documentation.
+ * @param ... The other units accepted (up to 16).
+ */
+#define CUDL_ADD_EXPLICIT_FLOAT_CHARS_WITH_CONVERSIONS(_name, _type, _suffix, ...)                                     \
+    __CUDL_FLOAT_CHARS(_name, _type, _suffix, __CUDL_FOR_EACH(__CUDL_CHARS_FROM_CONVERTED, _name, __VA_ARGS__))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_CHARS_H
@@ -0,0 +1,289 @@
+/**
+ * @file cudl_filter.h
+ * @author Olivier Allaire
+ * @brief Streaming filters of the values of a unit defined with cudl.h: moving average, FIR and biquad IIR filters,
+ * and decimation. They keep their state between calls, so a stream is filtered chunk by chunk as it arrives, and their
+ * outputs are values of the unit.
+ */
+
+#ifndef CUDL_FILTER_H
+#define CUDL_FILTER_H
+
+#include "cudl.h"
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CUDL_FILTER_BLOCK_SIZE
+/**
+ * @brief Number of values that the FIR filters added by #CUDL_ADD_EXPLICIT_FIR_FILTER process at once. Each filter
+ * holds a block of values, and its process function an accumulator per value of a block on the stack. It can be
+ * redefined before including this header.
+ */
+#define CUDL_FILTER_BLOCK_SIZE 256
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Divides an accumulated sum of products by the scale of the coefficients, rounding to the nearest like the
+ * fixed-point division of cudl.h. The half of the scale is constant folded, and is 0 for a floating point accumulator.
+ * For internal use only.
+ */
+#define __CUDL_FILTER_HALF(_acc_type, _coef_scale)                                                                     \
+    ((_acc_type) 1 / 2 != 0 ? (_acc_type) 0 : (_acc_type) (_coef_scale) / 2)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_FILTER_SCALE(_acc_type, _coef_scale, _acc)                                                              \
+    (((_acc) + ((_acc) < 0 ? -__CUDL_FILTER_HALF(_acc_type, _coef_scale)                                               \
+                           : __CUDL_FILTER_HALF(_acc_type, _coef_scale))) /                                            \
+     (_acc_type) (_coef_scale))// NOLINT(bugprone-reserved-identifier)
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Adds a moving average of the last _window values of the _name unit, named cudl_<filter name>_t, computed with
+ * a running sum: each value costs an addition and a subtraction whatever the window is. It must be initialized with
+ * cudl_<filter name>_init(filter) before use, then cudl_<filter name>_process_n(filter, dst, src, n) writes in dst[i]
+ * the average of the _window values up to src[i]. The values before the first one are 0, like for an FIR filter, and
+ * the averages are truncated like an integer division. dst may be src to filter in place.
+ *
+ * The sum is accumulated in _sum_type, which must hold the sum of _window values, e.g. int32_t for a window of up to
+ * 65536 int16_t values. It is summed again from the window each time the window has been replaced, which costs one
+ * addition per value more but prevents the rounding errors of a floating point running sum from accumulating.
+ * @include add_filter_example.c
+ * @param _name The unit of the values. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _filter_name The name of the filter. This will be used to define the filter type and its functions.
+ * @param _sum_type The type the sum of the window is accumulated in.
+ * @param _window The number of averaged values.
+ */
+#define CUDL_ADD_EXPLICIT_MOVING_AVERAGE(_name, _filter_name, _sum_type, _window)                                      \
+    __CUDL_STATIC_ASSERT((_window) >= 1, "The window of a moving average must have at least 1 value");                 \
+    typedef struct {                                                                                                   \
+        _sum_type sum;                                                                                                 \
+        size_t next;                                                                                                   \
+        __CUDL_STORAGE(_name) window[_window];                                                                         \
+    } __CUDL_UT(_filter_name);                                                                                         \
+    static inline void __CUDL_L1STR(__CUDL_AP(_filter_name), _init)(__CUDL_UT(_filter_name) * filter) {                \
+        memset(filter, 0, sizeof(*filter));                                                                            \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(__CUDL_AP(_filter_name), _process_n)(__CUDL_UT(_filter_name) * filter,             \
+                                                                         __CUDL_UT(_name) * dst,                       \
+                                                                         const __CUDL_UT(_name) * src, size_t n) {     \
+        _sum_type sum = filter->sum;                                                                                   \
+        size_t next = filter->next;                                                                                    \
+        for (size_t i = 0; i < n; ++i) {                                                                               \
+            const __CUDL_STORAGE(_name) oldest = filter->window[next];                                                 \
+            filter->window[next] = src[i].value;                                                                       \
+            sum += (_sum_type) src[i].value;                                                                           \
+            sum -= (_sum_type) oldest;                                                                                 \
+            if (++next == (_window)) {                                                                                 \
+                next = 0;                                                                                              \
+                sum = 0;                                                                                               \
+                for (size_t j = 0; j < (_window); ++j) { sum += (_sum_type) filter->window[j]; }                       \
+            }                                                                                                          \
+            dst[i] = __CUDL_AP(_name)((__CUDL_STORAGE(_name)) (sum / (_sum_type) (_window)));                          \
+        }                                                                                                              \
+        filter->sum = sum;                                                                                             \
+        filter->next = next;                                                                                           \
+    }
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_MOVING_AVERAGE naming the filter <name>_moving_average, e.g.
+ * cudl_mv_moving_average_t and cudl_mv_moving_average_process_n for the mv unit.
+ * @include add_filter_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_MOVING_AVERAGE documentation.
+ * @param _sum_type See #CUDL_ADD_EXPLICIT_MOVING_AVERAGE documentation.
+ * @param _window See #CUDL_ADD_EXPLICIT_MOVING_AVERAGE documentation.
+ */
+#define CUDL_ADD_MOVING_AVERAGE(_name, _sum_type, _window)                                                             \
+    CUDL_ADD_EXPLICIT_MOVING_AVERAGE(_name, _name##_moving_average, _sum_type, _window)
+
+/**
+ * @brief Adds a FIR filter of _taps coefficients of the values of the _name unit, named cudl_<filter name>_t:
+ * - cudl_<filter name>_init(filter, coefs) sets the _taps coefficients, coefs[0] applying to the newest value, and
+ *   clears the history of the filter;
+ * - cudl_<filter name>_process_n(filter, dst, src, n) writes in dst[i] the sum of coefs[k] * src[i - k] divided by
+ *   _coef_scale, the values before the first one being 0. dst may be src to filter in place.
+ *
+ * The coefficients are values of _coef_type scaled by _coef_scale: for an integer unit they are typically fixed-point
+ * integers, e.g. int16_t coefficients with a scale of 1 << 15 for coefficients from -1 to 1, and for a floating point
+ * unit they are floating point values with a scale of 1. The products are accumulated in _acc_type, which must hold
+ * the sum of _taps products, e.g. int32_t for int16_t values and coefficients, then divided by _coef_scale (rounded to
+ * the nearest for an integer accumulator) and converted to the storage type without saturation.
+ *
+ * The values are processed by blocks of #CUDL_FILTER_BLOCK_SIZE, appended to the last _taps - 1 values kept from the
+ * previous block. The convolution loops over the values of a block for each coefficient, so it is vectorized by GCC and
+ * Clang (-O3, or -O2 with -ftree-vectorize), floating point ones included since the sum of each output is accumulated
+ * in the order of the coefficients.
+ * @include add_filter_example.c
+ * @param _name The unit of the values. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _filter_name The name of the filter. This will be used to define the filter type and its functions.
+ * @param _taps The number of coefficients.
+ * @param _coef_type The type of the coefficients.
+ * @param _acc_type The type the products are accumulated in.
+ * @param _coef_scale The value of a coefficient of 1, the sums being divided by it.
+ */
+#define CUDL_ADD_EXPLICIT_FIR_FILTER(_name, _filter_name, _taps, _coef_type, _acc_type, _coef_scale)                   \
+    __CUDL_STATIC_ASSERT((_taps) >= 1, "A FIR filter must have at least 1 coefficient");                               \
+    typedef struct {                                                                                                   \
+        _coef_type reversed_coefs[_taps];                                                                              \
+        __CUDL_STORAGE(_name) line[(_taps) - 1 + CUDL_FILTER_BLOCK_SIZE];                                              \
+    } __CUDL_UT(_filter_name);                                                                                         \
+    static inline void __CUDL_L1STR(__CUDL_AP(_filter_name), _init)(__CUDL_UT(_filter_name) * filter,                  \
+                                                                    const _coef_type *coefs) {                         \
+        for (size_t k = 0; k < (_taps); ++k) { filter->reversed_coefs[k] = coefs[(_taps) - 1 - k]; }                   \
+        memset(filter->line, 0, sizeof(filter->line));                                                                 \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(__CUDL_AP(_filter_name), _process_n)(__CUDL_UT(_filter_name) * filter,             \
+                                                                         __CUDL_UT(_name) * dst,                       \
+                                                                         const __CUDL_UT(_name) * src, size_t n) {     \
+        _acc_type acc[CUDL_FILTER_BLOCK_SIZE];                                                                         \
+        for (size_t done = 0; done < n;) {                                                                             \
+            const size_t block = n - done < CUDL_FILTER_BLOCK_SIZE ? n - done : CUDL_FILTER_BLOCK_SIZE;                \
+            for (size_t i = 0; i < block; ++i) {                                                                       \
+                filter->line[(_taps) - 1 + i] = src[done + i].value;                                                   \
+                acc[i] = 0;                                                                                            \
+            }                                                                                                          \
+            for (size_t k = 0; k < (_taps); ++k) {                                                                     \
+                const _acc_type coef = (_acc_type) filter->reversed_coefs[k];                                          \
+                const __CUDL_STORAGE(_name) *values = filter->line + k;                                                \
+                for (size_t i = 0; i < block; ++i) { acc[i] += coef * (_acc_type) values[i]; }                         \
+            }                                                                                                          \
+            for (size_t i = 0; i < block; ++i) {                                                                       \
+                const _acc_type scaled = __CUDL_FILTER_SCALE(_acc_type, _coef_scale, acc[i]);                          \
+                dst[done + i] = __CUDL_AP(_name)((__CUDL_STORAGE(_name)) scaled);                                      \
+            }                                                                                                          \
+            memmove(filter->line, filter->line + block, ((_taps) - 1) * sizeof(filter->line[0]));                      \
+            done += block;                                                                                             \
+        }                                                                                                              \
+    }
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_FIR_FILTER naming the filter <name>_fir, e.g. cudl_mv_fir_t and
+ * cudl_mv_fir_process_n for the mv unit.
+ * @include add_filter_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_FIR_FILTER documentation.
+ * @param _taps See #CUDL_ADD_EXPLICIT_FIR_FILTER documentation.
+ * @param _coef_type See #CUDL_ADD_EXPLICIT_FIR_FILTER documentation.
+ * @param _acc_type See #CUDL_ADD_EXPLICIT_FIR_FILTER documentation.
+ * @param _coef_scale See #CUDL_ADD_EXPLICIT_FIR_FILTER documentation.
+ */
+#define CUDL_ADD_FIR_FILTER(_name, _taps, _coef_type, _acc_type, _coef_scale)                                          \
+    CUDL_ADD_EXPLICIT_FIR_FILTER(_name, _name##_fir, _taps, _coef_type, _acc_type, _coef_scale)
+
+/**
+ * @brief Adds a biquad IIR filter (second order section) of the values of the _name unit, named cudl_<filter name>_t:
+ * - cudl_<filter name>_init(filter, coefs) sets the 5 coefficients b0, b1, b2, a1 and a2, a0 being 1, and clears the
+ *   history of the filter;
+ * - cudl_<filter name>_process_n(filter, dst, src, n) writes in dst[i] (b0 * x[i] + b1 * x[i - 1] + b2 * x[i - 2] -
+ *   a1 * y[i - 1] - a2 * y[i - 2]) / _coef_scale, x being the values of src and y the ones of dst, the values before
+ *   the first one being 0. dst may be src to filter in place.
+ *
+ * The coefficients and the accumulator are scaled and typed as for #CUDL_ADD_EXPLICIT_FIR_FILTER. The filter is in
+ * direct form I, which keeps the previous inputs and outputs as values of the unit: the only rounding is the one of
+ * each output, to the nearest so that it does not bias the feedback, and an integer accumulator only has to hold the
+ * sum of the 5 products, which suits integer and fixed-point units. Each output depends on the previous ones, so the
+ * loop is not vectorized.
+ * @include add_filter_example.c
+ * @param _name The unit of the values. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _filter_name The name of the filter. This will be used to define the filter type and its functions.
+ * @param _coef_type The type of the coefficients.
+ * @param _acc_type The type the products are accumulated in.
+ * @param _coef_scale The value of a coefficient of 1, the sums being divided by it.
+ */
+#define CUDL_ADD_EXPLICIT_BIQUAD_FILTER(_name, _filter_name, _coef_type, _acc_type, _coef_scale)                       \
+    typedef struct {                                                                                                   \
+        _coef_type b0, b1, b2, a1, a2;                                                                                 \
+        __CUDL_STORAGE(_name) x1, x2, y1, y2;                                                                          \
+    } __CUDL_UT(_filter_name);                                                                                         \
+    static inline void __CUDL_L1STR(__CUDL_AP(_filter_name), _init)(__CUDL_UT(_filter_name) * filter,                  \
+                                                                    const _coef_type *coefs) {                         \
+        memset(filter, 0, sizeof(*filter));                                                                            \
+        filter->b0 = coefs[0];                                                                                         \
+        filter->b1 = coefs[1];                                                                                         \
+        filter->b2 = coefs[2];                                                                                         \
+        filter->a1 = coefs[3];                                                                                         \
+        filter->a2 = coefs[4];                                                                                         \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(__CUDL_AP(_filter_name), _process_n)(__CUDL_UT(_filter_name) * filter,             \
+                                                                         __CUDL_UT(_name) * dst,                       \
+                                                                         const __CUDL_UT(_name) * src, size_t n) {     \
+        __CUDL_STORAGE(_name) x1 = filter->x1, x2 = filter->x2, y1 = filter->y1, y2 = filter->y2;                      \
+        for (size_t i = 0; i < n; ++i) {                                                                               \
+            const __CUDL_STORAGE(_name) x = src[i].value;                                                              \
+            const _acc_type acc = (_acc_type) filter->b0 * x + (_acc_type) filter->b1 * x1 +                           \
+                                  (_acc_type) filter->b2 * x2 - (_acc_type) filter->a1 * y1 -                          \
+                                  (_acc_type) filter->a2 * y2;                                                         \
+            const __CUDL_STORAGE(_name) y =                                                                            \
+                    (__CUDL_STORAGE(_name)) __CUDL_FILTER_SCALE(_acc_type, _coef_scale, acc);                          \
+            x2 = x1;                                                                                                   \
+            x1 = x;                                                                                                    \
+            y2 = y1;                                                                                                   \
+            y1 = y;                                                                                                    \
+            dst[i] = __CUDL_AP(_name)(y);                                                                              \
+        }                                                                                                              \
+        filter->x1 = x1;                                                                                               \
+        filter->x2 = x2;                                                                                               \
+        filter->y1 = y1;                                                                                               \
+        filter->y2 = y2;                                                                                               \
+    }
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_BIQUAD_FILTER naming the filter <name>_biquad, e.g.
+ * cudl_mv_biquad_t and cudl_mv_biquad_process_n for the mv unit.
+ * @include add_filter_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_BIQUAD_FILTER documentation.
+ * @param _coef_type See #CUDL_ADD_EXPLICIT_BIQUAD_FILTER documentation.
+ * @param _acc_type See #CUDL_ADD_EXPLICIT_BIQUAD_FILTER documentation.
+ * @param _coef_scale See #CUDL_ADD_EXPLICIT_BIQUAD_FILTER documentation.
+ */
+#define CUDL_ADD_BIQUAD_FILTER(_name, _coef_type, _acc_type, _coef_scale)                                              \
+    CUDL_ADD_EXPLICIT_BIQUAD_FILTER(_name, _name##_biquad, _coef_type, _acc_type, _coef_scale)
+
+/**
+ * @brief Adds a decimator keeping one value of the _name unit out of _factor, named cudl_<decimator name>_t. It must
+ * be initialized with cudl_<decimator name>_init(decimator) before use, then size_t cudl_<decimator name>_process_n(
+ * decimator, dst, src, n) copies src[0], src[_factor], src[2 * _factor]... of the whole stream to dst and returns how
+ * many were copied: the position in the stream is kept between calls, whatever the size of the chunks. dst must have
+ * room for n / _factor + 1 values, and may be src to decimate in place.
+ *
+ * The decimator does not filter: the stream should be low-pass filtered first, e.g. with a FIR filter or a moving
+ * average of _factor values, so that the frequencies above the new Nyquist frequency do not alias.
+ * @include add_filter_example.c
+ * @param _name The unit of the values. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _decimator_name The name of the decimator. This will be used to define the decimator type and its functions.
+ * @param _factor The decimation factor.
+ */
+#define CUDL_ADD_EXPLICIT_DECIMATOR(_name, _decimator_name, _factor)                                                   \
+    __CUDL_STATIC_ASSERT((_factor) >= 1, "The factor of a decimator must be at least 1");                              \
+    typedef struct {                                                                                                   \
+        size_t skip;                                                                                                   \
+    } __CUDL_UT(_decimator_name);                                                                                      \
+    static inline void __CUDL_L1STR(__CUDL_AP(_decimator_name), _init)(__CUDL_UT(_decimator_name) * decimator) {       \
+        decimator->skip = 0;                                                                                           \
+    }                                                                                                                  \
+    static inline size_t __CUDL_L1STR(__CUDL_AP(_decimator_name), _process_n)(__CUDL_UT(_decimator_name) * decimator,  \
+                                                                              __CUDL_UT(_name) * dst,                  \
+                                                                              const __CUDL_UT(_name) * src,            \
+                                                                              size_t n) {                              \
+        size_t count = 0;                                                                                              \
+        size_t i = decimator->skip;                                                                                    \
+        for (; i < n; i += (_factor)) { dst[count++] = src[i]; }                                                       \
+        decimator->skip = i - n;                                                                                       \
+        return count;                                                                                                  \
+    }
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_DECIMATOR naming the decimator <name>_decimator, e.g.
+ * cudl_mv_decimator_t and cudl_mv_decimator_process_n for the mv unit.
+ * @include add_filter_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_DECIMATOR documentation.
+ * @param _factor See #CUDL_ADD_EXPLICIT_DECIMATOR documentation.
+ */
+#define CUDL_ADD_DECIMATOR(_name, _factor) CUDL_ADD_EXPLICIT_DECIMATOR(_name, _name##_decimator, _factor)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_FILTER_H
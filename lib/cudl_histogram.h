@@ -0,0 +1,183 @@
+/**
+ * @file cudl_histogram.h
+ * @author Olivier Allaire
+ * @brief Fixed size log-linear histograms of the values of a unit defined with cudl.h, giving percentiles (e.g. p50,
+ * p99 and p99.9 of a latency) without storing nor sorting the values.
+ */
+
+#ifndef CUDL_HISTOGRAM_H
+#define CUDL_HISTOGRAM_H
+
+#include "cudl.h"
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Index of the most significant bit set of a non-zero value. For internal use only.
+ */
+static inline unsigned __cudl_histogram_msb(uint64_t value) {// NOLINT(bugprone-reserved-identifier)
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - (unsigned) __builtin_clzll(value);
+#else
+    unsigned msb = 0;
+    for (unsigned shift = 32; shift > 0; shift /= 2) {
+        if (value >> shift) {
+            value >>= shift;
+            msb += shift;
+        }
+    }
+    return msb;
+#endif
+}
+
+/**
+ * @brief Bucket of a value. The values below 2^_precision_bits have a bucket each, then every power of two range is
+ * split in 2^(_precision_bits - 1) buckets of equal width. Or-ing the low bits makes the values below 2^_precision_bits
+ * use a shift of 0 instead of a branch. For internal use only.
+ */
+static inline size_t __cudl_histogram_index(uint64_t value,// NOLINT(bugprone-reserved-identifier)
+                                            unsigned precision_bits) {
+    const unsigned shift =
+            __cudl_histogram_msb(value | ((UINT64_C(1) << precision_bits) - 1)) - (precision_bits - 1);
+    return ((size_t) shift << (precision_bits - 1)) + (size_t) (value >> shift);
+}
+
+/**
+ * @brief Highest value counted in a bucket, the reverse of #__cudl_histogram_index. The highest value of the last
+ * bucket of 64 bits values wraps to UINT64_MAX. For internal use only.
+ */
+static inline uint64_t __cudl_histogram_highest(size_t index,// NOLINT(bugprone-reserved-identifier)
+                                                unsigned precision_bits) {
+    const size_t half = (size_t) 1 << (precision_bits - 1);
+    const unsigned shift = index < 2 * half ? 0 : (unsigned) (index / half) - 1;
+    return (((uint64_t) (index - shift * half) + 1) << shift) - 1;
+}
+
+/**
+ * @brief Number of buckets of a histogram of values of the _type storage type, and the value counted by a histogram:
+ * the raw value, negative ones being counted as 0 by masking them with their sign. For internal use only.
+ */
+#define __CUDL_HISTOGRAM_BUCKETS(_type, _precision_bits)                                                               \
+    ((sizeof(_type) * 8 + 2 - (_precision_bits)) << ((_precision_bits) - 1))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_HISTOGRAM_RAW(_type, _value)                                                                            \
+    (__CUDL_TYPE_IS_SIGNED(_type) ? (uint64_t) (_value) & (((uint64_t) (_value) >> 63) - 1)                            \
+                                  : (uint64_t) (_value))// NOLINT(bugprone-reserved-identifier)
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Adds a histogram of the values of the _name unit, of fixed size, named cudl_<histogram name>_t. It must be
+ * initialized with cudl_<histogram name>_init (or be zero-initialized, e.g. static) before use:
+ * - cudl_<histogram name>_record(histogram, value) and cudl_<histogram name>_record_n(histogram, values, n) count
+ *   values. Recording is a bit scan, a shift and an increment, without branches nor allocations;
+ * - cudl_<histogram name>_merge(dst, src) adds the counts of src to dst, e.g. to merge the histograms recorded by each
+ *   thread, which do not need any synchronization while recording;
+ * - uint64_t cudl_<histogram name>_count(histogram) returns the number of recorded values;
+ * - cudl_<name>_t cudl_<histogram name>_percentile(histogram, percentile) returns the value below or equal to which
+ *   at least percentile % (from 0 to 100) of the recorded values are: the nearest-rank percentile, whose rank
+ *   percentile / 100 * count is rounded up (a relative error of 1e-12 is ignored, so p99 of 100 values is the 99th).
+ *   cudl_<histogram name>_percentiles(histogram, percentiles, dst, n) returns n of them in a single pass over the
+ *   buckets, the percentiles being in ascending order. They return 0 for an empty histogram. Being values of the
+ *   unit, they convert to other units with the CUDL_ADD_CONVERSION_* functions, e.g.
+ *   cudl_from_ns_to_us(cudl_ns_histogram_percentile(&histogram, 99.9)).
+ *
+ * The values below 2^_precision_bits are counted exactly. Above, each power of two range is split in
+ * 2^(_precision_bits - 1) buckets, so the percentiles are the highest value of their bucket: never below the exact
+ * value, and above it by less than 1 / 2^(_precision_bits - 1) of it (0.8 % with 8 bits). The buckets cover the whole
+ * range of the storage type of the unit, which must be an integer type, with 64 bits counts: a histogram of a 64 bits
+ * unit with 8 bits of precision is 58 KiB, of a 32 bits unit 26 KiB. Negative values are counted as 0.
+ * @include add_histogram_example.c
+ * @param _name The unit of the values. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _histogram_name The name of the histogram. This will be used to define the histogram type and its functions.
+ * @param _precision_bits The number of significant bits of the recorded values, from 2 to 16, and at most the width
+ * of the storage type.
+ */
+#define CUDL_ADD_EXPLICIT_HISTOGRAM(_name, _histogram_name, _precision_bits)                                           \
+    __CUDL_STATIC_ASSERT((_precision_bits) >= 2 && (_precision_bits) <= 16 &&                                          \
+                                 (_precision_bits) <= sizeof(__CUDL_STORAGE(_name)) * 8,                               \
+                         "The precision of a histogram must be from 2 to 16 bits, and at most the storage width");     \
+    typedef struct {                                                                                                   \
+        uint64_t counts[__CUDL_HISTOGRAM_BUCKETS(__CUDL_STORAGE(_name), _precision_bits)];                             \
+    } __CUDL_UT(_histogram_name);                                                                                      \
+    static inline void __CUDL_L1STR(__CUDL_AP(_histogram_name), _init)(__CUDL_UT(_histogram_name) * histogram) {       \
+        memset(histogram->counts, 0, sizeof(histogram->counts));                                                       \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(__CUDL_AP(_histogram_name), _record)(__CUDL_UT(_histogram_name) * histogram,       \
+                                                                         __CUDL_UT(_name) value) {                     \
+        ++histogram->counts[__cudl_histogram_index(__CUDL_HISTOGRAM_RAW(__CUDL_STORAGE(_name), CUDL_GET(value)),       \
+                                                   _precision_bits)];                                                  \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(__CUDL_AP(_histogram_name), _record_n)(__CUDL_UT(_histogram_name) * histogram,     \
+                                                                           const __CUDL_UT(_name) * values,            \
+                                                                           size_t n) {                                 \
+        for (size_t i = 0; i < n; ++i) {                                                                               \
+            ++histogram->counts[__cudl_histogram_index(                                                                \
+                    __CUDL_HISTOGRAM_RAW(__CUDL_STORAGE(_name), CUDL_GET(values[i])), _precision_bits)];               \
+        }                                                                                                              \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(__CUDL_AP(_histogram_name), _merge)(__CUDL_UT(_histogram_name) * dst,              \
+                                                                        const __CUDL_UT(_histogram_name) * src) {      \
+        for (size_t i = 0; i < sizeof(dst->counts) / sizeof(dst->counts[0]); ++i) {                                    \
+            dst->counts[i] += src->counts[i];                                                                          \
+        }                                                                                                              \
+    }                                                                                                                  \
+    static inline uint64_t __CUDL_L1STR(__CUDL_AP(_histogram_name),                                                    \
+                                        _count)(const __CUDL_UT(_histogram_name) * histogram) {                        \
+        uint64_t count = 0;                                                                                            \
+        for (size_t i = 0; i < sizeof(histogram->counts) / sizeof(histogram->counts[0]); ++i) {                        \
+            count += histogram->counts[i];                                                                             \
+        }                                                                                                              \
+        return count;                                                                                                  \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(__CUDL_AP(_histogram_name), _percentiles)(                                         \
+            const __CUDL_UT(_histogram_name) * histogram, const double *percentiles, __CUDL_UT(_name) * dst,           \
+            size_t n) {                                                                                                \
+        const uint64_t count = __CUDL_L1STR(__CUDL_AP(_histogram_name), _count)(histogram);                            \
+        const size_t last = sizeof(histogram->counts) / sizeof(histogram->counts[0]) - 1;                              \
+        size_t bucket = 0;                                                                                             \
+        uint64_t below = 0;                                                                                            \
+        for (size_t i = 0; i < n; ++i) {                                                                               \
+            if (count == 0) {                                                                                          \
+                dst[i] = __CUDL_AP(_name)((__CUDL_STORAGE(_name)) 0);                                                  \
+                continue;                                                                                              \
+            }                                                                                                          \
+            const double percentile = percentiles[i] < 0 ? 0 : percentiles[i] > 100 ? 100 : percentiles[i];            \
+            const double scaled = percentile / 100 * (double) count;                                                   \
+            uint64_t rank = (uint64_t) scaled;                                                                         \
+            rank += scaled - (double) rank > scaled * 1e-12;                                                           \
+            rank = rank < 1 ? 1 : rank > count ? count : rank;                                                         \
+            while (bucket < last && below + histogram->counts[bucket] < rank) {                                        \
+                below += histogram->counts[bucket++];                                                                  \
+            }                                                                                                          \
+            const uint64_t highest = __cudl_histogram_highest(bucket, _precision_bits);                                \
+            dst[i] = __CUDL_AP(_name)(highest > (uint64_t) __CUDL_TYPE_MAX(__CUDL_STORAGE(_name))                      \
+                                              ? __CUDL_TYPE_MAX(__CUDL_STORAGE(_name))                                 \
+                                              : (__CUDL_STORAGE(_name)) highest);                                      \
+        }                                                                                                              \
+    }                                                                                                                  \
+    static inline __CUDL_UT(_name) __CUDL_L1STR(__CUDL_AP(_histogram_name), _percentile)(                              \
+            const __CUDL_UT(_histogram_name) * histogram, double percentile) {                                         \
+        __CUDL_UT(_name) value;                                                                                        \
+        __CUDL_L1STR(__CUDL_AP(_histogram_name), _percentiles)(histogram, &percentile, &value, 1);                     \
+        return value;                                                                                                  \
+    }
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_HISTOGRAM naming the histogram <name>_histogram, e.g.
+ * cudl_ns_histogram_t and cudl_ns_histogram_record for the ns unit.
+ * @include add_histogram_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_HISTOGRAM documentation.
+ * @param _precision_bits See #CUDL_ADD_EXPLICIT_HISTOGRAM documentation.
+ */
+#define CUDL_ADD_HISTOGRAM(_name, _precision_bits)                                                                     \
+    CUDL_ADD_EXPLICIT_HISTOGRAM(_name, _name##_histogram, _precision_bits)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_HISTOGRAM_H
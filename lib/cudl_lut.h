@@ -0,0 +1,237 @@
+/**
+ * @file cudl_lut.h
+ * @author Olivier Allaire
+ * @brief Non-linear conversions between units defined with cudl.h, looked up in uniformly spaced tables with linear
+ * interpolation.
+ */
+
+#ifndef CUDL_LUT_H
+#define CUDL_LUT_H
+
+#include "cudl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Entries _i to _i + N - 1 of a table generated by #CUDL_LUT_TABLE. The abscissa is computed in double so that
+ * it matches the one used by the lookup even when the domain bounds are integers. For internal use only.
+ */
+#define __CUDL_LUT_ENTRY(_fn, _min, _max, _segments, _i)                                                               \
+    _fn((_min) + ((double) (_max) - (double) (_min)) * (_i) / (_segments))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_LUT_ENTRIES_1(_fn, _min, _max, _segments, _i)                                                           \
+    __CUDL_LUT_ENTRY(_fn, _min, _max, _segments, _i)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_LUT_ENTRIES_2(_fn, _min, _max, _segments, _i)                                                           \
+    __CUDL_LUT_ENTRIES_1(_fn, _min, _max, _segments, _i),                                                              \
+            __CUDL_LUT_ENTRIES_1(_fn, _min, _max, _segments, (_i) + 1)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_LUT_ENTRIES_4(_fn, _min, _max, _segments, _i)                                                           \
+    __CUDL_LUT_ENTRIES_2(_fn, _min, _max, _segments, _i),                                                              \
+            __CUDL_LUT_ENTRIES_2(_fn, _min, _max, _segments, (_i) + 2)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_LUT_ENTRIES_8(_fn, _min, _max, _segments, _i)                                                           \
+    __CUDL_LUT_ENTRIES_4(_fn, _min, _max, _segments, _i),                                                              \
+            __CUDL_LUT_ENTRIES_4(_fn, _min, _max, _segments, (_i) + 4)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_LUT_ENTRIES_16(_fn, _min, _max, _segments, _i)                                                          \
+    __CUDL_LUT_ENTRIES_8(_fn, _min, _max, _segments, _i),                                                              \
+            __CUDL_LUT_ENTRIES_8(_fn, _min, _max, _segments, (_i) + 8)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_LUT_ENTRIES_32(_fn, _min, _max, _segments, _i)                                                          \
+    __CUDL_LUT_ENTRIES_16(_fn, _min, _max, _segments, _i),                                                             \
+            __CUDL_LUT_ENTRIES_16(_fn, _min, _max, _segments, (_i) + 16)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_LUT_ENTRIES_64(_fn, _min, _max, _segments, _i)                                                          \
+    __CUDL_LUT_ENTRIES_32(_fn, _min, _max, _segments, _i),                                                             \
+            __CUDL_LUT_ENTRIES_32(_fn, _min, _max, _segments, (_i) + 32)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_LUT_ENTRIES_128(_fn, _min, _max, _segments, _i)                                                         \
+    __CUDL_LUT_ENTRIES_64(_fn, _min, _max, _segments, _i),                                                             \
+            __CUDL_LUT_ENTRIES_64(_fn, _min, _max, _segments, (_i) + 64)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_LUT_ENTRIES_256(_fn, _min, _max, _segments, _i)                                                         \
+    __CUDL_LUT_ENTRIES_128(_fn, _min, _max, _segments, _i),                                                            \
+            __CUDL_LUT_ENTRIES_128(_fn, _min, _max, _segments, (_i) + 128)// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Generator behind #CUDL_ADD_EXPLICIT_LUT_CONVERSION. The storage types are not known here, so the unit values
+ * themselves tell, once constant folded, whether they are floating point: 1 / 2 is only 0 for integers. The dead
+ * branch is removed by the compiler. For internal use only.
+ */
+#define __CUDL_LUT_CONVERSION(_def, _from, _to, _explicative, _table, _size, _min, _max)                               \
+    __CUDL_STATIC_ASSERT((_size) >= 2 && sizeof(_table) / sizeof((_table)[0]) == (_size),                              \
+                         "A conversion table must have _size entries, and at least 2");                                \
+    _def(__CUDL_UT(_to) __CUDL_L1STR(__CUDL_AP(_explicative), _to)(__CUDL_UT(_from) from_value), {                     \
+        __CUDL_UT(_from) position;                                                                                     \
+        __CUDL_UT(_to) lower;                                                                                          \
+        __CUDL_UT(_to) upper;                                                                                          \
+        __CUDL_UT(_to) to_value;                                                                                       \
+        long long remainder;                                                                                           \
+        long long span;                                                                                                \
+        int index;                                                                                                     \
+        position.value = 1;                                                                                            \
+        position.value /= 2;                                                                                           \
+        lower.value = 1;                                                                                               \
+        lower.value /= 2;                                                                                              \
+        const bool from_floating = position.value != 0;                                                                \
+        const bool to_floating = lower.value != 0;                                                                     \
+        if (from_floating) {                                                                                           \
+            __CUDL_UT(_from) scale;                                                                                    \
+            scale.value = (_size) - 1;                                                                                 \
+            scale.value /= (_max) - (_min);                                                                            \
+            position.value = (from_value.value - (_min)) * scale.value;                                                \
+            position.value = position.value > 0 ? position.value : 0;                                                  \
+            position.value = position.value < (_size) - 1 ? position.value : (_size) - 1;                              \
+            index = (int) position.value;                                                                              \
+            index = index < (_size) - 2 ? index : (_size) - 2;                                                         \
+            position.value -= index;                                                                                   \
+            remainder = 0;                                                                                             \
+            span = 1;                                                                                                  \
+        } else {                                                                                                       \
+            span = (long long) (_max) - (long long) (_min);                                                            \
+            long long offset = (long long) from_value.value - (long long) (_min);                                      \
+            offset = offset > 0 ? offset : 0;                                                                          \
+            offset = offset < span ? offset : span;                                                                    \
+            if (span * ((_size) - 1) <= 0x7FFFFFFF) {                                                                  \
+                const int scaled = (int) offset * ((_size) - 1);                                                       \
+                index = scaled / (int) span;                                                                           \
+                index = index < (_size) - 2 ? index : (_size) - 2;                                                     \
+                remainder = scaled - index * (int) span;                                                               \
+            } else {                                                                                                   \
+                const long long scaled = offset * ((_size) - 1);                                                       \
+                index = (int) (scaled / span);                                                                         \
+                index = index < (_size) - 2 ? index : (_size) - 2;                                                     \
+                remainder = scaled - (long long) index * span;                                                         \
+            }                                                                                                          \
+        }                                                                                                              \
+        lower.value = (_table)[index];                                                                                 \
+        upper.value = (_table)[index + 1];                                                                             \
+        if (from_floating && to_floating) {                                                                            \
+            to_value.value = lower.value + (upper.value - lower.value) * position.value;                               \
+        } else if (from_floating) {                                                                                    \
+            position.value *= upper.value - lower.value;                                                               \
+            to_value.value = lower.value + (long long) (position.value + ((double) position.value < 0 ? -0.5 : 0.5));  \
+        } else if (to_floating) {                                                                                      \
+            __CUDL_UT(_to) inverse_span;                                                                               \
+            inverse_span.value = 1;                                                                                    \
+            inverse_span.value /= span;                                                                                \
+            to_value.value = lower.value + (upper.value - lower.value) * (remainder * inverse_span.value);             \
+        } else {                                                                                                       \
+            const long long product = ((long long) upper.value - (long long) lower.value) * remainder;                 \
+            to_value.value = lower.value + (product + (product < 0 ? -span / 2 : span / 2)) / span;                    \
+        }                                                                                                              \
+        return to_value;                                                                                               \
+    })                                                                                                                 \
+    __CUDL_UNARY_ARRAY_FUNCTIONS(_def, __CUDL_ARRAY_FN(__CUDL_L1STR(__CUDL_AP(_explicative), _to)), __CUDL_UT(_to),    \
+                                 __CUDL_UT(_from), , dst[i] = __CUDL_L1STR(__CUDL_AP(_explicative), _to)(src[i]))
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Expands to the initializer of a table of _segments + 1 entries, _fn(x) for x uniformly spaced from _min to
+ * _max included, to be used with #CUDL_ADD_LUT_CONVERSION. The abscissas are computed at compile time, so the table
+ * is a constant initializer whenever _fn is: a function-like macro (e.g. a polynomial), a constexpr function in C++,
+ * or a math builtin that the compiler folds for constant arguments (e.g. log with GCC and Clang). Otherwise, the
+ * table must be a local or be filled at startup instead.
+ * @include add_lut_conversion_example.c
+ * @param _segments The number of segments of the table, one of 1, 2, 4, 8, 16, 32, 64, 128 or 256 written as an
+ * integer literal.
+ * @param _fn The function to tabulate, called with a double.
+ * @param _min The first abscissa of the table.
+ * @param _max The last abscissa of the table.
+ */
+#define CUDL_LUT_TABLE(_segments, _fn, _min, _max)                                                                     \
+    { __CUDL_L1STR(__CUDL_LUT_ENTRIES_, _segments)(_fn, _min, _max, _segments, 0), _fn((double) (_max)) }
+
+/**
+ * @brief Adds a non-linear conversion function from the _from unit to the _to unit, named
+ * cudl_<explicative><to>, and its array version cudl_<explicative><to>_n (with the _aligned variant of the other
+ * array functions). The _table holds the _to values of _size abscissas uniformly spaced from _min to _max included, so
+ * a value is converted without searching the table: its position in the table is computed with one multiply (or
+ * divisions by constants for integer _from units), then it is linearly interpolated between the two surrounding
+ * entries. Values outside [_min, _max] are clamped to it, as well as NaN to _min.
+ *
+ * With an integer _from unit, the position is computed in fixed point, exactly. With an integer _to unit, the result
+ * is rounded to the nearest integer. The table entries should be of the _to storage type. Integer _from values (and
+ * entries of integer tables) must fit in a long long, and so must (_max - _min) * (_size - 1).
+ *
+ * The conversion is branch free, so the array version of integer _from units is vectorized by GCC and Clang when
+ * the target has gathers (e.g. -mavx2). With floating point _from units, the clamping comparisons may trap, which
+ * prevents GCC from vectorizing it unless -fno-trapping-math is given. Whatever the target, the table is small enough
+ * to stay in cache. #CUDL_LUT_TABLE generates uniformly spaced tables at compile time.
+ * @include add_lut_conversion_example.c
+ * @param _from The unit to convert from. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _to The unit to convert to. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _explicative The text between the prefix and the unit name of the conversion function.
+ * @param _table The array of the _to values, e.g. a static const array declared before.
+ * @param _size The number of entries of _table, at least 2.
+ * @param _min The _from value of the first entry.
+ * @param _max The _from value of the last entry. It must be greater than _min.
+ */
+#define CUDL_ADD_EXPLICIT_LUT_CONVERSION(_from, _to, _explicative, _table, _size, _min, _max)                          \
+    __CUDL_LUT_CONVERSION(__CUDL_INLINE, _from, _to, _explicative, _table, _size, _min, _max)
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_LUT_CONVERSION to have a default explicative. It adds the same
+ * function names as #CUDL_ADD_CONVERSION_FRACTION_FACTOR, e.g. cudl_from_adc_to_celsius.
+ * @include add_lut_conversion_example.c
+ * @param _from See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param __to See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _table See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _size See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _min See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _max See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ */
+#define CUDL_ADD_LUT_CONVERSION(_from, __to, _table, _size, _min, _max)                                                \
+    CUDL_ADD_EXPLICIT_LUT_CONVERSION(_from, __to, from_##_from##_to_, _table, _size, _min, _max)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_EXPLICIT_LUT_CONVERSION, see #CUDL_DECLARE_UNIT_WITH_OP. The _table
+ * must be declared with its size before, e.g. as an extern const array defined in the implementation file.
+ * @param _from See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _explicative See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _table See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _size See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _min See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _max See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ */
+#define CUDL_DECLARE_EXPLICIT_LUT_CONVERSION(_from, _to, _explicative, _table, _size, _min, _max)                      \
+    __CUDL_LUT_CONVERSION(__CUDL_DECLARE, _from, _to, _explicative, _table, _size, _min, _max)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_EXPLICIT_LUT_CONVERSION, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _to See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _explicative See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _table See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _size See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _min See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ * @param _max See #CUDL_ADD_EXPLICIT_LUT_CONVERSION documentation.
+ */
+#define CUDL_IMPLEMENT_EXPLICIT_LUT_CONVERSION(_from, _to, _explicative, _table, _size, _min, _max)                    \
+    __CUDL_LUT_CONVERSION(__CUDL_IMPLEMENT, _from, _to, _explicative, _table, _size, _min, _max)
+
+/**
+ * @brief Declaration only version of #CUDL_ADD_LUT_CONVERSION, see #CUDL_DECLARE_EXPLICIT_LUT_CONVERSION.
+ * @param _from See #CUDL_ADD_LUT_CONVERSION documentation.
+ * @param __to See #CUDL_ADD_LUT_CONVERSION documentation.
+ * @param _table See #CUDL_ADD_LUT_CONVERSION documentation.
+ * @param _size See #CUDL_ADD_LUT_CONVERSION documentation.
+ * @param _min See #CUDL_ADD_LUT_CONVERSION documentation.
+ * @param _max See #CUDL_ADD_LUT_CONVERSION documentation.
+ */
+#define CUDL_DECLARE_LUT_CONVERSION(_from, __to, _table, _size, _min, _max)                                            \
+    __CUDL_LUT_CONVERSION(__CUDL_DECLARE, _from, __to, from_##_from##_to_, _table, _size, _min, _max)
+
+/**
+ * @brief Defines the functions declared by #CUDL_DECLARE_LUT_CONVERSION, see #CUDL_IMPLEMENT_UNIT_WITH_OP.
+ * @param _from See #CUDL_ADD_LUT_CONVERSION documentation.
+ * @param __to See #CUDL_ADD_LUT_CONVERSION documentation.
+ * @param _table See #CUDL_ADD_LUT_CONVERSION documentation.
+ * @param _size See #CUDL_ADD_LUT_CONVERSION documentation.
+ * @param _min See #CUDL_ADD_LUT_CONVERSION documentation.
+ * @param _max See #CUDL_ADD_LUT_CONVERSION documentation.
+ */
+#define CUDL_IMPLEMENT_LUT_CONVERSION(_from, __to, _table, _size, _min, _max)                                          \
+    __CUDL_LUT_CONVERSION(__CUDL_IMPLEMENT, _from, __to, from_##_from##_to_, _table, _size, _min, _max)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_LUT_H
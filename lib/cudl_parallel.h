@@ -0,0 +1,692 @@
+/**
+ * @file cudl_parallel.h
+ * @author Olivier Allaire
+ * @brief Optional multi-threaded execution of the array functions generated by cudl.h, on a persistent pool of POSIX
+ * threads, and fused chains of array functions processed chunk by chunk while the data is in cache.
+ *
+ * A call on a pool splits the arrays in chunks of at most #CUDL_PARALLEL_CHUNK_BYTES per array, and gives each worker
+ * (the calling thread is one of them) a contiguous run of chunks. A worker that runs out of chunks steals the second
+ * half of the chunks left to another one, so a slow or descheduled worker does not hold the whole call. The chunks are
+ * a multiple of #CUDL_CACHE_LINE_SIZE elements long, so two workers never write to the same cache line of an aligned
+ * destination array.
+ *
+ * The CUDL_ADD_PARALLEL_* macros add a _parallel version of the array functions of a unit, taking the pool as first
+ * parameter, e.g. cudl_from_adc_to_mv_n_parallel(pool, dst, src, n). A NULL pool runs the function on the calling
+ * thread, chunk by chunk. #CUDL_ADD_PARALLEL_CHAIN and #CUDL_ADD_PARALLEL_REDUCE_CHAIN fuse several array functions:
+ * each chunk goes through all of them, using two scratch buffers of #CUDL_PARALLEL_CHUNK_BYTES on the stack of the
+ * worker, instead of making each function stream the whole array through memory.
+ *
+ * The pool functions are defined in the single source file that defines CUDL_PARALLEL_IMPLEMENTATION before including
+ * this header. That file is linked to all the ones using the pool, and the program is linked with pthreads.
+ * @include parallel_example.c
+ */
+
+#ifndef CUDL_PARALLEL_H
+#define CUDL_PARALLEL_H
+
+#include "cudl_atomic.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CUDL_PARALLEL_CHUNK_BYTES
+/**
+ * @brief Largest size, in bytes, of the part of an array processed at once by a worker. It is also the size of each of
+ * the two scratch buffers of the chains, so the chunk of the source, of the destination and of the scratch buffers of a
+ * chain stay in a 256 KiB L2 cache. It can be redefined before including this header, it must be a multiple of
+ * #CUDL_ARRAY_ALIGNMENT.
+ */
+#define CUDL_PARALLEL_CHUNK_BYTES 32768
+#endif
+
+#ifndef CUDL_PARALLEL_MAX_THREADS
+/**
+ * @brief Largest number of workers of a pool, the calling thread included. The reductions keep one partial result per
+ * worker on the stack. It can be redefined before including this header.
+ */
+#define CUDL_PARALLEL_MAX_THREADS 256
+#endif
+
+/**
+ * @brief A pool of worker threads, created by #cudl_pool_create.
+ */
+typedef struct cudl_pool cudl_pool_t;
+
+/**
+ * @brief Function called by #cudl_pool_for for each chunk, with the context given to it. It processes the elements from
+ * begin (included) to end (excluded). worker is the index, lower than #cudl_pool_size, of the worker running it: the
+ * chunks of a given worker never run concurrently, so it can be used to index per worker partial results.
+ */
+typedef void (*cudl_pool_task_t)(void *context, size_t begin, size_t end, size_t worker);
+
+/**
+ * @brief Creates a pool of threads workers, the thread calling #cudl_pool_for being one of them, so threads - 1 threads
+ * are started. When threads is 0, it is the number of online processors. It is limited to #CUDL_PARALLEL_MAX_THREADS.
+ * @return The pool, or NULL when it could not be allocated or its threads could not be started.
+ */
+cudl_pool_t *cudl_pool_create(size_t threads);
+
+/**
+ * @brief Stops the threads of the pool and releases it. No #cudl_pool_for call may be running on it. A NULL pool is
+ * ignored.
+ */
+void cudl_pool_destroy(cudl_pool_t *pool);
+
+/**
+ * @brief Returns the number of workers of the pool, 1 for a NULL pool.
+ */
+size_t cudl_pool_size(const cudl_pool_t *pool);
+
+/**
+ * @brief Calls task for every chunk of chunk elements (the last one may be shorter) of the n elements, on the workers
+ * of the pool, and returns when all the chunks are processed. The calls from several threads on the same pool run one
+ * after the other. With a NULL pool, a pool of one worker, a single chunk, or when called from a task running on the
+ * same pool, the chunks are processed in order on the calling thread.
+ */
+void cudl_pool_for(cudl_pool_t *pool, size_t n, size_t chunk, cudl_pool_task_t task, void *context);
+
+/**
+ * @brief Returns the number of elements of a chunk processing arrays whose largest element is element_size bytes: as
+ * many as fit in #CUDL_PARALLEL_CHUNK_BYTES, rounded down to a multiple of #CUDL_CACHE_LINE_SIZE elements.
+ */
+static inline size_t cudl_parallel_chunk(size_t element_size) {
+    const size_t chunk = CUDL_PARALLEL_CHUNK_BYTES / (element_size > 0 ? element_size : 1);
+    if (chunk >= CUDL_CACHE_LINE_SIZE) { return chunk / CUDL_CACHE_LINE_SIZE * CUDL_CACHE_LINE_SIZE; }
+    return chunk > 0 ? chunk : 1;
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Arguments of a generated parallel function, given to its task: the arrays (rhs points to the scalar of the
+ * scalar ops), and the per worker partial results of the reductions with the flags telling which ones are set. For
+ * internal use only.
+ */
+typedef struct {
+    void *dst;
+    const void *lhs;
+    const void *rhs;
+    void *partials;
+    bool *seeded;
+} __cudl_parallel_job_t;// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Names of the task of a generated parallel function _fn, and of the function combining two partial results of
+ * a reduction by reducing them as an array. For internal use only.
+ */
+#define __CUDL_PARALLEL_TASK(_fn) __CUDL_L1STR(__cudl_parallel_task_, _fn)     // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_COMBINE(_fn) __CUDL_L1STR(__cudl_parallel_combine_, _fn)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_MAX_SIZE(_a, _b) ((_a) > (_b) ? (_a) : (_b))          // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_ADD(_lhs, _rhs) ((_lhs) + (_rhs))                     // NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Generates the parallel version of an array function taking one source array, see
+ * #__CUDL_UNARY_ARRAY_FUNCTIONS. For internal use only.
+ */
+#define __CUDL_PARALLEL_UNARY_FUNCTIONS(_fn, _dst_type, _src_type)                                                     \
+    static inline void __CUDL_PARALLEL_TASK(_fn)(void *context, size_t begin, size_t end, size_t worker) {             \
+        const __cudl_parallel_job_t *job = (const __cudl_parallel_job_t *) context;                                    \
+        (void) worker;                                                                                                 \
+        _fn((_dst_type *) job->dst + begin, (const _src_type *) job->lhs + begin, end - begin);                        \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(_fn, _parallel)(cudl_pool_t * pool, _dst_type * dst, const _src_type *src,         \
+                                                    size_t n) {                                                        \
+        __cudl_parallel_job_t job = {dst, src, NULL, NULL, NULL};                                                      \
+        cudl_pool_for(pool, n, cudl_parallel_chunk(__CUDL_PARALLEL_MAX_SIZE(sizeof(_dst_type), sizeof(_src_type))),    \
+                      __CUDL_PARALLEL_TASK(_fn), &job);                                                                \
+    }
+
+/**
+ * @brief Generates the parallel version of an array function taking two source arrays, see
+ * #__CUDL_MIXED_BINARY_ARRAY_FUNCTIONS. For internal use only.
+ */
+#define __CUDL_PARALLEL_BINARY_FUNCTIONS(_fn, _dst_type, _lhs_type, _rhs_type)                                         \
+    static inline void __CUDL_PARALLEL_TASK(_fn)(void *context, size_t begin, size_t end, size_t worker) {             \
+        const __cudl_parallel_job_t *job = (const __cudl_parallel_job_t *) context;                                    \
+        (void) worker;                                                                                                 \
+        _fn((_dst_type *) job->dst + begin, (const _lhs_type *) job->lhs + begin,                                      \
+            (const _rhs_type *) job->rhs + begin, end - begin);                                                        \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(_fn, _parallel)(cudl_pool_t * pool, _dst_type * dst, const _lhs_type *lhs,         \
+                                                    const _rhs_type *rhs, size_t n) {                                  \
+        __cudl_parallel_job_t job = {dst, lhs, rhs, NULL, NULL};                                                       \
+        const size_t largest = __CUDL_PARALLEL_MAX_SIZE(sizeof(_lhs_type), sizeof(_rhs_type));                         \
+        cudl_pool_for(pool, n, cudl_parallel_chunk(__CUDL_PARALLEL_MAX_SIZE(sizeof(_dst_type), largest)),              \
+                      __CUDL_PARALLEL_TASK(_fn), &job);                                                                \
+    }
+
+/**
+ * @brief Generates the parallel version of an array function taking one source array and a scalar, see
+ * #__CUDL_SCALAR_ARRAY_FUNCTIONS. For internal use only.
+ */
+#define __CUDL_PARALLEL_SCALAR_FUNCTIONS(_fn, _dst_type, _src_type, _scalar_type)                                      \
+    static inline void __CUDL_PARALLEL_TASK(_fn)(void *context, size_t begin, size_t end, size_t worker) {             \
+        const __cudl_parallel_job_t *job = (const __cudl_parallel_job_t *) context;                                    \
+        (void) worker;                                                                                                 \
+        _fn((_dst_type *) job->dst + begin, (const _src_type *) job->lhs + begin, *(const _scalar_type *) job->rhs,    \
+            end - begin);                                                                                              \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(_fn, _parallel)(cudl_pool_t * pool, _dst_type * dst, const _src_type *lhs,         \
+                                                    _scalar_type rhs, size_t n) {                                      \
+        __cudl_parallel_job_t job = {dst, lhs, &rhs, NULL, NULL};                                                      \
+        cudl_pool_for(pool, n, cudl_parallel_chunk(__CUDL_PARALLEL_MAX_SIZE(sizeof(_dst_type), sizeof(_src_type))),    \
+                      __CUDL_PARALLEL_TASK(_fn), &job);                                                                \
+    }
+
+/**
+ * @brief Pieces shared by the reductions: the task combines the result of each chunk with the partial result of its
+ * worker, and the function combines the partial results in the order of the workers. _combine is a macro or function
+ * taking two _result_type values. An empty array is reduced by a single call of the task, for an empty chunk. For
+ * internal use only.
+ */
+#define __CUDL_PARALLEL_COMBINE_CHUNK(_result_type, _combine, _chunk_result)                                           \
+    _result_type *partial = (_result_type *) job->partials + worker;                                                   \
+    const _result_type chunk_result = _chunk_result;                                                                   \
+    *partial = job->seeded[worker] ? _combine(*partial, chunk_result) : chunk_result;                                  \
+    job->seeded[worker] = true;// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_REDUCE(_result_type, _combine, _chunk, _task)                                                  \
+    _result_type partials[CUDL_PARALLEL_MAX_THREADS];                                                                  \
+    bool seeded[CUDL_PARALLEL_MAX_THREADS] = {false};                                                                  \
+    job.partials = partials;                                                                                           \
+    job.seeded = seeded;                                                                                               \
+    if (n == 0) {                                                                                                      \
+        _task(&job, 0, 0, 0);                                                                                          \
+    } else {                                                                                                           \
+        cudl_pool_for(pool, n, _chunk, _task, &job);                                                                   \
+    }                                                                                                                  \
+    size_t first = 0;                                                                                                  \
+    while (!seeded[first]) { ++first; }                                                                                \
+    _result_type result = partials[first];                                                                             \
+    for (size_t worker = first + 1; worker < cudl_pool_size(pool); ++worker) {                                         \
+        if (seeded[worker]) { result = _combine(result, partials[worker]); }                                           \
+    }                                                                                                                  \
+    return result;// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Generates the parallel version of a reduction, see #__CUDL_REDUCTION_FUNCTIONS. For internal use only.
+ */
+#define __CUDL_PARALLEL_REDUCTION_FUNCTIONS(_fn, _result_type, _src_type, _combine)                                    \
+    static inline void __CUDL_PARALLEL_TASK(_fn)(void *context, size_t begin, size_t end, size_t worker) {             \
+        const __cudl_parallel_job_t *job = (const __cudl_parallel_job_t *) context;                                    \
+        __CUDL_PARALLEL_COMBINE_CHUNK(_result_type, _combine, _fn((const _src_type *) job->lhs + begin, end - begin))  \
+    }                                                                                                                  \
+    static inline _result_type __CUDL_L1STR(_fn, _parallel)(cudl_pool_t * pool, const _src_type *src, size_t n) {      \
+        __cudl_parallel_job_t job = {NULL, src, NULL, NULL, NULL};                                                     \
+        __CUDL_PARALLEL_REDUCE(_result_type, _combine, cudl_parallel_chunk(sizeof(_src_type)),                         \
+                               __CUDL_PARALLEL_TASK(_fn))                                                              \
+    }
+
+/**
+ * @brief Generates the parallel version of a reduction of two arrays, like cudl_<name>_dot_n. For internal use only.
+ */
+#define __CUDL_PARALLEL_BINARY_REDUCTION_FUNCTIONS(_fn, _result_type, _src_type, _combine)                             \
+    static inline void __CUDL_PARALLEL_TASK(_fn)(void *context, size_t begin, size_t end, size_t worker) {             \
+        const __cudl_parallel_job_t *job = (const __cudl_parallel_job_t *) context;                                    \
+        __CUDL_PARALLEL_COMBINE_CHUNK(                                                                                 \
+                _result_type, _combine,                                                                                \
+                _fn((const _src_type *) job->lhs + begin, (const _src_type *) job->rhs + begin, end - begin))          \
+    }                                                                                                                  \
+    static inline _result_type __CUDL_L1STR(_fn, _parallel)(cudl_pool_t * pool, const _src_type *lhs,                  \
+                                                            const _src_type *rhs, size_t n) {                          \
+        __cudl_parallel_job_t job = {NULL, lhs, rhs, NULL, NULL};                                                      \
+        __CUDL_PARALLEL_REDUCE(_result_type, _combine, cudl_parallel_chunk(sizeof(_src_type)),                         \
+                               __CUDL_PARALLEL_TASK(_fn))                                                              \
+    }
+
+/**
+ * @brief Generates the parallel version of a min or max reduction, whose partial results are combined by the reduction
+ * itself, so that they compare like it does (e.g. -0 and NaN values of the floating point units). For internal use
+ * only.
+ */
+#define __CUDL_PARALLEL_EXTREMUM_FUNCTIONS(_fn, _unit_type)                                                            \
+    static inline _unit_type __CUDL_PARALLEL_COMBINE(_fn)(_unit_type lhs, _unit_type rhs) {                            \
+        const _unit_type pair[2] = {lhs, rhs};                                                                         \
+        return _fn(pair, 2);                                                                                           \
+    }                                                                                                                  \
+    __CUDL_PARALLEL_REDUCTION_FUNCTIONS(_fn, _unit_type, _unit_type, __CUDL_PARALLEL_COMBINE(_fn))
+
+/**
+ * @brief Function and destination type of a (function, type) stage of a chain. For internal use only.
+ */
+#define __CUDL_PARALLEL_STAGE_FN(_stage) __CUDL_PARALLEL_STAGE_FN_I _stage      // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGE_FN_I(_fn, _type) _fn                              // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGE_TYPE(_stage) __CUDL_PARALLEL_STAGE_TYPE_I _stage  // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGE_TYPE_I(_fn, _type) _type                          // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGE_SIZE(_unused, _stage)                                                                    \
+    largest = __CUDL_PARALLEL_MAX_SIZE(                                                                                \
+            largest, sizeof(__CUDL_PARALLEL_STAGE_TYPE(_stage)));// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Code of the stages of a chain, in the task of the chain. They refer to the job, begin, count, stage_src,
+ * scratch, flip and chunk_result variables of the task. Every stage but the last one writes to a scratch buffer, the
+ * last one is given by _last, called with _arg, its source type and its stage. For internal use only.
+ */
+#define __CUDL_PARALLEL_STAGES(_last, _arg, _src_type, ...)                                                            \
+    __CUDL_L1STR(__CUDL_PARALLEL_STAGES_, __CUDL_COUNT_ARGS(__VA_ARGS__))                                              \
+    (_last, _arg, _src_type, __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGES_1(_last, _arg, _in, _stage)                                                             \
+    _last(_arg, _in, _stage)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGES_2(_last, _arg, _in, _stage, ...)                                                        \
+    __CUDL_PARALLEL_TO_SCRATCH(_arg, _in, _stage)                                                                      \
+    __CUDL_PARALLEL_STAGES_1(_last, _arg, __CUDL_PARALLEL_STAGE_TYPE(_stage),                                          \
+                             __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGES_3(_last, _arg, _in, _stage, ...)                                                        \
+    __CUDL_PARALLEL_TO_SCRATCH(_arg, _in, _stage)                                                                      \
+    __CUDL_PARALLEL_STAGES_2(_last, _arg, __CUDL_PARALLEL_STAGE_TYPE(_stage),                                          \
+                             __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGES_4(_last, _arg, _in, _stage, ...)                                                        \
+    __CUDL_PARALLEL_TO_SCRATCH(_arg, _in, _stage)                                                                      \
+    __CUDL_PARALLEL_STAGES_3(_last, _arg, __CUDL_PARALLEL_STAGE_TYPE(_stage),                                          \
+                             __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGES_5(_last, _arg, _in, _stage, ...)                                                        \
+    __CUDL_PARALLEL_TO_SCRATCH(_arg, _in, _stage)                                                                      \
+    __CUDL_PARALLEL_STAGES_4(_last, _arg, __CUDL_PARALLEL_STAGE_TYPE(_stage),                                          \
+                             __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGES_6(_last, _arg, _in, _stage, ...)                                                        \
+    __CUDL_PARALLEL_TO_SCRATCH(_arg, _in, _stage)                                                                      \
+    __CUDL_PARALLEL_STAGES_5(_last, _arg, __CUDL_PARALLEL_STAGE_TYPE(_stage),                                          \
+                             __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGES_7(_last, _arg, _in, _stage, ...)                                                        \
+    __CUDL_PARALLEL_TO_SCRATCH(_arg, _in, _stage)                                                                      \
+    __CUDL_PARALLEL_STAGES_6(_last, _arg, __CUDL_PARALLEL_STAGE_TYPE(_stage),                                          \
+                             __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_STAGES_8(_last, _arg, _in, _stage, ...)                                                        \
+    __CUDL_PARALLEL_TO_SCRATCH(_arg, _in, _stage)                                                                      \
+    __CUDL_PARALLEL_STAGES_7(_last, _arg, __CUDL_PARALLEL_STAGE_TYPE(_stage),                                          \
+                             __VA_ARGS__)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_TO_SCRATCH(_unused, _in, _stage)                                                               \
+    {                                                                                                                  \
+        __CUDL_PARALLEL_STAGE_TYPE(_stage) *stage_dst = (__CUDL_PARALLEL_STAGE_TYPE(_stage) *) (void *) scratch[flip]; \
+        __CUDL_PARALLEL_STAGE_FN(_stage)(stage_dst, (const _in *) stage_src, count);                                   \
+        stage_src = stage_dst;                                                                                         \
+        flip ^= 1;                                                                                                     \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_TO_DST(_dst_type, _in, _stage)                                                                 \
+    __CUDL_PARALLEL_STAGE_FN(_stage)((_dst_type *) job->dst + begin, (const _in *) stage_src,                          \
+                                     count);// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_PARALLEL_TO_REDUCE(_reduce, _in, _stage)                                                                \
+    __CUDL_PARALLEL_TO_SCRATCH(_reduce, _in, _stage)                                                                   \
+    chunk_result = _reduce((const __CUDL_PARALLEL_STAGE_TYPE(_stage) *) stage_src,                                     \
+                           count);// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Beginning of the task of a chain, declaring the variables used by the stages. For internal use only.
+ */
+#define __CUDL_PARALLEL_CHAIN_TASK_VARIABLES(_src_type)                                                                \
+    const __cudl_parallel_job_t *job = (const __cudl_parallel_job_t *) context;                                        \
+    __CUDL_ALIGNAS(CUDL_ARRAY_ALIGNMENT) unsigned char scratch[2][CUDL_PARALLEL_CHUNK_BYTES];                          \
+    const void *stage_src = (const _src_type *) job->lhs + begin;                                                      \
+    const size_t count = end - begin;                                                                                  \
+    int flip = 0;                                                                                                      \
+    (void) scratch;                                                                                                    \
+    (void) flip;// NOLINT(bugprone-reserved-identifier)
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Adds cudl_from_<from>_to_<to>_n_parallel(pool, dst, src, n), the parallel version of the array conversion
+ * added with any of the CUDL_ADD_*CONVERSION* macros of the same units. See #cudl_pool_for for how the work is split.
+ * @include parallel_example.c
+ * @param _from The unit to convert from. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param __to The unit to convert to. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ */
+#define CUDL_ADD_PARALLEL_CONVERSION(_from, __to) CUDL_ADD_PARALLEL_EXPLICIT_CONVERSION(_from, __to, from_##_from##_to_)
+
+/**
+ * @brief Version of #CUDL_ADD_PARALLEL_CONVERSION for the conversions added with an explicative, e.g. with
+ * #CUDL_ADD_EXPLICIT_CONVERSION_FRACTION_FACTOR.
+ * @param _from The unit to convert from. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _to The unit to convert to. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _explicative The explicative given to the macro that added the conversion.
+ */
+#define CUDL_ADD_PARALLEL_EXPLICIT_CONVERSION(_from, _to, _explicative)                                                \
+    __CUDL_PARALLEL_UNARY_FUNCTIONS(__CUDL_ARRAY_FN(__CUDL_L1STR(__CUDL_AP(_explicative), _to)), __CUDL_UT(_to),       \
+                                    __CUDL_UT(_from))
+
+/**
+ * @brief Adds cudl_<name><op_name>_n_parallel(pool, dst, lhs, rhs, n), the parallel version of an array op whose
+ * operands and result are of the unit, e.g. one added with #CUDL_ADD_NO_TRANSFORM_ARRAY_OP or a saturating op.
+ * @param _name The unit of the op. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of the op, e.g. _add.
+ */
+#define CUDL_ADD_PARALLEL_ARRAY_OP(_name, _op_name)                                                                    \
+    __CUDL_PARALLEL_BINARY_FUNCTIONS(__CUDL_FN(_name, _op_name, _n), __CUDL_UT(_name), __CUDL_UT(_name),               \
+                                     __CUDL_UT(_name))
+
+/**
+ * @brief Adds cudl_<name><op_name>_n_parallel(pool, dst, lhs, rhs, n), the parallel version of an array op added with
+ * #CUDL_ADD_NO_UNIT_ARRAY_OP, rhs being the unitless scalar.
+ * @param _name The unit of the op. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of the op, e.g. _mul.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_PARALLEL_NO_UNIT_ARRAY_OP(_name, _op_name, _type)                                                     \
+    __CUDL_PARALLEL_SCALAR_FUNCTIONS(__CUDL_FN(_name, _op_name, _n), __CUDL_UT(_name), __CUDL_UT(_name), _type)
+
+/**
+ * @brief Adds cudl_<name><op_name>_n_parallel(pool, dst, lhs, rhs, n), the parallel version of an array op added with
+ * #CUDL_ADD_RELATIONAL_ARRAY_OP.
+ * @param _name The unit of the op. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _op_name The core name of the op, e.g. _gt.
+ */
+#define CUDL_ADD_PARALLEL_RELATIONAL_ARRAY_OP(_name, _op_name)                                                         \
+    __CUDL_PARALLEL_BINARY_FUNCTIONS(__CUDL_FN(_name, _op_name, _n), bool, __CUDL_UT(_name), __CUDL_UT(_name))
+
+/**
+ * @brief Helper macro to add the parallel version of the array ops added by #CUDL_ADD_COMMON_ARRAY_OPERATORS.
+ * @param _name The unit of the ops. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _type The underlying storage type to use.
+ */
+#define CUDL_ADD_PARALLEL_COMMON_ARRAY_OPERATORS(_name, _type)                                                         \
+    CUDL_ADD_PARALLEL_ARRAY_OP(_name, _add)                                                                            \
+    CUDL_ADD_PARALLEL_ARRAY_OP(_name, _sub)                                                                            \
+    CUDL_ADD_PARALLEL_NO_UNIT_ARRAY_OP(_name, _mul, _type)                                                             \
+    CUDL_ADD_PARALLEL_NO_UNIT_ARRAY_OP(_name, _div, _type)                                                             \
+    CUDL_ADD_PARALLEL_RELATIONAL_ARRAY_OP(_name, _eq)                                                                  \
+    CUDL_ADD_PARALLEL_RELATIONAL_ARRAY_OP(_name, _ne)                                                                  \
+    CUDL_ADD_PARALLEL_RELATIONAL_ARRAY_OP(_name, _gt)                                                                  \
+    CUDL_ADD_PARALLEL_RELATIONAL_ARRAY_OP(_name, _ge)                                                                  \
+    CUDL_ADD_PARALLEL_RELATIONAL_ARRAY_OP(_name, _lt)                                                                  \
+    CUDL_ADD_PARALLEL_RELATIONAL_ARRAY_OP(_name, _le)
+
+/**
+ * @brief Adds the parallel version of the reductions added by #CUDL_ADD_INTEGER_REDUCTION_OPERATORS or
+ * #CUDL_ADD_FLOAT_REDUCTION_OPERATORS: cudl_<name>_sum_n_parallel(pool, src, n), cudl_<name>_sumsq_n_parallel,
+ * cudl_<name>_dot_n_parallel(pool, lhs, rhs, n), cudl_<name>_mean_n_parallel, cudl_<name>_min_n_parallel and
+ * cudl_<name>_max_n_parallel. Each chunk is reduced by the reduction, then the results of the chunks are added, or
+ * reduced again for the min and max. The integer results are the same as the ones of the reductions. The floating point
+ * sums add the chunks in an order that depends on how the chunks were shared by the workers, so they may differ in the
+ * last bits from one call to the next. The mean, min and max of an empty array are 0.
+ * @param _name The unit of the reductions. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _sum_type The _sum_type given to #CUDL_ADD_INTEGER_REDUCTION_OPERATORS, or the storage type of a floating
+ * point unit.
+ */
+#define CUDL_ADD_PARALLEL_REDUCTION_OPERATORS(_name, _sum_type)                                                        \
+    __CUDL_PARALLEL_REDUCTION_FUNCTIONS(__CUDL_FN(_name, _sum, _n), _sum_type, __CUDL_UT(_name), __CUDL_PARALLEL_ADD)  \
+    __CUDL_PARALLEL_REDUCTION_FUNCTIONS(__CUDL_FN(_name, _sumsq, _n), _sum_type, __CUDL_UT(_name),                     \
+                                       __CUDL_PARALLEL_ADD)                                                            \
+    __CUDL_PARALLEL_BINARY_REDUCTION_FUNCTIONS(__CUDL_FN(_name, _dot, _n), _sum_type, __CUDL_UT(_name),                \
+                                               __CUDL_PARALLEL_ADD)                                                    \
+    static inline __CUDL_UT(_name) __CUDL_FN(_name, _mean, _n_parallel)(cudl_pool_t * pool,                            \
+                                                                        const __CUDL_UT(_name) *src, size_t n) {       \
+        return __CUDL_AP(_name)(n == 0 ? 0                                                                             \
+                                       : (__CUDL_STORAGE(_name)) (__CUDL_FN(_name, _sum, _n_parallel)(pool, src, n) /  \
+                                                                  (_sum_type) n));                                     \
+    }                                                                                                                  \
+    __CUDL_PARALLEL_EXTREMUM_FUNCTIONS(__CUDL_FN(_name, _min, _n), __CUDL_UT(_name))                                   \
+    __CUDL_PARALLEL_EXTREMUM_FUNCTIONS(__CUDL_FN(_name, _max, _n), __CUDL_UT(_name))
+
+/**
+ * @brief Adds void cudl_<chain>(pool, dst, src, n), which passes the n values of src through a chain of array functions
+ * and writes the output of the last one to dst. The functions are given as (function, destination type) stages, e.g.
+ * (cudl_from_adc_to_mv_n, cudl_mv_t), each one taking (dst, src, n) and reading the output type of the previous one
+ * (_src_type for the first one). Their array parameters may be restrict qualified, like the ones of the generated array
+ * functions. Functions taking more parameters, like the scalar of an op or the byte order of a decoding, are wrapped
+ * in a small function taking (dst, src, n).
+ *
+ * The chain is split in chunks like the functions added by #CUDL_ADD_PARALLEL_CONVERSION, and each chunk goes through
+ * all the stages before the next chunk is read: the intermediate results are written to two scratch buffers of
+ * #CUDL_PARALLEL_CHUNK_BYTES on the stack of the worker, that stay in cache, instead of whole temporary arrays. The
+ * chunk size is computed for the largest type of the chain.
+ * @include parallel_example.c
+ * @param _chain The name of the function to add, without the CUDL_PREFIX.
+ * @param _src_type The type of the elements of src, e.g. uint16_t or cudl_adc_t.
+ * @param _dst_type The type of the elements of dst, the destination type of the last stage.
+ * @param ... The (function, destination type) stages, 1 to 8 of them.
+ */
+#define CUDL_ADD_PARALLEL_CHAIN(_chain, _src_type, _dst_type, ...)                                                     \
+    static inline void __CUDL_PARALLEL_TASK(__CUDL_AP(_chain))(void *context, size_t begin, size_t end,                \
+                                                               size_t worker) {                                        \
+        __CUDL_PARALLEL_CHAIN_TASK_VARIABLES(_src_type)                                                                \
+        (void) worker;                                                                                                 \
+        __CUDL_PARALLEL_STAGES(__CUDL_PARALLEL_TO_DST, _dst_type, _src_type, __VA_ARGS__)                              \
+    }                                                                                                                  \
+    static inline void __CUDL_AP(_chain)(cudl_pool_t * pool, _dst_type * dst, const _src_type *src, size_t n) {        \
+        __cudl_parallel_job_t job = {dst, src, NULL, NULL, NULL};                                                      \
+        size_t largest = __CUDL_PARALLEL_MAX_SIZE(sizeof(_src_type), sizeof(_dst_type));                               \
+        __CUDL_FOR_EACH(__CUDL_PARALLEL_STAGE_SIZE, , __VA_ARGS__)                                                     \
+        cudl_pool_for(pool, n, cudl_parallel_chunk(largest), __CUDL_PARALLEL_TASK(__CUDL_AP(_chain)), &job);           \
+    }
+
+/**
+ * @brief Adds _result_type cudl_<chain>(pool, src, n), which passes the n values of src through a chain of array
+ * functions like #CUDL_ADD_PARALLEL_CHAIN, and reduces the output of the last one with _reduce instead of writing it.
+ * Each chunk is reduced while it is in cache, and the results of the chunks are combined with _combine, first with
+ * the other chunks of the same worker and then in the order of the workers. The result for an empty src is the one of
+ * _reduce for an empty array, which is given zeroed scratch memory: a min or max of an empty src reads a zero.
+ * @include parallel_example.c
+ * @param _chain The name of the function to add, without the CUDL_PREFIX.
+ * @param _src_type The type of the elements of src, e.g. uint16_t or cudl_adc_t.
+ * @param _result_type The type returned by _reduce and by the added function.
+ * @param _reduce A function taking (src, n), src being an array of the destination type of the last stage, and
+ * returning a _result_type, e.g. cudl_mv_sum_n.
+ * @param _combine A macro or function taking two _result_type values and returning their combination, e.g. a macro
+ * adding them when _reduce is a sum.
+ * @param ... The (function, destination type) stages, 1 to 8 of them.
+ */
+#define CUDL_ADD_PARALLEL_REDUCE_CHAIN(_chain, _src_type, _result_type, _reduce, _combine, ...)                        \
+    static inline void __CUDL_PARALLEL_TASK(__CUDL_AP(_chain))(void *context, size_t begin, size_t end,                \
+                                                               size_t worker) {                                        \
+        __CUDL_PARALLEL_CHAIN_TASK_VARIABLES(_src_type)                                                                \
+        _result_type chunk_result;                                                                                     \
+        if (count == 0) { memset(scratch, 0, sizeof(scratch)); }                                                       \
+        __CUDL_PARALLEL_STAGES(__CUDL_PARALLEL_TO_REDUCE, _reduce, _src_type, __VA_ARGS__)                             \
+        _result_type *partial = (_result_type *) job->partials + worker;                                               \
+        *partial = job->seeded[worker] ? _combine(*partial, chunk_result) : chunk_result;                              \
+        job->seeded[worker] = true;                                                                                    \
+    }                                                                                                                  \
+    static inline _result_type __CUDL_AP(_chain)(cudl_pool_t * pool, const _src_type *src, size_t n) {                 \
+        __cudl_parallel_job_t job = {NULL, src, NULL, NULL, NULL};                                                     \
+        size_t largest = sizeof(_src_type);                                                                            \
+        __CUDL_FOR_EACH(__CUDL_PARALLEL_STAGE_SIZE, , __VA_ARGS__)                                                     \
+        __CUDL_PARALLEL_REDUCE(_result_type, _combine, cudl_parallel_chunk(largest),                                   \
+                               __CUDL_PARALLEL_TASK(__CUDL_AP(_chain)))                                                \
+    }
+
+#if defined(CUDL_PARALLEL_IMPLEMENTATION) && !defined(DOXYGEN_SHOULD_SKIP_THIS)
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+__CUDL_STATIC_ASSERT(CUDL_PARALLEL_CHUNK_BYTES % CUDL_ARRAY_ALIGNMENT == 0,
+                     "CUDL_PARALLEL_CHUNK_BYTES must be a multiple of CUDL_ARRAY_ALIGNMENT");
+
+/**
+ * @brief Chunks left to a worker, from begin (the low 32 bits) to end (the high 32 bits). The worker takes them from
+ * the beginning, the thieves take the second half, both with a compare and exchange of the whole range. A range only
+ * grows again when its worker, after emptying it, stores the chunks it stole, which were never part of it before: a
+ * thief cannot mistake it for the range it read. For internal use only.
+ */
+typedef struct {
+    __CUDL_ALIGNAS(CUDL_CACHE_LINE_SIZE) __CUDL_ATOMIC(uint64_t) range;
+} __cudl_pool_slot_t;// NOLINT(bugprone-reserved-identifier)
+
+typedef struct {
+    cudl_pool_t *pool;
+    size_t index;
+    pthread_t thread;
+} __cudl_pool_thread_t;// NOLINT(bugprone-reserved-identifier)
+
+struct cudl_pool {
+    pthread_mutex_t run_mutex;///< Held during a whole cudl_pool_for call, to run the calls one after the other.
+    pthread_mutex_t mutex;    ///< Protects the fields below, and the job.
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    uint64_t generation;///< Incremented for each job, the workers wait for it to change.
+    size_t busy;        ///< Number of threads that did not finish the current job.
+    bool stop;
+    size_t size;
+    size_t started;
+    cudl_pool_task_t task;
+    void *context;
+    size_t n;
+    size_t chunk;
+    __cudl_pool_slot_t *slots;
+    __cudl_pool_thread_t *threads;
+};
+
+/**
+ * @brief Pool whose job the current thread is running, to run the nested calls on the calling thread. For internal use
+ * only.
+ */
+static __CUDL_THREAD_LOCAL cudl_pool_t *__cudl_pool_running;// NOLINT(bugprone-reserved-identifier)
+
+static inline uint64_t __cudl_pool_range(uint64_t begin, uint64_t end) {// NOLINT(bugprone-reserved-identifier)
+    return end << 32 | begin;
+}
+
+/**
+ * @brief Takes the first chunk left to the worker, or steals the second half of the chunks left to the first other
+ * worker that has some. Returns false when no chunk is left. For internal use only.
+ */
+static bool __cudl_pool_next(cudl_pool_t *pool, size_t worker, size_t *index) {// NOLINT(bugprone-reserved-identifier)
+    __cudl_pool_slot_t *own = &pool->slots[worker];
+    uint64_t range = __CUDL_ATOMIC_LOAD(&own->range, relaxed);
+    while ((uint32_t) range < (uint32_t) (range >> 32)) {
+        if (__CUDL_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT(&own->range, &range, range + 1, __CUDL_MEMORY_ORDER(relaxed),
+                                                         __CUDL_MEMORY_ORDER(relaxed))) {
+            *index = (uint32_t) range;
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < pool->size; ++offset) {
+        __cudl_pool_slot_t *victim = &pool->slots[(worker + offset) % pool->size];
+        range = __CUDL_ATOMIC_LOAD(&victim->range, relaxed);
+        while ((uint32_t) range < (uint32_t) (range >> 32)) {
+            const uint64_t begin = (uint32_t) range;
+            const uint64_t end = (uint32_t) (range >> 32);
+            const uint64_t middle = begin + (end - begin) / 2;
+            if (__CUDL_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT(&victim->range, &range, __cudl_pool_range(begin, middle),
+                                                             __CUDL_MEMORY_ORDER(relaxed),
+                                                             __CUDL_MEMORY_ORDER(relaxed))) {
+                __CUDL_ATOMIC_STORE(&own->range, __cudl_pool_range(middle + 1, end), relaxed);
+                *index = (size_t) middle;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void __cudl_pool_work(cudl_pool_t *pool, size_t worker) {// NOLINT(bugprone-reserved-identifier)
+    size_t index;
+    while (__cudl_pool_next(pool, worker, &index)) {
+        const size_t begin = index * pool->chunk;
+        const size_t end = pool->n - begin > pool->chunk ? begin + pool->chunk : pool->n;
+        pool->task(pool->context, begin, end, worker);
+    }
+}
+
+static void *__cudl_pool_worker(void *argument) {// NOLINT(bugprone-reserved-identifier)
+    const __cudl_pool_thread_t *thread = (const __cudl_pool_thread_t *) argument;
+    cudl_pool_t *pool = thread->pool;
+    __cudl_pool_running = pool;
+    pthread_mutex_lock(&pool->mutex);
+    uint64_t generation = 0;// Not the current one: a job may have been started before this thread got the mutex
+    for (;;) {
+        while (pool->generation == generation && !pool->stop) { pthread_cond_wait(&pool->wake, &pool->mutex); }
+        if (pool->stop) { break; }
+        generation = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+        __cudl_pool_work(pool, thread->index);
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->busy == 0) { pthread_cond_signal(&pool->done); }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+cudl_pool_t *cudl_pool_create(size_t threads) {
+    if (threads == 0) {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (size_t) online : 1;
+    }
+    threads = threads < CUDL_PARALLEL_MAX_THREADS ? threads : CUDL_PARALLEL_MAX_THREADS;
+    cudl_pool_t *pool = (cudl_pool_t *) calloc(1, sizeof(cudl_pool_t));
+    if (pool == NULL) { return NULL; }
+    pool->size = threads;
+    pool->started = 1;
+    pool->slots = (__cudl_pool_slot_t *) aligned_alloc(CUDL_CACHE_LINE_SIZE, threads * sizeof(__cudl_pool_slot_t));
+    pool->threads = (__cudl_pool_thread_t *) calloc(threads, sizeof(__cudl_pool_thread_t));
+    pthread_mutex_init(&pool->run_mutex, NULL);
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    if (pool->slots == NULL || pool->threads == NULL) {
+        cudl_pool_destroy(pool);
+        return NULL;
+    }
+    for (size_t i = 0; i < threads; ++i) { __CUDL_ATOMIC_INIT(&pool->slots[i].range, 0); }
+    for (; pool->started < threads; ++pool->started) {
+        __cudl_pool_thread_t *thread = &pool->threads[pool->started];
+        thread->pool = pool;
+        thread->index = pool->started;
+        if (pthread_create(&thread->thread, NULL, __cudl_pool_worker, thread) != 0) {
+            cudl_pool_destroy(pool);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void cudl_pool_destroy(cudl_pool_t *pool) {
+    if (pool == NULL) { return; }
+    pthread_mutex_lock(&pool->mutex);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
+    for (size_t i = 1; i < pool->started; ++i) { pthread_join(pool->threads[i].thread, NULL); }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_mutex_destroy(&pool->run_mutex);
+    free(pool->threads);
+    free(pool->slots);
+    free(pool);
+}
+
+size_t cudl_pool_size(const cudl_pool_t *pool) { return pool != NULL ? pool->size : 1; }
+
+void cudl_pool_for(cudl_pool_t *pool, size_t n, size_t chunk, cudl_pool_task_t task, void *context) {
+    chunk = chunk > 0 ? chunk : 1;
+    if (n / chunk >= UINT32_MAX) { chunk = n / (UINT32_MAX - 1) + 1; }// The chunk indexes must fit in 32 bits
+    const size_t chunks = n / chunk + (n % chunk != 0);
+    if (pool == NULL || pool->size == 1 || chunks <= 1 || __cudl_pool_running == pool) {
+        for (size_t begin = 0; begin < n; begin += chunk) {
+            task(context, begin, n - begin > chunk ? begin + chunk : n, 0);
+        }
+        return;
+    }
+    pthread_mutex_lock(&pool->run_mutex);
+    for (size_t worker = 0, begin = 0; worker < pool->size; ++worker) {
+        const size_t count = chunks / pool->size + (worker < chunks % pool->size);
+        __CUDL_ATOMIC_STORE(&pool->slots[worker].range, __cudl_pool_range(begin, begin + count), relaxed);
+        begin += count;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    pool->task = task;
+    pool->context = context;
+    pool->n = n;
+    pool->chunk = chunk;
+    pool->busy = pool->size - 1;
+    ++pool->generation;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
+
+    cudl_pool_t *running = __cudl_pool_running;
+    __cudl_pool_running = pool;
+    __cudl_pool_work(pool, 0);
+    __cudl_pool_running = running;
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->busy != 0) { pthread_cond_wait(&pool->done, &pool->mutex); }
+    pthread_mutex_unlock(&pool->mutex);
+    pthread_mutex_unlock(&pool->run_mutex);
+}
+#endif//CUDL_PARALLEL_IMPLEMENTATION
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_PARALLEL_H
@@ -0,0 +1,160 @@
+/**
+ * @file cudl_ring_buffer.h
+ * @author Olivier Allaire
+ * @brief Lock-free single producer, single consumer ring buffers holding values of a unit defined with cudl.h.
+ */
+
+#ifndef CUDL_RING_BUFFER_H
+#define CUDL_RING_BUFFER_H
+
+#include "cudl_atomic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Adds a lock-free single producer, single consumer ring buffer of _capacity values of the _name unit. The
+ * buffer type is named cudl_<buffer name>_t and must be initialized with cudl_<buffer name>_init before use. Then, one
+ * thread (or interrupt handler) can push values while another one pops them, without locks:
+ * - bool cudl_<buffer name>_push(buffer, value) and bool cudl_<buffer name>_pop(buffer, &value) move a single value
+ *   and return false when the buffer is full or empty;
+ * - size_t cudl_<buffer name>_push_n(buffer, src, n) and size_t cudl_<buffer name>_pop_n(buffer, dst, n) move up to n
+ *   values with at most two memcpy calls and return the number of values moved;
+ * - size_t cudl_<buffer name>_reserve(buffer, &span) and cudl_<buffer name>_commit(buffer, count) let the producer
+ *   write values in place, size_t cudl_<buffer name>_peek(buffer, &span) and cudl_<buffer name>_consume(buffer, count)
+ *   let the consumer read them in place. The returned span is the largest contiguous part of the buffer available, and
+ *   count must not be larger than it;
+ * - size_t cudl_<buffer name>_size(buffer) returns the number of values in the buffer, which may already have changed
+ *   when used by a thread that is neither the producer nor the consumer.
+ *
+ * The read and write indexes are C11 (or C++11) atomics, each in its own cache line with the copy of the other index
+ * that its thread last saw, so the threads only share a cache line when the buffer is found full or empty. The
+ * buffer type is aligned on #CUDL_CACHE_LINE_SIZE, which must be respected when allocating it dynamically (e.g. with
+ * aligned_alloc).
+ * @include add_ring_buffer_example.c
+ * @param _name The unit of the values. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*.
+ * @param _buffer_name The name of the buffer. This will be used to define the buffer type and its functions.
+ * @param _capacity The number of values the buffer can hold. It must be a power of two.
+ */
+#define CUDL_ADD_EXPLICIT_RING_BUFFER(_name, _buffer_name, _capacity)                                                  \
+    __CUDL_STATIC_ASSERT((_capacity) > 0 && ((_capacity) & ((_capacity) - 1)) == 0,                                    \
+                         "The capacity of a ring buffer must be a power of two");                                      \
+    typedef struct {                                                                                                   \
+        __CUDL_ALIGNAS(CUDL_CACHE_LINE_SIZE) __CUDL_ATOMIC(size_t) head;                                               \
+        size_t cached_tail;                                                                                            \
+        __CUDL_ALIGNAS(CUDL_CACHE_LINE_SIZE) __CUDL_ATOMIC(size_t) tail;                                               \
+        size_t cached_head;                                                                                            \
+        __CUDL_ALIGNAS(CUDL_CACHE_LINE_SIZE) __CUDL_UT(_name) items[_capacity];                                        \
+    } __CUDL_UT(_buffer_name);                                                                                         \
+    static inline void __CUDL_L1STR(__CUDL_AP(_buffer_name), _init)(__CUDL_UT(_buffer_name) * buffer) {                \
+        __CUDL_ATOMIC_INIT(&buffer->head, (size_t) 0);                                                                 \
+        __CUDL_ATOMIC_INIT(&buffer->tail, (size_t) 0);                                                                 \
+        buffer->cached_tail = 0;                                                                                       \
+        buffer->cached_head = 0;                                                                                       \
+    }                                                                                                                  \
+    static inline size_t __CUDL_L1STR(__CUDL_AP(_buffer_name), _size)(__CUDL_UT(_buffer_name) * buffer) {              \
+        const size_t tail = __CUDL_ATOMIC_LOAD(&buffer->tail, acquire);                                                \
+        return __CUDL_ATOMIC_LOAD(&buffer->head, acquire) - tail;                                                      \
+    }                                                                                                                  \
+    static inline size_t __CUDL_L1STR(__CUDL_AP(_buffer_name), _reserve)(__CUDL_UT(_buffer_name) * buffer,             \
+                                                                         __CUDL_UT(_name) * *span) {                   \
+        const size_t head = __CUDL_ATOMIC_LOAD(&buffer->head, relaxed);                                                \
+        const size_t index = head & ((_capacity) - 1);                                                                 \
+        size_t available = (_capacity) - (head - buffer->cached_tail);                                                 \
+        if (available < (_capacity) - index) {                                                                         \
+            buffer->cached_tail = __CUDL_ATOMIC_LOAD(&buffer->tail, acquire);                                          \
+            available = (_capacity) - (head - buffer->cached_tail);                                                    \
+        }                                                                                                              \
+        *span = &buffer->items[index];                                                                                 \
+        return available < (_capacity) - index ? available : (_capacity) - index;                                      \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(__CUDL_AP(_buffer_name), _commit)(__CUDL_UT(_buffer_name) * buffer,                \
+                                                                      size_t count) {                                  \
+        __CUDL_ATOMIC_STORE(&buffer->head, __CUDL_ATOMIC_LOAD(&buffer->head, relaxed) + count, release);               \
+    }                                                                                                                  \
+    static inline size_t __CUDL_L1STR(__CUDL_AP(_buffer_name), _peek)(__CUDL_UT(_buffer_name) * buffer,                \
+                                                                      const __CUDL_UT(_name) * *span) {                \
+        const size_t tail = __CUDL_ATOMIC_LOAD(&buffer->tail, relaxed);                                                \
+        const size_t index = tail & ((_capacity) - 1);                                                                 \
+        size_t available = buffer->cached_head - tail;                                                                 \
+        if (available < (_capacity) - index) {                                                                         \
+            buffer->cached_head = __CUDL_ATOMIC_LOAD(&buffer->head, acquire);                                          \
+            available = buffer->cached_head - tail;                                                                    \
+        }                                                                                                              \
+        *span = &buffer->items[index];                                                                                 \
+        return available < (_capacity) - index ? available : (_capacity) - index;                                      \
+    }                                                                                                                  \
+    static inline void __CUDL_L1STR(__CUDL_AP(_buffer_name), _consume)(__CUDL_UT(_buffer_name) * buffer,               \
+                                                                       size_t count) {                                 \
+        __CUDL_ATOMIC_STORE(&buffer->tail, __CUDL_ATOMIC_LOAD(&buffer->tail, relaxed) + count, release);               \
+    }                                                                                                                  \
+    static inline bool __CUDL_L1STR(__CUDL_AP(_buffer_name), _push)(__CUDL_UT(_buffer_name) * buffer,                  \
+                                                                    __CUDL_UT(_name) value) {                          \
+        const size_t head = __CUDL_ATOMIC_LOAD(&buffer->head, relaxed);                                                \
+        if (head - buffer->cached_tail == (_capacity)) {                                                               \
+            buffer->cached_tail = __CUDL_ATOMIC_LOAD(&buffer->tail, acquire);                                          \
+            if (head - buffer->cached_tail == (_capacity)) { return false; }                                           \
+        }                                                                                                              \
+        buffer->items[head & ((_capacity) - 1)] = value;                                                               \
+        __CUDL_ATOMIC_STORE(&buffer->head, head + 1, release);                                                         \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static inline bool __CUDL_L1STR(__CUDL_AP(_buffer_name), _pop)(__CUDL_UT(_buffer_name) * buffer,                   \
+                                                                   __CUDL_UT(_name) * value) {                         \
+        const size_t tail = __CUDL_ATOMIC_LOAD(&buffer->tail, relaxed);                                                \
+        if (buffer->cached_head == tail) {                                                                             \
+            buffer->cached_head = __CUDL_ATOMIC_LOAD(&buffer->head, acquire);                                          \
+            if (buffer->cached_head == tail) { return false; }                                                         \
+        }                                                                                                              \
+        *value = buffer->items[tail & ((_capacity) - 1)];                                                              \
+        __CUDL_ATOMIC_STORE(&buffer->tail, tail + 1, release);                                                         \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static inline size_t __CUDL_L1STR(__CUDL_AP(_buffer_name), _push_n)(__CUDL_UT(_buffer_name) * buffer,              \
+                                                                        const __CUDL_UT(_name) * src, size_t n) {      \
+        const size_t head = __CUDL_ATOMIC_LOAD(&buffer->head, relaxed);                                                \
+        const size_t index = head & ((_capacity) - 1);                                                                 \
+        size_t count = (_capacity) - (head - buffer->cached_tail);                                                     \
+        if (count < n) {                                                                                               \
+            buffer->cached_tail = __CUDL_ATOMIC_LOAD(&buffer->tail, acquire);                                          \
+            count = (_capacity) - (head - buffer->cached_tail);                                                        \
+        }                                                                                                              \
+        count = count < n ? count : n;                                                                                 \
+        const size_t first = count < (_capacity) - index ? count : (_capacity) - index;                                \
+        memcpy(&buffer->items[index], src, first * sizeof(__CUDL_UT(_name)));                                          \
+        memcpy(&buffer->items[0], src + first, (count - first) * sizeof(__CUDL_UT(_name)));                            \
+        __CUDL_ATOMIC_STORE(&buffer->head, head + count, release);                                                     \
+        return count;                                                                                                  \
+    }                                                                                                                  \
+    static inline size_t __CUDL_L1STR(__CUDL_AP(_buffer_name), _pop_n)(__CUDL_UT(_buffer_name) * buffer,               \
+                                                                       __CUDL_UT(_name) * dst, size_t n) {             \
+        const size_t tail = __CUDL_ATOMIC_LOAD(&buffer->tail, relaxed);                                                \
+        const size_t index = tail & ((_capacity) - 1);                                                                 \
+        size_t count = buffer->cached_head - tail;                                                                     \
+        if (count < n) {                                                                                               \
+            buffer->cached_head = __CUDL_ATOMIC_LOAD(&buffer->head, acquire);                                          \
+            count = buffer->cached_head - tail;                                                                        \
+        }                                                                                                              \
+        count = count < n ? count : n;                                                                                 \
+        const size_t first = count < (_capacity) - index ? count : (_capacity) - index;                                \
+        memcpy(dst, &buffer->items[index], first * sizeof(__CUDL_UT(_name)));                                          \
+        memcpy(dst + first, &buffer->items[0], (count - first) * sizeof(__CUDL_UT(_name)));                            \
+        __CUDL_ATOMIC_STORE(&buffer->tail, tail + count, release);                                                     \
+        return count;                                                                                                  \
+    }
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_RING_BUFFER naming the buffer <name>_ring_buffer, e.g.
+ * cudl_mv_ring_buffer_t and cudl_mv_ring_buffer_push for the mv unit.
+ * @include add_ring_buffer_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_RING_BUFFER documentation.
+ * @param _capacity See #CUDL_ADD_EXPLICIT_RING_BUFFER documentation.
+ */
+#define CUDL_ADD_RING_BUFFER(_name, _capacity) CUDL_ADD_EXPLICIT_RING_BUFFER(_name, _name##_ring_buffer, _capacity)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_RING_BUFFER_H
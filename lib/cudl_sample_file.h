@@ -0,0 +1,342 @@
+/**
+ * @file cudl_sample_file.h
+ * @author Olivier Allaire
+ * @brief Files of samples of a unit defined with cudl.h, tagged with the unit they hold, read back by mapping them in
+ * memory instead of copying them.
+ *
+ * A sample file is a header of #CUDL_SAMPLE_FILE_HEADER_SIZE bytes followed by the raw array of samples, at the width
+ * of their storage type. Opening a file maps it and returns a typed view on the samples, after checking that the file
+ * holds the samples of the unit it is opened for. The samples are not read nor copied when the file is opened: the
+ * pages are read by the kernel when the view is first used, and stay shared with the page cache. The view is aligned
+ * on #CUDL_ARRAY_ALIGNMENT, so the _n and _n_aligned array functions run directly on it.
+ *
+ * Files are written with a buffered append writer, in the byte order of the target, and the mapping uses the POSIX
+ * open, mmap and write functions.
+ * @include add_sample_file_example.c
+ */
+
+#ifndef CUDL_SAMPLE_FILE_H
+#define CUDL_SAMPLE_FILE_H
+
+#include "cudl_wire.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size, in bytes, of the header of a sample file, where the samples start. It holds, in this order:
+ * - the magic bytes "cudlsmp1";
+ * - the unit name, the kind and width of the storage type, the byte order and the scale, laid out like in the wire
+ *   header described by #CUDL_WIRE_HEADER_SIZE, on 20 bytes;
+ * - the size of the header, on 4 bytes in the byte order of the file;
+ * - the number of samples, on 8 bytes in the byte order of the file. It is UINT64_MAX while the file is being written,
+ *   in which case it is given by the size of the file;
+ * - 24 reserved bytes, set to 0.
+ */
+#define CUDL_SAMPLE_FILE_HEADER_SIZE 64
+
+#ifndef CUDL_SAMPLE_FILE_WRITE_SIZE
+/**
+ * @brief Size, in bytes, of the buffer of a writer, so of each write to the file. Appends of at least this size are
+ * written directly from the array given. It can be redefined before including this header.
+ */
+#define CUDL_SAMPLE_FILE_WRITE_SIZE (1 << 20)
+#endif
+
+/**
+ * @brief Result of opening, writing or closing a sample file.
+ */
+typedef enum {
+    CUDL_SAMPLE_FILE_OK = 0,             ///< Success.
+    CUDL_SAMPLE_FILE_IO_ERROR,           ///< A system call failed, errno tells why.
+    CUDL_SAMPLE_FILE_INVALID,            ///< The file is not a sample file, or is shorter than its header says.
+    CUDL_SAMPLE_FILE_UNIT_MISMATCH,      ///< The samples are not of the unit, storage type or scale expected.
+    CUDL_SAMPLE_FILE_BYTE_ORDER_MISMATCH,///< The samples were written in another byte order than the target one.
+} cudl_sample_file_status_t;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Mapping of a file and the samples it holds, and state of a writer. For internal use only.
+ */
+typedef struct {
+    const void *samples;
+    size_t count;
+    void *mapping;
+    size_t size;
+} __cudl_sample_file_t;// NOLINT(bugprone-reserved-identifier)
+typedef struct {
+    int fd;
+    uint64_t count;
+    size_t used;
+    size_t width;
+    unsigned char *buffer;
+} __cudl_sample_writer_t;// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Reads or writes an unsigned integer of size bytes at bytes, in the given byte order. For internal use only.
+ */
+static inline uint64_t __cudl_sample_file_get(const unsigned char *bytes,// NOLINT(bugprone-reserved-identifier)
+                                              size_t size, cudl_byte_order_t order) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+        value |= (uint64_t) bytes[order == CUDL_BIG_ENDIAN ? size - 1 - i : i] << 8 * i;
+    }
+    return value;
+}
+static inline void __cudl_sample_file_set(unsigned char *bytes, size_t size,// NOLINT(bugprone-reserved-identifier)
+                                          uint64_t value) {
+    for (size_t i = 0; i < size; ++i) {
+        bytes[CUDL_HOST_BYTE_ORDER == CUDL_BIG_ENDIAN ? size - 1 - i : i] = (unsigned char) (value >> 8 * i);
+    }
+}
+
+/**
+ * @brief Writes size bytes to the file of the writer, retrying on partial writes and interruptions. For internal use
+ * only.
+ */
+static inline bool __cudl_sample_write(int fd, const unsigned char *bytes,// NOLINT(bugprone-reserved-identifier)
+                                       size_t size) {
+    while (size > 0) {
+        const ssize_t written = write(fd, bytes, size);
+        if (written < 0 && errno == EINTR) { continue; }
+        if (written <= 0) { return false; }
+        bytes += written;
+        size -= (size_t) written;
+    }
+    return true;
+}
+
+/**
+ * @brief Maps the file at path and checks its header against the unit it is opened for. For internal use only.
+ */
+static inline cudl_sample_file_status_t __cudl_sample_file_open(// NOLINT(bugprone-reserved-identifier)
+        __cudl_sample_file_t *file, const char *path, const char *name, cudl_wire_kind_t kind, size_t width,
+        unsigned frac_bits) {
+    memset(file, 0, sizeof(*file));
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) { return CUDL_SAMPLE_FILE_IO_ERROR; }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        return CUDL_SAMPLE_FILE_IO_ERROR;
+    }
+    if (status.st_size < CUDL_SAMPLE_FILE_HEADER_SIZE || (uint64_t) status.st_size > SIZE_MAX) {
+        close(fd);
+        return CUDL_SAMPLE_FILE_INVALID;
+    }
+    void *mapping = mmap(NULL, (size_t) status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);// The mapping keeps the file open
+    if (mapping == MAP_FAILED) { return CUDL_SAMPLE_FILE_IO_ERROR; }
+    file->mapping = mapping;
+    file->size = (size_t) status.st_size;
+
+    const unsigned char *header = (const unsigned char *) mapping;
+    uint32_t unused_count;
+    cudl_byte_order_t order;
+    if (memcmp(header, "cudlsmp1", 8) != 0 || header[26] > CUDL_BIG_ENDIAN) { return CUDL_SAMPLE_FILE_INVALID; }
+    // The wire header check also reads a count, from the bytes of the header size
+    if (!__cudl_wire_decode_header(header + 8, name, kind, width, frac_bits, &unused_count, &order)) {
+        return CUDL_SAMPLE_FILE_UNIT_MISMATCH;
+    }
+    if (order != CUDL_HOST_BYTE_ORDER && width > 1) { return CUDL_SAMPLE_FILE_BYTE_ORDER_MISMATCH; }
+    const uint64_t header_size = __cudl_sample_file_get(header + 28, 4, order);
+    uint64_t count = __cudl_sample_file_get(header + 32, 8, order);
+    if (header_size < CUDL_SAMPLE_FILE_HEADER_SIZE || header_size % CUDL_ARRAY_ALIGNMENT != 0 ||
+        header_size > file->size) {
+        return CUDL_SAMPLE_FILE_INVALID;
+    }
+    if (count == UINT64_MAX) {
+        count = (file->size - header_size) / width;
+    } else if (count > (file->size - header_size) / width) {
+        return CUDL_SAMPLE_FILE_INVALID;
+    }
+    file->samples = header + header_size;
+    file->count = (size_t) count;
+    return CUDL_SAMPLE_FILE_OK;
+}
+static inline void __cudl_sample_file_close(__cudl_sample_file_t *file) {// NOLINT(bugprone-reserved-identifier)
+    if (file->mapping != NULL) { munmap(file->mapping, file->size); }
+    memset(file, 0, sizeof(*file));
+}
+
+/**
+ * @brief Creates the file at path, writes its header with an unknown count, and allocates the buffer of the writer.
+ * The final count is written by __cudl_sample_writer_close. For internal use only.
+ */
+static inline void __cudl_sample_writer_header(// NOLINT(bugprone-reserved-identifier)
+        unsigned char *header, const char *name, cudl_wire_kind_t kind, size_t width, unsigned frac_bits) {
+    memset(header, 0, CUDL_SAMPLE_FILE_HEADER_SIZE);
+    memcpy(header, "cudlsmp1", 8);
+    __cudl_wire_encode_header(header + 8, name, kind, width, frac_bits, 0, CUDL_HOST_BYTE_ORDER);
+    __cudl_sample_file_set(header + 28, 4, CUDL_SAMPLE_FILE_HEADER_SIZE);
+    __cudl_sample_file_set(header + 32, 8, UINT64_MAX);
+}
+static inline cudl_sample_file_status_t __cudl_sample_writer_open(// NOLINT(bugprone-reserved-identifier)
+        __cudl_sample_writer_t *writer, const char *path, const char *name, cudl_wire_kind_t kind, size_t width,
+        unsigned frac_bits) {
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = -1;
+    writer->width = width;
+    writer->buffer = (unsigned char *) malloc(CUDL_SAMPLE_FILE_WRITE_SIZE);
+    if (writer->buffer == NULL) { return CUDL_SAMPLE_FILE_IO_ERROR; }
+    writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (writer->fd < 0) {
+        free(writer->buffer);
+        writer->buffer = NULL;
+        return CUDL_SAMPLE_FILE_IO_ERROR;
+    }
+    __cudl_sample_writer_header(writer->buffer, name, kind, width, frac_bits);
+    writer->used = CUDL_SAMPLE_FILE_HEADER_SIZE;
+    return CUDL_SAMPLE_FILE_OK;
+}
+static inline cudl_sample_file_status_t __cudl_sample_writer_flush(// NOLINT(bugprone-reserved-identifier)
+        __cudl_sample_writer_t *writer) {
+    const size_t used = writer->used;
+    writer->used = 0;
+    return __cudl_sample_write(writer->fd, writer->buffer, used) ? CUDL_SAMPLE_FILE_OK : CUDL_SAMPLE_FILE_IO_ERROR;
+}
+static inline cudl_sample_file_status_t __cudl_sample_writer_append_n(// NOLINT(bugprone-reserved-identifier)
+        __cudl_sample_writer_t *writer, const void *src, size_t n) {
+    const unsigned char *bytes = (const unsigned char *) src;
+    size_t size = n * writer->width;
+    writer->count += n;
+    if (writer->used + size > CUDL_SAMPLE_FILE_WRITE_SIZE) {
+        // Fills the buffer so that every write but the last one is of the buffer size
+        const size_t fill = CUDL_SAMPLE_FILE_WRITE_SIZE - writer->used;
+        memcpy(writer->buffer + writer->used, bytes, fill);
+        writer->used += fill;
+        bytes += fill;
+        size -= fill;
+        if (__cudl_sample_writer_flush(writer) != CUDL_SAMPLE_FILE_OK) { return CUDL_SAMPLE_FILE_IO_ERROR; }
+        const size_t direct = size / CUDL_SAMPLE_FILE_WRITE_SIZE * CUDL_SAMPLE_FILE_WRITE_SIZE;
+        if (!__cudl_sample_write(writer->fd, bytes, direct)) { return CUDL_SAMPLE_FILE_IO_ERROR; }
+        bytes += direct;
+        size -= direct;
+    }
+    memcpy(writer->buffer + writer->used, bytes, size);
+    writer->used += size;
+    return CUDL_SAMPLE_FILE_OK;
+}
+static inline cudl_sample_file_status_t __cudl_sample_writer_close(// NOLINT(bugprone-reserved-identifier)
+        __cudl_sample_writer_t *writer) {
+    cudl_sample_file_status_t status = CUDL_SAMPLE_FILE_OK;
+    if (writer->fd >= 0) {
+        unsigned char count[8];
+        __cudl_sample_file_set(count, 8, writer->count);
+        if (__cudl_sample_writer_flush(writer) != CUDL_SAMPLE_FILE_OK || pwrite(writer->fd, count, 8, 32) != 8) {
+            status = CUDL_SAMPLE_FILE_IO_ERROR;
+        }
+        if (close(writer->fd) != 0) { status = CUDL_SAMPLE_FILE_IO_ERROR; }
+    }
+    free(writer->buffer);
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = -1;
+    return status;
+}
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Adds the functions to write sample files of the _name unit, and to map them back:
+ * - cudl_sample_file_status_t cudl_<name>_sample_file_open(file, path) maps the file at path in a
+ *   cudl_<name>_sample_file_t. On success, file->samples is a const cudl_<name>_t * view on the file->count samples.
+ *   The file must hold samples of the unit, written with the same storage type, scale and byte order, otherwise
+ *   CUDL_SAMPLE_FILE_UNIT_MISMATCH or CUDL_SAMPLE_FILE_BYTE_ORDER_MISMATCH is returned;
+ * - cudl_<name>_sample_file_close(file) unmaps it. It must be called whatever open returned, and the view is invalid
+ *   after it;
+ * - cudl_sample_file_status_t cudl_<name>_sample_writer_open(writer, path) creates or truncates the file at path, for a
+ *   cudl_<name>_sample_writer_t;
+ * - cudl_<name>_sample_writer_append(writer, value) and cudl_<name>_sample_writer_append_n(writer, src, n) add samples
+ *   at the end of the file. They are copied to a buffer of #CUDL_SAMPLE_FILE_WRITE_SIZE bytes, written to the file when
+ *   full, and large appends are written directly from src;
+ * - cudl_sample_file_status_t cudl_<name>_sample_writer_close(writer) writes what is left in the buffer and the number
+ *   of samples in the header, and closes the file. A file still being written can be opened, its count is then given
+ *   by its size.
+ *
+ * Reading the view on the pages of a file may raise SIGBUS if the file is truncated by another process meanwhile.
+ * madvise(file.samples, ...) can be used to tell the kernel how the samples will be read.
+ * @include add_sample_file_example.c
+ * @param _name The unit of the samples. It is expected to be the same as the _name param used with CUDL_ADD_UNIT*. It
+ * is also the unit name recorded in the header.
+ * @param _type The underlying storage type. It is expected to be the same as the _type param used with CUDL_ADD_UNIT*.
+ * @param _frac_bits The scale recorded in the header, as a number of fractional bits.
+ */
+#define CUDL_ADD_EXPLICIT_SAMPLE_FILE(_name, _type, _frac_bits)                                                        \
+    typedef struct {                                                                                                   \
+        const __CUDL_UT(_name) * samples;                                                                              \
+        size_t count;                                                                                                  \
+        __cudl_sample_file_t file;                                                                                     \
+    } __CUDL_L1STR(__CUDL_AP(_name), _sample_file_t);                                                                  \
+    typedef struct {                                                                                                   \
+        __cudl_sample_writer_t writer;                                                                                 \
+    } __CUDL_L1STR(__CUDL_AP(_name), _sample_writer_t);                                                                \
+    static inline cudl_sample_file_status_t __CUDL_FN(_name, _sample_file, _open)(                                     \
+            __CUDL_L1STR(__CUDL_AP(_name), _sample_file_t) * file, const char *path) {                                 \
+        const cudl_sample_file_status_t status = __cudl_sample_file_open(&file->file, path, #_name,                    \
+                                                                         __CUDL_WIRE_KIND(_type), sizeof(_type),       \
+                                                                         (_frac_bits));                                \
+        file->samples = status == CUDL_SAMPLE_FILE_OK ? (const __CUDL_UT(_name) *) file->file.samples : NULL;          \
+        file->count = status == CUDL_SAMPLE_FILE_OK ? file->file.count : 0;                                            \
+        return status;                                                                                                 \
+    }                                                                                                                  \
+    static inline void __CUDL_FN(_name, _sample_file, _close)(__CUDL_L1STR(__CUDL_AP(_name), _sample_file_t) * file) { \
+        __cudl_sample_file_close(&file->file);                                                                         \
+        file->samples = NULL;                                                                                          \
+        file->count = 0;                                                                                               \
+    }                                                                                                                  \
+    static inline cudl_sample_file_status_t __CUDL_FN(_name, _sample_writer, _open)(                                   \
+            __CUDL_L1STR(__CUDL_AP(_name), _sample_writer_t) * writer, const char *path) {                             \
+        return __cudl_sample_writer_open(&writer->writer, path, #_name, __CUDL_WIRE_KIND(_type), sizeof(_type),        \
+                                         (_frac_bits));                                                                \
+    }                                                                                                                  \
+    static inline cudl_sample_file_status_t __CUDL_FN(_name, _sample_writer, _append_n)(                               \
+            __CUDL_L1STR(__CUDL_AP(_name), _sample_writer_t) * writer, const __CUDL_UT(_name) * src, size_t n) {       \
+        return __cudl_sample_writer_append_n(&writer->writer, src, n);                                                 \
+    }                                                                                                                  \
+    static inline cudl_sample_file_status_t __CUDL_FN(_name, _sample_writer, _append)(                                 \
+            __CUDL_L1STR(__CUDL_AP(_name), _sample_writer_t) * writer, __CUDL_UT(_name) value) {                       \
+        if (writer->writer.used + sizeof(value) <= CUDL_SAMPLE_FILE_WRITE_SIZE) {                                      \
+            memcpy(writer->writer.buffer + writer->writer.used, &value, sizeof(value));                                \
+            writer->writer.used += sizeof(value);                                                                      \
+            ++writer->writer.count;                                                                                    \
+            return CUDL_SAMPLE_FILE_OK;                                                                                \
+        }                                                                                                              \
+        return __cudl_sample_writer_append_n(&writer->writer, &value, 1);                                              \
+    }                                                                                                                  \
+    static inline cudl_sample_file_status_t __CUDL_FN(_name, _sample_writer, _close)(                                  \
+            __CUDL_L1STR(__CUDL_AP(_name), _sample_writer_t) * writer) {                                               \
+        return __cudl_sample_writer_close(&writer->writer);                                                            \
+    }
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_SAMPLE_FILE for units without fractional bits.
+ * @include add_sample_file_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_SAMPLE_FILE documentation.
+ * @param _type See #CUDL_ADD_EXPLICIT_SAMPLE_FILE documentation.
+ */
+#define CUDL_ADD_SAMPLE_FILE(_name, _type) CUDL_ADD_EXPLICIT_SAMPLE_FILE(_name, _type, 0)
+
+/**
+ * @brief Version of #CUDL_ADD_EXPLICIT_SAMPLE_FILE for fixed-point units added with #CUDL_ADD_FIXED_POINT_UNIT,
+ * recording their number of fractional bits in the header.
+ * @include add_sample_file_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_SAMPLE_FILE documentation.
+ * @param _storage The storage type. It is expected to be the same as the _storage param used with
+ * CUDL_ADD_FIXED_POINT_UNIT.
+ */
+#define CUDL_ADD_FIXED_POINT_SAMPLE_FILE(_name, _storage)                                                              \
+    CUDL_ADD_EXPLICIT_SAMPLE_FILE(_name, _storage, __CUDL_FRAC_BITS(_name))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_SAMPLE_FILE_H
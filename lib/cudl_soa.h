@@ -0,0 +1,311 @@
+/**
+ * @file cudl_soa.h
+ * @author Olivier Allaire
+ * @brief Struct-of-arrays containers of records whose fields are units defined with cudl.h, and the allocators they
+ * get their storage from.
+ */
+
+#ifndef CUDL_SOA_H
+#define CUDL_SOA_H
+
+#include "cudl.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Allocator the containers get their storage from. allocate returns size bytes aligned on alignment (a power of
+ * two), or NULL when it cannot. release gives back a block returned by allocate, with its size. context is passed to
+ * both, e.g. the arena to allocate from.
+ */
+typedef struct {
+    void *(*allocate)(void *context, size_t size, size_t alignment);
+    void (*release)(void *context, void *block, size_t size);
+    void *context;
+} cudl_allocator_t;
+
+/**
+ * @brief Bump allocator carving blocks out of a buffer given by the user. Blocks are not released one by one, except
+ * the last one allocated, but all at once by #cudl_arena_reset. This makes the allocation of many containers, or of
+ * the columns of a capture, a few additions.
+ */
+typedef struct {
+    unsigned char *buffer;
+    size_t capacity;
+    size_t used;
+} cudl_arena_t;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+static inline void *__cudl_heap_allocate(// NOLINT(bugprone-reserved-identifier)
+        void *context, size_t size, size_t alignment) {
+    (void) context;
+#ifdef _MSC_VER
+    return _aligned_malloc(size, alignment);
+#else
+    // C11 requires the size given to aligned_alloc to be a multiple of the alignment
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+static inline void __cudl_heap_release(void *context, void *block, size_t size) {// NOLINT(bugprone-reserved-identifier)
+    (void) context;
+    (void) size;
+#ifdef _MSC_VER
+    _aligned_free(block);
+#else
+    free(block);
+#endif
+}
+
+static inline void *__cudl_arena_allocate(// NOLINT(bugprone-reserved-identifier)
+        void *context, size_t size, size_t alignment) {
+    cudl_arena_t *arena = (cudl_arena_t *) context;
+    const size_t misalignment = ((uintptr_t) arena->buffer + arena->used) & (alignment - 1);
+    const size_t start = arena->used + (misalignment ? alignment - misalignment : 0);
+    if (start > arena->capacity || size > arena->capacity - start) { return NULL; }
+    arena->used = start + size;
+    return arena->buffer + start;
+}
+
+static inline void __cudl_arena_release(// NOLINT(bugprone-reserved-identifier)
+        void *context, void *block, size_t size) {
+    cudl_arena_t *arena = (cudl_arena_t *) context;
+    if ((unsigned char *) block + size == arena->buffer + arena->used) {
+        arena->used = (size_t) ((unsigned char *) block - arena->buffer);
+    }
+}
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Returns the allocator of aligned blocks from the heap, with aligned_alloc and free (_aligned_malloc and
+ * _aligned_free with MSVC). It is the one used by the containers when none is given.
+ */
+static inline cudl_allocator_t cudl_heap_allocator(void) {
+    cudl_allocator_t allocator;
+    allocator.allocate = __cudl_heap_allocate;
+    allocator.release = __cudl_heap_release;
+    allocator.context = NULL;
+    return allocator;
+}
+
+/**
+ * @brief Initializes an arena allocating from the capacity bytes of buffer, which must outlive it.
+ */
+static inline void cudl_arena_init(cudl_arena_t *arena, void *buffer, size_t capacity) {
+    arena->buffer = (unsigned char *) buffer;
+    arena->capacity = capacity;
+    arena->used = 0;
+}
+
+/**
+ * @brief Releases all the blocks allocated from the arena at once. The containers using it must not be used anymore,
+ * or be initialized again.
+ */
+static inline void cudl_arena_reset(cudl_arena_t *arena) { arena->used = 0; }
+
+/**
+ * @brief Returns an allocator getting its blocks from the arena, which must outlive the containers using it.
+ */
+static inline cudl_allocator_t cudl_arena_allocator(cudl_arena_t *arena) {
+    cudl_allocator_t allocator;
+    allocator.allocate = __cudl_arena_allocate;
+    allocator.release = __cudl_arena_release;
+    allocator.context = arena;
+    return allocator;
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Field name and unit of a (field, unit) pair given to #CUDL_ADD_SOA. For internal use only.
+ */
+#define __CUDL_SOA_FIELD(_pair) __CUDL_SOA_FIELD_I _pair      // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_FIELD_I(_field, _unit) _field              // NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_UNIT_TYPE(_pair) __CUDL_SOA_UNIT_TYPE_I _pair// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_UNIT_TYPE_I(_field, _unit) __CUDL_UT(_unit)  // NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Size of a column of _capacity values, rounded up to keep the next column aligned. For internal use only.
+ */
+#define __CUDL_SOA_COLUMN_SIZE(_capacity, _pair)                                                                       \
+    (((_capacity) * sizeof(__CUDL_SOA_UNIT_TYPE(_pair)) + CUDL_ARRAY_ALIGNMENT - 1) /                                  \
+     CUDL_ARRAY_ALIGNMENT * CUDL_ARRAY_ALIGNMENT)// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Pieces of the code generated by #CUDL_ADD_SOA for each column, called by #__CUDL_FOR_EACH. They refer to the
+ * soa, grown, block, row, rows, view, begin, index, count and n variables of the functions they are used in. For
+ * internal use only.
+ */
+#define __CUDL_SOA_MEMBER(_qualifier, _pair)                                                                           \
+    _qualifier __CUDL_SOA_UNIT_TYPE(_pair) * __CUDL_SOA_FIELD(_pair);// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_ROW_MEMBER(_unused, _pair)                                                                          \
+    __CUDL_SOA_UNIT_TYPE(_pair) __CUDL_SOA_FIELD(_pair);// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_ADD_COLUMN_SIZE(_capacity, _pair)                                                                   \
+    +__CUDL_SOA_COLUMN_SIZE(_capacity, _pair)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_MOVE_COLUMN(_capacity, _pair)                                                                       \
+    grown.__CUDL_SOA_FIELD(_pair) = (__CUDL_SOA_UNIT_TYPE(_pair) *) (void *) block;                                    \
+    if (soa->size > 0) {                                                                                               \
+        memcpy(grown.__CUDL_SOA_FIELD(_pair), soa->__CUDL_SOA_FIELD(_pair),                                            \
+               soa->size * sizeof(__CUDL_SOA_UNIT_TYPE(_pair)));                                                       \
+    }                                                                                                                  \
+    block += __CUDL_SOA_COLUMN_SIZE(_capacity, _pair);// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_NULL_COLUMN(_soa, _pair)                                                                            \
+    (_soa)->__CUDL_SOA_FIELD(_pair) = NULL;// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_SET_FROM_ROW(_unused, _pair)                                                                        \
+    soa->__CUDL_SOA_FIELD(_pair)[soa->size] = row.__CUDL_SOA_FIELD(_pair);// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_SET_FROM_ROWS(_unused, _pair)                                                                       \
+    for (size_t i = 0; i < n; ++i) {                                                                                   \
+        soa->__CUDL_SOA_FIELD(_pair)[soa->size + i] = rows[i].__CUDL_SOA_FIELD(_pair);                                 \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_SET_FROM_VIEW(_unused, _pair)                                                                       \
+    memcpy(soa->__CUDL_SOA_FIELD(_pair) + soa->size, view.__CUDL_SOA_FIELD(_pair),                                     \
+           view.size * sizeof(__CUDL_SOA_UNIT_TYPE(_pair)));// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_GET_ROW(_unused, _pair)                                                                             \
+    row.__CUDL_SOA_FIELD(_pair) = soa->__CUDL_SOA_FIELD(_pair)[index];// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_SLICE(_unused, _pair)                                                                               \
+    view.__CUDL_SOA_FIELD(_pair) = soa->__CUDL_SOA_FIELD(_pair) + begin;// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_SOA_COLUMN_ACCESSOR(_record, _pair)                                                                     \
+    static inline __CUDL_SOA_UNIT_TYPE(_pair) *                                                                        \
+            __CUDL_FN(_record, _, __CUDL_SOA_FIELD(_pair))(__CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa) {           \
+        return soa->__CUDL_SOA_FIELD(_pair);                                                                           \
+    }// NOLINT(bugprone-reserved-identifier)
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Adds a struct-of-arrays container of _record records, whose fields are given as (field, unit) pairs, e.g.
+ * CUDL_ADD_SOA(sample, (time, ns), (voltage, mv)). Each field is stored in its own column, a cudl_<unit>_t array, so a
+ * loop over one field reads contiguous values instead of striding over whole records. It adds:
+ * - cudl_<record>_t, the record with one cudl_<unit>_t member per field, and cudl_<record>_soa_t, the container. Its
+ *   size member is the number of records, and each field is a column pointer;
+ * - cudl_<record>_view_t, a view of size records with a const column pointer per field. The columns can be given
+ *   directly to the array functions of their unit, e.g. cudl_mv_sum_n(view.voltage, view.size);
+ * - cudl_<record>_soa_init(soa, allocator) and cudl_<record>_soa_release(soa), where allocator may be NULL to use
+ *   #cudl_heap_allocator, or e.g. the one of an arena with #cudl_arena_allocator;
+ * - bool cudl_<record>_soa_reserve(soa, capacity), to allocate the columns for at least capacity records, which
+ *   returns false without allocating when the block size of capacity records would not fit in a size_t, and
+ *   cudl_<record>_soa_clear(soa), to remove all the records but keep the columns;
+ * - bool cudl_<record>_soa_append(soa, record), bool cudl_<record>_soa_append_n(soa, records, n) to append the n
+ *   records of an array, and bool cudl_<record>_soa_append_view(soa, view) to append the records of a view column by
+ *   column. They grow the storage when needed, doubling its capacity, and return false when it cannot be allocated;
+ * - cudl_<record>_t cudl_<record>_soa_get(soa, index), to gather the fields of a record;
+ * - cudl_<record>_view_t cudl_<record>_soa_view(soa) and cudl_<record>_soa_slice(soa, begin, count), the views of all
+ *   or part of the records, e.g. to split a scan in chunks;
+ * - cudl_<unit>_t *cudl_<record>_<field>(soa), the column of a field.
+ *
+ * All the columns live in a single block from the allocator, each one aligned on #CUDL_ARRAY_ALIGNMENT, so the columns
+ * of a whole view can be given to the _n_aligned array functions too. Growing reallocates the block and copies the
+ * columns, which invalidates the column pointers and views previously taken.
+ * @include add_soa_example.c
+ * @param _record The name of the record. This will be used to define the types and function names.
+ * @param ... The (field, unit) pairs, 1 to 16 of them. The units are expected to be the _name params used with
+ * CUDL_ADD_UNIT*.
+ */
+#define CUDL_ADD_SOA(_record, ...)                                                                                     \
+    typedef struct {                                                                                                   \
+        __CUDL_FOR_EACH(__CUDL_SOA_ROW_MEMBER, , __VA_ARGS__)                                                          \
+    } __CUDL_UT(_record);                                                                                              \
+    typedef struct {                                                                                                   \
+        size_t size;                                                                                                   \
+        size_t capacity;                                                                                               \
+        cudl_allocator_t allocator;                                                                                    \
+        unsigned char *block;                                                                                          \
+        size_t block_size;                                                                                             \
+        __CUDL_FOR_EACH(__CUDL_SOA_MEMBER, , __VA_ARGS__)                                                              \
+    } __CUDL_L1STR(__CUDL_AP(_record), _soa_t);                                                                        \
+    typedef struct {                                                                                                   \
+        size_t size;                                                                                                   \
+        __CUDL_FOR_EACH(__CUDL_SOA_MEMBER, const, __VA_ARGS__)                                                         \
+    } __CUDL_L1STR(__CUDL_AP(_record), _view_t);                                                                       \
+    static inline void __CUDL_FN(_record, _soa, _init)(__CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa,                 \
+                                                       const cudl_allocator_t *allocator) {                            \
+        soa->size = 0;                                                                                                 \
+        soa->capacity = 0;                                                                                             \
+        soa->allocator = allocator ? *allocator : cudl_heap_allocator();                                               \
+        soa->block = NULL;                                                                                             \
+        soa->block_size = 0;                                                                                           \
+        __CUDL_FOR_EACH(__CUDL_SOA_NULL_COLUMN, soa, __VA_ARGS__)                                                      \
+    }                                                                                                                  \
+    static inline void __CUDL_FN(_record, _soa, _release)(__CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa) {            \
+        if (soa->block) { soa->allocator.release(soa->allocator.context, soa->block, soa->block_size); }               \
+        __CUDL_FN(_record, _soa, _init)(soa, &soa->allocator);                                                         \
+    }                                                                                                                  \
+    static inline void __CUDL_FN(_record, _soa, _clear)(__CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa) {              \
+        soa->size = 0;                                                                                                 \
+    }                                                                                                                  \
+    static inline bool __CUDL_FN(_record, _soa, _reserve)(__CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa,              \
+                                                          size_t capacity) {                                           \
+        if (capacity <= soa->capacity) { return true; }                                                                \
+        if (capacity > (((size_t) -1) - sizeof(__CUDL_UT(_record)) * CUDL_ARRAY_ALIGNMENT) /                           \
+                               sizeof(__CUDL_UT(_record))) {                                                           \
+            return false;                                                                                              \
+        }                                                                                                              \
+        const size_t block_size = 0 __CUDL_FOR_EACH(__CUDL_SOA_ADD_COLUMN_SIZE, capacity, __VA_ARGS__);                \
+        unsigned char *block = (unsigned char *) soa->allocator.allocate(soa->allocator.context, block_size,           \
+                                                                         CUDL_ARRAY_ALIGNMENT);                        \
+        if (!block) { return false; }                                                                                  \
+        __CUDL_L1STR(__CUDL_AP(_record), _soa_t) grown = *soa;                                                         \
+        grown.capacity = capacity;                                                                                     \
+        grown.block = block;                                                                                           \
+        grown.block_size = block_size;                                                                                 \
+        __CUDL_FOR_EACH(__CUDL_SOA_MOVE_COLUMN, capacity, __VA_ARGS__)                                                 \
+        if (soa->block) { soa->allocator.release(soa->allocator.context, soa->block, soa->block_size); }               \
+        *soa = grown;                                                                                                  \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static inline bool __CUDL_FN(_record, _soa, _grow)(__CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa, size_t n) {     \
+        if (n <= soa->capacity - soa->size) { return true; }                                                           \
+        if (n > ((size_t) -1) / 2 - soa->size) { return false; }                                                       \
+        const size_t doubled = soa->capacity * 2 > CUDL_ARRAY_ALIGNMENT ? soa->capacity * 2 : CUDL_ARRAY_ALIGNMENT;    \
+        return __CUDL_FN(_record, _soa, _reserve)(soa, soa->size + n > doubled ? soa->size + n : doubled);             \
+    }                                                                                                                  \
+    static inline bool __CUDL_FN(_record, _soa, _append)(__CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa,               \
+                                                         __CUDL_UT(_record) row) {                                     \
+        if (!__CUDL_FN(_record, _soa, _grow)(soa, 1)) { return false; }                                                \
+        __CUDL_FOR_EACH(__CUDL_SOA_SET_FROM_ROW, , __VA_ARGS__)                                                        \
+        ++soa->size;                                                                                                   \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static inline bool __CUDL_FN(_record, _soa, _append_n)(__CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa,             \
+                                                           const __CUDL_UT(_record) * rows, size_t n) {                \
+        if (!__CUDL_FN(_record, _soa, _grow)(soa, n)) { return false; }                                                \
+        __CUDL_FOR_EACH(__CUDL_SOA_SET_FROM_ROWS, , __VA_ARGS__)                                                       \
+        soa->size += n;                                                                                                \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static inline bool __CUDL_FN(_record, _soa, _append_view)(__CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa,          \
+                                                              __CUDL_L1STR(__CUDL_AP(_record), _view_t) view) {        \
+        if (!__CUDL_FN(_record, _soa, _grow)(soa, view.size)) { return false; }                                        \
+        if (view.size > 0) { __CUDL_FOR_EACH(__CUDL_SOA_SET_FROM_VIEW, , __VA_ARGS__) }                                \
+        soa->size += view.size;                                                                                        \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    static inline __CUDL_UT(_record)                                                                                   \
+            __CUDL_FN(_record, _soa, _get)(const __CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa, size_t index) {       \
+        __CUDL_UT(_record) row;                                                                                        \
+        __CUDL_FOR_EACH(__CUDL_SOA_GET_ROW, , __VA_ARGS__)                                                             \
+        return row;                                                                                                    \
+    }                                                                                                                  \
+    static inline __CUDL_L1STR(__CUDL_AP(_record), _view_t) __CUDL_FN(_record, _soa, _slice)(                          \
+            const __CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa, size_t begin, size_t count) {                        \
+        __CUDL_L1STR(__CUDL_AP(_record), _view_t) view;                                                                \
+        view.size = count;                                                                                             \
+        __CUDL_FOR_EACH(__CUDL_SOA_SLICE, , __VA_ARGS__)                                                               \
+        return view;                                                                                                   \
+    }                                                                                                                  \
+    static inline __CUDL_L1STR(__CUDL_AP(_record), _view_t)                                                            \
+            __CUDL_FN(_record, _soa, _view)(const __CUDL_L1STR(__CUDL_AP(_record), _soa_t) * soa) {                    \
+        return __CUDL_FN(_record, _soa, _slice)(soa, 0, soa->size);                                                    \
+    }                                                                                                                  \
+    __CUDL_FOR_EACH(__CUDL_SOA_COLUMN_ACCESSOR, _record, __VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_SOA_H
@@ -0,0 +1,323 @@
+/**
+ * @file cudl_trace.h
+ * @author Olivier Allaire
+ * @brief Opt-in instrumentation of the operators and conversions generated by cudl.h, to find the hot ones and where
+ * integer conversions overflow or lose precision.
+ *
+ * Tracing is enabled by defining CUDL_ENABLE_TRACE before including cudl.h, which then includes this header. Without
+ * it, the hooks of the generated functions expand to nothing and the functions compile to the same code as before (the
+ * cudl-codegen-check test verifies it). With it, the following functions record events under the name of their unit
+ * and op (without the CUDL_PREFIX and the leading underscore, e.g. "mv" and "add", or "mv" and "from_mv_to_v"):
+ * - the ops added by CUDL_ADD_NO_TRANSFORM_OP, CUDL_ADD_NO_UNIT_OP, CUDL_ADD_RELATIONAL_OP, CUDL_ADD_BITWISE_NOT_OP,
+ *   the saturating and checked ops, the product, quotient and fused ops (under the unit of their lhs), the fixed-point
+ *   qmul and qdiv, and the fraction, reduced and affine conversions count a #CUDL_TRACE_CALL per call;
+ * - their array versions count a #CUDL_TRACE_CALL per element under the op name with a _n suffix, e.g. "add_n". The
+ *   array versions built on the scalar function (reduced and affine conversions) also count each element under the
+ *   scalar op;
+ * - the reductions count a #CUDL_TRACE_CALL per element under their name, e.g. "sum_n". A mean also counts its
+ *   elements under "sum_n";
+ * - the conversions to an integer unit count a #CUDL_TRACE_OVERFLOW when the result is off by one or more from the
+ *   exact value (computed in long double), and a #CUDL_TRACE_TRUNCATION when it is off by less than one, e.g. when
+ *   1999 mV are converted to 1 V. The array version of the fraction conversions only counts calls;
+ * - the checked ops count a #CUDL_TRACE_OVERFLOW when their builtin reports one.
+ *
+ * Each thread counts in its own block of counters, without atomic read-modify-write or locks, and the blocks are only
+ * summed by #cudl_trace_snapshot and #cudl_trace_dump. A callback can also be set with #cudl_trace_set_hook, e.g. to
+ * break or log on the first overflow. In C++, the traced functions stay constexpr with compilers providing
+ * __builtin_is_constant_evaluated (GCC 9, Clang 9 or later), and nothing is recorded during constant evaluation.
+ *
+ * The counters are defined in the single source file that defines CUDL_TRACE_IMPLEMENTATION before including cudl.h,
+ * with CUDL_ENABLE_TRACE. That file is linked to all the traced ones.
+ * @include trace_example.c
+ */
+
+#ifndef CUDL_TRACE_H
+#define CUDL_TRACE_H
+
+#include "cudl_atomic.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CUDL_TRACE_MAX_SITES
+/**
+ * @brief Number of distinct unit and op names that can be counted. Events of the names seen after this limit is reached
+ * are only counted by #cudl_trace_dropped. It must be a power of two, and can be redefined in the
+ * CUDL_TRACE_IMPLEMENTATION source file.
+ */
+#define CUDL_TRACE_MAX_SITES 256
+#endif
+
+/**
+ * @brief Events recorded by the traced functions.
+ */
+typedef enum {
+    CUDL_TRACE_CALL,      ///< A call of the function, or an element processed by an array function.
+    CUDL_TRACE_OVERFLOW,  ///< The result does not fit in the storage of the result unit.
+    CUDL_TRACE_TRUNCATION,///< The result of a conversion to an integer unit is not exact.
+    CUDL_TRACE_EVENT_COUNT///< Number of events, not an event.
+} cudl_trace_event_t;
+
+/**
+ * @brief Callback called for each event, with the context given in the same hook. It runs on the thread of the traced
+ * function, and count is the number of events (the number of elements for the array functions).
+ */
+typedef struct {
+    void (*callback)(const char *unit, const char *op, cudl_trace_event_t event, uint64_t count, void *context);
+    void *context;
+} cudl_trace_hook_t;
+
+/**
+ * @brief Counts of a unit and op name, summed over all threads.
+ */
+typedef struct {
+    const char *unit;
+    const char *op;
+    uint64_t counts[CUDL_TRACE_EVENT_COUNT];
+} cudl_trace_count_t;
+
+/**
+ * @brief Records count events for the unit and op names. This is called by the traced functions, the names must be
+ * string literals (or outlive the program).
+ */
+void cudl_trace_record(const char *unit, const char *op, cudl_trace_event_t event, uint64_t count);
+
+/**
+ * @brief Sets the hook called for each event, or removes it when hook is NULL. The hook is not copied and must stay
+ * valid until it is replaced. Threads may still call the previous hook for a short time after it is replaced.
+ */
+void cudl_trace_set_hook(const cudl_trace_hook_t *hook);
+
+/**
+ * @brief Sums the counters of all threads by unit and op name, sorted by unit then op. Counters being updated by other
+ * threads are read without stopping them, so the result is not an atomic snapshot of all the counters.
+ * @param counts The array to fill.
+ * @param capacity The number of elements of counts. Only the first ones are filled when it is too small.
+ * @return The number of distinct unit and op names, which may be larger than capacity.
+ */
+size_t cudl_trace_snapshot(cudl_trace_count_t *counts, size_t capacity);
+
+/**
+ * @brief Returns the number of events that could not be counted because #CUDL_TRACE_MAX_SITES names were already
+ * seen, or because the counters of a thread could not be allocated.
+ */
+uint64_t cudl_trace_dropped(void);
+
+/**
+ * @brief Prints a table of the counts returned by #cudl_trace_snapshot to stream, one line per unit and op.
+ */
+void cudl_trace_dump(FILE *stream);
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Helpers of the hooks below: the flag version records an event when _flag is true and returns it, the
+ * conversion version records a call and classifies the difference between the result and the exact value. For internal
+ * use only.
+ */
+static inline bool __cudl_trace_flag(const char *unit, const char *op, cudl_trace_event_t event,
+                                     bool flag) {// NOLINT(bugprone-reserved-identifier)
+    if (flag) { cudl_trace_record(unit, op, event, 1); }
+    return flag;
+}
+static inline void __cudl_trace_conversion(const char *unit, const char *op,
+                                           long double error) {// NOLINT(bugprone-reserved-identifier)
+    cudl_trace_record(unit, op, CUDL_TRACE_CALL, 1);
+    if (error >= 1 || error <= -1) {
+        cudl_trace_record(unit, op, CUDL_TRACE_OVERFLOW, 1);
+    } else if (error != 0) {
+        cudl_trace_record(unit, op, CUDL_TRACE_TRUNCATION, 1);
+    }
+}
+
+/**
+ * @brief Enabled versions of the instrumentation hooks declared in cudl.h. Nothing is recorded during constant
+ * evaluation, so the constexpr functions can still be evaluated at compile time. For internal use only.
+ */
+#define __CUDL_TRACE_OP_NAME(_op_string)                                                                               \
+    ((_op_string)[0] == '_' ? (_op_string) + 1 : (_op_string))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_TRACE_CALLS(_name, _op_name, _count)                                                                    \
+    if (!__CUDL_CONSTANT_EVALUATED()) {                                                                                \
+        cudl_trace_record(#_name, __CUDL_TRACE_OP_NAME(#_op_name), CUDL_TRACE_CALL, (uint64_t) (_count));              \
+    }// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_TRACE_FLAG(_name, _op_name, _event, _cond)                                                              \
+    __cudl_trace_flag(#_name, __CUDL_TRACE_OP_NAME(#_op_name), _event, (_cond))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_TRACE_CONVERSION(_from, _to, _explicative, _value, _exact)                                              \
+    if (!__CUDL_CONSTANT_EVALUATED()) {                                                                                \
+        __cudl_trace_conversion(#_from, #_explicative #_to,                                                            \
+                                __CUDL_IS_FLOAT(__CUDL_STORAGE(_to)) ? 0.0L : (long double) (_value) - (_exact));      \
+    }// NOLINT(bugprone-reserved-identifier)
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+#if defined(CUDL_TRACE_IMPLEMENTATION) && !defined(DOXYGEN_SHOULD_SKIP_THIS)
+#include <stdlib.h>
+
+__CUDL_STATIC_ASSERT((CUDL_TRACE_MAX_SITES & (CUDL_TRACE_MAX_SITES - 1)) == 0,
+                     "CUDL_TRACE_MAX_SITES must be a power of two");
+
+/**
+ * @brief A unit and op name pair. It is claimed by the first thread recording it: state goes from 0 (free) to 1 (being
+ * written) to 2 (ready). Names are compared by address, the same names at different addresses (e.g. in different
+ * translation units) use different sites that are merged by name in the snapshots. For internal use only.
+ */
+typedef struct {
+    __CUDL_ATOMIC(int) state;
+    const char *unit;
+    const char *op;
+} __cudl_trace_site_t;// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Counters of a thread. Only their thread writes them, other threads read them when summing, so relaxed loads
+ * and stores are enough. The blocks are linked together and never freed, so the counts of the threads that exited are
+ * kept. For internal use only.
+ */
+typedef struct __cudl_trace_thread {
+    struct __cudl_trace_thread *next;
+    __CUDL_ATOMIC(uint64_t) counts[CUDL_TRACE_MAX_SITES][CUDL_TRACE_EVENT_COUNT];
+} __cudl_trace_thread_t;// NOLINT(bugprone-reserved-identifier)
+
+static __cudl_trace_site_t __cudl_trace_sites[CUDL_TRACE_MAX_SITES];     // NOLINT(bugprone-reserved-identifier)
+static __CUDL_ATOMIC(__cudl_trace_thread_t *) __cudl_trace_threads;      // NOLINT(bugprone-reserved-identifier)
+static __CUDL_ATOMIC(const cudl_trace_hook_t *) __cudl_trace_hook;       // NOLINT(bugprone-reserved-identifier)
+static __CUDL_ATOMIC(uint64_t) __cudl_trace_dropped_events;              // NOLINT(bugprone-reserved-identifier)
+static __CUDL_THREAD_LOCAL __cudl_trace_thread_t *__cudl_trace_this_thread;// NOLINT(bugprone-reserved-identifier)
+static __CUDL_THREAD_LOCAL const char *__cudl_trace_last_unit;           // NOLINT(bugprone-reserved-identifier)
+static __CUDL_THREAD_LOCAL const char *__cudl_trace_last_op;             // NOLINT(bugprone-reserved-identifier)
+static __CUDL_THREAD_LOCAL size_t __cudl_trace_last_site;                // NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Returns the index of the site of unit and op, claiming a free one the first time, or CUDL_TRACE_MAX_SITES when
+ * all are taken. For internal use only.
+ */
+static size_t __cudl_trace_find_site(const char *unit, const char *op) {// NOLINT(bugprone-reserved-identifier)
+    size_t hash = (size_t) (((uintptr_t) unit >> 3) * 31u + ((uintptr_t) op >> 3));
+    hash ^= hash >> 11;
+    for (size_t probe = 0; probe < CUDL_TRACE_MAX_SITES; ++probe) {
+        const size_t index = (hash + probe) & (CUDL_TRACE_MAX_SITES - 1);
+        __cudl_trace_site_t *site = &__cudl_trace_sites[index];
+        int state = __CUDL_ATOMIC_LOAD(&site->state, acquire);
+        if (state == 0) {
+            if (__CUDL_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT(&site->state, &state, 1, __CUDL_MEMORY_ORDER(acquire),
+                                                               __CUDL_MEMORY_ORDER(acquire))) {
+                site->unit = unit;
+                site->op = op;
+                __CUDL_ATOMIC_STORE(&site->state, 2, release);
+                return index;
+            }
+        }
+        while (state == 1) { state = __CUDL_ATOMIC_LOAD(&site->state, acquire); }
+        if (site->unit == unit && site->op == op) { return index; }
+    }
+    return CUDL_TRACE_MAX_SITES;
+}
+
+/**
+ * @brief Returns the counters of the calling thread, allocating and publishing them on its first event. For internal
+ * use only.
+ */
+static __cudl_trace_thread_t *__cudl_trace_thread(void) {// NOLINT(bugprone-reserved-identifier)
+    if (__cudl_trace_this_thread == NULL) {
+        __cudl_trace_thread_t *thread = (__cudl_trace_thread_t *) calloc(1, sizeof(__cudl_trace_thread_t));
+        if (thread == NULL) { return NULL; }
+        thread->next = __CUDL_ATOMIC_LOAD(&__cudl_trace_threads, relaxed);
+        while (!__CUDL_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT(&__cudl_trace_threads, &thread->next, thread,
+                                                             __CUDL_MEMORY_ORDER(release),
+                                                             __CUDL_MEMORY_ORDER(relaxed))) {}
+        __cudl_trace_this_thread = thread;
+    }
+    return __cudl_trace_this_thread;
+}
+
+void cudl_trace_record(const char *unit, const char *op, cudl_trace_event_t event, uint64_t count) {
+    __cudl_trace_thread_t *thread = __cudl_trace_thread();
+    if (unit != __cudl_trace_last_unit || op != __cudl_trace_last_op) {
+        __cudl_trace_last_site = __cudl_trace_find_site(unit, op);
+        __cudl_trace_last_unit = unit;
+        __cudl_trace_last_op = op;
+    }
+    if (thread != NULL && __cudl_trace_last_site < CUDL_TRACE_MAX_SITES) {
+        __CUDL_ATOMIC(uint64_t) *counter = &thread->counts[__cudl_trace_last_site][event];
+        __CUDL_ATOMIC_STORE(counter, __CUDL_ATOMIC_LOAD(counter, relaxed) + count, relaxed);
+    } else {
+        __CUDL_ATOMIC_FETCH_ADD_EXPLICIT(&__cudl_trace_dropped_events, count, __CUDL_MEMORY_ORDER(relaxed));
+    }
+    const cudl_trace_hook_t *hook = __CUDL_ATOMIC_LOAD(&__cudl_trace_hook, acquire);
+    if (hook != NULL) { hook->callback(unit, op, event, count, hook->context); }
+}
+
+void cudl_trace_set_hook(const cudl_trace_hook_t *hook) { __CUDL_ATOMIC_STORE(&__cudl_trace_hook, hook, release); }
+
+static int __cudl_trace_compare(const void *lhs, const void *rhs) {// NOLINT(bugprone-reserved-identifier)
+    const cudl_trace_count_t *left = (const cudl_trace_count_t *) lhs;
+    const cudl_trace_count_t *right = (const cudl_trace_count_t *) rhs;
+    const int unit = strcmp(left->unit, right->unit);
+    return unit != 0 ? unit : strcmp(left->op, right->op);
+}
+
+size_t cudl_trace_snapshot(cudl_trace_count_t *counts, size_t capacity) {
+    size_t distinct = 0;
+    size_t filled = 0;
+    for (size_t index = 0; index < CUDL_TRACE_MAX_SITES; ++index) {
+        const __cudl_trace_site_t *site = &__cudl_trace_sites[index];
+        if (__CUDL_ATOMIC_LOAD(&site->state, acquire) != 2) { continue; }
+        bool seen = false;
+        for (size_t other = 0; other < index && !seen; ++other) {
+            const __cudl_trace_site_t *previous = &__cudl_trace_sites[other];
+            seen = __CUDL_ATOMIC_LOAD(&previous->state, acquire) == 2 && strcmp(previous->unit, site->unit) == 0 &&
+                   strcmp(previous->op, site->op) == 0;
+        }
+        cudl_trace_count_t *entry = NULL;
+        if (!seen) {
+            ++distinct;
+            if (filled < capacity) {
+                entry = &counts[filled++];
+                entry->unit = site->unit;
+                entry->op = site->op;
+                for (int event = 0; event < CUDL_TRACE_EVENT_COUNT; ++event) { entry->counts[event] = 0; }
+            }
+        } else {
+            for (size_t i = 0; i < filled && entry == NULL; ++i) {
+                if (strcmp(counts[i].unit, site->unit) == 0 && strcmp(counts[i].op, site->op) == 0) {
+                    entry = &counts[i];
+                }
+            }
+        }
+        if (entry == NULL) { continue; }
+        for (__cudl_trace_thread_t *thread = __CUDL_ATOMIC_LOAD(&__cudl_trace_threads, acquire); thread != NULL;
+             thread = thread->next) {
+            for (int event = 0; event < CUDL_TRACE_EVENT_COUNT; ++event) {
+                entry->counts[event] += __CUDL_ATOMIC_LOAD(&thread->counts[index][event], relaxed);
+            }
+        }
+    }
+    if (filled > 1) { qsort(counts, filled, sizeof(cudl_trace_count_t), __cudl_trace_compare); }
+    return distinct;
+}
+
+uint64_t cudl_trace_dropped(void) { return __CUDL_ATOMIC_LOAD(&__cudl_trace_dropped_events, relaxed); }
+
+void cudl_trace_dump(FILE *stream) {
+    cudl_trace_count_t *counts = (cudl_trace_count_t *) calloc(CUDL_TRACE_MAX_SITES, sizeof(cudl_trace_count_t));
+    if (counts == NULL) { return; }
+    const size_t size = cudl_trace_snapshot(counts, CUDL_TRACE_MAX_SITES);
+    fprintf(stream, "%-16s %-24s %14s %14s %14s\n", "unit", "op", "calls", "overflows", "truncations");
+    for (size_t i = 0; i < size; ++i) {
+        fprintf(stream, "%-16s %-24s %14llu %14llu %14llu\n", counts[i].unit, counts[i].op,
+                (unsigned long long) counts[i].counts[CUDL_TRACE_CALL],
+                (unsigned long long) counts[i].counts[CUDL_TRACE_OVERFLOW],
+                (unsigned long long) counts[i].counts[CUDL_TRACE_TRUNCATION]);
+    }
+    if (cudl_trace_dropped() != 0) {
+        fprintf(stream, "%llu events dropped\n", (unsigned long long) cudl_trace_dropped());
+    }
+    free(counts);
+}
+#endif//CUDL_TRACE_IMPLEMENTATION
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_TRACE_H
@@ -0,0 +1,252 @@
+/**
+ * @file cudl_wire.h
+ * @author Olivier Allaire
+ * @brief Binary wire encoding of unit arrays, at the width of their storage type and in a given byte order.
+ */
+
+#ifndef CUDL_WIRE_H
+#define CUDL_WIRE_H
+
+#include "cudl.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Byte order of encoded values.
+ */
+typedef enum {
+    CUDL_LITTLE_ENDIAN = 0,
+    CUDL_BIG_ENDIAN = 1,
+} cudl_byte_order_t;
+
+#ifndef CUDL_HOST_BYTE_ORDER
+/**
+ * @brief Byte order of the target. It is detected with the __BYTE_ORDER__ macro of GCC and Clang, and defaults to
+ * little endian otherwise. It can be defined before including this header for other big endian targets.
+ */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define CUDL_HOST_BYTE_ORDER CUDL_BIG_ENDIAN
+#else
+#define CUDL_HOST_BYTE_ORDER CUDL_LITTLE_ENDIAN
+#endif
+#endif
+
+/**
+ * @brief Size, in bytes, of the header written by cudl_<name>_encode_header. It holds, in this order:
+ * - the unit name, on 16 bytes padded with 0 (longer names are truncated);
+ * - the kind of storage type, see #cudl_wire_kind_t, on 1 byte;
+ * - the width of the storage type, in bytes, on 1 byte;
+ * - the byte order of the values and of the count, see #cudl_byte_order_t, on 1 byte;
+ * - the scale, as the number of fractional bits of fixed-point units (0 otherwise), on 1 byte;
+ * - the number of values following the header, on 4 bytes.
+ */
+#define CUDL_WIRE_HEADER_SIZE 24
+
+/**
+ * @brief Kind of storage type recorded in the wire header.
+ */
+typedef enum {
+    CUDL_WIRE_UNSIGNED = 'u',
+    CUDL_WIRE_SIGNED = 'i',
+    CUDL_WIRE_FLOAT = 'f',
+} cudl_wire_kind_t;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief Number of bytes of the unit name in the wire header. For internal use only.
+ */
+#define __CUDL_WIRE_NAME_SIZE 16// NOLINT(bugprone-reserved-identifier)
+
+/**
+ * @brief Byte swap of 16, 32 and 64 bits integers. GCC and Clang recognize the loops below and vectorize them with
+ * byte shuffles (pshufb on x86, rev on ARM). For internal use only.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define __CUDL_BSWAP16(_x) __builtin_bswap16(_x)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_BSWAP32(_x) __builtin_bswap32(_x)// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_BSWAP64(_x) __builtin_bswap64(_x)// NOLINT(bugprone-reserved-identifier)
+#else
+#define __CUDL_BSWAP16(_x) ((uint16_t) (((_x) >> 8) | ((_x) << 8)))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_BSWAP32(_x)                                                                                             \
+    ((((_x) & 0xff000000u) >> 24) | (((_x) & 0x00ff0000u) >> 8) | (((_x) & 0x0000ff00u) << 8) |                        \
+     (((_x) & 0x000000ffu) << 24))// NOLINT(bugprone-reserved-identifier)
+#define __CUDL_BSWAP64(_x)                                                                                             \
+    (((uint64_t) __CUDL_BSWAP32((uint32_t) (_x)) << 32) |                                                              \
+     __CUDL_BSWAP32((uint32_t) ((_x) >> 32)))// NOLINT(bugprone-reserved-identifier)
+#endif
+
+/**
+ * @brief Copies n values of width bytes from src to dst, reversing the bytes of each value. dst and src may be equal.
+ * For internal use only.
+ */
+#define __CUDL_WIRE_SWAP_LOOP(_bits)                                                                                   \
+    for (size_t i = 0; i < n; ++i) {                                                                                   \
+        uint##_bits##_t value;                                                                                         \
+        memcpy(&value, src + i * sizeof(value), sizeof(value));                                                        \
+        value = __CUDL_BSWAP##_bits(value);                                                                            \
+        memcpy(dst + i * sizeof(value), &value, sizeof(value));                                                        \
+    }// NOLINT(bugprone-reserved-identifier)
+static inline void __cudl_wire_swap_n(uint8_t *dst, const uint8_t *src, size_t n,// NOLINT(bugprone-reserved-identifier)
+                                      size_t width) {
+    switch (width) {
+        case 2: __CUDL_WIRE_SWAP_LOOP(16) break;
+        case 4: __CUDL_WIRE_SWAP_LOOP(32) break;
+        case 8: __CUDL_WIRE_SWAP_LOOP(64) break;
+        default:
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t low = 0, high = width - 1; low <= high && high < width; ++low, --high) {
+                    const uint8_t byte = src[i * width + low];
+                    dst[i * width + low] = src[i * width + high];
+                    dst[i * width + high] = byte;
+                }
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Copies n values of width bytes from src to dst, swapping their bytes if order is not the byte order of the
+ * target. For internal use only.
+ */
+static inline void __cudl_wire_copy_n(uint8_t *dst, const uint8_t *src, size_t n,// NOLINT(bugprone-reserved-identifier)
+                                      size_t width, cudl_byte_order_t order) {
+    if (order == CUDL_HOST_BYTE_ORDER || width == 1) {
+        if (dst != src) { memcpy(dst, src, n * width); }
+    } else {
+        __cudl_wire_swap_n(dst, src, n, width);
+    }
+}
+
+/**
+ * @brief Writes and checks the wire header described by #CUDL_WIRE_HEADER_SIZE. For internal use only.
+ */
+static inline size_t __cudl_wire_encode_header(// NOLINT(bugprone-reserved-identifier)
+        uint8_t *dst, const char *name, cudl_wire_kind_t kind, size_t width, unsigned frac_bits, uint32_t count,
+        cudl_byte_order_t order) {
+    size_t i = 0;
+    for (; i < __CUDL_WIRE_NAME_SIZE && name[i] != '\0'; ++i) { dst[i] = (uint8_t) name[i]; }
+    for (; i < __CUDL_WIRE_NAME_SIZE; ++i) { dst[i] = 0; }
+    dst[16] = (uint8_t) kind;
+    dst[17] = (uint8_t) width;
+    dst[18] = (uint8_t) order;
+    dst[19] = (uint8_t) frac_bits;
+    for (i = 0; i < 4; ++i) {
+        dst[order == CUDL_BIG_ENDIAN ? 23 - i : 20 + i] = (uint8_t) (count >> (8 * i));
+    }
+    return CUDL_WIRE_HEADER_SIZE;
+}
+static inline bool __cudl_wire_decode_header(// NOLINT(bugprone-reserved-identifier)
+        const uint8_t *src, const char *name, cudl_wire_kind_t kind, size_t width, unsigned frac_bits, uint32_t *count,
+        cudl_byte_order_t *order) {
+    size_t i = 0;
+    for (; i < __CUDL_WIRE_NAME_SIZE && name[i] != '\0'; ++i) {
+        if (src[i] != (uint8_t) name[i]) { return false; }
+    }
+    for (; i < __CUDL_WIRE_NAME_SIZE; ++i) {
+        if (src[i] != 0) { return false; }
+    }
+    if (src[16] != (uint8_t) kind || src[17] != width || src[18] > CUDL_BIG_ENDIAN || src[19] != frac_bits) {
+        return false;
+    }
+    *order = (cudl_byte_order_t) src[18];
+    *count = 0;
+    for (i = 0; i < 4; ++i) { *count |= (uint32_t) src[*order == CUDL_BIG_ENDIAN ? 23 - i : 20 + i] << (8 * i); }
+    return true;
+}
+
+/**
+ * @brief Kind of the storage type _type, see #cudl_wire_kind_t. For internal use only.
+ */
+#define __CUDL_WIRE_KIND(_type)                                                                                        \
+    ((_type) 0.5 != 0               ? CUDL_WIRE_FLOAT                                                                  \
+     : __CUDL_TYPE_IS_SIGNED(_type) ? CUDL_WIRE_SIGNED                                                                 \
+                                    : CUDL_WIRE_UNSIGNED)// NOLINT(bugprone-reserved-identifier)
+#endif//DOXYGEN_SHOULD_SKIP_THIS
+
+/**
+ * @brief Adds functions to encode arrays of the _name unit to bytes, and to decode them back, with the width of the
+ * storage type and an explicit byte order:
+ * - size_t cudl_<name>_encode_n(dst, src, n, order) writes the n values of src to the dst bytes and returns the number
+ *   of bytes written, n * sizeof(_type);
+ * - cudl_<name>_decode_n(dst, src, n, order) reads n values from the src bytes to dst;
+ * - const cudl_<name>_t *cudl_<name>_decode_view(src, order) returns src itself, without any copy, when order is the
+ *   byte order of the target and src is aligned for the unit type. It returns NULL otherwise, and
+ *   cudl_<name>_decode_n must be used instead;
+ * - cudl_<name>_t *cudl_<name>_decode_in_place_n(buffer, n, order) swaps the bytes of the values in buffer if needed,
+ *   then returns it like cudl_<name>_decode_view;
+ * - size_t cudl_<name>_encode_header(dst, count, order) writes the optional header of #CUDL_WIRE_HEADER_SIZE bytes,
+ *   recording the unit name, the storage type and the scale. bool cudl_<name>_decode_header(src, len, &count,
+ *   &order) returns false if the len bytes of src are shorter than the header or if it was written for another unit,
+ *   and gives the count and byte order otherwise.
+ *
+ * Byte swaps are only done when order is not the byte order of the target. The views read the bytes through the unit
+ * type, so the buffer should not be a variable declared with another type (memory from malloc or from an array of the
+ * unit type is fine).
+ * @include add_wire_encoding_example.c
+ * @param _name The unit to add the functions for. It is expected to be the same as the _name param used with
+ * CUDL_ADD_UNIT*. It is also the unit name recorded in the header.
+ * @param _type The underlying storage type. It is expected to be the same as the _type param used with CUDL_ADD_UNIT*.
+ * @param _frac_bits The scale recorded in the header, as a number of fractional bits.
+ */
+#define CUDL_ADD_EXPLICIT_WIRE_ENCODING(_name, _type, _frac_bits)                                                      \
+    static inline size_t __CUDL_FN(_name, _encode, _n)(uint8_t * dst, const __CUDL_UT(_name) * src, size_t n,          \
+                                                       cudl_byte_order_t order) {                                      \
+        __cudl_wire_copy_n(dst, (const uint8_t *) src, n, sizeof(_type), order);                                       \
+        return n * sizeof(_type);                                                                                      \
+    }                                                                                                                  \
+    static inline void __CUDL_FN(_name, _decode, _n)(__CUDL_UT(_name) * dst, const uint8_t *src, size_t n,             \
+                                                     cudl_byte_order_t order) {                                        \
+        __cudl_wire_copy_n((uint8_t *) dst, src, n, sizeof(_type), order);                                             \
+    }                                                                                                                  \
+    static inline const __CUDL_UT(_name) * __CUDL_FN(_name, _decode, _view)(const uint8_t *src,                        \
+                                                                            cudl_byte_order_t order) {                 \
+        if ((order != CUDL_HOST_BYTE_ORDER && sizeof(_type) != 1) ||                                                   \
+            (uintptr_t) src % __CUDL_ALIGNOF(__CUDL_UT(_name)) != 0) {                                                 \
+            return NULL;                                                                                               \
+        }                                                                                                              \
+        return (const __CUDL_UT(_name) *) (const void *) src;                                                          \
+    }                                                                                                                  \
+    static inline __CUDL_UT(_name) * __CUDL_FN(_name, _decode_in_place, _n)(uint8_t * buffer, size_t n,                \
+                                                                            cudl_byte_order_t order) {                 \
+        if ((uintptr_t) buffer % __CUDL_ALIGNOF(__CUDL_UT(_name)) != 0) { return NULL; }                               \
+        __cudl_wire_copy_n(buffer, buffer, n, sizeof(_type), order);                                                   \
+        return (__CUDL_UT(_name) *) (void *) buffer;                                                                   \
+    }                                                                                                                  \
+    static inline size_t __CUDL_FN(_name, _encode, _header)(uint8_t * dst, uint32_t count, cudl_byte_order_t order) {  \
+        return __cudl_wire_encode_header(dst, #_name, __CUDL_WIRE_KIND(_type), sizeof(_type), (_frac_bits), count,     \
+                                         order);                                                                       \
+    }                                                                                                                  \
+    static inline bool __CUDL_FN(_name, _decode, _header)(const uint8_t *src, size_t len, uint32_t *count,             \
+                                                          cudl_byte_order_t *order) {                                  \
+        if (len < CUDL_WIRE_HEADER_SIZE) { return false; }                                                             \
+        return __cudl_wire_decode_header(src, #_name, __CUDL_WIRE_KIND(_type), sizeof(_type), (_frac_bits), count,     \
+                                         order);                                                                       \
+    }
+
+/**
+ * @brief Simplified version of #CUDL_ADD_EXPLICIT_WIRE_ENCODING for units without fractional bits.
+ * @include add_wire_encoding_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_WIRE_ENCODING documentation.
+ * @param _type See #CUDL_ADD_EXPLICIT_WIRE_ENCODING documentation.
+ */
+#define CUDL_ADD_WIRE_ENCODING(_name, _type) CUDL_ADD_EXPLICIT_WIRE_ENCODING(_name, _type, 0)
+
+/**
+ * @brief Version of #CUDL_ADD_EXPLICIT_WIRE_ENCODING for fixed-point units added with #CUDL_ADD_FIXED_POINT_UNIT,
+ * recording their number of fractional bits in the header.
+ * @include add_wire_encoding_example.c
+ * @param _name See #CUDL_ADD_EXPLICIT_WIRE_ENCODING documentation.
+ * @param _storage The storage type. It is expected to be the same as the _storage param used with
+ * CUDL_ADD_FIXED_POINT_UNIT.
+ */
+#define CUDL_ADD_FIXED_POINT_WIRE_ENCODING(_name, _storage)                                                            \
+    CUDL_ADD_EXPLICIT_WIRE_ENCODING(_name, _storage, __CUDL_FRAC_BITS(_name))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CUDL_WIRE_H
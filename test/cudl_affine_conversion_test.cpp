@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#define CUDL_PREFIX aftest_
+#include <cudl.h>
+
+CUDL_ADD_UNIT(celsius, float)
+CUDL_ADD_UNIT(fahrenheit, float)
+CUDL_ADD_AFFINE_CONVERSION(celsius, fahrenheit, 9, 5, 32)
+CUDL_ADD_AFFINE_CONVERSION(fahrenheit, celsius, 5, 9, -160.0f / 9)
+
+CUDL_ADD_UNIT(kelvin, double)
+CUDL_ADD_AFFINE_CONVERSION(celsius, kelvin, 1, 1, 273.15)
+
+CUDL_ADD_UNIT(deci_celsius, int16_t)
+CUDL_ADD_UNIT(deci_fahrenheit, int16_t)
+CUDL_ADD_AFFINE_CONVERSION(deci_celsius, deci_fahrenheit, 9, 5, 320)
+
+CUDL_ADD_UNIT(adc, uint16_t)
+CUDL_ADD_UNIT(v, float)
+CUDL_ADD_UNIT(mv, int32_t)
+CUDL_ADD_AFFINE_CONVERSION(adc, v, 3.3, 4096, -1.65)
+CUDL_ADD_AFFINE_CONVERSION(adc, mv, 3300, 4096, -1650)
+CUDL_ADD_AFFINE_CONVERSION(v, mv, 1000, 1, 0)
+
+CUDL_ADD_UNIT(half, int32_t)
+CUDL_ADD_EXPLICIT_AFFINE_CONVERSION(mv, half, negated_, -1, 2, 10)
+
+CUDL_ADD_UNIT(ticks, int64_t)
+CUDL_ADD_UNIT(ns, int64_t)
+CUDL_ADD_AFFINE_CONVERSION(ticks, ns, 125, 3, -1000)
+
+TEST(test_cudl_affine_conversion, whenConvertingFloats_resultIsScaledThenOffset)
+{
+    ASSERT_FLOAT_EQ(CUDL_GET(aftest_from_celsius_to_fahrenheit(aftest_celsius(100.0f))), 212.0f);
+    ASSERT_FLOAT_EQ(CUDL_GET(aftest_from_celsius_to_fahrenheit(aftest_celsius(-40.0f))), -40.0f);
+    ASSERT_FLOAT_EQ(CUDL_GET(aftest_from_fahrenheit_to_celsius(aftest_fahrenheit(212.0f))), 100.0f);
+    ASSERT_NEAR(CUDL_GET(aftest_from_fahrenheit_to_celsius(aftest_fahrenheit(0.0f))), -17.7777777f, 1e-5f);
+    ASSERT_DOUBLE_EQ(CUDL_GET(aftest_from_celsius_to_kelvin(aftest_celsius(-273.15f))), -273.15f + 273.15);
+    ASSERT_NEAR(CUDL_GET(aftest_from_adc_to_v(aftest_adc(4096))), 1.65f, 1e-6f);
+    ASSERT_NEAR(CUDL_GET(aftest_from_adc_to_v(aftest_adc(0))), -1.65f, 1e-6f);
+}
+
+TEST(test_cudl_affine_conversion, whenConvertingIntegers_resultIsRoundedOnceToNearest)
+{
+    ASSERT_EQ(CUDL_GET(aftest_from_deci_celsius_to_deci_fahrenheit(aftest_deci_celsius(-1))), 318);
+    ASSERT_EQ(CUDL_GET(aftest_from_deci_celsius_to_deci_fahrenheit(aftest_deci_celsius(5))), 329);
+    ASSERT_EQ(CUDL_GET(aftest_from_deci_celsius_to_deci_fahrenheit(aftest_deci_celsius(-400))), -400);
+    ASSERT_EQ(CUDL_GET(aftest_from_deci_celsius_to_deci_fahrenheit(aftest_deci_celsius(-178))), 0);
+    ASSERT_EQ(CUDL_GET(aftest_from_adc_to_mv(aftest_adc(2048))), 0);
+    ASSERT_EQ(CUDL_GET(aftest_from_adc_to_mv(aftest_adc(4095))), 1649);
+    ASSERT_EQ(CUDL_GET(aftest_from_adc_to_mv(aftest_adc(1))), -1649);
+}
+
+TEST(test_cudl_affine_conversion, whenTheScaleIsNegative_tiesAreRoundedUp)
+{
+    ASSERT_EQ(CUDL_GET(aftest_negated_half(aftest_mv(21))), 0);
+    ASSERT_EQ(CUDL_GET(aftest_negated_half(aftest_mv(23))), -1);
+    ASSERT_EQ(CUDL_GET(aftest_negated_half(aftest_mv(-3))), 12);
+    ASSERT_EQ(CUDL_GET(aftest_negated_half(aftest_mv(0))), 10);
+}
+
+TEST(test_cudl_affine_conversion, whenConvertingAFloatToAnInteger_resultIsRoundedToNearest)
+{
+    ASSERT_EQ(CUDL_GET(aftest_from_v_to_mv(aftest_v(1.2345f))), 1235);
+    ASSERT_EQ(CUDL_GET(aftest_from_v_to_mv(aftest_v(-1.2345f))), -1235);
+}
+
+TEST(test_cudl_affine_conversion, whenConverting64BitsValues_intermediateProductDoesNotOverflow)
+{
+    ASSERT_EQ(CUDL_GET(aftest_from_ticks_to_ns(aftest_ticks(INT64_C(3) << 56))), (INT64_C(125) << 56) - 1000);
+    ASSERT_EQ(CUDL_GET(aftest_from_ticks_to_ns(aftest_ticks(1))), -958);
+}
+
+TEST(test_cudl_affine_conversion, whenConvertingAnArray_resultsAreTheScalarConversions)
+{
+    std::vector<aftest_deci_celsius_t> temperatures;
+    for (int i = -1000; i < 1000; i += 3) { temperatures.push_back(aftest_deci_celsius((int16_t) i)); }
+    std::vector<aftest_deci_fahrenheit_t> converted(temperatures.size());
+    aftest_from_deci_celsius_to_deci_fahrenheit_n(converted.data(), temperatures.data(), temperatures.size());
+    for (size_t i = 0; i < temperatures.size(); ++i) {
+        ASSERT_EQ(CUDL_GET(converted[i]), CUDL_GET(aftest_from_deci_celsius_to_deci_fahrenheit(temperatures[i])));
+    }
+
+    std::vector<aftest_celsius_t> celsius;
+    for (int i = -100; i < 100; ++i) { celsius.push_back(aftest_celsius((float) i * 0.7f)); }
+    std::vector<aftest_fahrenheit_t> fahrenheit(celsius.size());
+    aftest_from_celsius_to_fahrenheit_n(fahrenheit.data(), celsius.data(), celsius.size());
+    for (size_t i = 0; i < celsius.size(); ++i) {
+        ASSERT_EQ(CUDL_GET(fahrenheit[i]), CUDL_GET(aftest_from_celsius_to_fahrenheit(celsius[i])));
+    }
+}
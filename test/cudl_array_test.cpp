@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include <cudl.h>
+#include <cmath>
+#include <cstdint>
+
+CUDL_ADD_UNIT(v, uint32_t)
+CUDL_ADD_INTEGER_OPERATORS(v, uint32_t)
+CUDL_ADD_INTEGER_ARRAY_OPERATORS(v, uint32_t)
+
+CUDL_ADD_UNIT(mv, uint32_t)
+
+CUDL_ADD_CONVERSION_FACTOR(v, mv, 1000)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(mv, v, 1, 1000)
+
+CUDL_ADD_UNIT(rad, double)
+CUDL_ADD_COMMON_OPERATORS(rad, double)
+CUDL_ADD_COMMON_ARRAY_OPERATORS(rad, double)
+
+CUDL_ADD_UNIT(deg, double)
+
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(rad, deg, 180.0, M_PI)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(deg, rad, M_PI, 180.0)
+
+CUDL_ADD_UNIT(ma, int16_t)
+CUDL_ADD_UNIT(ua, int16_t)
+
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(ua, ma, 3, 7)
+
+// Odd size so the vectorized loops also run their scalar epilogue.
+#define CUDL_ARRAY_TEST_SIZE 103
+
+class cudl_array_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+            lhs[i] = cudl_v(static_cast<uint32_t>(i * 7 + 3));
+            rhs[i] = cudl_v(static_cast<uint32_t>((i * 13) % 50 + 1));
+            rad_lhs[i] = cudl_rad(static_cast<double>(i) * M_PI / 8);
+            rad_rhs[i] = cudl_rad(static_cast<double>(i % 5) * M_PI / 4);
+        }
+    }
+
+    alignas(CUDL_ARRAY_ALIGNMENT) cudl_v_t lhs[CUDL_ARRAY_TEST_SIZE];
+    alignas(CUDL_ARRAY_ALIGNMENT) cudl_v_t rhs[CUDL_ARRAY_TEST_SIZE];
+    alignas(CUDL_ARRAY_ALIGNMENT) cudl_v_t result[CUDL_ARRAY_TEST_SIZE];
+    alignas(CUDL_ARRAY_ALIGNMENT) bool bool_result[CUDL_ARRAY_TEST_SIZE];
+    cudl_rad_t rad_lhs[CUDL_ARRAY_TEST_SIZE];
+    cudl_rad_t rad_rhs[CUDL_ARRAY_TEST_SIZE];
+    cudl_rad_t rad_result[CUDL_ARRAY_TEST_SIZE];
+};
+
+TEST_F(cudl_array_test, add)
+{
+    cudl_v_add_n(result, lhs, rhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_v_add(lhs[i], rhs[i])));
+    }
+}
+
+TEST_F(cudl_array_test, addAligned)
+{
+    cudl_v_add_n_aligned(result, lhs, rhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_v_add(lhs[i], rhs[i])));
+    }
+}
+
+TEST_F(cudl_array_test, sub)
+{
+    cudl_v_sub_n(result, lhs, rhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_v_sub(lhs[i], rhs[i])));
+    }
+}
+
+TEST_F(cudl_array_test, multiply)
+{
+    cudl_v_mul_n(result, lhs, 10, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_v_mul(lhs[i], 10)));
+    }
+}
+
+TEST_F(cudl_array_test, divide)
+{
+    cudl_v_div_n(result, lhs, 3, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_v_div(lhs[i], 3)));
+    }
+}
+
+TEST_F(cudl_array_test, integerOps)
+{
+    cudl_v_mod_n(result, lhs, 10, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_v_mod(lhs[i], 10)));
+    }
+    cudl_v_xor_n(result, lhs, 0xF, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_v_xor(lhs[i], 0xF)));
+    }
+    cudl_v_bsl_n_aligned(result, lhs, 3, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_v_bsl(lhs[i], 3)));
+    }
+    cudl_v_bnot_n(result, lhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_v_bnot(lhs[i])));
+    }
+}
+
+TEST_F(cudl_array_test, relational)
+{
+    cudl_v_gt_n(bool_result, lhs, rhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(bool_result[i], cudl_v_gt(lhs[i], rhs[i]));
+    }
+    cudl_v_eq_n_aligned(bool_result, lhs, rhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(bool_result[i], cudl_v_eq(lhs[i], rhs[i]));
+    }
+    cudl_v_le_n(bool_result, lhs, rhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(bool_result[i], cudl_v_le(lhs[i], rhs[i]));
+    }
+}
+
+TEST_F(cudl_array_test, floatOps)
+{
+    cudl_rad_add_n(rad_result, rad_lhs, rad_rhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(rad_result[i]), CUDL_GET(cudl_rad_add(rad_lhs[i], rad_rhs[i])));
+    }
+    cudl_rad_div_n(rad_result, rad_lhs, 2.0, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(rad_result[i]), CUDL_GET(cudl_rad_div(rad_lhs[i], 2.0)));
+    }
+    cudl_rad_lt_n(bool_result, rad_lhs, rad_rhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(bool_result[i], cudl_rad_lt(rad_lhs[i], rad_rhs[i]));
+    }
+}
+
+TEST_F(cudl_array_test, emptyArray)
+{
+    result[0] = cudl_v(42);
+    cudl_v_add_n(result, lhs, rhs, 0);
+    ASSERT_EQ(CUDL_GET(result[0]), 42);
+}
+
+TEST_F(cudl_array_test, integerConversionMatchesScalar)
+{
+    alignas(CUDL_ARRAY_ALIGNMENT) cudl_mv_t mvolts[CUDL_ARRAY_TEST_SIZE];
+    cudl_v_t volts[CUDL_ARRAY_TEST_SIZE];
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        mvolts[i] = cudl_mv(static_cast<uint32_t>(UINT32_MAX - i * 40000037u));
+    }
+
+    cudl_from_mv_to_v_n(volts, mvolts, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(volts[i]), CUDL_GET(cudl_from_mv_to_v(mvolts[i])));
+    }
+
+    cudl_from_v_to_mv_n_aligned(mvolts, lhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(mvolts[i]), CUDL_GET(cudl_from_v_to_mv(lhs[i])));
+    }
+}
+
+TEST_F(cudl_array_test, signedConversionMatchesScalar)
+{
+    cudl_ua_t uamps[CUDL_ARRAY_TEST_SIZE];
+    cudl_ma_t mamps[CUDL_ARRAY_TEST_SIZE];
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        uamps[i] = cudl_ua(static_cast<int16_t>(static_cast<int>(i) * 211 - 10000));
+    }
+
+    cudl_from_ua_to_ma_n(mamps, uamps, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_EQ(CUDL_GET(mamps[i]), CUDL_GET(cudl_from_ua_to_ma(uamps[i])));
+    }
+}
+
+TEST_F(cudl_array_test, floatConversionMatchesScalar)
+{
+    cudl_deg_t degs[CUDL_ARRAY_TEST_SIZE];
+    cudl_from_rad_to_deg_n(degs, rad_lhs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_DOUBLE_EQ(CUDL_GET(degs[i]), CUDL_GET(cudl_from_rad_to_deg(rad_lhs[i])));
+    }
+
+    cudl_from_deg_to_rad_n(rad_result, degs, CUDL_ARRAY_TEST_SIZE);
+    for (size_t i = 0; i < CUDL_ARRAY_TEST_SIZE; ++i) {
+        ASSERT_DOUBLE_EQ(CUDL_GET(rad_result[i]), CUDL_GET(rad_lhs[i]));
+    }
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#define CUDL_PREFIX attest_
+#include <cudl_atomic.h>
+
+CUDL_ADD_UNIT(b, uint64_t)
+CUDL_ADD_ATOMIC_UNIT(b, uint64_t)
+CUDL_ADD_SHARDED_COUNTER(b, 8)
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_ATOMIC_UNIT(mv, int16_t)
+
+CUDL_ADD_UNIT(j, double)
+CUDL_ADD_ATOMIC_FLOAT_UNIT(j, double)
+
+static_assert(sizeof(attest_b_padded_atomic_t) == CUDL_CACHE_LINE_SIZE, "A padded atomic must fill its cache line");
+static_assert(sizeof(attest_b_sharded_counter_t) == 8 * CUDL_CACHE_LINE_SIZE, "One cache line per shard");
+
+TEST(test_cudl_atomic, whenUsingAtomicUnit_valuesAreLoadedStoredAndExchanged)
+{
+    attest_mv_atomic_t atomic;
+    attest_mv_atomic_init(&atomic, attest_mv(-5));
+    ASSERT_EQ(CUDL_GET(attest_mv_atomic_load(&atomic)), -5);
+    attest_mv_atomic_store(&atomic, attest_mv(12));
+    ASSERT_EQ(CUDL_GET(attest_mv_atomic_load_explicit(&atomic, std::memory_order_acquire)), 12);
+    ASSERT_EQ(CUDL_GET(attest_mv_atomic_exchange(&atomic, attest_mv(7))), 12);
+    attest_mv_atomic_store_explicit(&atomic, attest_mv(8), std::memory_order_release);
+    ASSERT_EQ(CUDL_GET(attest_mv_atomic_exchange_explicit(&atomic, attest_mv(9), std::memory_order_acq_rel)), 8);
+    ASSERT_EQ(CUDL_GET(attest_mv_atomic_fetch_add(&atomic, attest_mv(1))), 9);
+    ASSERT_EQ(CUDL_GET(attest_mv_atomic_fetch_sub_explicit(&atomic, attest_mv(20), std::memory_order_relaxed)), 10);
+    ASSERT_EQ(CUDL_GET(attest_mv_atomic_load(&atomic)), -10);
+}
+
+TEST(test_cudl_atomic, whenComparingAndExchanging_expectedIsUpdatedOnFailure)
+{
+    attest_mv_atomic_t atomic;
+    attest_mv_atomic_init(&atomic, attest_mv(3));
+    attest_mv_t expected = attest_mv(4);
+    ASSERT_FALSE(attest_mv_atomic_compare_exchange(&atomic, &expected, attest_mv(10)));
+    ASSERT_EQ(CUDL_GET(expected), 3);
+    ASSERT_TRUE(attest_mv_atomic_compare_exchange(&atomic, &expected, attest_mv(10)));
+    ASSERT_EQ(CUDL_GET(attest_mv_atomic_load(&atomic)), 10);
+
+    expected = attest_mv(10);
+    while (!attest_mv_atomic_compare_exchange_weak_explicit(&atomic, &expected, attest_mv(11),
+                                                            std::memory_order_acq_rel, std::memory_order_relaxed)) {}
+    ASSERT_EQ(CUDL_GET(attest_mv_atomic_load(&atomic)), 11);
+}
+
+TEST(test_cudl_atomic, whenAddingConcurrently_noIncrementIsLost)
+{
+    constexpr int threads = 4;
+    constexpr int increments = 100000;
+    attest_b_atomic_t bytes;
+    attest_j_atomic_t energy;
+    attest_b_sharded_counter_t counter;
+    attest_b_atomic_init(&bytes, attest_b(0));
+    attest_j_atomic_init(&energy, attest_j(0.0));
+    attest_b_sharded_counter_init(&counter);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < increments; ++i) {
+                attest_b_atomic_fetch_add_explicit(&bytes, attest_b(3), std::memory_order_relaxed);
+                attest_j_atomic_fetch_add(&energy, attest_j(0.5));
+                attest_b_sharded_counter_add(&counter, attest_b(2));
+            }
+            attest_b_sharded_counter_sub(&counter, attest_b(1));
+        });
+    }
+    for (auto &worker : workers) { worker.join(); }
+
+    ASSERT_EQ(CUDL_GET(attest_b_atomic_load(&bytes)), 3ULL * threads * increments);
+    ASSERT_EQ(CUDL_GET(attest_j_atomic_load(&energy)), 0.5 * threads * increments);
+    ASSERT_EQ(CUDL_GET(attest_b_sharded_counter_load(&counter)), 2ULL * threads * increments - threads);
+    ASSERT_EQ(CUDL_GET(attest_j_atomic_fetch_sub(&energy, attest_j(0.5 * threads * increments))),
+              0.5 * threads * increments);
+    ASSERT_EQ(CUDL_GET(attest_j_atomic_load(&energy)), 0.0);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#define CUDL_PREFIX chtest_
+#include <cudl_chars.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_UNIT(v, int16_t)
+CUDL_ADD_UNIT(uv, int32_t)
+CUDL_ADD_CONVERSION_FACTOR(v, mv, 1000)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(uv, mv, 1, 1000)
+CUDL_ADD_EXPLICIT_INTEGER_CHARS(v, int16_t, "V")
+CUDL_ADD_EXPLICIT_INTEGER_CHARS(uv, int32_t, "uV")
+CUDL_ADD_EXPLICIT_INTEGER_CHARS_WITH_CONVERSIONS(mv, int16_t, "mV", v, uv)
+
+CUDL_ADD_UNIT(count, uint64_t)
+CUDL_ADD_INTEGER_CHARS(count, uint64_t)
+
+CUDL_ADD_UNIT(rad, double)
+CUDL_ADD_UNIT(deg, double)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(deg, rad, 3.141592653589793, 180.0)
+CUDL_ADD_FLOAT_CHARS(deg, double)
+CUDL_ADD_EXPLICIT_FLOAT_CHARS_WITH_CONVERSIONS(rad, double, "rad", deg)
+
+CUDL_ADD_UNIT(a, float)
+CUDL_ADD_EXPLICIT_FLOAT_CHARS(a, float, "A")
+
+template<typename T, typename F>
+static std::string to_string(F to_chars, T value)
+{
+    char buffer[64];
+    size_t len = to_chars(buffer, sizeof(buffer), value);
+    return std::string(buffer, len);
+}
+
+TEST(test_cudl_chars, whenFormattingIntegers_valueIsFollowedBySuffix)
+{
+    ASSERT_EQ(to_string(chtest_mv_to_chars, chtest_mv(3300)), "3300mV");
+    ASSERT_EQ(to_string(chtest_mv_to_chars, chtest_mv(-32768)), "-32768mV");
+    ASSERT_EQ(to_string(chtest_mv_to_chars, chtest_mv(0)), "0mV");
+    ASSERT_EQ(to_string(chtest_count_to_chars, chtest_count(18446744073709551615ULL)), "18446744073709551615count");
+
+    char small[6];
+    ASSERT_EQ(chtest_mv_to_chars(small, sizeof(small), chtest_mv(3300)), 6);
+    ASSERT_EQ(chtest_mv_to_chars(small, sizeof(small), chtest_mv(-3300)), 0);
+}
+
+TEST(test_cudl_chars, whenParsingIntegers_suffixAndRangeAreChecked)
+{
+    chtest_mv_t value = chtest_mv(0);
+    ASSERT_EQ(chtest_mv_from_chars("3300mV", 6, &value), 6);
+    ASSERT_EQ(CUDL_GET(value), 3300);
+    ASSERT_EQ(chtest_mv_from_chars("-32768mV, next", 14, &value), 8);
+    ASSERT_EQ(CUDL_GET(value), -32768);
+    ASSERT_EQ(chtest_mv_from_chars("+7mV", 4, &value), 4);
+    ASSERT_EQ(CUDL_GET(value), 7);
+
+    ASSERT_EQ(chtest_mv_from_chars("32768mV", 7, &value), 0);
+    ASSERT_EQ(chtest_mv_from_chars("3300", 4, &value), 0);
+    ASSERT_EQ(chtest_mv_from_chars("3300mVx", 7, &value), 0);
+    ASSERT_EQ(chtest_mv_from_chars("3300mV", 5, &value), 0);
+    ASSERT_EQ(chtest_mv_from_chars("mV", 2, &value), 0);
+    ASSERT_EQ(chtest_count_from_chars("-1count", 7, nullptr), 0);
+}
+
+TEST(test_cudl_chars, whenParsingOtherUnits_valueIsConverted)
+{
+    chtest_mv_t value = chtest_mv(0);
+    ASSERT_EQ(chtest_mv_from_chars("3V", 2, &value), 2);
+    ASSERT_EQ(CUDL_GET(value), 3000);
+    ASSERT_EQ(chtest_mv_from_chars("-2500uV", 7, &value), 7);
+    ASSERT_EQ(CUDL_GET(value), -2);
+    ASSERT_EQ(chtest_mv_from_chars("3kV", 3, &value), 0);
+
+    chtest_rad_t angle = chtest_rad(0);
+    ASSERT_EQ(chtest_rad_from_chars("180deg", 6, &angle), 6);
+    ASSERT_DOUBLE_EQ(CUDL_GET(angle), 3.141592653589793);
+}
+
+TEST(test_cudl_chars, whenFormattingFloats_shortestTextIsWritten)
+{
+    ASSERT_EQ(to_string(chtest_rad_to_chars, chtest_rad(1.57)), "1.57rad");
+    ASSERT_EQ(to_string(chtest_rad_to_chars, chtest_rad(0.1)), "0.1rad");
+    ASSERT_EQ(to_string(chtest_rad_to_chars, chtest_rad(-1e-7)), "-1e-7rad");
+    ASSERT_EQ(to_string(chtest_rad_to_chars, chtest_rad(1e21)), "1e21rad");
+    ASSERT_EQ(to_string(chtest_rad_to_chars, chtest_rad(123456.0)), "123456rad");
+    ASSERT_EQ(to_string(chtest_rad_to_chars, chtest_rad(5e-324)), "5e-324rad");
+    ASSERT_EQ(to_string(chtest_rad_to_chars, chtest_rad(1.7976931348623157e308)), "1.7976931348623157e308rad");
+    ASSERT_EQ(to_string(chtest_rad_to_chars, chtest_rad(INFINITY)), "infrad");
+    ASSERT_EQ(to_string(chtest_a_to_chars, chtest_a(0.1f)), "0.1A");
+    ASSERT_EQ(to_string(chtest_a_to_chars, chtest_a(3.4028235e38f)), "3.4028235e38A");
+}
+
+TEST(test_cudl_chars, whenParsingFloats_resultIsCorrectlyRounded)
+{
+    chtest_rad_t value = chtest_rad(0);
+    ASSERT_EQ(chtest_rad_from_chars("1.57rad", 7, &value), 7);
+    ASSERT_EQ(CUDL_GET(value), 1.57);
+    ASSERT_EQ(chtest_rad_from_chars("-2.5E-3rad", 10, &value), 10);
+    ASSERT_EQ(CUDL_GET(value), -2.5e-3);
+    ASSERT_EQ(chtest_rad_from_chars("2.2250738585072011e-308rad", 26, &value), 26);
+    ASSERT_EQ(CUDL_GET(value), 2.2250738585072011e-308);
+    ASSERT_EQ(chtest_rad_from_chars("0.30000000000000000000000000001rad", 34, &value), 34);
+    ASSERT_EQ(CUDL_GET(value), 0.30000000000000000000000000001);
+    ASSERT_EQ(chtest_rad_from_chars("nanrad", 6, &value), 6);
+    ASSERT_TRUE(std::isnan(CUDL_GET(value)));
+    ASSERT_EQ(chtest_rad_from_chars(".rad", 4, &value), 0);
+    ASSERT_EQ(chtest_rad_from_chars("1erad", 5, &value), 0);
+
+    chtest_a_t current = chtest_a(0);
+    ASSERT_EQ(chtest_a_from_chars("16777217A", 9, &current), 9);
+    ASSERT_EQ(CUDL_GET(current), 16777216.0f);
+}
+
+TEST(test_cudl_chars, whenFormattingRandomValues_textReadsBackToTheSameValue)
+{
+    uint64_t state = 88172645463325252ULL;
+    for (int i = 0; i < 100000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        double number;
+        std::memcpy(&number, &state, sizeof(number));
+        auto single_bits = (uint32_t) state;
+        float single;
+        std::memcpy(&single, &single_bits, sizeof(single));
+        if (std::isnan(number) || std::isnan(single)) { continue; }
+
+        std::string text = to_string(chtest_rad_to_chars, chtest_rad(number));
+        chtest_rad_t parsed = chtest_rad(0);
+        ASSERT_EQ(chtest_rad_from_chars(text.data(), text.size(), &parsed), text.size());
+        ASSERT_EQ(CUDL_GET(parsed), number) << text;
+        ASSERT_EQ(std::strtod(text.substr(0, text.size() - 3).c_str(), nullptr), number) << text;
+
+        text = to_string(chtest_a_to_chars, chtest_a(single));
+        chtest_a_t parsed_single = chtest_a(0);
+        ASSERT_EQ(chtest_a_from_chars(text.data(), text.size(), &parsed_single), text.size());
+        ASSERT_EQ(CUDL_GET(parsed_single), single) << text;
+        ASSERT_EQ(std::strtof(text.substr(0, text.size() - 1).c_str(), nullptr), single) << text;
+    }
+}
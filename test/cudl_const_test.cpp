@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#define CUDL_PREFIX cntest_
+#include <cudl.h>
+
+#define CNTEST_TIMES_TEN(_x) ((_x) * 10)
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_UNIT(uv, int32_t)
+CUDL_ADD_UNIT(nv, int64_t)
+CUDL_ADD_UNIT(v, float)
+CUDL_ADD_UNIT(count, uint32_t)
+CUDL_ADD_UNIT(ticks, uint64_t)
+CUDL_ADD_UNIT(celsius, double)
+CUDL_ADD_UNIT(fahrenheit, double)
+CUDL_ADD_UNIT(kelvin, float)
+CUDL_ADD_UNIT(adc, uint16_t)
+CUDL_ADD_UNIT_WITH_OP(cmv, int16_t, CNTEST_TIMES_TEN)
+CUDL_ADD_FIXED_POINT_UNIT(gain, int32_t, 16)
+
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(mv, v, 1, 1000)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(uv, mv, 1, 1000)
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(mv, nv, 1000000, 1)
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(count, ticks, 48000, 3)
+CUDL_ADD_AFFINE_CONVERSION(celsius, fahrenheit, 9, 5, 32)
+CUDL_ADD_AFFINE_CONVERSION(kelvin, celsius, 1, 1, -273.15)
+CUDL_ADD_AFFINE_CONVERSION(adc, mv, 3300, 4096, -5)
+CUDL_ADD_AFFINE_CONVERSION(celsius, mv, 10, 1, 500)
+CUDL_ADD_AFFINE_CONVERSION(nv, uv, 1, 1000, 0)
+
+// The macros are constant expressions, so these tables are built by the compiler
+static const cntest_mv_t thresholds[] = {CUDL_CONST(mv, -3300), CUDL_CONST(mv, 0), CUDL_CONST(mv, 3300)};
+static const cntest_cmv_t brownout = CUDL_CONST_WITH_OP(cmv, CNTEST_TIMES_TEN, 290);
+static const cntest_gain_t gains[] = {CUDL_CONST_FIXED_POINT(gain, 1.0), CUDL_CONST_FIXED_POINT(gain, -0.25)};
+constexpr cntest_ticks_t period = CUDL_CONST_REDUCED_CONVERSION_FRACTION_FACTOR(count, ticks, 1000, 48000, 3);
+static_assert(CUDL_GET(period) == 16000000, "Constant expression");
+
+TEST(test_cudl_const, whenInitializingStaticTables_valuesMatchTheInitFunctions)
+{
+    ASSERT_EQ(CUDL_GET(thresholds[0]), CUDL_GET(cntest_mv(-3300)));
+    ASSERT_EQ(CUDL_GET(thresholds[2]), CUDL_GET(cntest_mv(3300)));
+    ASSERT_EQ(CUDL_GET(brownout), CUDL_GET(cntest_cmv(290)));
+    ASSERT_EQ(CUDL_GET(brownout), 2900);
+    ASSERT_EQ(CUDL_GET(gains[0]), CUDL_GET(CUDL_FIXED_POINT(gain, 1.0)));
+    ASSERT_EQ(CUDL_GET(gains[1]), CUDL_GET(CUDL_FIXED_POINT(gain, -0.25)));
+    ASSERT_EQ(CUDL_GET(gains[1]), -16384);
+}
+
+TEST(test_cudl_const, whenConvertingWithFractionFactors_valuesMatchTheConversionFunctions)
+{
+    for (int i = -32768; i <= 32767; i += 7) {
+        const cntest_v_t v = CUDL_CONST_CONVERSION_FRACTION_FACTOR(mv, v, i, 1, 1000);
+        ASSERT_EQ(CUDL_GET(v), CUDL_GET(cntest_from_mv_to_v(cntest_mv((int16_t) i))));
+        const cntest_nv_t nv = CUDL_CONST_REDUCED_CONVERSION_FRACTION_FACTOR(mv, nv, i, 1000000, 1);
+        ASSERT_EQ(CUDL_GET(nv), CUDL_GET(cntest_from_mv_to_nv(cntest_mv((int16_t) i))));
+        const cntest_mv_t mv = CUDL_CONST_CONVERSION_FRACTION_FACTOR(uv, mv, i * 1000 + 999, 1, 1000);
+        ASSERT_EQ(CUDL_GET(mv), CUDL_GET(cntest_from_uv_to_mv(cntest_uv(i * 1000 + 999))));
+    }
+    for (uint32_t i = 0; i < 4000000000u; i += 9999991u) {
+        const cntest_ticks_t ticks = CUDL_CONST_REDUCED_CONVERSION_FRACTION_FACTOR(count, ticks, i, 48000, 3);
+        ASSERT_EQ(CUDL_GET(ticks), CUDL_GET(cntest_from_count_to_ticks(cntest_count(i))));
+    }
+}
+
+TEST(test_cudl_const, whenConvertingWithAffineConversions_valuesMatchTheConversionFunctions)
+{
+    for (int i = -400; i <= 400; ++i) {
+        const double celsius = i / 4.0;
+        const cntest_fahrenheit_t fahrenheit = CUDL_CONST_AFFINE_CONVERSION(celsius, fahrenheit, celsius, 9, 5, 32);
+        ASSERT_EQ(CUDL_GET(fahrenheit), CUDL_GET(cntest_from_celsius_to_fahrenheit(cntest_celsius(celsius))));
+        const cntest_mv_t mv = CUDL_CONST_AFFINE_CONVERSION(celsius, mv, celsius, 10, 1, 500);
+        ASSERT_EQ(CUDL_GET(mv), CUDL_GET(cntest_from_celsius_to_mv(cntest_celsius(celsius)))) << celsius;
+        const cntest_celsius_t from_kelvin = CUDL_CONST_AFFINE_CONVERSION(kelvin, celsius, i + 400.5f, 1, 1, -273.15);
+        ASSERT_EQ(CUDL_GET(from_kelvin), CUDL_GET(cntest_from_kelvin_to_celsius(cntest_kelvin(i + 400.5f))));
+    }
+    for (int i = 0; i < 4096; ++i) {
+        const cntest_mv_t mv = CUDL_CONST_AFFINE_CONVERSION(adc, mv, i, 3300, 4096, -5);
+        ASSERT_EQ(CUDL_GET(mv), CUDL_GET(cntest_from_adc_to_mv(cntest_adc((uint16_t) i)))) << i;
+    }
+    for (int64_t i = -5000000; i <= 5000000; i += 777) {
+        const cntest_uv_t uv = CUDL_CONST_AFFINE_CONVERSION(nv, uv, i, 1, 1000, 0);
+        ASSERT_EQ(CUDL_GET(uv), CUDL_GET(cntest_from_nv_to_uv(cntest_nv(i)))) << i;
+    }
+}
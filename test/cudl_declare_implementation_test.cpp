@@ -0,0 +1,4 @@
+#define CUDL_IMPLEMENTATION
+#include "cudl_declare_test.h"
+
+const uint32_t dtest_squared_amps[5] = {0, 100, 400, 900, 1600};
@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "cudl_declare_test.h"
+
+// Declared and implemented in this file, with the explicit CUDL_IMPLEMENT_* macros.
+CUDL_DECLARE_UNIT(ma, int16_t)
+CUDL_DECLARE_NO_TRANSFORM_OP(ma, _add, +)
+CUDL_DECLARE_NO_UNIT_OP(ma, _mul, *, int16_t)
+CUDL_DECLARE_RELATIONAL_OP(ma, _lt, <)
+CUDL_DECLARE_BITWISE_NOT_OP(ma, _bnot)
+CUDL_DECLARE_NO_TRANSFORM_ARRAY_OP(ma, _add, +)
+CUDL_DECLARE_NO_UNIT_ARRAY_OP(ma, _mul, *, int16_t)
+CUDL_DECLARE_RELATIONAL_ARRAY_OP(ma, _lt, <)
+CUDL_DECLARE_BITWISE_NOT_ARRAY_OP(ma, _bnot)
+CUDL_DECLARE_SATURATING_ADD_OP(ma, _sat_add, int16_t)
+CUDL_DECLARE_CHECKED_NO_UNIT_OP(ma, _checked_mul, __builtin_mul_overflow, int16_t)
+CUDL_DECLARE_SELECTION_OPERATORS(ma, int16_t)
+
+CUDL_DECLARE_UNIT(ua, int32_t)
+
+CUDL_DECLARE_FIXED_POINT_UNIT(ma_q, int32_t, 8)
+CUDL_DECLARE_FIXED_POINT_OPERATORS(ma_q, int32_t)
+CUDL_DECLARE_UNIT(ma_f, float)
+CUDL_DECLARE_FIXED_POINT_CONVERSION_FRACTION_FACTOR(ma_q, rad_q, 1, 1000)
+CUDL_DECLARE_FIXED_POINT_FLOAT_CONVERSIONS(ma_q, ma_f)
+CUDL_DECLARE_EXPLICIT_AFFINE_CONVERSION(ma, ma_f, biased_, 1, 2, 0.25f)
+static const float ma_cubes[3] = {-1000.0f, 0.0f, 1000.0f};
+CUDL_DECLARE_EXPLICIT_LUT_CONVERSION(ma, ma_f, cubed_, ma_cubes, 3, -10, 10)
+
+CUDL_DECLARE_CONVERSION_FRACTION_FACTOR(ma, ua, 1000, 1)
+
+CUDL_IMPLEMENT_UNIT(ma, int16_t)
+CUDL_IMPLEMENT_NO_TRANSFORM_OP(ma, _add, +)
+CUDL_IMPLEMENT_NO_UNIT_OP(ma, _mul, *, int16_t)
+CUDL_IMPLEMENT_RELATIONAL_OP(ma, _lt, <)
+CUDL_IMPLEMENT_BITWISE_NOT_OP(ma, _bnot)
+CUDL_IMPLEMENT_NO_TRANSFORM_ARRAY_OP(ma, _add, +)
+CUDL_IMPLEMENT_NO_UNIT_ARRAY_OP(ma, _mul, *, int16_t)
+CUDL_IMPLEMENT_RELATIONAL_ARRAY_OP(ma, _lt, <)
+CUDL_IMPLEMENT_BITWISE_NOT_ARRAY_OP(ma, _bnot)
+CUDL_IMPLEMENT_SATURATING_ADD_OP(ma, _sat_add, int16_t)
+CUDL_IMPLEMENT_CHECKED_NO_UNIT_OP(ma, _checked_mul, __builtin_mul_overflow, int16_t)
+CUDL_IMPLEMENT_SELECTION_OPERATORS(ma, int16_t)
+
+CUDL_IMPLEMENT_UNIT(ua, int32_t)
+
+CUDL_IMPLEMENT_FIXED_POINT_UNIT(ma_q, int32_t)
+CUDL_IMPLEMENT_FIXED_POINT_OPERATORS(ma_q, int32_t)
+CUDL_IMPLEMENT_UNIT(ma_f, float)
+CUDL_IMPLEMENT_FIXED_POINT_CONVERSION_FRACTION_FACTOR(ma_q, rad_q, 1, 1000)
+CUDL_IMPLEMENT_FIXED_POINT_FLOAT_CONVERSIONS(ma_q, ma_f)
+CUDL_IMPLEMENT_EXPLICIT_AFFINE_CONVERSION(ma, ma_f, biased_, 1, 2, 0.25f)
+CUDL_IMPLEMENT_EXPLICIT_LUT_CONVERSION(ma, ma_f, cubed_, ma_cubes, 3, -10, 10)
+
+CUDL_IMPLEMENT_CONVERSION_FRACTION_FACTOR(ma, ua, 1000, 1)
+
+TEST(test_cudl_declare, whenUsingDeclaredUnits_opsAreDefinedByTheImplementationFile)
+{
+    dtest_v_t sum = dtest_v_add(dtest_v(10), dtest_v(32));
+    ASSERT_EQ(CUDL_GET(sum), 42u);
+    ASSERT_EQ(CUDL_GET(dtest_v_bsl(sum, 1)), 84u);
+    ASSERT_EQ(CUDL_GET(dtest_v_bnot(dtest_v(0))), UINT32_MAX);
+    ASSERT_TRUE(dtest_v_gt(sum, dtest_v(41)));
+    ASSERT_FALSE(dtest_v_eq(sum, dtest_v(41)));
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredUnitWithOp_initOpIsApplied)
+{
+    ASSERT_EQ(CUDL_GET(dtest_mv(21)), 42u);
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredConversions_resultsMatchTheInlineVersions)
+{
+    ASSERT_EQ(CUDL_GET(dtest_from_v_to_mv(dtest_v(3))), 3000u);
+    ASSERT_EQ(CUDL_GET(dtest_from_mv_to_v(dtest_mv(2500))), 5u);
+    ASSERT_DOUBLE_EQ(CUDL_GET(dtest_rad_to_deg(dtest_rad(3.14159265358979323846))), 180.0);
+    ASSERT_EQ(CUDL_GET(dtest_from_ma_to_ua(dtest_ma(-7))), -7000);
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredArrayOps_everyElementIsComputed)
+{
+    dtest_v_t lhs[5], rhs[5], sum[5];
+    bool greater[5];
+    for (uint32_t i = 0; i < 5; ++i) {
+        lhs[i] = dtest_v(i * 10);
+        rhs[i] = dtest_v(20);
+    }
+    dtest_v_add_n(sum, lhs, rhs, 5);
+    dtest_v_gt_n(greater, lhs, rhs, 5);
+    for (uint32_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(CUDL_GET(sum[i]), i * 10 + 20);
+        ASSERT_EQ(greater[i], i > 2);
+    }
+
+    dtest_rad_t rad[3] = {dtest_rad(1.0), dtest_rad(2.0), dtest_rad(3.0)};
+    dtest_rad_t scaled[3];
+    dtest_rad_mul_n(scaled, rad, 0.5, 3);
+    ASSERT_DOUBLE_EQ(CUDL_GET(scaled[2]), 1.5);
+}
+
+TEST(test_cudl_declare, whenUsingImplementMacros_opsAreDefinedInThisFile)
+{
+    alignas(CUDL_ARRAY_ALIGNMENT) dtest_ma_t ma[3] = {dtest_ma(1), dtest_ma(-2), dtest_ma(3)};
+    alignas(CUDL_ARRAY_ALIGNMENT) dtest_ma_t result[3];
+    bool lower[3];
+    ASSERT_EQ(CUDL_GET(dtest_ma_add(ma[0], ma[2])), 4);
+    ASSERT_EQ(CUDL_GET(dtest_ma_mul(ma[1], 3)), -6);
+    ASSERT_TRUE(dtest_ma_lt(ma[1], ma[0]));
+    ASSERT_EQ(CUDL_GET(dtest_ma_bnot(ma[0])), -2);
+    dtest_ma_add_n(result, ma, ma, 3);
+    ASSERT_EQ(CUDL_GET(result[1]), -4);
+    dtest_ma_mul_n(result, ma, 2, 3);
+    ASSERT_EQ(CUDL_GET(result[2]), 6);
+    dtest_ma_lt_n(lower, ma, result, 3);
+    ASSERT_FALSE(lower[1]);
+    dtest_ma_bnot_n(result, ma, 3);
+    ASSERT_EQ(CUDL_GET(result[0]), -2);
+    ASSERT_EQ(CUDL_GET(dtest_ma_sat_add(dtest_ma(INT16_MAX), ma[0])), INT16_MAX);
+    ASSERT_TRUE(dtest_ma_checked_mul_n(result, ma, INT16_MAX, 3));
+    ASSERT_FALSE(dtest_ma_checked_mul_n_aligned(result, ma, 2, 3));
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredSaturatingAndCheckedOps_theyMatchTheInlineVersions)
+{
+    dtest_v_t values[3] = {dtest_v(1), dtest_v(UINT32_MAX - 1), dtest_v(UINT32_MAX / 2 + 1)};
+    dtest_v_t result[3];
+    ASSERT_EQ(CUDL_GET(dtest_v_sat_sub(dtest_v(1), dtest_v(2))), 0u);
+    dtest_v_sat_add_n(result, values, values, 3);
+    ASSERT_EQ(CUDL_GET(result[0]), 2u);
+    ASSERT_EQ(CUDL_GET(result[1]), UINT32_MAX);
+    dtest_v_sat_mul_n(result, values, 3, 3);
+    ASSERT_EQ(CUDL_GET(result[2]), UINT32_MAX);
+    ASSERT_TRUE(dtest_v_checked_add_n(result, values, values, 3));
+    ASSERT_FALSE(dtest_v_checked_sub(dtest_v(3), dtest_v(1), &result[0]));
+    ASSERT_EQ(CUDL_GET(result[0]), 2u);
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredSelectionOps_theyMatchTheInlineVersions)
+{
+    alignas(CUDL_ARRAY_ALIGNMENT) dtest_v_t volts[4] = {dtest_v(5), dtest_v(50), dtest_v(7), dtest_v(70)};
+    alignas(CUDL_ARRAY_ALIGNMENT) dtest_v_t clamped[4];
+    uint64_t mask[CUDL_MASK_WORDS(4)];
+    dtest_v_gt_mask_n(mask, volts, dtest_v(10), 4);
+    ASSERT_EQ(mask[0], 0xAu);
+    dtest_v_clamp_n_aligned(clamped, volts, dtest_v(6), dtest_v(60), 4);
+    ASSERT_EQ(CUDL_GET(clamped[0]), 6u);
+    ASSERT_EQ(CUDL_GET(clamped[3]), 60u);
+    dtest_v_t selected[4];
+    dtest_v_select_n(selected, mask, volts, clamped, 4);
+    ASSERT_EQ(CUDL_GET(selected[0]), 6u);
+    ASSERT_EQ(CUDL_GET(selected[3]), 70u);
+    ASSERT_EQ(dtest_v_filter_gt_n(selected, volts, dtest_v(6), 4), 3u);
+
+    const dtest_ma_t milliamps[3] = {dtest_ma(-3), dtest_ma(0), dtest_ma(3)};
+    dtest_ma_t positive[3];
+    ASSERT_EQ(dtest_ma_filter_ge_n(positive, milliamps, dtest_ma(0), 3), 2u);
+    ASSERT_EQ(CUDL_GET(positive[1]), 3);
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredProductOps_resultsAreInTheResultUnit)
+{
+    ASSERT_EQ(CUDL_GET(dtest_v_times_a(dtest_v(3), dtest_a(4))), 12u);
+    ASSERT_EQ(CUDL_GET(dtest_w_per_a(dtest_w(12), dtest_a(4))), 3u);
+    ASSERT_EQ(CUDL_GET(dtest_mv_times_a(dtest_mv(2000000), dtest_a(1000))), 4000000u);
+    alignas(CUDL_ARRAY_ALIGNMENT) dtest_v_t volts[3] = {dtest_v(1), dtest_v(2), dtest_v(3)};
+    alignas(CUDL_ARRAY_ALIGNMENT) dtest_a_t amps[3] = {dtest_a(10), dtest_a(20), dtest_a(30)};
+    alignas(CUDL_ARRAY_ALIGNMENT) dtest_w_t watts[3] = {dtest_w(1), dtest_w(1), dtest_w(1)};
+    dtest_v_times_a_plus_n(watts, volts, amps, watts, 3);
+    ASSERT_EQ(CUDL_GET(watts[2]), 91u);
+    dtest_w_per_a_n_aligned(volts, watts, amps, 3);
+    ASSERT_EQ(CUDL_GET(volts[1]), 2u);
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredFixedPointOps_resultsAreRoundedLikeTheInlineVersions)
+{
+    dtest_ma_q_t lhs[2] = {CUDL_FIXED_POINT(ma_q, 1.5), CUDL_FIXED_POINT(ma_q, -3.0)};
+    dtest_ma_q_t rhs[2] = {CUDL_FIXED_POINT(ma_q, 2.0), CUDL_FIXED_POINT(ma_q, 0.5)};
+    dtest_ma_q_t result[2];
+    ASSERT_EQ(CUDL_GET(dtest_ma_q_add(lhs[0], rhs[0])), CUDL_GET(CUDL_FIXED_POINT(ma_q, 3.5)));
+    dtest_ma_q_qmul_n(result, lhs, rhs, 2);
+    ASSERT_EQ(CUDL_GET(result[1]), CUDL_GET(CUDL_FIXED_POINT(ma_q, -1.5)));
+    dtest_ma_q_qdiv_n(result, lhs, rhs, 2);
+    ASSERT_EQ(CUDL_GET(result[0]), CUDL_GET(CUDL_FIXED_POINT(ma_q, 0.75)));
+    ASSERT_EQ(CUDL_GET(dtest_ma_q_qdiv(lhs[1], rhs[1])), CUDL_GET(CUDL_FIXED_POINT(ma_q, -6.0)));
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredReductions_theyMatchTheInlineVersions)
+{
+    const dtest_v_t volts[4] = {dtest_v(4), dtest_v(UINT32_MAX), dtest_v(1), dtest_v(7)};
+    ASSERT_EQ(dtest_v_sum_n(volts, 4), UINT32_MAX + 12ull);
+    ASSERT_EQ(dtest_v_dot_n(volts, volts, 2), 16ull + (uint64_t) UINT32_MAX * UINT32_MAX);
+    ASSERT_EQ(CUDL_GET(dtest_v_min_n(volts, 4)), 1u);
+    ASSERT_EQ(CUDL_GET(dtest_v_max_n(volts, 4)), UINT32_MAX);
+
+    std::vector<dtest_rad_t> rads(3000, dtest_rad(0.5));
+    ASSERT_DOUBLE_EQ(dtest_rad_sum_n(rads.data(), rads.size()), 1500.0);
+    ASSERT_DOUBLE_EQ(dtest_rad_dot_n(rads.data(), rads.data(), rads.size()), 750.0);
+    ASSERT_DOUBLE_EQ(CUDL_GET(dtest_rad_mean_n(rads.data(), rads.size())), 0.5);
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredFixedPointConversions_resultsMatchTheInlineVersions)
+{
+    ASSERT_EQ(CUDL_GET(dtest_ma_q_from_int(-3)), -768);
+    ASSERT_EQ(dtest_ma_q_to_int(CUDL_FIXED_POINT(ma_q, 2.75)), 2);
+    ASSERT_EQ(CUDL_GET(dtest_from_ma_q_to_rad_q(CUDL_FIXED_POINT(ma_q, 500.0))), CUDL_GET(CUDL_FIXED_POINT(rad_q, 0.5)));
+    ASSERT_FLOAT_EQ(CUDL_GET(dtest_from_ma_q_to_ma_f(CUDL_FIXED_POINT(ma_q, -1.25))), -1.25f);
+
+    const dtest_rad_q_t rads[2] = {CUDL_FIXED_POINT(rad_q, 1.5), CUDL_FIXED_POINT(rad_q, -0.25)};
+    dtest_rad_q8_t narrow[2];
+    dtest_from_rad_q_to_rad_q8_n(narrow, rads, 2);
+    ASSERT_EQ(CUDL_GET(narrow[1]), CUDL_GET(CUDL_FIXED_POINT(rad_q8, -0.25)));
+    ASSERT_DOUBLE_EQ(CUDL_GET(dtest_from_rad_q_to_rad(rads[0])), 1.5);
+    ASSERT_EQ(CUDL_GET(dtest_from_rad_to_rad_q(dtest_rad(-0.25))), CUDL_GET(rads[1]));
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredAffineConversions_resultsMatchTheInlineVersions)
+{
+    ASSERT_EQ(CUDL_GET(dtest_from_celsius_to_fahrenheit(dtest_celsius(-40))), -40);
+    ASSERT_EQ(CUDL_GET(dtest_from_celsius_to_fahrenheit(dtest_celsius(37))), 99);
+    ASSERT_FLOAT_EQ(CUDL_GET(dtest_biased_ma_f(dtest_ma(-3))), -1.25f);
+
+    const dtest_celsius_t celsius[2] = {dtest_celsius(0), dtest_celsius(100)};
+    dtest_fahrenheit_t fahrenheit[2];
+    dtest_from_celsius_to_fahrenheit_n(fahrenheit, celsius, 2);
+    ASSERT_EQ(CUDL_GET(fahrenheit[0]), 32);
+    ASSERT_EQ(CUDL_GET(fahrenheit[1]), 212);
+    alignas(CUDL_ARRAY_ALIGNMENT) const dtest_ma_t milliamps[2] = {dtest_ma(1), dtest_ma(4)};
+    alignas(CUDL_ARRAY_ALIGNMENT) dtest_ma_f_t biased[2];
+    dtest_biased_ma_f_n_aligned(biased, milliamps, 2);
+    ASSERT_FLOAT_EQ(CUDL_GET(biased[1]), 2.25f);
+}
+
+TEST(test_cudl_declare, whenUsingDeclaredLutConversions_resultsMatchTheInlineVersions)
+{
+    ASSERT_EQ(CUDL_GET(dtest_from_a_to_w(dtest_a(15))), 250u);
+    ASSERT_EQ(CUDL_GET(dtest_from_a_to_w(dtest_a(50))), 1600u);
+    ASSERT_FLOAT_EQ(CUDL_GET(dtest_cubed_ma_f(dtest_ma(-5))), -500.0f);
+
+    const dtest_a_t amps[2] = {dtest_a(0), dtest_a(25)};
+    dtest_w_t watts[2];
+    dtest_from_a_to_w_n(watts, amps, 2);
+    ASSERT_EQ(CUDL_GET(watts[0]), 0u);
+    ASSERT_EQ(CUDL_GET(watts[1]), 650u);
+    alignas(CUDL_ARRAY_ALIGNMENT) const dtest_ma_t milliamps[2] = {dtest_ma(-20), dtest_ma(2)};
+    alignas(CUDL_ARRAY_ALIGNMENT) dtest_ma_f_t cubed[2];
+    dtest_cubed_ma_f_n_aligned(cubed, milliamps, 2);
+    ASSERT_FLOAT_EQ(CUDL_GET(cubed[0]), -1000.0f);
+    ASSERT_FLOAT_EQ(CUDL_GET(cubed[1]), 200.0f);
+}
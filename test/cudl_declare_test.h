@@ -0,0 +1,52 @@
+#ifndef CUDL_DECLARE_TEST_H
+#define CUDL_DECLARE_TEST_H
+
+#include <cstdint>
+
+#define CUDL_PREFIX dtest_
+#include <cudl.h>
+#include <cudl_lut.h>
+
+// Catalog defined in cudl_declare_implementation_test.cpp, which defines CUDL_IMPLEMENTATION before including it.
+CUDL_DECLARE_UNIT(v, uint32_t)
+CUDL_DECLARE_INTEGER_OPERATORS(v, uint32_t)
+CUDL_DECLARE_INTEGER_ARRAY_OPERATORS(v, uint32_t)
+CUDL_DECLARE_SATURATING_OPERATORS(v, uint32_t)
+CUDL_DECLARE_CHECKED_OPERATORS(v, uint32_t)
+CUDL_DECLARE_INTEGER_REDUCTION_OPERATORS(v, uint32_t, uint64_t)
+CUDL_DECLARE_SELECTION_OPERATORS(v, uint32_t)
+
+CUDL_DECLARE_UNIT_WITH_OP(mv, uint32_t, 2 *)
+
+CUDL_DECLARE_CONVERSION_FACTOR(v, mv, 1000)
+CUDL_DECLARE_REDUCED_CONVERSION_FRACTION_FACTOR(mv, v, 1000, 1000000)
+
+CUDL_DECLARE_UNIT(a, uint32_t)
+CUDL_DECLARE_UNIT(w, uint32_t)
+CUDL_DECLARE_PRODUCT_OP(v, a, w, _times_a)
+CUDL_DECLARE_QUOTIENT_OP(w, a, v, _per_a)
+CUDL_DECLARE_WIDENED_PRODUCT_OP(mv, a, w, _times_a, uint64_t, 1, 1000)
+CUDL_DECLARE_FUSED_PRODUCT_OP(v, a, w, _times_a_plus)
+
+CUDL_DECLARE_UNIT(rad, double)
+CUDL_DECLARE_COMMON_OPERATORS(rad, double)
+CUDL_DECLARE_COMMON_ARRAY_OPERATORS(rad, double)
+CUDL_DECLARE_FLOAT_REDUCTION_OPERATORS(rad, double)
+
+CUDL_DECLARE_UNIT(deg, double)
+
+CUDL_DECLARE_EXPLICIT_CONVERSION_FRACTION_FACTOR(rad, deg, rad_to_, 180.0, 3.14159265358979323846)
+
+CUDL_DECLARE_FIXED_POINT_UNIT(rad_q, int32_t, 16)
+CUDL_DECLARE_FIXED_POINT_UNIT(rad_q8, int16_t, 8)
+CUDL_DECLARE_FIXED_POINT_CONVERSION(rad_q, rad_q8)
+CUDL_DECLARE_FIXED_POINT_FLOAT_CONVERSIONS(rad_q, rad)
+
+CUDL_DECLARE_UNIT(celsius, int32_t)
+CUDL_DECLARE_UNIT(fahrenheit, int32_t)
+CUDL_DECLARE_AFFINE_CONVERSION(celsius, fahrenheit, 9, 5, 32)
+
+extern const uint32_t dtest_squared_amps[5];
+CUDL_DECLARE_LUT_CONVERSION(a, w, dtest_squared_amps, 5, 0, 40)
+
+#endif//CUDL_DECLARE_TEST_H
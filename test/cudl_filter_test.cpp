@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#define CUDL_PREFIX fitest_
+// A small block so that the tests go through several blocks
+#define CUDL_FILTER_BLOCK_SIZE 16
+#include <cudl_filter.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_MOVING_AVERAGE(mv, int32_t, 4)
+CUDL_ADD_FIR_FILTER(mv, 5, int16_t, int32_t, 1 << 15)
+CUDL_ADD_EXPLICIT_FIR_FILTER(mv, mv_delay, 3, int16_t, int32_t, 1)
+CUDL_ADD_BIQUAD_FILTER(mv, int32_t, int64_t, 1 << 14)
+CUDL_ADD_DECIMATOR(mv, 3)
+
+CUDL_ADD_UNIT(v, double)
+CUDL_ADD_MOVING_AVERAGE(v, double, 10)
+CUDL_ADD_FIR_FILTER(v, 3, double, double, 1)
+CUDL_ADD_BIQUAD_FILTER(v, double, double, 1)
+
+CUDL_ADD_FIXED_POINT_UNIT(gain, int32_t, 16)
+CUDL_ADD_FIR_FILTER(gain, 2, int32_t, int64_t, 1 << 16)
+
+static std::vector<fitest_mv_t> ramp(size_t n) {
+    std::vector<fitest_mv_t> values(n);
+    for (size_t i = 0; i < n; ++i) { values[i] = fitest_mv((int16_t) ((i * 37) % 1000)); }
+    return values;
+}
+
+TEST(test_cudl_filter, whenAveragingValues_eachOutputIsTheAverageOfTheWindow)
+{
+    const std::vector<fitest_mv_t> values = ramp(100);
+    fitest_mv_moving_average_t average;
+    fitest_mv_moving_average_init(&average);
+    std::vector<fitest_mv_t> averages(values.size());
+    // Chunks of different sizes give the same result as a single call
+    fitest_mv_moving_average_process_n(&average, averages.data(), values.data(), 3);
+    fitest_mv_moving_average_process_n(&average, &averages[3], &values[3], 50);
+    fitest_mv_moving_average_process_n(&average, &averages[53], &values[53], 47);
+    for (size_t i = 0; i < values.size(); ++i) {
+        int32_t sum = 0;
+        for (size_t j = 0; j < 4 && j <= i; ++j) { sum += CUDL_GET(values[i - j]); }
+        ASSERT_EQ(CUDL_GET(averages[i]), sum / 4) << i;
+    }
+
+    // The floating point sum does not drift
+    fitest_v_moving_average_t v_average;
+    fitest_v_moving_average_init(&v_average);
+    std::vector<fitest_v_t> volts(100000);
+    for (size_t i = 0; i < volts.size(); ++i) { volts[i] = fitest_v(i % 2 ? 1e6 : 0.1); }
+    fitest_v_moving_average_process_n(&v_average, volts.data(), volts.data(), volts.size());
+    ASSERT_NEAR(CUDL_GET(volts.back()), (1e6 + 0.1) / 2, 1e-9);
+}
+
+TEST(test_cudl_filter, whenFilteringWithAFir_theOutputIsTheConvolutionInBlocks)
+{
+    const std::vector<fitest_mv_t> values = ramp(100);
+    const int16_t coefs[5] = {4096, 8192, 8192, 8192, 4096};// 1/8, 1/4, 1/4, 1/4, 1/8
+    std::unique_ptr<fitest_mv_fir_t> fir(new fitest_mv_fir_t);
+    fitest_mv_fir_init(fir.get(), coefs);
+    std::vector<fitest_mv_t> filtered = values;
+    fitest_mv_fir_process_n(fir.get(), filtered.data(), filtered.data(), 7);// In place
+    fitest_mv_fir_process_n(fir.get(), &filtered[7], &filtered[7], 93);
+    for (size_t i = 0; i < values.size(); ++i) {
+        int32_t sum = 0;
+        for (size_t k = 0; k < 5 && k <= i; ++k) { sum += coefs[k] * CUDL_GET(values[i - k]); }
+        ASSERT_EQ(CUDL_GET(filtered[i]), (sum + (1 << 14)) / (1 << 15)) << i;// Rounded to the nearest
+    }
+
+    // The first coefficient applies to the newest value
+    const int16_t delay[3] = {0, 0, 1};
+    fitest_mv_delay_t delay_line;
+    fitest_mv_delay_init(&delay_line, delay);
+    std::vector<fitest_mv_t> delayed(values.size());
+    fitest_mv_delay_process_n(&delay_line, delayed.data(), values.data(), values.size());
+    ASSERT_EQ(CUDL_GET(delayed[0]), 0);
+    ASSERT_EQ(CUDL_GET(delayed[1]), 0);
+    for (size_t i = 2; i < values.size(); ++i) { ASSERT_EQ(CUDL_GET(delayed[i]), CUDL_GET(values[i - 2])); }
+}
+
+TEST(test_cudl_filter, whenFilteringOtherUnits_theCoefficientsAreScaled)
+{
+    const double coefs[3] = {0.25, 0.5, 0.25};
+    fitest_v_fir_t fir;
+    fitest_v_fir_init(&fir, coefs);
+    const fitest_v_t volts[4] = {fitest_v(4.0), fitest_v(8.0), fitest_v(0.0), fitest_v(-4.0)};
+    fitest_v_t filtered[4];
+    fitest_v_fir_process_n(&fir, filtered, volts, 4);
+    ASSERT_DOUBLE_EQ(CUDL_GET(filtered[0]), 1.0);
+    ASSERT_DOUBLE_EQ(CUDL_GET(filtered[1]), 4.0);
+    ASSERT_DOUBLE_EQ(CUDL_GET(filtered[2]), 5.0);
+    ASSERT_DOUBLE_EQ(CUDL_GET(filtered[3]), 1.0);
+
+    // Q16 values with Q16 coefficients, the products need 64 bits
+    const int32_t gain_coefs[2] = {1 << 15, 1 << 15};
+    fitest_gain_fir_t gain_fir;
+    fitest_gain_fir_init(&gain_fir, gain_coefs);
+    const fitest_gain_t gains[2] = {CUDL_FIXED_POINT(gain, 1000.0), CUDL_FIXED_POINT(gain, 3000.0)};
+    fitest_gain_t smoothed[2];
+    fitest_gain_fir_process_n(&gain_fir, smoothed, gains, 2);
+    ASSERT_EQ(CUDL_GET(smoothed[0]), CUDL_GET(CUDL_FIXED_POINT(gain, 500.0)));
+    ASSERT_EQ(CUDL_GET(smoothed[1]), CUDL_GET(CUDL_FIXED_POINT(gain, 2000.0)));
+}
+
+TEST(test_cudl_filter, whenFilteringWithABiquad_theStateIsKeptBetweenChunks)
+{
+    // Low-pass filter of a 1/20 cutoff frequency, from the RBJ cookbook
+    const double w0 = 2 * M_PI / 20, alpha = std::sin(w0) / (2 * std::sqrt(0.5)), a0 = 1 + alpha;
+    const double coefs[5] = {(1 - std::cos(w0)) / 2 / a0, (1 - std::cos(w0)) / a0, (1 - std::cos(w0)) / 2 / a0,
+                             -2 * std::cos(w0) / a0, (1 - alpha) / a0};
+    fitest_v_biquad_t biquad;
+    fitest_v_biquad_init(&biquad, coefs);
+    std::vector<fitest_v_t> step(200, fitest_v(1.0));
+    fitest_v_biquad_process_n(&biquad, step.data(), step.data(), 50);
+    fitest_v_biquad_process_n(&biquad, &step[50], &step[50], 150);
+    ASSERT_NEAR(CUDL_GET(step.back()), 1.0, 1e-6);// Unity gain at DC
+
+    // The same filter with Q14 coefficients on integer values
+    int32_t q14_coefs[5];
+    for (size_t k = 0; k < 5; ++k) { q14_coefs[k] = (int32_t) std::lround(coefs[k] * (1 << 14)); }
+    fitest_mv_biquad_t mv_biquad;
+    fitest_mv_biquad_init(&mv_biquad, q14_coefs);
+    std::vector<fitest_mv_t> mv_step(200, fitest_mv(1000));
+    for (size_t i = 0; i < mv_step.size(); i += 10) {
+        fitest_mv_biquad_process_n(&mv_biquad, &mv_step[i], &mv_step[i], 10);
+    }
+    for (size_t i = 0; i < mv_step.size(); ++i) {
+        // The coefficients rounded to 14 bits change the gain a little, the rounding of the outputs does not add up
+        ASSERT_NEAR(CUDL_GET(mv_step[i]), 1000.0 * CUDL_GET(step[i]), 3.0) << i;
+    }
+}
+
+TEST(test_cudl_filter, whenDecimatingChunks_thePositionInTheStreamIsKept)
+{
+    const std::vector<fitest_mv_t> values = ramp(100);
+    fitest_mv_decimator_t decimator;
+    fitest_mv_decimator_init(&decimator);
+    std::vector<fitest_mv_t> decimated(values.size());
+    size_t count = 0;
+    const size_t chunks[] = {1, 1, 5, 2, 0, 40, 51};
+    size_t done = 0;
+    for (size_t chunk : chunks) {
+        count += fitest_mv_decimator_process_n(&decimator, &decimated[count], &values[done], chunk);
+        done += chunk;
+    }
+    ASSERT_EQ(count, 34u);
+    for (size_t i = 0; i < count; ++i) { ASSERT_EQ(CUDL_GET(decimated[i]), CUDL_GET(values[i * 3])); }
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <cudl.h>
+#include <cmath>
+#include <cstdint>
+
+CUDL_ADD_FIXED_POINT_UNIT(rad_q, int32_t, 16)
+CUDL_ADD_FIXED_POINT_OPERATORS(rad_q, int32_t)
+
+CUDL_ADD_FIXED_POINT_UNIT(deg_q, int32_t, 8)
+CUDL_ADD_FIXED_POINT_OPERATORS(deg_q, int32_t)
+
+CUDL_ADD_FIXED_POINT_UNIT(rad_q32, int64_t, 32)
+CUDL_ADD_FIXED_POINT_OPERATORS(rad_q32, int64_t)
+
+CUDL_ADD_FIXED_POINT_UNIT(gain_q, uint16_t, 12)
+CUDL_ADD_FIXED_POINT_OPERATORS(gain_q, uint16_t)
+
+// The widest formats accepted: all the value bits but one are fractional
+CUDL_ADD_FIXED_POINT_UNIT(edge_q, int16_t, 14)
+CUDL_ADD_FIXED_POINT_UNIT(uedge_q, uint16_t, 15)
+
+CUDL_ADD_UNIT(rad, double)
+CUDL_ADD_UNIT(radf, float)
+
+CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR(rad_q, deg_q, 5729578, 100000)
+CUDL_ADD_FIXED_POINT_CONVERSION(rad_q, rad_q32)
+CUDL_ADD_FIXED_POINT_CONVERSION(rad_q32, rad_q)
+CUDL_ADD_FIXED_POINT_FLOAT_CONVERSIONS(rad_q, rad)
+CUDL_ADD_FIXED_POINT_FLOAT_CONVERSIONS(deg_q, radf)
+
+TEST(cudl_fixed_point_test, initFromLiteral)
+{
+    ASSERT_EQ(cudl_rad_q_frac_bits, 16);
+    ASSERT_EQ(CUDL_GET(CUDL_FIXED_POINT(rad_q, 1.5)), 98304);
+    ASSERT_EQ(CUDL_GET(CUDL_FIXED_POINT(rad_q, -1.5)), -98304);
+    ASSERT_EQ(CUDL_GET(CUDL_FIXED_POINT(rad_q, M_PI)), 205887);
+    ASSERT_EQ(CUDL_GET(CUDL_FIXED_POINT(gain_q, 0.75)), 3072);
+}
+
+TEST(cudl_fixed_point_test, initFromInteger)
+{
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_from_int(3)), 196608);
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_from_int(-3)), -196608);
+    ASSERT_EQ(cudl_rad_q_to_int(CUDL_FIXED_POINT(rad_q, 3.75)), 3);
+    ASSERT_EQ(cudl_rad_q_to_int(CUDL_FIXED_POINT(rad_q, -3.75)), -3);
+}
+
+TEST(cudl_fixed_point_test, widestFormatsKeepOneIntegerBit)
+{
+    static_assert(cudl_edge_q_frac_bits == 14 && cudl_uedge_q_frac_bits == 15, "Widest accepted formats");
+    ASSERT_EQ(CUDL_GET(cudl_edge_q_from_int(1)), 16384);
+    ASSERT_EQ(CUDL_GET(cudl_edge_q_from_int(-1)), -16384);
+    ASSERT_EQ(CUDL_GET(cudl_uedge_q_from_int(1)), 32768u);
+    ASSERT_EQ(cudl_uedge_q_to_int(CUDL_FIXED_POINT(uedge_q, 1.75)), 1u);
+}
+
+TEST(cudl_fixed_point_test, commonOperators)
+{
+    cudl_rad_q_t a = CUDL_FIXED_POINT(rad_q, 1.25);
+    cudl_rad_q_t b = CUDL_FIXED_POINT(rad_q, 0.5);
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_add(a, b)), CUDL_GET(CUDL_FIXED_POINT(rad_q, 1.75)));
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_sub(a, b)), CUDL_GET(CUDL_FIXED_POINT(rad_q, 0.75)));
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_mul(a, 2)), CUDL_GET(CUDL_FIXED_POINT(rad_q, 2.5)));
+    ASSERT_TRUE(cudl_rad_q_gt(a, b));
+}
+
+TEST(cudl_fixed_point_test, qMultiplyRoundsToNearest)
+{
+    cudl_rad_q_t a = CUDL_FIXED_POINT(rad_q, 1.5);
+    cudl_rad_q_t b = CUDL_FIXED_POINT(rad_q, -2.25);
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_qmul(a, b)), CUDL_GET(CUDL_FIXED_POINT(rad_q, -3.375)));
+
+    // 1/65536 * 0.5 is exactly half a LSB and rounds up.
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_qmul(cudl_rad_q(1), CUDL_FIXED_POINT(rad_q, 0.5))), 1);
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_qmul(cudl_rad_q(1), CUDL_FIXED_POINT(rad_q, 0.25))), 0);
+
+    // The product does not fit 32 bits before the shift.
+    cudl_rad_q_t big = CUDL_FIXED_POINT(rad_q, 200.0);
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_qmul(big, big)), CUDL_GET(CUDL_FIXED_POINT(rad_q, 40000.0)));
+
+    cudl_rad_q32_t c = CUDL_FIXED_POINT(rad_q32, 100000.5);
+    ASSERT_EQ(CUDL_GET(cudl_rad_q32_qmul(c, CUDL_FIXED_POINT(rad_q32, 2.0))),
+              CUDL_GET(CUDL_FIXED_POINT(rad_q32, 200001.0)));
+
+    cudl_gain_q_t g = CUDL_FIXED_POINT(gain_q, 3.5);
+    ASSERT_EQ(CUDL_GET(cudl_gain_q_qmul(g, CUDL_FIXED_POINT(gain_q, 0.5))), CUDL_GET(CUDL_FIXED_POINT(gain_q, 1.75)));
+}
+
+TEST(cudl_fixed_point_test, qDivideRoundsToNearest)
+{
+    cudl_rad_q_t a = CUDL_FIXED_POINT(rad_q, 3.0);
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_qdiv(a, CUDL_FIXED_POINT(rad_q, 2.0))), CUDL_GET(CUDL_FIXED_POINT(rad_q, 1.5)));
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_qdiv(a, CUDL_FIXED_POINT(rad_q, -2.0))), CUDL_GET(CUDL_FIXED_POINT(rad_q, -1.5)));
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_qdiv(cudl_rad_q_from_int(1), cudl_rad_q_from_int(3))), 21845);
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_qdiv(cudl_rad_q_from_int(2), cudl_rad_q_from_int(3))), 43691);
+    ASSERT_EQ(CUDL_GET(cudl_rad_q_qdiv(cudl_rad_q_from_int(-2), cudl_rad_q_from_int(3))), -43691);
+
+    cudl_rad_q32_t c = CUDL_FIXED_POINT(rad_q32, 1000000.0);
+    ASSERT_EQ(CUDL_GET(cudl_rad_q32_qdiv(c, CUDL_FIXED_POINT(rad_q32, 0.5))),
+              CUDL_GET(CUDL_FIXED_POINT(rad_q32, 2000000.0)));
+}
+
+TEST(cudl_fixed_point_test, convertBetweenFormats)
+{
+    cudl_rad_q_t half_pi = CUDL_FIXED_POINT(rad_q, M_PI / 2);
+    ASSERT_EQ(CUDL_GET(cudl_from_rad_q_to_deg_q(half_pi)), CUDL_GET(CUDL_FIXED_POINT(deg_q, 90.0)));
+
+    cudl_rad_q32_t wide = cudl_from_rad_q_to_rad_q32(half_pi);
+    ASSERT_EQ(CUDL_GET(wide), static_cast<int64_t>(CUDL_GET(half_pi)) << 16);
+    ASSERT_EQ(CUDL_GET(cudl_from_rad_q32_to_rad_q(wide)), CUDL_GET(half_pi));
+    ASSERT_EQ(CUDL_GET(cudl_from_rad_q32_to_rad_q(CUDL_FIXED_POINT(rad_q32, M_PI))),
+              CUDL_GET(CUDL_FIXED_POINT(rad_q, M_PI)));
+}
+
+TEST(cudl_fixed_point_test, convertWithFloat)
+{
+    cudl_rad_t rads = cudl_from_rad_q_to_rad(CUDL_FIXED_POINT(rad_q, -1.25));
+    ASSERT_DOUBLE_EQ(CUDL_GET(rads), -1.25);
+    ASSERT_EQ(CUDL_GET(cudl_from_rad_to_rad_q(cudl_rad(M_PI))), CUDL_GET(CUDL_FIXED_POINT(rad_q, M_PI)));
+
+    cudl_radf_t degrees = cudl_from_deg_q_to_radf(CUDL_FIXED_POINT(deg_q, -90.5));
+    ASSERT_FLOAT_EQ(CUDL_GET(degrees), -90.5f);
+    ASSERT_EQ(CUDL_GET(cudl_from_radf_to_deg_q(cudl_radf(12.3f))), CUDL_GET(CUDL_FIXED_POINT(deg_q, 12.3)));
+    ASSERT_EQ(CUDL_GET(cudl_from_radf_to_deg_q(cudl_radf(-12.3f))), CUDL_GET(CUDL_FIXED_POINT(deg_q, -12.3)));
+
+    cudl_rad_t values[3] = {{0.5}, {-0.25}, {M_PI}};
+    cudl_rad_q_t fixed[3];
+    cudl_from_rad_to_rad_q_n(fixed, values, 3);
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(CUDL_GET(fixed[i]), CUDL_GET(cudl_from_rad_to_rad_q(values[i])));
+    }
+}
+
+TEST(cudl_fixed_point_test, qMultiplyAndDivideArrays)
+{
+    cudl_rad_q_t lhs[4] = {CUDL_FIXED_POINT(rad_q, 1.5), CUDL_FIXED_POINT(rad_q, -3.0), cudl_rad_q(1),
+                           CUDL_FIXED_POINT(rad_q, 200.0)};
+    cudl_rad_q_t rhs[4] = {CUDL_FIXED_POINT(rad_q, -2.25), CUDL_FIXED_POINT(rad_q, 2.0), CUDL_FIXED_POINT(rad_q, 0.5),
+                           CUDL_FIXED_POINT(rad_q, 200.0)};
+    cudl_rad_q_t result[4];
+    cudl_rad_q_qmul_n(result, lhs, rhs, 4);
+    for (size_t i = 0; i < 4; ++i) { ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_rad_q_qmul(lhs[i], rhs[i]))); }
+    cudl_rad_q_qdiv_n(result, lhs, rhs, 4);
+    for (size_t i = 0; i < 4; ++i) { ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_rad_q_qdiv(lhs[i], rhs[i]))); }
+
+    cudl_rad_q32_t wide[2] = {CUDL_FIXED_POINT(rad_q32, 100000.5), CUDL_FIXED_POINT(rad_q32, -0.25)};
+    cudl_rad_q32_t wide_result[2];
+    cudl_rad_q32_qmul_n(wide_result, wide, wide, 2);
+    ASSERT_EQ(CUDL_GET(wide_result[1]), CUDL_GET(CUDL_FIXED_POINT(rad_q32, 0.0625)));
+}
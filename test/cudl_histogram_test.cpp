@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#define CUDL_PREFIX hitest_
+#include <cudl_histogram.h>
+
+CUDL_ADD_UNIT(ns, uint64_t)
+CUDL_ADD_UNIT(us, uint64_t)
+CUDL_ADD_UNIT(ticks, int32_t)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(ns, us, 1, 1000)
+CUDL_ADD_HISTOGRAM(ns, 8)
+CUDL_ADD_EXPLICIT_HISTOGRAM(ticks, coarse_ticks, 3)
+
+static_assert(sizeof(hitest_ns_histogram_t) == 58 * 128 * sizeof(uint64_t), "Buckets of 64 bits values");
+
+TEST(test_cudl_histogram, whenRecordingSmallValues_percentilesAreExact)
+{
+    std::unique_ptr<hitest_ns_histogram_t> histogram(new hitest_ns_histogram_t);
+    hitest_ns_histogram_init(histogram.get());
+    ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), 50)), 0u);
+    for (uint64_t i = 0; i < 256; ++i) { hitest_ns_histogram_record(histogram.get(), hitest_ns(i)); }
+
+    ASSERT_EQ(hitest_ns_histogram_count(histogram.get()), 256u);
+    ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), 0)), 0u);
+    ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), 50)), 127u);
+    ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), 99)), 253u);
+    ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), 100)), 255u);
+    ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), 150)), 255u);
+}
+
+TEST(test_cudl_histogram, whenRecordingLargeValues_percentilesAreWithinThePrecision)
+{
+    std::unique_ptr<hitest_ns_histogram_t> histogram(new hitest_ns_histogram_t);
+    hitest_ns_histogram_init(histogram.get());
+    std::mt19937_64 random(42);
+    std::lognormal_distribution<double> latency(10, 2);
+    std::vector<hitest_ns_t> values(100000);
+    for (hitest_ns_t &value : values) { value = hitest_ns((uint64_t) latency(random)); }
+    hitest_ns_histogram_record_n(histogram.get(), values.data(), values.size());
+    std::sort(values.begin(), values.end(), [](hitest_ns_t lhs, hitest_ns_t rhs) { return lhs.value < rhs.value; });
+
+    const double percentiles[] = {10, 50, 90, 99, 99.9, 99.99};
+    hitest_ns_t results[6];
+    hitest_ns_histogram_percentiles(histogram.get(), percentiles, results, 6);
+    for (size_t i = 0; i < 6; ++i) {
+        const double rank = percentiles[i] / 100 * (double) values.size();// e.g. 99990.00000000001 for p99.99
+        const uint64_t exact = CUDL_GET(values[(size_t) std::ceil(rank - rank * 1e-12) - 1]);
+        ASSERT_GE(CUDL_GET(results[i]), exact);
+        ASSERT_LE(CUDL_GET(results[i]), exact + exact / 128);
+        ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), percentiles[i])), CUDL_GET(results[i]));
+    }
+}
+
+TEST(test_cudl_histogram, whenRecordingFewValues_percentilesAreNeverBelowTheNearestRank)
+{
+    std::unique_ptr<hitest_ns_histogram_t> histogram(new hitest_ns_histogram_t);
+    for (uint64_t count = 1; count <= 200; ++count) {
+        hitest_ns_histogram_init(histogram.get());
+        for (uint64_t value = 1; value <= count; ++value) {
+            hitest_ns_histogram_record(histogram.get(), hitest_ns(value));
+        }
+        for (unsigned percentile = 1; percentile <= 100; ++percentile) {
+            // The values 1 to count are exact, so the nearest rank percentile is its rank, the smallest value
+            // covering at least percentile % of them
+            uint64_t rank = 1;
+            while (rank * 100 < percentile * count) { ++rank; }
+            ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), percentile)), rank)
+                    << "p" << percentile << " of " << count << " values";
+        }
+    }
+    hitest_ns_histogram_init(histogram.get());
+    for (uint64_t value = 1; value <= 100; ++value) { hitest_ns_histogram_record(histogram.get(), hitest_ns(value)); }
+    ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), 99)), 99u);
+    ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), 99.9)), 100u);
+}
+
+TEST(test_cudl_histogram, whenRecordingTheExtremes_theyAreInTheFirstAndLastBuckets)
+{
+    std::unique_ptr<hitest_ns_histogram_t> histogram(new hitest_ns_histogram_t);
+    hitest_ns_histogram_init(histogram.get());
+    hitest_ns_histogram_record(histogram.get(), hitest_ns(UINT64_MAX));
+    ASSERT_EQ(histogram->counts[sizeof(histogram->counts) / sizeof(histogram->counts[0]) - 1], 1u);
+    ASSERT_EQ(CUDL_GET(hitest_ns_histogram_percentile(histogram.get(), 50)), UINT64_MAX);
+
+    hitest_coarse_ticks_t ticks;
+    hitest_coarse_ticks_init(&ticks);
+    hitest_coarse_ticks_record(&ticks, hitest_ticks(-5));// Negative values are counted as 0
+    hitest_coarse_ticks_record(&ticks, hitest_ticks(INT32_MAX));
+    ASSERT_EQ(ticks.counts[0], 1u);
+    ASSERT_EQ(CUDL_GET(hitest_coarse_ticks_percentile(&ticks, 50)), 0);
+    ASSERT_EQ(CUDL_GET(hitest_coarse_ticks_percentile(&ticks, 100)), INT32_MAX);
+    // With 3 bits of precision, the values from 8 are in buckets a quarter of their power of two wide
+    hitest_coarse_ticks_record(&ticks, hitest_ticks(1000));
+    ASSERT_EQ(CUDL_GET(hitest_coarse_ticks_percentile(&ticks, 60)), 1023);
+}
+
+TEST(test_cudl_histogram, whenMergingPerThreadHistograms_countsAreTheSameAsASingleOne)
+{
+    const size_t threads = 4;
+    std::vector<std::unique_ptr<hitest_ns_histogram_t>> histograms;
+    for (size_t t = 0; t <= threads; ++t) {
+        histograms.emplace_back(new hitest_ns_histogram_t);
+        hitest_ns_histogram_init(histograms.back().get());
+    }
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&histograms, t] {
+            for (uint64_t i = 0; i < 100000; ++i) {
+                hitest_ns_histogram_record(histograms[t].get(), hitest_ns(i * (t + 1) * 7919));
+            }
+        });
+    }
+    for (std::thread &worker : workers) { worker.join(); }
+    hitest_ns_histogram_t *merged = histograms[threads].get();
+    for (size_t t = 0; t < threads; ++t) { hitest_ns_histogram_merge(merged, histograms[t].get()); }
+
+    std::unique_ptr<hitest_ns_histogram_t> single(new hitest_ns_histogram_t);
+    hitest_ns_histogram_init(single.get());
+    for (size_t t = 0; t < threads; ++t) {
+        for (uint64_t i = 0; i < 100000; ++i) {
+            hitest_ns_histogram_record(single.get(), hitest_ns(i * (t + 1) * 7919));
+        }
+    }
+    ASSERT_EQ(hitest_ns_histogram_count(merged), 400000u);
+    ASSERT_EQ(memcmp(merged->counts, single->counts, sizeof(single->counts)), 0);
+}
+
+TEST(test_cudl_histogram, whenConvertingPercentiles_theUnitConversionsApply)
+{
+    std::unique_ptr<hitest_ns_histogram_t> histogram(new hitest_ns_histogram_t);
+    hitest_ns_histogram_init(histogram.get());
+    for (uint64_t i = 1; i <= 100; ++i) { hitest_ns_histogram_record(histogram.get(), hitest_ns(i * 10000)); }
+
+    const hitest_us_t p99 = hitest_from_ns_to_us(hitest_ns_histogram_percentile(histogram.get(), 99));
+    ASSERT_GE(CUDL_GET(p99), 990u);
+    ASSERT_LE(CUDL_GET(p99), 990u + 990u / 128);
+}
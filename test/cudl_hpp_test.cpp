@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#define CUDL_PREFIX hpptest_
+#include <cudl.hpp>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_INTEGER_OPERATORS(mv, int16_t)
+CUDL_ADD_INTEGER_ARRAY_OPERATORS(mv, int16_t)
+CUDL_ADD_UNIT(uv, int32_t)
+CUDL_ADD_UNIT(v, float)
+CUDL_ADD_COMMON_OPERATORS(v, float)
+CUDL_ADD_UNIT(count, uint32_t)
+CUDL_ADD_UNIT(celsius, double)
+CUDL_ADD_UNIT(fahrenheit, double)
+CUDL_ADD_UNIT(adc, uint16_t)
+
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(mv, v, 1, 1000)
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(mv, uv, 1000, 1)
+CUDL_ADD_AFFINE_CONVERSION(celsius, fahrenheit, 9, 5, 32)
+CUDL_ADD_AFFINE_CONVERSION(adc, mv, 3300, 4096, -5)
+
+CUDL_ADD_LITERAL(mv, _mV)
+CUDL_ADD_LITERAL(v, _V)
+CUDL_ADD_LITERAL(count, _counts)
+CUDL_ADD_LITERAL(celsius, _degC)
+
+// The C++ operators and literals work on the C structs themselves, so they keep the layout of their storage
+static_assert(std::is_standard_layout<hpptest_mv_t>::value && std::is_trivially_copyable<hpptest_mv_t>::value,
+              "Units must stay C structs");
+static_assert(sizeof(hpptest_v_t) == sizeof(float) && alignof(hpptest_v_t) == alignof(float), "Same layout as float");
+static_assert(offsetof(hpptest_celsius_t, value) == 0, "The value is the only member");
+static_assert(std::is_same<cudl::storage_t<hpptest_mv_t>, int16_t>::value, "Storage of a unit");
+static_assert(cudl::is_unit<hpptest_count_t>::value && !cudl::is_unit<int>::value, "Only units are units");
+static_assert(cudl::is_integer_unit<hpptest_adc_t>::value && !cudl::is_integer_unit<hpptest_v_t>::value,
+              "Integer units");
+
+// Literals
+static_assert(CUDL_GET(3300_mV) == 3300, "Decimal literal");
+static_assert(CUDL_GET(0x7FFF_mV) == 32767 && CUDL_GET(0b101_mV) == 5 && CUDL_GET(017_mV) == 15, "Other bases");
+static_assert(CUDL_GET(4'000'000'000_counts) == 4000000000u, "Digit separators");
+static_assert(CUDL_GET(-5_mV) == -5, "Negative literal");
+static_assert(CUDL_GET(3.3_V) == 3.3f && CUDL_GET(2_V) == 2.0f, "Float literals");
+static_assert(CUDL_GET(1e3_mV) == 1000, "Whole floating literal of an integer unit");
+
+// The C functions are constexpr
+static_assert(CUDL_GET(hpptest_mv(12)) == 12, "Init function");
+static_assert(hpptest_mv_gt(hpptest_mv_add(1_mV, 2_mV), 2_mV), "C ops");
+static_assert(CUDL_GET(hpptest_mv_bnot(0_mV)) == -1, "C bitwise not");
+static_assert(CUDL_GET(hpptest_from_mv_to_v(3300_mV)) == 3.0f, "Fraction conversion");
+static_assert(CUDL_GET(hpptest_from_mv_to_uv(-3300_mV)) == -3300000, "Reduced conversion");
+static_assert(CUDL_GET(hpptest_from_celsius_to_fahrenheit(100_degC)) == 212.0, "Affine float conversion");
+static_assert(CUDL_GET(hpptest_from_adc_to_mv(hpptest_adc(4095))) == 3294, "Affine integer conversion");
+
+// C++ operators
+static_assert(CUDL_GET(1000_mV + 300_mV - 100_mV) == 1200, "Add and sub");
+static_assert(CUDL_GET(300_mV * 2) == 600 && CUDL_GET(2 * 300_mV) == 600 && CUDL_GET(301_mV / 2) == 150, "Scaling");
+static_assert(3300_mV / 1100_mV == 3, "Ratio of two values");
+static_assert(CUDL_GET(7_mV % 4) == 3 && CUDL_GET(6_mV & 3) == 2 && CUDL_GET(1_mV << 4) == 16, "Integer ops");
+static_assert(CUDL_GET(~0_counts) == UINT32_MAX && CUDL_GET(+5_mV) == 5, "Unary ops");
+static_assert(1_mV < 2_mV && 2_mV <= 2_mV && 3_mV > 2_mV && 3_mV >= 3_mV && 1_mV != 2_mV && 4_mV == 4_mV,
+              "Relational ops");
+static_assert(CUDL_GET(1.5_V * 2.0f) == 3.0f && 1.5_V < 2_V, "Float ops");
+
+constexpr hpptest_mv_t accumulate() {
+    hpptest_mv_t total = 0_mV;
+    for (int i = 1; i <= 4; ++i) { total += cudl::make<hpptest_mv_t>((int16_t) i); }
+    total *= 10;
+    total -= 50_mV;
+    return total;
+}
+static_assert(CUDL_GET(accumulate()) == 50, "Compound assignments");
+
+struct volt_table {
+    hpptest_v_t volts[4];
+};
+
+constexpr volt_table make_volt_table() {
+    volt_table table{};
+    const hpptest_mv_t millivolts[4] = {0_mV, 1000_mV, 2000_mV, 3000_mV};
+    hpptest_from_mv_to_v_n(table.volts, millivolts, 4);
+    return table;
+}
+
+// A conversion table built by the array version of the conversion and folded at compile time
+constexpr volt_table volts = make_volt_table();
+static_assert(CUDL_GET(volts.volts[0]) == 0.0f && CUDL_GET(volts.volts[3]) == 3.0f, "Compile time table");
+
+TEST(test_cudl_hpp, whenMixingCAndCpp_valuesArePassedWithoutCopy)
+{
+    alignas(CUDL_ARRAY_ALIGNMENT) hpptest_mv_t lhs[64];
+    alignas(CUDL_ARRAY_ALIGNMENT) hpptest_mv_t rhs[64];
+    alignas(CUDL_ARRAY_ALIGNMENT) hpptest_mv_t sum[64];
+    for (int16_t i = 0; i < 64; ++i) {
+        lhs[i] = cudl::make<hpptest_mv_t>(i) * 2;
+        rhs[i] = 100_mV - lhs[i];
+    }
+    hpptest_mv_add_n_aligned(sum, lhs, rhs, 64);
+    for (const hpptest_mv_t &value : sum) { ASSERT_EQ(value, 100_mV); }
+    ASSERT_EQ(volts.volts[2], 2_V);
+}
+
+TEST(test_cudl_hpp, whenEvaluatingAtRunTime_resultsMatchTheCFunctions)
+{
+    volatile int16_t raw = 1234;
+    const hpptest_mv_t value = hpptest_mv(raw);
+    ASSERT_EQ(value + value, hpptest_mv_add(value, value));
+    ASSERT_EQ(value * 3, hpptest_mv_mul(value, 3));
+    ASSERT_EQ(value >> 2, hpptest_mv_bsr(value, 2));
+    ASSERT_EQ(-value, hpptest_mv_sub(0_mV, value));
+    ASSERT_EQ(CUDL_GET(hpptest_from_mv_to_uv(value)), 1234000);
+}
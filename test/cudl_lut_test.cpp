@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#define CUDL_PREFIX ltest_
+#include <cudl_lut.h>
+
+#define LTEST_SQUARE(_x) ((_x) * (_x))
+#define LTEST_ADC_TO_MV(_x) ((int16_t) ((_x) < 2048 ? (_x) * 2 : 4096 - ((_x) - 2048)))
+
+CUDL_ADD_UNIT(ratio, double)
+CUDL_ADD_UNIT(power, double)
+CUDL_ADD_UNIT(adc, uint16_t)
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_UNIT(gain, float)
+
+static const double square_table[17] = CUDL_LUT_TABLE(16, LTEST_SQUARE, 0, 4);
+static const int16_t adc_table[5] = CUDL_LUT_TABLE(4, LTEST_ADC_TO_MV, 0, 4096);
+static const float adc_gain_table[4] = {0.0f, 1.0f, 4.0f, 9.0f};
+static const int16_t ratio_mv_table[3] = {0, 100, -100};
+
+CUDL_ADD_LUT_CONVERSION(ratio, power, square_table, 17, 0, 4)
+CUDL_ADD_LUT_CONVERSION(adc, mv, adc_table, 5, 0, 4096)
+CUDL_ADD_LUT_CONVERSION(adc, gain, adc_gain_table, 4, 1000, 4000)
+CUDL_ADD_EXPLICIT_LUT_CONVERSION(ratio, mv, signed_from_ratio_to_, ratio_mv_table, 3, -1.0, 1.0)
+
+TEST(test_cudl_lut, whenGeneratingATable_entriesAreTheFunctionOfUniformlySpacedAbscissas)
+{
+    for (int i = 0; i <= 16; ++i) { ASSERT_DOUBLE_EQ(square_table[i], (i / 4.0) * (i / 4.0)); }
+    ASSERT_EQ(adc_table[0], 0);
+    ASSERT_EQ(adc_table[1], 2048);
+    ASSERT_EQ(adc_table[2], 4096);
+    ASSERT_EQ(adc_table[3], 3072);
+    ASSERT_EQ(adc_table[4], 2048);
+}
+
+TEST(test_cudl_lut, whenConvertingAnAbscissaOfTheTable_resultIsTheTableEntry)
+{
+    for (int i = 0; i <= 16; ++i) {
+        ASSERT_DOUBLE_EQ(CUDL_GET(ltest_from_ratio_to_power(ltest_ratio(i / 4.0))), square_table[i]);
+    }
+    ASSERT_EQ(CUDL_GET(ltest_from_adc_to_mv(ltest_adc(3072))), 3072);
+    ASSERT_FLOAT_EQ(CUDL_GET(ltest_from_adc_to_gain(ltest_adc(3000))), 4.0f);
+}
+
+TEST(test_cudl_lut, whenConvertingBetweenTwoEntries_resultIsLinearlyInterpolated)
+{
+    ASSERT_DOUBLE_EQ(CUDL_GET(ltest_from_ratio_to_power(ltest_ratio(0.375))), (0.0625 + 0.25) / 2);
+    ASSERT_NEAR(CUDL_GET(ltest_from_ratio_to_power(ltest_ratio(3.9))), 14.0625 + 0.6 * (16.0 - 14.0625), 1e-12);
+    ASSERT_EQ(CUDL_GET(ltest_from_adc_to_mv(ltest_adc(512))), 1024);
+    ASSERT_EQ(CUDL_GET(ltest_from_adc_to_mv(ltest_adc(2560))), 3584);
+    ASSERT_NEAR(CUDL_GET(ltest_from_adc_to_gain(ltest_adc(1500))), 0.5f, 1e-6f);
+    ASSERT_NEAR(CUDL_GET(ltest_from_adc_to_gain(ltest_adc(3999))), 9.0f - 5.0f / 1000, 1e-5f);
+}
+
+TEST(test_cudl_lut, whenConvertingToAnIntegerUnit_resultIsRoundedToNearest)
+{
+    ASSERT_EQ(CUDL_GET(ltest_from_adc_to_mv(ltest_adc(1))), 2);
+    ASSERT_EQ(CUDL_GET(ltest_from_adc_to_mv(ltest_adc(2049))), 4095);
+    ASSERT_EQ(CUDL_GET(ltest_signed_from_ratio_to_mv(ltest_ratio(-0.504))), 50);
+    ASSERT_EQ(CUDL_GET(ltest_signed_from_ratio_to_mv(ltest_ratio(0.254))), 49);
+    ASSERT_EQ(CUDL_GET(ltest_signed_from_ratio_to_mv(ltest_ratio(0.996))), -99);
+}
+
+TEST(test_cudl_lut, whenConvertingOutsideTheTable_resultIsClampedToTheBounds)
+{
+    ASSERT_DOUBLE_EQ(CUDL_GET(ltest_from_ratio_to_power(ltest_ratio(-3.0))), 0.0);
+    ASSERT_DOUBLE_EQ(CUDL_GET(ltest_from_ratio_to_power(ltest_ratio(1e300))), 16.0);
+    ASSERT_DOUBLE_EQ(CUDL_GET(ltest_from_ratio_to_power(ltest_ratio(std::numeric_limits<double>::quiet_NaN()))), 0.0);
+    ASSERT_FLOAT_EQ(CUDL_GET(ltest_from_adc_to_gain(ltest_adc(0))), 0.0f);
+    ASSERT_FLOAT_EQ(CUDL_GET(ltest_from_adc_to_gain(ltest_adc(65535))), 9.0f);
+    ASSERT_EQ(CUDL_GET(ltest_from_adc_to_mv(ltest_adc(65535))), 2048);
+}
+
+TEST(test_cudl_lut, whenConvertingAnArray_resultsAreTheScalarConversions)
+{
+    std::vector<ltest_adc_t> readings;
+    for (uint32_t i = 0; i < 5000; i += 7) { readings.push_back(ltest_adc((uint16_t) i)); }
+    std::vector<ltest_gain_t> gains(readings.size());
+    std::vector<ltest_mv_t> mvolts(readings.size());
+    ltest_from_adc_to_gain_n(gains.data(), readings.data(), readings.size());
+    ltest_from_adc_to_mv_n(mvolts.data(), readings.data(), readings.size());
+    for (size_t i = 0; i < readings.size(); ++i) {
+        ASSERT_EQ(CUDL_GET(gains[i]), CUDL_GET(ltest_from_adc_to_gain(readings[i])));
+        ASSERT_EQ(CUDL_GET(mvolts[i]), CUDL_GET(ltest_from_adc_to_mv(readings[i])));
+    }
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#define CUDL_PREFIX patest_
+#define CUDL_PARALLEL_IMPLEMENTATION
+#include <cudl_parallel.h>
+
+CUDL_ADD_UNIT(adc, uint16_t)
+CUDL_ADD_UNIT(mv, int32_t)
+CUDL_ADD_INTEGER_ARRAY_OPERATORS(mv, int32_t)
+CUDL_ADD_SATURATING_OPERATORS(mv, int32_t)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int32_t, int64_t)
+CUDL_ADD_UNIT(v, float)
+CUDL_ADD_FLOAT_REDUCTION_OPERATORS(v, float)
+CUDL_ADD_AFFINE_CONVERSION(adc, mv, 3300, 4096, -5)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(mv, v, 1, 1000)
+
+CUDL_ADD_PARALLEL_CONVERSION(adc, mv)
+CUDL_ADD_PARALLEL_CONVERSION(mv, v)
+CUDL_ADD_PARALLEL_COMMON_ARRAY_OPERATORS(mv, int32_t)
+CUDL_ADD_PARALLEL_ARRAY_OP(mv, _sat_add)
+CUDL_ADD_PARALLEL_REDUCTION_OPERATORS(mv, int64_t)
+CUDL_ADD_PARALLEL_REDUCTION_OPERATORS(v, float)
+
+static void patest_decode_n(patest_adc_t *dst, const uint16_t *src, size_t n) {
+    for (size_t i = 0; i < n; ++i) { dst[i] = patest_adc((uint16_t) (src[i] & 0x0fff)); }
+}
+
+static void patest_clamp_n(patest_mv_t *dst, const patest_mv_t *src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = patest_mv(src[i].value < 0 ? 0 : src[i].value > 3000 ? 3000 : src[i].value);
+    }
+}
+
+#define PATEST_ADD(_lhs, _rhs) ((_lhs) + (_rhs))
+
+static patest_mv_t patest_mv_max_pair(patest_mv_t lhs, patest_mv_t rhs) { return lhs.value < rhs.value ? rhs : lhs; }
+
+CUDL_ADD_PARALLEL_CHAIN(decode_to_mv, uint16_t, patest_mv_t, (patest_decode_n, patest_adc_t),
+                        (patest_from_adc_to_mv_n, patest_mv_t), (patest_clamp_n, patest_mv_t))
+CUDL_ADD_PARALLEL_REDUCE_CHAIN(decoded_mv_sum, uint16_t, int64_t, patest_mv_sum_n, PATEST_ADD,
+                               (patest_decode_n, patest_adc_t), (patest_from_adc_to_mv_n, patest_mv_t),
+                               (patest_clamp_n, patest_mv_t))
+CUDL_ADD_PARALLEL_REDUCE_CHAIN(raw_max, patest_mv_t, patest_mv_t, patest_mv_max_n, patest_mv_max_pair,
+                               (patest_mv_bnot_n, patest_mv_t))
+
+struct coverage {
+    std::vector<std::atomic<int>> hits;
+    explicit coverage(size_t n) : hits(n) {}
+};
+
+static void cover(void *context, size_t begin, size_t end, size_t worker) {
+    (void) worker;
+    coverage *covered = static_cast<coverage *>(context);
+    for (size_t i = begin; i < end; ++i) { covered->hits[i].fetch_add(1); }
+}
+
+TEST(test_cudl_parallel, whenRunningOnAPool_everyElementIsProcessedOnce)
+{
+    for (size_t threads : {1, 2, 3, 8}) {
+        cudl_pool_t *pool = cudl_pool_create(threads);
+        ASSERT_NE(pool, nullptr);
+        ASSERT_EQ(cudl_pool_size(pool), threads);
+        for (size_t n : {0, 1, 63, 64, 65, 1000, 100003}) {
+            for (size_t chunk : {0, 1, 7, 64, 100000}) {
+                coverage covered(n);
+                cudl_pool_for(pool, n, chunk, cover, &covered);
+                for (size_t i = 0; i < n; ++i) { ASSERT_EQ(covered.hits[i].load(), 1) << threads << " " << n; }
+            }
+        }
+        cudl_pool_destroy(pool);
+    }
+    coverage covered(1000);
+    cudl_pool_for(NULL, 1000, 64, cover, &covered);
+    for (size_t i = 0; i < 1000; ++i) { ASSERT_EQ(covered.hits[i].load(), 1); }
+    ASSERT_EQ(cudl_pool_size(NULL), 1u);
+}
+
+struct ownership {
+    std::vector<size_t> workers;
+};
+
+static void record_worker(void *context, size_t begin, size_t end, size_t worker) {
+    ownership *owned = static_cast<ownership *>(context);
+    // The chunks run by the calling thread are slow, the other workers have to steal them
+    if (worker == 0) { std::this_thread::sleep_for(std::chrono::milliseconds(2)); }
+    for (size_t i = begin; i < end; ++i) { owned->workers[i] = worker; }
+}
+
+TEST(test_cudl_parallel, whenAWorkerIsSlow_itsChunksAreStolen)
+{
+    cudl_pool_t *pool = cudl_pool_create(4);
+    ASSERT_NE(pool, nullptr);
+    ownership owned;
+    owned.workers.resize(64);
+    cudl_pool_for(pool, 64, 1, record_worker, &owned);
+    // The calling thread starts with the chunks 0 to 15
+    size_t stolen = 0;
+    for (size_t i = 0; i < 16; ++i) { stolen += owned.workers[i] != 0; }
+    ASSERT_GT(stolen, 0u);
+    for (size_t i = 0; i < 64; ++i) { ASSERT_LT(owned.workers[i], 4u); }
+    cudl_pool_destroy(pool);
+}
+
+static void nested(void *context, size_t begin, size_t end, size_t worker) {
+    (void) worker;
+    cudl_pool_t *pool = static_cast<cudl_pool_t *>(context);
+    for (size_t i = begin; i < end; ++i) {
+        coverage covered(100);
+        cudl_pool_for(pool, 100, 10, cover, &covered);
+        for (size_t j = 0; j < 100; ++j) { ASSERT_EQ(covered.hits[j].load(), 1); }
+    }
+}
+
+TEST(test_cudl_parallel, whenCalledFromATask_theCallRunsOnTheCallingThread)
+{
+    cudl_pool_t *pool = cudl_pool_create(3);
+    ASSERT_NE(pool, nullptr);
+    cudl_pool_for(pool, 30, 1, nested, pool);
+    std::thread other([pool] {
+        coverage covered(5000);
+        cudl_pool_for(pool, 5000, 64, cover, &covered);
+        for (size_t i = 0; i < 5000; ++i) { ASSERT_EQ(covered.hits[i].load(), 1); }
+    });
+    coverage covered(5000);
+    cudl_pool_for(pool, 5000, 64, cover, &covered);
+    other.join();
+    for (size_t i = 0; i < 5000; ++i) { ASSERT_EQ(covered.hits[i].load(), 1); }
+    cudl_pool_destroy(pool);
+}
+
+TEST(test_cudl_parallel, whenConvertingAndOperatingInParallel_resultsMatchTheArrayFunctions)
+{
+    const size_t n = 300001;
+    std::vector<patest_adc_t> codes(n);
+    std::vector<patest_mv_t> lhs(n), rhs(n), expected(n), actual(n);
+    std::vector<patest_v_t> expected_volts(n), volts(n);
+    std::unique_ptr<bool[]> expected_greater(new bool[n]), greater(new bool[n]);
+    for (size_t i = 0; i < n; ++i) {
+        codes[i] = patest_adc((uint16_t) (i * 7919 % 4096));
+        lhs[i] = patest_mv((int32_t) (i * 2654435761u));
+        rhs[i] = patest_mv((int32_t) (i * 40503u) - 1000000);
+    }
+    cudl_pool_t *pool = cudl_pool_create(4);
+    ASSERT_NE(pool, nullptr);
+
+    patest_from_adc_to_mv_n(expected.data(), codes.data(), n);
+    patest_from_adc_to_mv_n_parallel(pool, actual.data(), codes.data(), n);
+    ASSERT_EQ(memcmp(expected.data(), actual.data(), n * sizeof(patest_mv_t)), 0);
+    patest_from_mv_to_v_n(expected_volts.data(), lhs.data(), n);
+    patest_from_mv_to_v_n_parallel(pool, volts.data(), lhs.data(), n);
+    ASSERT_EQ(memcmp(expected_volts.data(), volts.data(), n * sizeof(patest_v_t)), 0);
+    patest_mv_sat_add_n(expected.data(), lhs.data(), rhs.data(), n);
+    patest_mv_sat_add_n_parallel(pool, actual.data(), lhs.data(), rhs.data(), n);
+    ASSERT_EQ(memcmp(expected.data(), actual.data(), n * sizeof(patest_mv_t)), 0);
+    // Arrays starting in the middle of a cache line
+    patest_mv_div_n(expected.data() + 1, lhs.data() + 3, 7, n - 3);
+    patest_mv_div_n_parallel(pool, actual.data() + 1, lhs.data() + 3, 7, n - 3);
+    ASSERT_EQ(memcmp(expected.data(), actual.data(), (n - 2) * sizeof(patest_mv_t)), 0);
+    patest_mv_gt_n(expected_greater.get(), lhs.data(), rhs.data(), n);
+    patest_mv_gt_n_parallel(pool, greater.get(), lhs.data(), rhs.data(), n);
+    ASSERT_EQ(memcmp(expected_greater.get(), greater.get(), n * sizeof(bool)), 0);
+    cudl_pool_destroy(pool);
+}
+
+TEST(test_cudl_parallel, whenReducingInParallel_resultsMatchTheReductions)
+{
+    const size_t n = 1000003;
+    std::vector<patest_mv_t> values(n);
+    std::vector<patest_v_t> volts(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = patest_mv((int32_t) (i * 2654435761u));
+        volts[i] = patest_v((float) (i % 1000) / 8 - 60);
+    }
+    cudl_pool_t *pool = cudl_pool_create(3);
+    ASSERT_NE(pool, nullptr);
+
+    ASSERT_EQ(patest_mv_sum_n_parallel(pool, values.data(), n), patest_mv_sum_n(values.data(), n));
+    ASSERT_EQ(patest_mv_sumsq_n_parallel(pool, values.data(), n), patest_mv_sumsq_n(values.data(), n));
+    ASSERT_EQ(patest_mv_dot_n_parallel(pool, values.data(), values.data() + 1, n - 1),
+              patest_mv_dot_n(values.data(), values.data() + 1, n - 1));
+    ASSERT_EQ(CUDL_GET(patest_mv_mean_n_parallel(pool, values.data(), n)),
+              CUDL_GET(patest_mv_mean_n(values.data(), n)));
+    ASSERT_EQ(CUDL_GET(patest_mv_min_n_parallel(pool, values.data(), n)), CUDL_GET(patest_mv_min_n(values.data(), n)));
+    ASSERT_EQ(CUDL_GET(patest_mv_max_n_parallel(pool, values.data(), n)), CUDL_GET(patest_mv_max_n(values.data(), n)));
+    ASSERT_EQ(patest_mv_sum_n_parallel(pool, values.data(), 0), 0);
+    ASSERT_EQ(CUDL_GET(patest_mv_mean_n_parallel(pool, values.data(), 0)), 0);
+    ASSERT_EQ(CUDL_GET(patest_mv_max_n_parallel(pool, values.data(), 0)), 0);
+    ASSERT_EQ(CUDL_GET(patest_v_min_n_parallel(pool, volts.data(), 0)), 0.0f);
+    ASSERT_NEAR(patest_v_sum_n_parallel(pool, volts.data(), n), patest_v_sum_n(volts.data(), n), 1.0);
+    volts[n / 2] = patest_v(-0.0f);
+    volts[n - 1] = patest_v(-1000.0f);
+    ASSERT_EQ(CUDL_GET(patest_v_min_n_parallel(pool, volts.data(), n)), -1000.0f);
+    ASSERT_EQ(CUDL_GET(patest_v_max_n_parallel(NULL, volts.data(), n)), CUDL_GET(patest_v_max_n(volts.data(), n)));
+    cudl_pool_destroy(pool);
+}
+
+TEST(test_cudl_parallel, whenRunningAChain_eachChunkGoesThroughAllTheStages)
+{
+    const size_t n = 200000;
+    std::vector<uint16_t> raw(n);
+    for (size_t i = 0; i < n; ++i) { raw[i] = (uint16_t) (i * 40503u); }
+    std::vector<patest_adc_t> codes(n);
+    std::vector<patest_mv_t> converted(n), expected(n), actual(n);
+    patest_decode_n(codes.data(), raw.data(), n);
+    patest_from_adc_to_mv_n(converted.data(), codes.data(), n);
+    patest_clamp_n(expected.data(), converted.data(), n);
+
+    cudl_pool_t *pool = cudl_pool_create(4);
+    ASSERT_NE(pool, nullptr);
+    for (cudl_pool_t *used : {pool, (cudl_pool_t *) NULL}) {
+        std::fill(actual.begin(), actual.end(), patest_mv(-1));
+        patest_decode_to_mv(used, actual.data(), raw.data(), n);
+        ASSERT_EQ(memcmp(expected.data(), actual.data(), n * sizeof(patest_mv_t)), 0);
+        ASSERT_EQ(patest_decoded_mv_sum(used, raw.data(), n), patest_mv_sum_n(expected.data(), n));
+    }
+    ASSERT_EQ(patest_decoded_mv_sum(pool, raw.data(), 0), 0);
+    patest_mv_bnot_n(actual.data(), expected.data(), n);
+    ASSERT_EQ(CUDL_GET(patest_raw_max(pool, expected.data(), n)), CUDL_GET(patest_mv_max_n(actual.data(), n)));
+    cudl_pool_destroy(pool);
+}
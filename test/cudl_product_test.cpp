@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+
+#define CUDL_PREFIX ptest_
+#include <cudl.h>
+
+CUDL_ADD_UNIT(v, double)
+CUDL_ADD_UNIT(a, double)
+CUDL_ADD_UNIT(w, double)
+CUDL_ADD_UNIT(s, double)
+CUDL_ADD_UNIT(j, double)
+
+CUDL_ADD_PRODUCT_OP(v, a, w, _mul_a)
+CUDL_ADD_QUOTIENT_OP(w, a, v, _div_a)
+CUDL_ADD_FUSED_PRODUCT_OP(w, s, j, _mul_s_add)
+
+CUDL_ADD_UNIT(wf, float)
+CUDL_ADD_UNIT(sf, float)
+CUDL_ADD_UNIT(jf, float)
+
+CUDL_ADD_FUSED_PRODUCT_OP(wf, sf, jf, _mul_sf_add)
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_UNIT(ma, int16_t)
+CUDL_ADD_UNIT(uw, int32_t)
+CUDL_ADD_UNIT(mw, int32_t)
+CUDL_ADD_UNIT(m, int32_t)
+CUDL_ADD_UNIT(ms, int32_t)
+CUDL_ADD_UNIT(mps, int32_t)
+
+CUDL_ADD_PRODUCT_OP(mv, ma, uw, _mul_ma)
+CUDL_ADD_WIDENED_PRODUCT_OP(mv, ma, mw, _mul_ma_to_mw, int64_t, 1, 1000)
+CUDL_ADD_WIDENED_QUOTIENT_OP(m, ms, mps, _div_ms, int64_t, 1000, 1)
+CUDL_ADD_FUSED_PRODUCT_OP(mv, ma, uw, _mul_ma_add)
+
+TEST(test_cudl_product, whenMultiplyingVoltsByAmperes_resultIsInWatts)
+{
+    ptest_w_t watts = ptest_v_mul_a(ptest_v(12.0), ptest_a(0.5));
+    ASSERT_DOUBLE_EQ(CUDL_GET(watts), 6.0);
+}
+
+TEST(test_cudl_product, whenDividingWattsByAmperes_resultIsInVolts)
+{
+    ptest_v_t volts = ptest_w_div_a(ptest_w(6.0), ptest_a(2.0));
+    ASSERT_DOUBLE_EQ(CUDL_GET(volts), 3.0);
+}
+
+TEST(test_cudl_product, whenMultiplyingSmallIntegers_productIsComputedInTheResultType)
+{
+    // 30000 * 30000 overflows int16_t, but not the int32_t storage of the result.
+    ptest_uw_t uwatts = ptest_mv_mul_ma(ptest_mv(30000), ptest_ma(30000));
+    ASSERT_EQ(CUDL_GET(uwatts), 900000000);
+}
+
+TEST(test_cudl_product, whenUsingWidenedProduct_resultIsScaled)
+{
+    ptest_mw_t mwatts = ptest_mv_mul_ma_to_mw(ptest_mv(3300), ptest_ma(-2000));
+    ASSERT_EQ(CUDL_GET(mwatts), -6600);
+}
+
+TEST(test_cudl_product, whenUsingWidenedQuotient_resultIsScaled)
+{
+    // 2000000000 * 1000 does not fit on 32 bits, the intermediate is on 64 bits.
+    ptest_mps_t speed = ptest_m_div_ms(ptest_m(2000000000), ptest_ms(4000000));
+    ASSERT_EQ(CUDL_GET(speed), 500000);
+}
+
+TEST(test_cudl_product, whenUsingFusedProduct_resultIsProductPlusAddend)
+{
+    ptest_j_t joules = ptest_w_mul_s_add(ptest_w(6.0), ptest_s(10.0), ptest_j(1.5));
+    ASSERT_DOUBLE_EQ(CUDL_GET(joules), 61.5);
+    ptest_jf_t fjoules = ptest_wf_mul_sf_add(ptest_wf(6.0f), ptest_sf(10.0f), ptest_jf(1.5f));
+    ASSERT_FLOAT_EQ(CUDL_GET(fjoules), 61.5f);
+    ptest_uw_t uwatts = ptest_mv_mul_ma_add(ptest_mv(1000), ptest_ma(1000), ptest_uw(5));
+    ASSERT_EQ(CUDL_GET(uwatts), 1000005);
+}
+
+TEST(test_cudl_product, whenUsingArrayVersions_everyElementIsComputed)
+{
+    ptest_v_t volts[5];
+    ptest_a_t amps[5];
+    ptest_w_t watts[5];
+    ptest_s_t seconds[5];
+    ptest_j_t joules[5];
+    ptest_mv_t mvolts[5];
+    ptest_ma_t mamps[5];
+    ptest_mw_t mwatts[5];
+    for (int i = 0; i < 5; ++i) {
+        volts[i] = ptest_v(i);
+        amps[i] = ptest_a(2.0);
+        seconds[i] = ptest_s(0.5);
+        joules[i] = ptest_j(1.0);
+        mvolts[i] = ptest_mv(static_cast<int16_t>(i * 1000));
+        mamps[i] = ptest_ma(static_cast<int16_t>(-500));
+    }
+
+    ptest_v_mul_a_n(watts, volts, amps, 5);
+    ptest_w_div_a_n(volts, watts, amps, 5);
+    ptest_mv_mul_ma_to_mw_n(mwatts, mvolts, mamps, 5);
+    // In place accumulation: joules[i] += watts[i] * seconds[i].
+    ptest_w_mul_s_add_n(joules, watts, seconds, joules, 5);
+    ptest_w_mul_s_add_n(joules, watts, seconds, joules, 5);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_DOUBLE_EQ(CUDL_GET(watts[i]), i * 2.0);
+        ASSERT_DOUBLE_EQ(CUDL_GET(volts[i]), i);
+        ASSERT_EQ(CUDL_GET(mwatts[i]), i * -500);
+        ASSERT_DOUBLE_EQ(CUDL_GET(joules[i]), 1.0 + i * 2.0);
+    }
+}
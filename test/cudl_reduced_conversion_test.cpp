@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <cudl.h>
+#include <cstdint>
+
+CUDL_ADD_UNIT(v, uint32_t)
+CUDL_ADD_UNIT(mv, uint32_t)
+
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(v, mv, 1000000, 1000)
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(mv, v, 1000, 1000000)
+
+CUDL_ADD_UNIT(count, uint32_t)
+CUDL_ADD_UNIT(scaled_count, uint32_t)
+CUDL_ADD_UNIT(kib, uint32_t)
+
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(count, scaled_count, 3000, 7000)
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(count, kib, 1024, 1048576)
+
+CUDL_ADD_UNIT(ticks, int64_t)
+CUDL_ADD_UNIT(scaled_ticks, int64_t)
+
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(ticks, scaled_ticks, 3, 7)
+
+CUDL_ADD_UNIT(small, uint8_t)
+CUDL_ADD_UNIT(tiny, uint8_t)
+
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(small, tiny, 1, 1000)
+
+TEST(cudl_reduced_conversion_test, whenUsingVolts_canConvertToMillivolts)
+{
+    cudl_v_t volts = cudl_v(10);
+    cudl_mv_t mvolts = cudl_from_v_to_mv(volts);
+    ASSERT_EQ(CUDL_GET(mvolts), 10000);
+}
+
+TEST(cudl_reduced_conversion_test, whenUsingMillivolts_canConvertToVolts)
+{
+    cudl_mv_t mvolts = cudl_mv(UINT32_MAX);
+    cudl_v_t volts = cudl_from_mv_to_v(mvolts);
+    ASSERT_EQ(CUDL_GET(volts), UINT32_MAX / 1000);
+}
+
+TEST(cudl_reduced_conversion_test, whenIntermediateProductOverflows_resultIsStillExact)
+{
+    cudl_count_t count = cudl_count(4000000000u);
+    cudl_scaled_count_t scaled = cudl_from_count_to_scaled_count(count);
+    ASSERT_EQ(CUDL_GET(scaled), 1714285714u);
+}
+
+TEST(cudl_reduced_conversion_test, whenFactorIsPowerOfTwo_resultIsExact)
+{
+    cudl_count_t count = cudl_count(UINT32_MAX);
+    cudl_kib_t kib = cudl_from_count_to_kib(count);
+    ASSERT_EQ(CUDL_GET(kib), UINT32_MAX / 1024);
+}
+
+TEST(cudl_reduced_conversion_test, when64BitsIntermediateOverflows_resultIsStillExact)
+{
+    cudl_ticks_t ticks = cudl_ticks(9223372036854775800LL);
+    cudl_scaled_ticks_t scaled = cudl_from_ticks_to_scaled_ticks(ticks);
+    ASSERT_EQ(CUDL_GET(scaled), 3952873730080618200LL);
+
+    ticks = cudl_ticks(-7000000000000000000LL);
+    scaled = cudl_from_ticks_to_scaled_ticks(ticks);
+    ASSERT_EQ(CUDL_GET(scaled), -3000000000000000000LL);
+}
+
+TEST(cudl_reduced_conversion_test, whenDenominatorDoesNotFitStorage_resultIsZero)
+{
+    cudl_small_t value = cudl_small(255);
+    cudl_tiny_t result = cudl_from_small_to_tiny(value);
+    ASSERT_EQ(CUDL_GET(result), 0);
+}
+
+TEST(cudl_reduced_conversion_test, arrayMatchesScalar)
+{
+    cudl_count_t counts[67];
+    cudl_scaled_count_t scaled[67];
+    cudl_mv_t mvolts[67];
+    cudl_v_t volts[67];
+    for (uint32_t i = 0; i < 67; ++i) {
+        counts[i] = cudl_count(UINT32_MAX - i * 64000031u);
+        mvolts[i] = cudl_mv(i * 64000031u);
+    }
+
+    cudl_from_count_to_scaled_count_n(scaled, counts, 67);
+    cudl_from_mv_to_v_n(volts, mvolts, 67);
+    for (size_t i = 0; i < 67; ++i) {
+        ASSERT_EQ(CUDL_GET(scaled[i]), CUDL_GET(cudl_from_count_to_scaled_count(counts[i])));
+        ASSERT_EQ(CUDL_GET(volts[i]), CUDL_GET(mvolts[i]) / 1000);
+    }
+}
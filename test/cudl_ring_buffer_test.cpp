@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#define CUDL_PREFIX rbtest_
+#include <cudl_ring_buffer.h>
+
+CUDL_ADD_UNIT(mv, int32_t)
+CUDL_ADD_RING_BUFFER(mv, 8)
+CUDL_ADD_EXPLICIT_RING_BUFFER(mv, mv_stream, 1024)
+
+static_assert(alignof(rbtest_mv_ring_buffer_t) == CUDL_CACHE_LINE_SIZE, "The buffer must be cache line aligned");
+static_assert(offsetof(rbtest_mv_ring_buffer_t, tail) - offsetof(rbtest_mv_ring_buffer_t, head) >= CUDL_CACHE_LINE_SIZE,
+              "The indexes must not share a cache line");
+
+TEST(test_cudl_ring_buffer, whenPushingUntilFull_valuesArePoppedInOrder)
+{
+    rbtest_mv_ring_buffer_t buffer;
+    rbtest_mv_ring_buffer_init(&buffer);
+    rbtest_mv_t value;
+    ASSERT_FALSE(rbtest_mv_ring_buffer_pop(&buffer, &value));
+    for (int32_t i = 0; i < 8; ++i) { ASSERT_TRUE(rbtest_mv_ring_buffer_push(&buffer, rbtest_mv(i))); }
+    ASSERT_FALSE(rbtest_mv_ring_buffer_push(&buffer, rbtest_mv(8)));
+    ASSERT_EQ(rbtest_mv_ring_buffer_size(&buffer), 8);
+    for (int32_t i = 0; i < 8; ++i) {
+        ASSERT_TRUE(rbtest_mv_ring_buffer_pop(&buffer, &value));
+        ASSERT_EQ(CUDL_GET(value), i);
+    }
+    ASSERT_FALSE(rbtest_mv_ring_buffer_pop(&buffer, &value));
+    ASSERT_EQ(rbtest_mv_ring_buffer_size(&buffer), 0);
+}
+
+TEST(test_cudl_ring_buffer, whenBulkCopyingAcrossTheEnd_valuesAreWrappedAround)
+{
+    rbtest_mv_ring_buffer_t buffer;
+    rbtest_mv_ring_buffer_init(&buffer);
+    rbtest_mv_t src[10];
+    rbtest_mv_t dst[10];
+    for (int32_t i = 0; i < 10; ++i) { src[i] = rbtest_mv(i); }
+
+    ASSERT_EQ(rbtest_mv_ring_buffer_push_n(&buffer, src, 5), 5);
+    ASSERT_EQ(rbtest_mv_ring_buffer_pop_n(&buffer, dst, 10), 5);
+    ASSERT_EQ(rbtest_mv_ring_buffer_push_n(&buffer, src, 10), 8);
+    ASSERT_EQ(rbtest_mv_ring_buffer_push_n(&buffer, src, 10), 0);
+    ASSERT_EQ(rbtest_mv_ring_buffer_pop_n(&buffer, dst, 3), 3);
+    ASSERT_EQ(rbtest_mv_ring_buffer_pop_n(&buffer, dst + 3, 10), 5);
+    for (int32_t i = 0; i < 8; ++i) { ASSERT_EQ(CUDL_GET(dst[i]), i); }
+    ASSERT_EQ(rbtest_mv_ring_buffer_pop_n(&buffer, dst, 10), 0);
+}
+
+TEST(test_cudl_ring_buffer, whenPeekingAndReserving_contiguousSpansAreAccessedInPlace)
+{
+    rbtest_mv_ring_buffer_t buffer;
+    rbtest_mv_ring_buffer_init(&buffer);
+    rbtest_mv_t *write_span;
+    const rbtest_mv_t *read_span;
+
+    ASSERT_EQ(rbtest_mv_ring_buffer_peek(&buffer, &read_span), 0);
+    ASSERT_EQ(rbtest_mv_ring_buffer_reserve(&buffer, &write_span), 8);
+    for (int32_t i = 0; i < 6; ++i) { write_span[i] = rbtest_mv(i); }
+    rbtest_mv_ring_buffer_commit(&buffer, 6);
+
+    ASSERT_EQ(rbtest_mv_ring_buffer_peek(&buffer, &read_span), 6);
+    ASSERT_EQ(CUDL_GET(read_span[5]), 5);
+    rbtest_mv_ring_buffer_consume(&buffer, 4);
+
+    // Only the 2 slots before the end of the storage are contiguous, the 4 freed ones follow after wrapping around
+    ASSERT_EQ(rbtest_mv_ring_buffer_reserve(&buffer, &write_span), 2);
+    write_span[0] = rbtest_mv(6);
+    write_span[1] = rbtest_mv(7);
+    rbtest_mv_ring_buffer_commit(&buffer, 2);
+    ASSERT_EQ(rbtest_mv_ring_buffer_reserve(&buffer, &write_span), 4);
+    write_span[0] = rbtest_mv(8);
+    rbtest_mv_ring_buffer_commit(&buffer, 1);
+
+    ASSERT_EQ(rbtest_mv_ring_buffer_peek(&buffer, &read_span), 4);
+    ASSERT_EQ(CUDL_GET(read_span[0]), 4);
+    ASSERT_EQ(CUDL_GET(read_span[3]), 7);
+    rbtest_mv_ring_buffer_consume(&buffer, 4);
+    ASSERT_EQ(rbtest_mv_ring_buffer_peek(&buffer, &read_span), 1);
+    ASSERT_EQ(CUDL_GET(read_span[0]), 8);
+}
+
+TEST(test_cudl_ring_buffer, whenProducerAndConsumerRunConcurrently_everyValueIsReceivedOnceInOrder)
+{
+    constexpr int32_t count = 1000000;
+    auto buffer = std::make_unique<rbtest_mv_stream_t>();
+    rbtest_mv_stream_init(buffer.get());
+
+    std::thread producer([&buffer]() {
+        rbtest_mv_t block[37];
+        int32_t next = 0;
+        while (next < count) {
+            if (next % 3 == 0) {
+                if (rbtest_mv_stream_push(buffer.get(), rbtest_mv(next))) { ++next; }
+            } else {
+                size_t n = 0;
+                for (; n < 37 && next + (int32_t) n < count; ++n) { block[n] = rbtest_mv(next + (int32_t) n); }
+                next += (int32_t) rbtest_mv_stream_push_n(buffer.get(), block, n);
+            }
+        }
+    });
+
+    std::vector<int32_t> received;
+    received.reserve(count);
+    rbtest_mv_t block[53];
+    while (received.size() < (size_t) count) {
+        if (received.size() % 2 == 0) {
+            const rbtest_mv_t *span;
+            size_t n = rbtest_mv_stream_peek(buffer.get(), &span);
+            for (size_t i = 0; i < n; ++i) { received.push_back(CUDL_GET(span[i])); }
+            rbtest_mv_stream_consume(buffer.get(), n);
+        } else {
+            size_t n = rbtest_mv_stream_pop_n(buffer.get(), block, 53);
+            for (size_t i = 0; i < n; ++i) { received.push_back(CUDL_GET(block[i])); }
+        }
+    }
+    producer.join();
+
+    for (int32_t i = 0; i < count; ++i) { ASSERT_EQ(received[(size_t) i], i); }
+    ASSERT_EQ(rbtest_mv_stream_size(buffer.get()), 0);
+}
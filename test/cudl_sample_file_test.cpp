@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define CUDL_PREFIX sftest_
+// A small buffer so that the tests go through the flushes and the direct writes
+#define CUDL_SAMPLE_FILE_WRITE_SIZE 4096
+#include <cudl_sample_file.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_COMMON_ARRAY_OPERATORS(mv, int16_t)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int16_t, int64_t)
+CUDL_ADD_SAMPLE_FILE(mv, int16_t)
+CUDL_ADD_UNIT(uv, int16_t)
+CUDL_ADD_SAMPLE_FILE(uv, int16_t)
+CUDL_ADD_FIXED_POINT_UNIT(gain, int32_t, 16)
+CUDL_ADD_FIXED_POINT_SAMPLE_FILE(gain, int32_t)
+
+static std::string temp_path(const char *name) {
+    return testing::TempDir() + "cudl_sample_file_test_" + name;
+}
+
+static void write_mv_file(const std::string &path, const std::vector<sftest_mv_t> &samples) {
+    sftest_mv_sample_writer_t writer;
+    ASSERT_EQ(sftest_mv_sample_writer_open(&writer, path.c_str()), CUDL_SAMPLE_FILE_OK);
+    ASSERT_EQ(sftest_mv_sample_writer_append(&writer, samples[0]), CUDL_SAMPLE_FILE_OK);
+    ASSERT_EQ(sftest_mv_sample_writer_append_n(&writer, &samples[1], 100), CUDL_SAMPLE_FILE_OK);
+    ASSERT_EQ(sftest_mv_sample_writer_append_n(&writer, &samples[101], samples.size() - 102), CUDL_SAMPLE_FILE_OK);
+    ASSERT_EQ(sftest_mv_sample_writer_append(&writer, samples.back()), CUDL_SAMPLE_FILE_OK);
+    ASSERT_EQ(sftest_mv_sample_writer_close(&writer), CUDL_SAMPLE_FILE_OK);
+}
+
+static void patch_file(const std::string &path, size_t offset, unsigned char byte) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp((std::streamoff) offset);
+    file.put((char) byte);
+}
+
+TEST(test_cudl_sample_file, whenWritingSamples_theMappedViewHasThemAligned)
+{
+    const std::string path = temp_path("roundtrip");
+    std::vector<sftest_mv_t> samples(10000);
+    for (size_t i = 0; i < samples.size(); ++i) { samples[i] = sftest_mv((int16_t) (i * 7 - 30000)); }
+    write_mv_file(path, samples);
+
+    sftest_mv_sample_file_t file;
+    ASSERT_EQ(sftest_mv_sample_file_open(&file, path.c_str()), CUDL_SAMPLE_FILE_OK);
+    ASSERT_EQ(file.count, samples.size());
+    ASSERT_EQ((uintptr_t) file.samples % CUDL_ARRAY_ALIGNMENT, 0u);
+    ASSERT_EQ(memcmp(file.samples, samples.data(), samples.size() * sizeof(sftest_mv_t)), 0);
+    // The array functions run on the mapped samples
+    ASSERT_EQ(sftest_mv_sum_n_aligned(file.samples, file.count), sftest_mv_sum_n(samples.data(), samples.size()));
+    std::vector<sftest_mv_t> doubled(file.count);
+    sftest_mv_mul_n(doubled.data(), file.samples, 2, file.count);
+    ASSERT_EQ(CUDL_GET(doubled[3]), 2 * (3 * 7 - 30000) + 65536);
+    sftest_mv_sample_file_close(&file);
+    ASSERT_EQ(file.samples, nullptr);
+    remove(path.c_str());
+}
+
+TEST(test_cudl_sample_file, whenOpeningAsAnotherUnit_theMismatchIsReported)
+{
+    const std::string path = temp_path("mismatch");
+    write_mv_file(path, std::vector<sftest_mv_t>(200, sftest_mv(1)));
+
+    sftest_uv_sample_file_t uv_file;
+    ASSERT_EQ(sftest_uv_sample_file_open(&uv_file, path.c_str()), CUDL_SAMPLE_FILE_UNIT_MISMATCH);
+    ASSERT_EQ(uv_file.samples, nullptr);
+    sftest_uv_sample_file_close(&uv_file);
+    sftest_gain_sample_file_t gain_file;
+    ASSERT_EQ(sftest_gain_sample_file_open(&gain_file, path.c_str()), CUDL_SAMPLE_FILE_UNIT_MISMATCH);
+    sftest_gain_sample_file_close(&gain_file);
+
+    sftest_mv_sample_file_t file;
+    patch_file(path, 25, 4);// Width of the storage type
+    ASSERT_EQ(sftest_mv_sample_file_open(&file, path.c_str()), CUDL_SAMPLE_FILE_UNIT_MISMATCH);
+    sftest_mv_sample_file_close(&file);
+    patch_file(path, 25, 2);
+    patch_file(path, 26, CUDL_HOST_BYTE_ORDER == CUDL_LITTLE_ENDIAN ? CUDL_BIG_ENDIAN : CUDL_LITTLE_ENDIAN);
+    ASSERT_EQ(sftest_mv_sample_file_open(&file, path.c_str()), CUDL_SAMPLE_FILE_BYTE_ORDER_MISMATCH);
+    sftest_mv_sample_file_close(&file);
+    remove(path.c_str());
+}
+
+TEST(test_cudl_sample_file, whenTheFileIsNotASampleFile_itIsRejected)
+{
+    sftest_mv_sample_file_t file;
+    ASSERT_EQ(sftest_mv_sample_file_open(&file, temp_path("missing").c_str()), CUDL_SAMPLE_FILE_IO_ERROR);
+    sftest_mv_sample_file_close(&file);
+
+    const std::string path = temp_path("invalid");
+    write_mv_file(path, std::vector<sftest_mv_t>(200, sftest_mv(1)));
+    patch_file(path, 32, 201);// More samples than the file holds
+    ASSERT_EQ(sftest_mv_sample_file_open(&file, path.c_str()), CUDL_SAMPLE_FILE_INVALID);
+    sftest_mv_sample_file_close(&file);
+    patch_file(path, 0, 'C');
+    ASSERT_EQ(sftest_mv_sample_file_open(&file, path.c_str()), CUDL_SAMPLE_FILE_INVALID);
+    sftest_mv_sample_file_close(&file);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "cudlsmp1";
+    ASSERT_EQ(sftest_mv_sample_file_open(&file, path.c_str()), CUDL_SAMPLE_FILE_INVALID);
+    sftest_mv_sample_file_close(&file);
+    remove(path.c_str());
+}
+
+TEST(test_cudl_sample_file, whenAFileIsStillBeingWritten_itsCountIsGivenByItsSize)
+{
+    const std::string path = temp_path("live");
+    std::vector<sftest_gain_t> gains(3000, sftest_gain(1 << 15));// 0.5
+    sftest_gain_sample_writer_t writer;
+    ASSERT_EQ(sftest_gain_sample_writer_open(&writer, path.c_str()), CUDL_SAMPLE_FILE_OK);
+    ASSERT_EQ(sftest_gain_sample_writer_append_n(&writer, gains.data(), gains.size()), CUDL_SAMPLE_FILE_OK);
+
+    // The header and the first samples fill a buffer, then a whole buffer is written directly, the rest is buffered
+    sftest_gain_sample_file_t file;
+    ASSERT_EQ(sftest_gain_sample_file_open(&file, path.c_str()), CUDL_SAMPLE_FILE_OK);
+    ASSERT_EQ(file.count, (2 * 4096 - CUDL_SAMPLE_FILE_HEADER_SIZE) / 4u);
+    ASSERT_EQ(CUDL_GET(file.samples[file.count - 1]), 1 << 15);
+    sftest_gain_sample_file_close(&file);
+
+    ASSERT_EQ(sftest_gain_sample_writer_close(&writer), CUDL_SAMPLE_FILE_OK);
+    ASSERT_EQ(sftest_gain_sample_file_open(&file, path.c_str()), CUDL_SAMPLE_FILE_OK);
+    ASSERT_EQ(file.count, 3000u);
+    sftest_gain_sample_file_close(&file);
+    remove(path.c_str());
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <cudl.h>
+#include <cstdint>
+
+CUDL_ADD_UNIT(ma, uint16_t)
+CUDL_ADD_SATURATING_OPERATORS(ma, uint16_t)
+CUDL_ADD_CHECKED_OPERATORS(ma, uint16_t)
+
+CUDL_ADD_UNIT(temp, int16_t)
+CUDL_ADD_SATURATING_OPERATORS(temp, int16_t)
+
+CUDL_ADD_UNIT(v, uint32_t)
+CUDL_ADD_SATURATING_OPERATORS(v, uint32_t)
+CUDL_ADD_CHECKED_OPERATORS(v, uint32_t)
+
+CUDL_ADD_UNIT(offset, int32_t)
+CUDL_ADD_SATURATING_OPERATORS(offset, int32_t)
+
+CUDL_ADD_UNIT(ns, int64_t)
+CUDL_ADD_SATURATING_OPERATORS(ns, int64_t)
+CUDL_ADD_CHECKED_OPERATORS(ns, int64_t)
+
+CUDL_ADD_UNIT(bytes, uint64_t)
+CUDL_ADD_SATURATING_OPERATORS(bytes, uint64_t)
+
+TEST(cudl_saturating_test, add)
+{
+    ASSERT_EQ(CUDL_GET(cudl_ma_sat_add(cudl_ma(60000), cudl_ma(5000))), 65000);
+    ASSERT_EQ(CUDL_GET(cudl_ma_sat_add(cudl_ma(60000), cudl_ma(6000))), UINT16_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_temp_sat_add(cudl_temp(30000), cudl_temp(3000))), INT16_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_temp_sat_add(cudl_temp(-30000), cudl_temp(-3000))), INT16_MIN);
+    ASSERT_EQ(CUDL_GET(cudl_v_sat_add(cudl_v(UINT32_MAX - 1), cudl_v(2))), UINT32_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_offset_sat_add(cudl_offset(INT32_MAX), cudl_offset(1))), INT32_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_offset_sat_add(cudl_offset(INT32_MIN), cudl_offset(-1))), INT32_MIN);
+    ASSERT_EQ(CUDL_GET(cudl_ns_sat_add(cudl_ns(INT64_MAX), cudl_ns(1))), INT64_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_ns_sat_add(cudl_ns(INT64_MIN), cudl_ns(-1))), INT64_MIN);
+    ASSERT_EQ(CUDL_GET(cudl_ns_sat_add(cudl_ns(-5), cudl_ns(3))), -2);
+    ASSERT_EQ(CUDL_GET(cudl_bytes_sat_add(cudl_bytes(UINT64_MAX), cudl_bytes(1))), UINT64_MAX);
+}
+
+TEST(cudl_saturating_test, sub)
+{
+    ASSERT_EQ(CUDL_GET(cudl_ma_sat_sub(cudl_ma(5), cudl_ma(6))), 0);
+    ASSERT_EQ(CUDL_GET(cudl_ma_sat_sub(cudl_ma(6), cudl_ma(5))), 1);
+    ASSERT_EQ(CUDL_GET(cudl_temp_sat_sub(cudl_temp(-30000), cudl_temp(3000))), INT16_MIN);
+    ASSERT_EQ(CUDL_GET(cudl_temp_sat_sub(cudl_temp(30000), cudl_temp(-3000))), INT16_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_v_sat_sub(cudl_v(1), cudl_v(2))), 0);
+    ASSERT_EQ(CUDL_GET(cudl_offset_sat_sub(cudl_offset(INT32_MIN), cudl_offset(1))), INT32_MIN);
+    ASSERT_EQ(CUDL_GET(cudl_ns_sat_sub(cudl_ns(INT64_MIN), cudl_ns(1))), INT64_MIN);
+    ASSERT_EQ(CUDL_GET(cudl_ns_sat_sub(cudl_ns(INT64_MAX), cudl_ns(-1))), INT64_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_bytes_sat_sub(cudl_bytes(0), cudl_bytes(1))), 0);
+}
+
+TEST(cudl_saturating_test, multiply)
+{
+    ASSERT_EQ(CUDL_GET(cudl_ma_sat_mul(cudl_ma(1000), 66)), UINT16_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_ma_sat_mul(cudl_ma(1000), 65)), 65000);
+    ASSERT_EQ(CUDL_GET(cudl_temp_sat_mul(cudl_temp(-1000), 40)), INT16_MIN);
+    ASSERT_EQ(CUDL_GET(cudl_temp_sat_mul(cudl_temp(-1000), -40)), INT16_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_v_sat_mul(cudl_v(UINT32_MAX / 2), 3)), UINT32_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_offset_sat_mul(cudl_offset(INT32_MAX / 2), -3)), INT32_MIN);
+    ASSERT_EQ(CUDL_GET(cudl_ns_sat_mul(cudl_ns(INT64_MAX / 2), -3)), INT64_MIN);
+    ASSERT_EQ(CUDL_GET(cudl_ns_sat_mul(cudl_ns(INT64_MIN / 2), -3)), INT64_MAX);
+    ASSERT_EQ(CUDL_GET(cudl_bytes_sat_mul(cudl_bytes(UINT64_MAX / 2), 3)), UINT64_MAX);
+}
+
+TEST(cudl_saturating_test, arrayMatchesScalar)
+{
+    cudl_ma_t lhs[131];
+    cudl_ma_t rhs[131];
+    cudl_ma_t result[131];
+    cudl_temp_t temp_lhs[131];
+    cudl_temp_t temp_rhs[131];
+    cudl_temp_t temp_result[131];
+    for (int i = 0; i < 131; ++i) {
+        lhs[i] = cudl_ma(static_cast<uint16_t>(i * 997));
+        rhs[i] = cudl_ma(static_cast<uint16_t>(65535 - i * 499));
+        temp_lhs[i] = cudl_temp(static_cast<int16_t>(i * 500 - 32000));
+        temp_rhs[i] = cudl_temp(static_cast<int16_t>(i * -300 + 20000));
+    }
+
+    cudl_ma_sat_add_n(result, lhs, rhs, 131);
+    for (size_t i = 0; i < 131; ++i) { ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_ma_sat_add(lhs[i], rhs[i]))); }
+    cudl_ma_sat_sub_n(result, lhs, rhs, 131);
+    for (size_t i = 0; i < 131; ++i) { ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_ma_sat_sub(lhs[i], rhs[i]))); }
+    cudl_ma_sat_mul_n(result, lhs, 7, 131);
+    for (size_t i = 0; i < 131; ++i) { ASSERT_EQ(CUDL_GET(result[i]), CUDL_GET(cudl_ma_sat_mul(lhs[i], 7))); }
+    cudl_temp_sat_add_n(temp_result, temp_lhs, temp_rhs, 131);
+    for (size_t i = 0; i < 131; ++i) {
+        ASSERT_EQ(CUDL_GET(temp_result[i]), CUDL_GET(cudl_temp_sat_add(temp_lhs[i], temp_rhs[i])));
+    }
+    cudl_temp_sat_sub_n(temp_result, temp_lhs, temp_rhs, 131);
+    for (size_t i = 0; i < 131; ++i) {
+        ASSERT_EQ(CUDL_GET(temp_result[i]), CUDL_GET(cudl_temp_sat_sub(temp_lhs[i], temp_rhs[i])));
+    }
+}
+
+TEST(cudl_checked_test, reportsOverflow)
+{
+    cudl_ma_t result;
+    ASSERT_FALSE(cudl_ma_checked_add(cudl_ma(60000), cudl_ma(5000), &result));
+    ASSERT_EQ(CUDL_GET(result), 65000);
+    ASSERT_TRUE(cudl_ma_checked_add(cudl_ma(60000), cudl_ma(6000), &result));
+    ASSERT_EQ(CUDL_GET(result), 464);
+    ASSERT_TRUE(cudl_ma_checked_sub(cudl_ma(0), cudl_ma(1), &result));
+    ASSERT_EQ(CUDL_GET(result), UINT16_MAX);
+    ASSERT_TRUE(cudl_ma_checked_mul(cudl_ma(1000), 66, &result));
+
+    cudl_v_t volts;
+    ASSERT_FALSE(cudl_v_checked_mul(cudl_v(1000), 1000, &volts));
+    ASSERT_EQ(CUDL_GET(volts), 1000000);
+
+    cudl_ns_t ns;
+    ASSERT_TRUE(cudl_ns_checked_sub(cudl_ns(INT64_MIN), cudl_ns(1), &ns));
+    ASSERT_FALSE(cudl_ns_checked_add(cudl_ns(-3), cudl_ns(1), &ns));
+    ASSERT_EQ(CUDL_GET(ns), -2);
+}
+
+TEST(cudl_checked_test, arrayReportsAnyOverflow)
+{
+    cudl_v_t lhs[4] = {{1}, {2}, {3}, {UINT32_MAX}};
+    cudl_v_t rhs[4] = {{1}, {1}, {1}, {1}};
+    cudl_v_t result[4];
+
+    ASSERT_FALSE(cudl_v_checked_add_n(result, lhs, rhs, 3));
+    ASSERT_EQ(CUDL_GET(result[2]), 4);
+    ASSERT_TRUE(cudl_v_checked_add_n(result, lhs, rhs, 4));
+    ASSERT_EQ(CUDL_GET(result[3]), 0);
+    ASSERT_TRUE(cudl_v_checked_mul_n(result, lhs, 2, 4));
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#define CUDL_PREFIX setest_
+#include <cudl.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_SELECTION_OPERATORS(mv, int16_t)
+
+CUDL_ADD_UNIT(a, double)
+CUDL_ADD_SELECTION_OPERATORS(a, double)
+
+// Not a multiple of 64, so the last word of the masks is partial
+#define SELECTION_TEST_SIZE 1000
+
+static std::vector<setest_mv_t> samples() {
+    std::vector<setest_mv_t> values(SELECTION_TEST_SIZE);
+    for (size_t i = 0; i < values.size(); ++i) { values[i] = setest_mv((int16_t) ((i * 7919) % 2001 - 1000)); }
+    return values;
+}
+
+TEST(test_cudl_selection, whenMaskingValues_eachBitIsAComparisonWithTheThreshold)
+{
+    const std::vector<setest_mv_t> values = samples();
+    std::vector<uint64_t> greater(CUDL_MASK_WORDS(SELECTION_TEST_SIZE), UINT64_MAX);
+    std::vector<uint64_t> lower_or_equal(CUDL_MASK_WORDS(SELECTION_TEST_SIZE));
+    std::vector<uint64_t> equal(CUDL_MASK_WORDS(SELECTION_TEST_SIZE));
+    setest_mv_gt_mask_n(greater.data(), values.data(), setest_mv(500), values.size());
+    setest_mv_le_mask_n(lower_or_equal.data(), values.data(), setest_mv(500), values.size());
+    setest_mv_eq_mask_n(equal.data(), values.data(), values[10], values.size());
+
+    ASSERT_EQ(greater.size(), 16u);
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ((greater[i / 64] >> (i % 64)) & 1, CUDL_GET(values[i]) > 500 ? 1u : 0u);
+        ASSERT_EQ((lower_or_equal[i / 64] >> (i % 64)) & 1, CUDL_GET(values[i]) <= 500 ? 1u : 0u);
+    }
+    ASSERT_EQ(greater.back() >> (SELECTION_TEST_SIZE % 64), 0u);
+    ASSERT_EQ(lower_or_equal.back() >> (SELECTION_TEST_SIZE % 64), 0u);
+    ASSERT_EQ((equal[0] >> 10) & 1, 1u);
+}
+
+TEST(test_cudl_selection, whenFilteringValues_theMatchingOnesAreKeptInOrder)
+{
+    const std::vector<setest_mv_t> values = samples();
+    std::vector<setest_mv_t> expected;
+    for (setest_mv_t value : values) {
+        if (CUDL_GET(value) >= 900) { expected.push_back(value); }
+    }
+    std::vector<setest_mv_t> filtered(values.size());
+    const size_t count = setest_mv_filter_ge_n(filtered.data(), values.data(), setest_mv(900), values.size());
+    ASSERT_EQ(count, expected.size());
+    for (size_t i = 0; i < count; ++i) { ASSERT_EQ(CUDL_GET(filtered[i]), CUDL_GET(expected[i])); }
+
+    ASSERT_EQ(setest_mv_filter_gt_n(filtered.data(), values.data(), setest_mv(1000), values.size()), 0u);
+    ASSERT_EQ(setest_mv_filter_lt_n(filtered.data(), values.data(), setest_mv(1001), 0), 0u);
+
+    // In place, the whole array matching
+    std::vector<setest_mv_t> in_place = values;
+    ASSERT_EQ(setest_mv_filter_ne_n(in_place.data(), in_place.data(), setest_mv(2000), in_place.size()), values.size());
+    for (size_t i = 0; i < values.size(); ++i) { ASSERT_EQ(CUDL_GET(in_place[i]), CUDL_GET(values[i])); }
+}
+
+TEST(test_cudl_selection, whenSelectingWithAMask_valuesAreBlended)
+{
+    const std::vector<setest_mv_t> values = samples();
+    std::vector<setest_mv_t> zeros(values.size(), setest_mv(0));
+    std::vector<uint64_t> negative(CUDL_MASK_WORDS(SELECTION_TEST_SIZE));
+    std::vector<setest_mv_t> rectified(values.size());
+    setest_mv_lt_mask_n(negative.data(), values.data(), setest_mv(0), values.size());
+    setest_mv_select_n(rectified.data(), negative.data(), zeros.data(), values.data(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(CUDL_GET(rectified[i]), CUDL_GET(values[i]) < 0 ? 0 : CUDL_GET(values[i]));
+    }
+
+    const setest_a_t currents[3] = {setest_a(1.5), setest_a(-2.0), setest_a(0.25)};
+    const setest_a_t limits[3] = {setest_a(1.0), setest_a(1.0), setest_a(1.0)};
+    uint64_t over[1];
+    setest_a_t limited[3];
+    setest_a_gt_mask_n(over, currents, setest_a(1.0), 3);
+    ASSERT_EQ(over[0], 1u);
+    setest_a_select_n(limited, over, limits, currents, 3);
+    ASSERT_DOUBLE_EQ(CUDL_GET(limited[0]), 1.0);
+    ASSERT_DOUBLE_EQ(CUDL_GET(limited[1]), -2.0);
+}
+
+TEST(test_cudl_selection, whenClampingValues_theyAreWithinTheBounds)
+{
+    alignas(CUDL_ARRAY_ALIGNMENT) setest_mv_t values[SELECTION_TEST_SIZE];
+    alignas(CUDL_ARRAY_ALIGNMENT) setest_mv_t clamped[SELECTION_TEST_SIZE];
+    const std::vector<setest_mv_t> source = samples();
+    std::copy(source.begin(), source.end(), values);
+    setest_mv_clamp_n_aligned(clamped, values, setest_mv(-100), setest_mv(250), SELECTION_TEST_SIZE);
+    for (size_t i = 0; i < SELECTION_TEST_SIZE; ++i) {
+        const int16_t value = CUDL_GET(values[i]);
+        ASSERT_EQ(CUDL_GET(clamped[i]), value < -100 ? -100 : value > 250 ? 250 : value);
+    }
+
+    const setest_a_t currents[3] = {setest_a(1.5), setest_a(-2.0), setest_a(0.25)};
+    setest_a_t clamped_currents[3];
+    setest_a_clamp_n(clamped_currents, currents, setest_a(-1.0), setest_a(1.0), 3);
+    ASSERT_DOUBLE_EQ(CUDL_GET(clamped_currents[0]), 1.0);
+    ASSERT_DOUBLE_EQ(CUDL_GET(clamped_currents[1]), -1.0);
+    ASSERT_DOUBLE_EQ(CUDL_GET(clamped_currents[2]), 0.25);
+}
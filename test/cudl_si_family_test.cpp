@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#define CUDL_PREFIX sitest_
+#include <cudl.h>
+
+CUDL_ADD_SI_FAMILY(v, int32_t, k, , m, u)
+CUDL_ADD_SI_FAMILY(s, int64_t, m, u, n)
+CUDL_ADD_SI_FAMILY(hz, double, G, M, k, )
+
+static_assert(CUDL_GET(sitest_from_kv_to_uv(sitest_kv(2))) == 2000000000, "Single multiplication");
+static_assert(CUDL_GET(sitest_mv_add_uv(sitest_mv(2), sitest_uv(5))) == 2005, "Constant expression");
+
+TEST(test_cudl_si_family, whenConverting_everyPairIsConvertedDirectly)
+{
+    ASSERT_EQ(CUDL_GET(sitest_from_v_to_mv(sitest_v(-3))), -3000);
+    ASSERT_EQ(CUDL_GET(sitest_from_kv_to_v(sitest_kv(7))), 7000);
+    ASSERT_EQ(CUDL_GET(sitest_from_uv_to_mv(sitest_uv(1999))), 1);
+    ASSERT_EQ(CUDL_GET(sitest_from_uv_to_v(sitest_uv(1999999))), 1);
+    ASSERT_EQ(CUDL_GET(sitest_from_uv_to_kv(sitest_uv(2147483647))), 2);
+    ASSERT_EQ(CUDL_GET(sitest_from_mv_to_kv(sitest_mv(-2500000))), -2);
+    ASSERT_EQ(CUDL_GET(sitest_from_ms_to_ns(sitest_ms(4000000000))), 4000000000000000LL);
+    ASSERT_EQ(CUDL_GET(sitest_from_ns_to_us(sitest_ns(123456))), 123);
+    ASSERT_DOUBLE_EQ(CUDL_GET(sitest_from_hz_to_Ghz(sitest_hz(2400000000.0))), 2.4);
+    ASSERT_DOUBLE_EQ(CUDL_GET(sitest_from_Ghz_to_khz(sitest_Ghz(1.5))), 1500000.0);
+}
+
+TEST(test_cudl_si_family, whenConvertingDirectly_theResultIsNotRoundedTwice)
+{
+    // Through mv, 1999 uV would first be truncated to 1 mV, then to 0 V
+    sitest_uv_t values[3] = {sitest_uv(999999), sitest_uv(1999999), sitest_uv(-1000000)};
+    sitest_v_t volts[3];
+    sitest_from_uv_to_v_n(volts, values, 3);
+    ASSERT_EQ(CUDL_GET(volts[0]), 0);
+    ASSERT_EQ(CUDL_GET(volts[1]), 1);
+    ASSERT_EQ(CUDL_GET(volts[2]), -1);
+}
+
+TEST(test_cudl_si_family, whenMixingPrefixes_onlyTheCoarserOperandIsConverted)
+{
+    ASSERT_EQ(CUDL_GET(sitest_mv_add_uv(sitest_mv(3), sitest_uv(-250))), 2750);
+    ASSERT_EQ(CUDL_GET(sitest_uv_add_mv(sitest_uv(-250), sitest_mv(3))), 2750);
+    ASSERT_EQ(CUDL_GET(sitest_kv_sub_v(sitest_kv(1), sitest_v(1))), 999);
+    ASSERT_EQ(CUDL_GET(sitest_v_sub_kv(sitest_v(1), sitest_kv(1))), -999);
+    ASSERT_EQ(CUDL_GET(sitest_ms_add_ns(sitest_ms(1), sitest_ns(1))), 1000001);
+
+    ASSERT_TRUE(sitest_uv_lt_v(sitest_uv(999999), sitest_v(1)));
+    ASSERT_TRUE(sitest_v_eq_uv(sitest_v(1), sitest_uv(1000000)));
+    ASSERT_TRUE(sitest_kv_gt_mv(sitest_kv(1), sitest_mv(999999)));
+    ASSERT_FALSE(sitest_mv_ge_v(sitest_mv(999), sitest_v(1)));
+    ASSERT_TRUE(sitest_v_le_mv(sitest_v(1), sitest_mv(1000)));
+    ASSERT_TRUE(sitest_us_ne_ms(sitest_us(1001), sitest_ms(1)));
+    ASSERT_TRUE(sitest_khz_lt_Mhz(sitest_khz(999.5), sitest_Mhz(1)));
+}
+
+TEST(test_cudl_si_family, whenUsingTheUnitOperators_theyAreTheCommonOperators)
+{
+    sitest_mv_t lhs[2] = {sitest_mv(1), sitest_mv(2)};
+    sitest_mv_t rhs[2] = {sitest_mv(10), sitest_mv(20)};
+    sitest_mv_t sum[2];
+    sitest_mv_add_n(sum, lhs, rhs, 2);
+    ASSERT_EQ(CUDL_GET(sum[1]), 22);
+    ASSERT_EQ(CUDL_GET(sitest_kv_mul(sitest_kv(3), 4)), 12);
+    ASSERT_TRUE(sitest_ns_lt(sitest_ns(1), sitest_ns(2)));
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#define CUDL_PREFIX sotest_
+#include <cudl_soa.h>
+
+CUDL_ADD_UNIT(ns, int64_t)
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int16_t, int64_t)
+CUDL_ADD_UNIT(celsius, float)
+CUDL_ADD_FLOAT_REDUCTION_OPERATORS(celsius, float)
+
+CUDL_ADD_SOA(sample, (time, ns), (voltage, mv), (temperature, celsius))
+
+static sotest_sample_t make_sample(int64_t i) {
+    sotest_sample_t sample;
+    sample.time = sotest_ns(i * 1000);
+    sample.voltage = sotest_mv((int16_t) (i - 100));
+    sample.temperature = sotest_celsius((float) i / 4);
+    return sample;
+}
+
+TEST(test_cudl_soa, whenAppendingRecords_fieldsAreStoredInTheirColumns)
+{
+    sotest_sample_soa_t samples;
+    sotest_sample_soa_init(&samples, NULL);
+    for (int64_t i = 0; i < 1000; ++i) { ASSERT_TRUE(sotest_sample_soa_append(&samples, make_sample(i))); }
+
+    ASSERT_EQ(samples.size, 1000u);
+    ASSERT_GE(samples.capacity, 1000u);
+    for (int64_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(CUDL_GET(sotest_sample_time(&samples)[i]), i * 1000);
+        ASSERT_EQ(CUDL_GET(sotest_sample_voltage(&samples)[i]), i - 100);
+        sotest_sample_t sample = sotest_sample_soa_get(&samples, (size_t) i);
+        ASSERT_EQ(CUDL_GET(sample.time), i * 1000);
+        ASSERT_EQ(CUDL_GET(sample.voltage), i - 100);
+        ASSERT_FLOAT_EQ(CUDL_GET(sample.temperature), (float) i / 4);
+    }
+    sotest_sample_soa_release(&samples);
+    ASSERT_EQ(samples.size, 0u);
+    ASSERT_EQ(samples.time, nullptr);
+}
+
+TEST(test_cudl_soa, whenGrowing_columnsAreAlignedForTheAlignedArrayFunctions)
+{
+    sotest_sample_soa_t samples;
+    sotest_sample_soa_init(&samples, NULL);
+    for (size_t capacity : {1u, 3u, 100u, 1001u}) {
+        ASSERT_TRUE(sotest_sample_soa_reserve(&samples, capacity));
+        ASSERT_EQ((uintptr_t) samples.time % CUDL_ARRAY_ALIGNMENT, 0u);
+        ASSERT_EQ((uintptr_t) samples.voltage % CUDL_ARRAY_ALIGNMENT, 0u);
+        ASSERT_EQ((uintptr_t) samples.temperature % CUDL_ARRAY_ALIGNMENT, 0u);
+    }
+    sotest_sample_soa_release(&samples);
+}
+
+TEST(test_cudl_soa, whenBulkAppending_recordsAndViewsAreAppendedInOrder)
+{
+    std::vector<sotest_sample_t> rows;
+    for (int64_t i = 0; i < 300; ++i) { rows.push_back(make_sample(i)); }
+    sotest_sample_soa_t samples;
+    sotest_sample_soa_init(&samples, NULL);
+    ASSERT_TRUE(sotest_sample_soa_append_n(&samples, rows.data(), 200));
+    ASSERT_TRUE(sotest_sample_soa_append_n(&samples, rows.data() + 200, 100));
+    ASSERT_TRUE(sotest_sample_soa_append_n(&samples, rows.data(), 0));
+
+    sotest_sample_soa_t copy;
+    sotest_sample_soa_init(&copy, NULL);
+    ASSERT_TRUE(sotest_sample_soa_append_view(&copy, sotest_sample_soa_slice(&samples, 100, 200)));
+    ASSERT_TRUE(sotest_sample_soa_append_view(&copy, sotest_sample_soa_slice(&samples, 0, 0)));
+
+    ASSERT_EQ(samples.size, 300u);
+    ASSERT_EQ(copy.size, 200u);
+    for (size_t i = 0; i < 200; ++i) {
+        ASSERT_EQ(CUDL_GET(copy.time[i]), CUDL_GET(samples.time[100 + i]));
+        ASSERT_EQ(CUDL_GET(copy.voltage[i]), CUDL_GET(samples.voltage[100 + i]));
+        ASSERT_EQ(CUDL_GET(copy.temperature[i]), CUDL_GET(samples.temperature[100 + i]));
+    }
+    sotest_sample_soa_release(&copy);
+    sotest_sample_soa_release(&samples);
+}
+
+TEST(test_cudl_soa, whenScanningAView_columnsAreGivenToTheUnitArrayFunctions)
+{
+    sotest_sample_soa_t samples;
+    sotest_sample_soa_init(&samples, NULL);
+    for (int64_t i = 0; i < 201; ++i) { ASSERT_TRUE(sotest_sample_soa_append(&samples, make_sample(i))); }
+
+    sotest_sample_view_t view = sotest_sample_soa_view(&samples);
+    ASSERT_EQ(view.size, 201u);
+    ASSERT_EQ(sotest_mv_sum_n(view.voltage, view.size), 0);
+    ASSERT_EQ(CUDL_GET(sotest_mv_min_n_aligned(view.voltage, view.size)), -100);
+    ASSERT_FLOAT_EQ(CUDL_GET(sotest_celsius_max_n(view.temperature, view.size)), 50.0f);
+
+    sotest_sample_view_t tail = sotest_sample_soa_slice(&samples, 101, 100);
+    ASSERT_EQ(CUDL_GET(tail.time[0]), 101000);
+    ASSERT_EQ(sotest_mv_sum_n(tail.voltage, tail.size), 5050);
+    sotest_sample_soa_release(&samples);
+}
+
+TEST(test_cudl_soa, whenUsingAnArena_columnsAreCarvedFromItsBufferUntilFull)
+{
+    alignas(CUDL_ARRAY_ALIGNMENT) static unsigned char buffer[4096];
+    cudl_arena_t arena;
+    cudl_arena_init(&arena, buffer, sizeof(buffer));
+    cudl_allocator_t allocator = cudl_arena_allocator(&arena);
+
+    sotest_sample_soa_t samples;
+    sotest_sample_soa_init(&samples, &allocator);
+    ASSERT_TRUE(sotest_sample_soa_reserve(&samples, 64));
+    ASSERT_GE((unsigned char *) samples.time, buffer);
+    ASSERT_LT((unsigned char *) samples.temperature, buffer + sizeof(buffer));
+    for (int64_t i = 0; i < 64; ++i) { ASSERT_TRUE(sotest_sample_soa_append(&samples, make_sample(i))); }
+    // The replaced block stays in the arena until it is reset, only the last block allocated is given back
+    ASSERT_TRUE(sotest_sample_soa_reserve(&samples, 128));
+    ASSERT_EQ(arena.used, 128u * 8 + 128u * 4 + 128u * 2 + 64u * 8 + 64u * 4 + 64u * 2);
+    ASSERT_EQ(CUDL_GET(sotest_sample_soa_get(&samples, 63).time), 63000);
+    ASSERT_FALSE(sotest_sample_soa_reserve(&samples, 1024));
+    ASSERT_EQ(samples.capacity, 128u);
+    // The time column of SIZE_MAX / 8 + 1 records would wrap around to a few bytes, which the arena could carve
+    ASSERT_FALSE(sotest_sample_soa_reserve(&samples, SIZE_MAX / 8 + 1));
+    ASSERT_FALSE(sotest_sample_soa_reserve(&samples, SIZE_MAX));
+    ASSERT_EQ(arena.used, 128u * 8 + 128u * 4 + 128u * 2 + 64u * 8 + 64u * 4 + 64u * 2);
+    ASSERT_EQ(samples.capacity, 128u);
+
+    sotest_sample_soa_release(&samples);
+    ASSERT_EQ(arena.used, 64u * 8 + 64u * 4 + 64u * 2);
+    cudl_arena_reset(&arena);
+    ASSERT_EQ(arena.used, 0u);
+}
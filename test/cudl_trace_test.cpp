@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define CUDL_PREFIX trtest_
+#define CUDL_ENABLE_TRACE
+#define CUDL_TRACE_IMPLEMENTATION
+#include <cudl.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_INTEGER_OPERATORS(mv, int16_t)
+CUDL_ADD_COMMON_ARRAY_OPERATORS(mv, int16_t)
+CUDL_ADD_CHECKED_OPERATORS(mv, int16_t)
+CUDL_ADD_UNIT(v, int16_t)
+CUDL_ADD_UNIT(fv, float)
+CUDL_ADD_UNIT(uv, int32_t)
+CUDL_ADD_UNIT(adc, uint16_t)
+CUDL_ADD_UNIT(ma, int16_t)
+CUDL_ADD_UNIT(uw, int32_t)
+CUDL_ADD_FIXED_POINT_UNIT(mv_q, int32_t, 8)
+CUDL_ADD_FIXED_POINT_OPERATORS(mv_q, int32_t)
+CUDL_ADD_FIXED_POINT_UNIT(v_q, int16_t, 4)
+CUDL_ADD_FIXED_POINT_CONVERSION_FRACTION_FACTOR(mv_q, v_q, 1, 1000)
+CUDL_ADD_FIXED_POINT_FLOAT_CONVERSIONS(mv_q, fv)
+
+CUDL_ADD_PRODUCT_OP(mv, ma, uw, _mul_ma)
+CUDL_ADD_WIDENED_PRODUCT_OP(mv, ma, uw, _mul_ma_to_uw, int64_t, 1, 1)
+CUDL_ADD_FUSED_PRODUCT_OP(mv, ma, uw, _mul_ma_add)
+CUDL_ADD_INTEGER_REDUCTION_OPERATORS(mv, int16_t, int64_t)
+CUDL_ADD_FLOAT_REDUCTION_OPERATORS(fv, float)
+
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(mv, v, 1, 1000)
+CUDL_ADD_CONVERSION_FACTOR(v, mv, 1000)
+CUDL_ADD_CONVERSION_FRACTION_FACTOR(mv, fv, 1, 1000)
+CUDL_ADD_REDUCED_CONVERSION_FRACTION_FACTOR(uv, mv, 1, 1000)
+CUDL_ADD_AFFINE_CONVERSION(adc, mv, 3300, 4096, 0)
+
+#if defined(__GNUC__) && __GNUC__ >= 9 || defined(__clang__) && __clang_major__ >= 9
+// Nothing is recorded during constant evaluation, so the traced functions stay constexpr
+static_assert(CUDL_GET(trtest_mv_add(trtest_mv(1), trtest_mv(2))) == 3, "Constexpr while tracing");
+#endif
+
+static uint64_t trace_count(const char *unit, const char *op, cudl_trace_event_t event) {
+    std::vector<cudl_trace_count_t> counts(CUDL_TRACE_MAX_SITES);
+    const size_t size = cudl_trace_snapshot(counts.data(), counts.size());
+    for (size_t i = 0; i < size; ++i) {
+        if (strcmp(counts[i].unit, unit) == 0 && strcmp(counts[i].op, op) == 0) { return counts[i].counts[event]; }
+    }
+    return 0;
+}
+
+TEST(test_cudl_trace, whenCallingOps_callsAreCountedByUnitAndOp)
+{
+    const uint64_t adds = trace_count("mv", "add", CUDL_TRACE_CALL);
+    const uint64_t gts = trace_count("mv", "gt", CUDL_TRACE_CALL);
+    const uint64_t add_ns = trace_count("mv", "add_n", CUDL_TRACE_CALL);
+
+    trtest_mv_t total = trtest_mv(0);
+    for (int16_t i = 0; i < 10; ++i) { total = trtest_mv_add(total, trtest_mv(i)); }
+    ASSERT_TRUE(trtest_mv_gt(total, trtest_mv(44)));
+    trtest_mv_t lhs[100] = {};
+    trtest_mv_t rhs[100] = {};
+    trtest_mv_t sum[100];
+    trtest_mv_add_n(sum, lhs, rhs, 100);
+
+    ASSERT_EQ(CUDL_GET(total), 45);
+    ASSERT_EQ(trace_count("mv", "add", CUDL_TRACE_CALL) - adds, 10u);
+    ASSERT_EQ(trace_count("mv", "gt", CUDL_TRACE_CALL) - gts, 1u);
+    ASSERT_EQ(trace_count("mv", "add_n", CUDL_TRACE_CALL) - add_ns, 100u);
+}
+
+TEST(test_cudl_trace, whenConvertingToIntegerUnits_overflowsAndTruncationsAreCounted)
+{
+    const uint64_t calls = trace_count("mv", "from_mv_to_v", CUDL_TRACE_CALL);
+    const uint64_t truncations = trace_count("mv", "from_mv_to_v", CUDL_TRACE_TRUNCATION);
+    const uint64_t overflows = trace_count("v", "from_v_to_mv", CUDL_TRACE_OVERFLOW);
+    const uint64_t exact = trace_count("v", "from_v_to_mv", CUDL_TRACE_TRUNCATION);
+
+    ASSERT_EQ(CUDL_GET(trtest_from_mv_to_v(trtest_mv(3000))), 3);
+    ASSERT_EQ(CUDL_GET(trtest_from_mv_to_v(trtest_mv(1999))), 1);
+    ASSERT_EQ(CUDL_GET(trtest_from_mv_to_v(trtest_mv(-1))), 0);
+    ASSERT_EQ(CUDL_GET(trtest_from_v_to_mv(trtest_v(32))), 32000);
+    trtest_from_v_to_mv(trtest_v(33));// 33000 mV do not fit in an int16_t
+
+    ASSERT_EQ(trace_count("mv", "from_mv_to_v", CUDL_TRACE_CALL) - calls, 3u);
+    ASSERT_EQ(trace_count("mv", "from_mv_to_v", CUDL_TRACE_TRUNCATION) - truncations, 2u);
+    ASSERT_EQ(trace_count("v", "from_v_to_mv", CUDL_TRACE_OVERFLOW) - overflows, 1u);
+    ASSERT_EQ(trace_count("v", "from_v_to_mv", CUDL_TRACE_TRUNCATION) - exact, 0u);
+}
+
+TEST(test_cudl_trace, whenConvertingWithOtherConversions_eventsAreCountedPerElement)
+{
+    const uint64_t floats = trace_count("mv", "from_mv_to_fv", CUDL_TRACE_TRUNCATION);
+    const uint64_t reduced = trace_count("uv", "from_uv_to_mv", CUDL_TRACE_OVERFLOW);
+    const uint64_t affine = trace_count("adc", "from_adc_to_mv", CUDL_TRACE_CALL);
+    const uint64_t affine_truncations = trace_count("adc", "from_adc_to_mv", CUDL_TRACE_TRUNCATION);
+    const uint64_t affine_n = trace_count("adc", "from_adc_to_mv_n", CUDL_TRACE_CALL);
+
+    trtest_from_mv_to_fv(trtest_mv(1999));
+    trtest_from_uv_to_mv(trtest_uv(40000000));
+    trtest_adc_t codes[4] = {trtest_adc(0), trtest_adc(1), trtest_adc(2048), trtest_adc(4095)};
+    trtest_mv_t millivolts[4];
+    trtest_from_adc_to_mv_n(millivolts, codes, 4);
+
+    ASSERT_EQ(CUDL_GET(millivolts[2]), 1650);
+    ASSERT_EQ(trace_count("mv", "from_mv_to_fv", CUDL_TRACE_TRUNCATION) - floats, 0u);
+    ASSERT_EQ(trace_count("uv", "from_uv_to_mv", CUDL_TRACE_OVERFLOW) - reduced, 1u);
+    ASSERT_EQ(trace_count("adc", "from_adc_to_mv", CUDL_TRACE_CALL) - affine, 4u);
+    ASSERT_EQ(trace_count("adc", "from_adc_to_mv", CUDL_TRACE_TRUNCATION) - affine_truncations, 2u);
+    ASSERT_EQ(trace_count("adc", "from_adc_to_mv_n", CUDL_TRACE_CALL) - affine_n, 4u);
+}
+
+TEST(test_cudl_trace, whenCheckedOpsOverflow_overflowsAreCounted)
+{
+    const uint64_t overflows = trace_count("mv", "checked_add", CUDL_TRACE_OVERFLOW);
+    const uint64_t array_overflows = trace_count("mv", "checked_mul_n", CUDL_TRACE_OVERFLOW);
+    trtest_mv_t result;
+    ASSERT_FALSE(trtest_mv_checked_add(trtest_mv(1), trtest_mv(2), &result));
+    ASSERT_TRUE(trtest_mv_checked_add(trtest_mv(INT16_MAX), trtest_mv(1), &result));
+    const trtest_mv_t values[3] = {trtest_mv(1), trtest_mv(20000), trtest_mv(-20000)};
+    trtest_mv_t products[3];
+    ASSERT_TRUE(trtest_mv_checked_mul_n(products, values, 2, 3));
+
+    ASSERT_EQ(trace_count("mv", "checked_add", CUDL_TRACE_OVERFLOW) - overflows, 1u);
+    ASSERT_EQ(trace_count("mv", "checked_mul_n", CUDL_TRACE_OVERFLOW) - array_overflows, 2u);
+}
+
+TEST(test_cudl_trace, whenCallingProductFixedPointAndReductionOps_callsAreCountedPerElement)
+{
+    const uint64_t products = trace_count("mv", "mul_ma", CUDL_TRACE_CALL);
+    const uint64_t product_ns = trace_count("mv", "mul_ma_n", CUDL_TRACE_CALL);
+    const uint64_t widened_ns = trace_count("mv", "mul_ma_to_uw_n", CUDL_TRACE_CALL);
+    const uint64_t fused_ns = trace_count("mv", "mul_ma_add_n", CUDL_TRACE_CALL);
+    const uint64_t qmuls = trace_count("mv_q", "qmul", CUDL_TRACE_CALL);
+    const uint64_t qdiv_ns = trace_count("mv_q", "qdiv_n", CUDL_TRACE_CALL);
+    const uint64_t sum_ns = trace_count("mv", "sum_n", CUDL_TRACE_CALL);
+    const uint64_t mean_ns = trace_count("mv", "mean_n", CUDL_TRACE_CALL);
+    const uint64_t float_sum_ns = trace_count("fv", "sum_n", CUDL_TRACE_CALL);
+    const uint64_t float_max_ns = trace_count("fv", "max_n", CUDL_TRACE_CALL);
+
+    trtest_mv_t millivolts[4] = {trtest_mv(1), trtest_mv(2), trtest_mv(3), trtest_mv(4)};
+    trtest_ma_t milliamps[4] = {trtest_ma(10), trtest_ma(10), trtest_ma(10), trtest_ma(10)};
+    trtest_uw_t microwatts[4] = {};
+    ASSERT_EQ(CUDL_GET(trtest_mv_mul_ma(millivolts[1], milliamps[0])), 20);
+    trtest_mv_mul_ma_n(microwatts, millivolts, milliamps, 4);
+    trtest_mv_mul_ma_to_uw_n(microwatts, millivolts, milliamps, 4);
+    trtest_mv_mul_ma_add_n(microwatts, millivolts, milliamps, microwatts, 4);
+    ASSERT_EQ(CUDL_GET(microwatts[3]), 80);
+    trtest_mv_q_t fixed[2] = {CUDL_FIXED_POINT(mv_q, 1.5), CUDL_FIXED_POINT(mv_q, 2.0)};
+    trtest_mv_q_t quotients[2];
+    trtest_mv_q_qmul(fixed[0], fixed[1]);
+    trtest_mv_q_qdiv_n(quotients, fixed, fixed, 2);
+    ASSERT_EQ(trtest_mv_sum_n(millivolts, 4), 10);
+    ASSERT_EQ(CUDL_GET(trtest_mv_mean_n(millivolts, 4)), 2);
+    // Longer than a pairwise block, so that the float sum is split
+    std::vector<trtest_fv_t> floats(3000, trtest_fv(0.5f));
+    ASSERT_FLOAT_EQ(trtest_fv_sum_n(floats.data(), floats.size()), 1500.0f);
+    trtest_fv_max_n(floats.data(), floats.size());
+
+    ASSERT_EQ(trace_count("mv", "mul_ma", CUDL_TRACE_CALL) - products, 1u);
+    ASSERT_EQ(trace_count("mv", "mul_ma_n", CUDL_TRACE_CALL) - product_ns, 4u);
+    ASSERT_EQ(trace_count("mv", "mul_ma_to_uw_n", CUDL_TRACE_CALL) - widened_ns, 4u);
+    ASSERT_EQ(trace_count("mv", "mul_ma_add_n", CUDL_TRACE_CALL) - fused_ns, 4u);
+    ASSERT_EQ(trace_count("mv_q", "qmul", CUDL_TRACE_CALL) - qmuls, 1u);
+    ASSERT_EQ(trace_count("mv_q", "qdiv_n", CUDL_TRACE_CALL) - qdiv_ns, 2u);
+    ASSERT_EQ(trace_count("mv", "sum_n", CUDL_TRACE_CALL) - sum_ns, 8u);// The mean sums its elements
+    ASSERT_EQ(trace_count("mv", "mean_n", CUDL_TRACE_CALL) - mean_ns, 4u);
+    ASSERT_EQ(trace_count("fv", "sum_n", CUDL_TRACE_CALL) - float_sum_ns, 3000u);
+    ASSERT_EQ(trace_count("fv", "max_n", CUDL_TRACE_CALL) - float_max_ns, 3000u);
+}
+
+TEST(test_cudl_trace, whenConvertingFixedPointUnits_callsAndLostPrecisionAreCounted)
+{
+    const uint64_t from_ints = trace_count("mv_q", "from_int", CUDL_TRACE_CALL);
+    const uint64_t calls = trace_count("mv_q", "from_mv_q_to_v_q", CUDL_TRACE_CALL);
+    const uint64_t truncations = trace_count("mv_q", "from_mv_q_to_v_q", CUDL_TRACE_TRUNCATION);
+    const uint64_t to_floats = trace_count("mv_q", "from_mv_q_to_fv", CUDL_TRACE_CALL);
+    const uint64_t to_fixed_ns = trace_count("fv", "from_fv_to_mv_q_n", CUDL_TRACE_CALL);
+    const uint64_t float_truncations = trace_count("fv", "from_fv_to_mv_q", CUDL_TRACE_TRUNCATION);
+
+    ASSERT_EQ(CUDL_GET(trtest_from_mv_q_to_v_q(trtest_mv_q_from_int(2000))), 32);// Exactly 2 V
+    trtest_from_mv_q_to_v_q(trtest_mv_q_from_int(1030));// 1.03 V is between two 1/16 V steps
+    trtest_from_mv_q_to_fv(trtest_mv_q_from_int(3));
+    const trtest_fv_t floats[3] = {trtest_fv(0.5f), trtest_fv(0.001f), trtest_fv(-2.0f)};
+    trtest_mv_q_t fixed[3];
+    trtest_from_fv_to_mv_q_n(fixed, floats, 3);
+
+    ASSERT_EQ(trace_count("mv_q", "from_int", CUDL_TRACE_CALL) - from_ints, 3u);
+    ASSERT_EQ(trace_count("mv_q", "from_mv_q_to_v_q", CUDL_TRACE_CALL) - calls, 2u);
+    ASSERT_EQ(trace_count("mv_q", "from_mv_q_to_v_q", CUDL_TRACE_TRUNCATION) - truncations, 1u);
+    ASSERT_EQ(trace_count("mv_q", "from_mv_q_to_fv", CUDL_TRACE_CALL) - to_floats, 1u);
+    ASSERT_EQ(trace_count("fv", "from_fv_to_mv_q_n", CUDL_TRACE_CALL) - to_fixed_ns, 3u);
+    ASSERT_EQ(trace_count("fv", "from_fv_to_mv_q", CUDL_TRACE_TRUNCATION) - float_truncations, 1u);
+}
+
+TEST(test_cudl_trace, whenManyThreadsCount_snapshotsSumAllThreads)
+{
+    const uint64_t subs = trace_count("mv", "sub", CUDL_TRACE_CALL);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            trtest_mv_t value = trtest_mv(0);
+            for (int i = 0; i < 1000; ++i) { value = trtest_mv_sub(value, trtest_mv(1)); }
+            ASSERT_EQ(CUDL_GET(value), -1000);
+        });
+    }
+    for (std::thread &thread : threads) { thread.join(); }
+    // The counters of the threads that exited are kept
+    ASSERT_EQ(trace_count("mv", "sub", CUDL_TRACE_CALL) - subs, 4000u);
+}
+
+struct recorded_event {
+    std::string unit;
+    std::string op;
+    cudl_trace_event_t event;
+    uint64_t count;
+};
+
+static void record_event(const char *unit, const char *op, cudl_trace_event_t event, uint64_t count, void *context) {
+    static_cast<std::vector<recorded_event> *>(context)->push_back({unit, op, event, count});
+}
+
+TEST(test_cudl_trace, whenAHookIsSet_itIsCalledForEachEvent)
+{
+    std::vector<recorded_event> events;
+    const cudl_trace_hook_t hook = {record_event, &events};
+    cudl_trace_set_hook(&hook);
+    const trtest_mv_t millivolts[8] = {};
+    trtest_mv_t products[8];
+    trtest_mv_mul_n(products, millivolts, 3, 8);
+    trtest_from_v_to_mv(trtest_v(-40));
+    cudl_trace_set_hook(NULL);
+    trtest_mv_add(trtest_mv(1), trtest_mv(1));
+
+    ASSERT_EQ(events.size(), 3u);
+    ASSERT_EQ(events[0].op, "mul_n");
+    ASSERT_EQ(events[0].count, 8u);
+    ASSERT_EQ(events[1].unit, "v");
+    ASSERT_EQ(events[1].event, CUDL_TRACE_CALL);
+    ASSERT_EQ(events[2].op, "from_v_to_mv");
+    ASSERT_EQ(events[2].event, CUDL_TRACE_OVERFLOW);
+}
+
+TEST(test_cudl_trace, whenDumping_countsArePrintedSortedByUnitAndOp)
+{
+    trtest_mv_bnot(trtest_mv(0));
+    trtest_mv_add(trtest_mv(0), trtest_mv(0));
+    trtest_from_mv_to_v(trtest_mv(0));
+    std::vector<cudl_trace_count_t> counts(CUDL_TRACE_MAX_SITES);
+    const size_t size = cudl_trace_snapshot(counts.data(), counts.size());
+    ASSERT_GE(size, 3u);
+    for (size_t i = 1; i < size; ++i) {
+        const int unit = strcmp(counts[i - 1].unit, counts[i].unit);
+        ASSERT_TRUE(unit < 0 || (unit == 0 && strcmp(counts[i - 1].op, counts[i].op) < 0));
+    }
+    ASSERT_EQ(cudl_trace_snapshot(counts.data(), 1), size);
+
+    testing::internal::CaptureStdout();
+    cudl_trace_dump(stdout);
+    const std::string dump = testing::internal::GetCapturedStdout();
+    ASSERT_EQ(dump.find("unit"), 0u);
+    ASSERT_NE(dump.find("bnot"), std::string::npos);
+    ASSERT_EQ(cudl_trace_dropped(), 0u);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#define CUDL_PREFIX wtest_
+#include <cudl_wire.h>
+
+CUDL_ADD_UNIT(mv, int16_t)
+CUDL_ADD_WIRE_ENCODING(mv, int16_t)
+
+CUDL_ADD_UNIT(ns, uint64_t)
+CUDL_ADD_WIRE_ENCODING(ns, uint64_t)
+
+CUDL_ADD_UNIT(v, float)
+CUDL_ADD_WIRE_ENCODING(v, float)
+
+CUDL_ADD_FIXED_POINT_UNIT(q, int32_t, 16)
+CUDL_ADD_FIXED_POINT_WIRE_ENCODING(q, int32_t)
+
+TEST(test_cudl_wire, whenEncodingWithAByteOrder_bytesAreWrittenInThatOrder)
+{
+    wtest_mv_t values[2] = {wtest_mv(0x1234), wtest_mv(-2)};
+    uint8_t bytes[4];
+    ASSERT_EQ(wtest_mv_encode_n(bytes, values, 2, CUDL_BIG_ENDIAN), 4);
+    ASSERT_EQ(bytes[0], 0x12);
+    ASSERT_EQ(bytes[1], 0x34);
+    ASSERT_EQ(bytes[2], 0xff);
+    ASSERT_EQ(bytes[3], 0xfe);
+    ASSERT_EQ(wtest_mv_encode_n(bytes, values, 2, CUDL_LITTLE_ENDIAN), 4);
+    ASSERT_EQ(bytes[0], 0x34);
+    ASSERT_EQ(bytes[1], 0x12);
+
+    wtest_ns_t time = wtest_ns(0x0102030405060708ULL);
+    uint8_t time_bytes[8];
+    wtest_ns_encode_n(time_bytes, &time, 1, CUDL_BIG_ENDIAN);
+    for (uint8_t i = 0; i < 8; ++i) { ASSERT_EQ(time_bytes[i], i + 1); }
+}
+
+TEST(test_cudl_wire, whenDecodingEncodedValues_valuesAreRestoredInBothByteOrders)
+{
+    std::vector<wtest_v_t> values;
+    for (int i = 0; i < 1001; ++i) { values.push_back(wtest_v((float) i * 0.25f - 100.0f)); }
+    std::vector<uint8_t> bytes(values.size() * sizeof(float));
+    std::vector<wtest_v_t> decoded(values.size());
+    for (cudl_byte_order_t order : {CUDL_LITTLE_ENDIAN, CUDL_BIG_ENDIAN}) {
+        wtest_v_encode_n(bytes.data(), values.data(), values.size(), order);
+        wtest_v_decode_n(decoded.data(), bytes.data(), bytes.size() / sizeof(float), order);
+        for (size_t i = 0; i < values.size(); ++i) { ASSERT_EQ(CUDL_GET(decoded[i]), CUDL_GET(values[i])); }
+    }
+}
+
+TEST(test_cudl_wire, whenByteOrderMatches_decodeViewDoesNotCopy)
+{
+    const cudl_byte_order_t other = CUDL_HOST_BYTE_ORDER == CUDL_LITTLE_ENDIAN ? CUDL_BIG_ENDIAN : CUDL_LITTLE_ENDIAN;
+    auto *bytes = static_cast<uint8_t *>(std::malloc(16));
+    wtest_mv_t values[4] = {wtest_mv(1), wtest_mv(2), wtest_mv(3), wtest_mv(4)};
+    wtest_mv_encode_n(bytes, values, 4, CUDL_HOST_BYTE_ORDER);
+
+    const wtest_mv_t *view = wtest_mv_decode_view(bytes, CUDL_HOST_BYTE_ORDER);
+    ASSERT_EQ(static_cast<const void *>(view), static_cast<const void *>(bytes));
+    ASSERT_EQ(CUDL_GET(view[3]), 4);
+    ASSERT_EQ(wtest_mv_decode_view(bytes, other), nullptr);
+    ASSERT_EQ(wtest_mv_decode_view(bytes + 1, CUDL_HOST_BYTE_ORDER), nullptr);
+
+    wtest_mv_encode_n(bytes, values, 4, other);
+    wtest_mv_t *swapped = wtest_mv_decode_in_place_n(bytes, 4, other);
+    ASSERT_EQ(static_cast<void *>(swapped), static_cast<void *>(bytes));
+    for (int16_t i = 0; i < 4; ++i) { ASSERT_EQ(CUDL_GET(swapped[i]), i + 1); }
+    std::free(bytes);
+}
+
+TEST(test_cudl_wire, whenDecodingHeader_onlyTheSameUnitIsAccepted)
+{
+    uint8_t header[CUDL_WIRE_HEADER_SIZE];
+    uint32_t count = 0;
+    cudl_byte_order_t order = CUDL_LITTLE_ENDIAN;
+
+    ASSERT_EQ(wtest_q_encode_header(header, 70000, CUDL_BIG_ENDIAN), CUDL_WIRE_HEADER_SIZE);
+    ASSERT_EQ(header[0], 'q');
+    ASSERT_EQ(header[1], 0);
+    ASSERT_EQ(header[16], 'i');
+    ASSERT_EQ(header[17], 4);
+    ASSERT_EQ(header[19], 16);
+    ASSERT_TRUE(wtest_q_decode_header(header, sizeof(header), &count, &order));
+    ASSERT_EQ(count, 70000u);
+    ASSERT_EQ(order, CUDL_BIG_ENDIAN);
+    ASSERT_FALSE(wtest_mv_decode_header(header, sizeof(header), &count, &order));
+
+    wtest_v_encode_header(header, 3, CUDL_LITTLE_ENDIAN);
+    ASSERT_EQ(header[16], 'f');
+    ASSERT_TRUE(wtest_v_decode_header(header, sizeof(header), &count, &order));
+    ASSERT_EQ(count, 3u);
+    ASSERT_EQ(order, CUDL_LITTLE_ENDIAN);
+    ASSERT_FALSE(wtest_q_decode_header(header, sizeof(header), &count, &order));
+    ASSERT_FALSE(wtest_v_decode_header(header, CUDL_WIRE_HEADER_SIZE - 1, &count, &order));
+}